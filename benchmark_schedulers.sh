@@ -0,0 +1,67 @@
+# Usage help
+if [ "$1" == "--help" ]; then
+  echo "Usage: bash benchmark_schedulers.sh [--help] [--basic, --satnet]*"
+  exit 0
+fi
+
+# Schedulers (simulator_scheduler_type) to compare
+SCHEDULERS="map list heap calendar ladder"
+
+# Benchmark results output folder
+rm -rf benchmark_results
+mkdir -p benchmark_results
+echo "workload,scheduler,num_events,wallclock_s,events_per_wallclock_s" > benchmark_results/benchmark_schedulers.csv
+
+# Rebuild to have the most up-to-date
+bash rebuild.sh || exit 1
+
+# Run one workload (main program and run directory) once with each scheduler
+benchmark_workload() {
+  workload=$1
+  main_program=$2
+  run_dir=$3
+  for scheduler in ${SCHEDULERS}; do
+    echo "Benchmarking ${workload} with the ${scheduler} scheduler"
+
+    # Copy of the run directory with the scheduler set
+    benchmark_run_dir="${run_dir}_benchmark_${scheduler}"
+    rm -rf "${benchmark_run_dir}"
+    cp -r "${run_dir}" "${benchmark_run_dir}" || exit 1
+    rm -rf "${benchmark_run_dir}/logs_ns3"
+    echo "" >> "${benchmark_run_dir}/config_ns3.properties"
+    echo "simulator_scheduler_type=${scheduler}" >> "${benchmark_run_dir}/config_ns3.properties"
+
+    # Run
+    console_file="benchmark_results/${workload}_${scheduler}_console.txt"
+    cd simulator || exit 1
+    ./waf --run="${main_program} --run_dir='$(pwd)/../${benchmark_run_dir}'" > "../${console_file}" 2>&1 || exit 1
+    cd .. || exit 1
+
+    # Executed <num_events> events with the <scheduler> scheduler (<events per second> events per wallclock second).
+    num_events=$(grep "^Executed .* events with the" "${console_file}" | awk '{print $2}')
+    events_per_s=$(grep "^Executed .* events with the" "${console_file}" | sed 's/.*(\([0-9]*\) events per wallclock second).*/\1/')
+    wallclock_s=$(grep "took in wallclock time" "${console_file}" | sed 's/.*wallclock time \([0-9.]*\) seconds.*/\1/')
+    echo "${workload},${scheduler},${num_events},${wallclock_s},${events_per_s}" >> benchmark_results/benchmark_schedulers.csv
+    echo "  > ${num_events} events in ${wallclock_s} s: ${events_per_s} events/s"
+
+    rm -rf "${benchmark_run_dir}"
+  done
+}
+
+# Point-to-point topology (basic_main)
+if [ "$1" == "" ] || [ "$1" == "--basic" ] || [ "$2" == "--basic" ]; then
+  benchmark_workload "basic_multi" "basic_main" "runsim/basic_multi"
+fi
+
+# Satellite network (main_satnet)
+if [ "$1" == "" ] || [ "$1" == "--satnet" ] || [ "$2" == "--satnet" ]; then
+  cd simulator/test_data || exit 1
+  bash extract_test_data.sh > /dev/null || exit 1
+  cd ../.. || exit 1
+  benchmark_workload "satnet_end_to_end" "main_satnet" "simulator/test_data/end_to_end/run"
+fi
+
+# Show results
+echo ""
+echo "Results are in: benchmark_results/benchmark_schedulers.csv"
+cat benchmark_results/benchmark_schedulers.csv
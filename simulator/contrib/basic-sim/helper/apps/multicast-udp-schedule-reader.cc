@@ -34,6 +34,25 @@ namespace ns3 {
         return m_to_node_ids;
     }
 
+    std::set<int64_t> MulticastUdpInfo::GetAllToNodeIds() {
+        std::set<int64_t> all_to_node_ids = m_to_node_ids;
+        for (const MulticastMembershipEvent& event : m_membership_events) {
+            all_to_node_ids.insert(event.node_id);
+        }
+        return all_to_node_ids;
+    }
+
+    const std::vector<MulticastMembershipEvent>& MulticastUdpInfo::GetMembershipEvents() {
+        return m_membership_events;
+    }
+
+    void MulticastUdpInfo::AddMembershipEvent(MulticastMembershipEvent event) {
+        if (!m_membership_events.empty() && event.time_ns < m_membership_events.back().time_ns) {
+            throw std::invalid_argument("Multicast membership events must be added weakly ascending on time");
+        }
+        m_membership_events.push_back(event);
+    }
+
     double MulticastUdpInfo::GetTargetRateMegabitPerSec() {
         return m_target_rate_megabit_per_s;
     }
@@ -177,4 +196,95 @@ namespace ns3 {
 
     }
 
-}
\ No newline at end of file
+    /**
+     * Read in the multicast membership changes, and add them to the multicast UDP schedule.
+     *
+     * Each line: [time (ns)],[multicast UDP ID],[join or leave],[node id]
+     *
+     * @param filename                  File name of the membership schedule
+     * @param topology                  Topology
+     * @param simulation_end_time_ns    Simulation end time (ns) : all changes must be less than this value
+     * @param schedule                  (Input/output) Multicast UDP schedule
+    */
+    void read_multicast_membership_schedule(const std::string& filename, Ptr<Topology> topology, const int64_t simulation_end_time_ns, std::vector<MulticastUdpInfo>& schedule) {
+
+        // Check that the file exists
+        if (!file_exists(filename)) {
+            throw std::runtime_error(format_string("File %s does not exist.", filename.c_str()));
+        }
+
+        // Current members of every group, to check each change is valid
+        std::vector<std::set<int64_t>> members;
+        for (MulticastUdpInfo& entry : schedule) {
+            members.push_back(entry.GetToNodeIds());
+        }
+
+        // Open file
+        std::string line;
+        std::ifstream membership_file(filename);
+        if (membership_file) {
+
+            // Go over each line
+            int64_t prev_time_ns = 0;
+            while (getline(membership_file, line)) {
+
+                // Split on ,
+                std::vector<std::string> comma_split = split_string(line, ",", 4);
+                int64_t time_ns = parse_positive_int64(comma_split[0]);
+                int64_t udp_burst_id = parse_positive_int64(comma_split[1]);
+                std::string type = comma_split[2];
+                int64_t node_id = parse_positive_int64(comma_split[3]);
+
+                // Must be weakly ascending time, and before the end
+                if (prev_time_ns > time_ns) {
+                    throw std::invalid_argument(format_string("Membership change time is not weakly ascending (violation: %" PRId64 ")\n", time_ns));
+                }
+                prev_time_ns = time_ns;
+                if (time_ns >= simulation_end_time_ns) {
+                    throw std::invalid_argument(format_string(
+                            "Membership change has invalid time %" PRId64 " >= %" PRId64 ".",
+                            time_ns, simulation_end_time_ns
+                    ));
+                }
+
+                // Check multicast UDP ID and node
+                if (udp_burst_id >= (int64_t) schedule.size()) {
+                    throw std::invalid_argument(format_string("Membership change of unknown multicast UDP ID: %" PRId64, udp_burst_id));
+                }
+                MulticastUdpInfo& entry = schedule[udp_burst_id];
+                if (!topology->IsValidEndpoint(node_id)) {
+                    throw std::invalid_argument(format_string("Invalid endpoint for a membership change based on topology: %" PRId64, node_id));
+                }
+                if (node_id == entry.GetFromNodeId()) {
+                    throw std::invalid_argument(format_string("Multicast UDP (ID: %" PRId64 ") source cannot join or leave its own group.", udp_burst_id));
+                }
+
+                // Join or leave
+                bool is_join;
+                if (type == "join") {
+                    if (!members[udp_burst_id].insert(node_id).second) {
+                        throw std::invalid_argument(format_string("Node %" PRId64 " joins multicast UDP %" PRId64 " of which it is already a member.", node_id, udp_burst_id));
+                    }
+                    is_join = true;
+                } else if (type == "leave") {
+                    if (members[udp_burst_id].erase(node_id) == 0) {
+                        throw std::invalid_argument(format_string("Node %" PRId64 " leaves multicast UDP %" PRId64 " of which it is not a member.", node_id, udp_burst_id));
+                    }
+                    is_join = false;
+                } else {
+                    throw std::invalid_argument("Unknown membership change (must be join or leave): " + type);
+                }
+                entry.AddMembershipEvent({time_ns, node_id, is_join});
+
+            }
+
+            // Close file
+            membership_file.close();
+
+        } else {
+            throw std::runtime_error(format_string("File %s could not be read.", filename.c_str()));
+        }
+
+    }
+
+}
@@ -17,6 +17,13 @@
 
 namespace ns3 {
 
+    // A destination joining or leaving a multicast group during the burst
+    struct MulticastMembershipEvent {
+        int64_t time_ns;
+        int64_t node_id;
+        bool is_join;
+    };
+
     class MulticastUdpInfo
     {
     public:
@@ -34,6 +41,9 @@ namespace ns3 {
         int64_t GetUdpBurstId() const;
         int64_t GetFromNodeId();
         std::set<int64_t>& GetToNodeIds();
+        std::set<int64_t> GetAllToNodeIds();
+        const std::vector<MulticastMembershipEvent>& GetMembershipEvents();
+        void AddMembershipEvent(MulticastMembershipEvent event);
         // int64_t GetToNodeId();
         double GetTargetRateMegabitPerSec();
         int64_t GetStartTimeNs();
@@ -45,7 +55,8 @@ namespace ns3 {
     private:
         int64_t m_udp_burst_id;
         int64_t m_from_node_id;
-        std::set<int64_t> m_to_node_ids;
+        std::set<int64_t> m_to_node_ids;                                //!< Members at the start
+        std::vector<MulticastMembershipEvent> m_membership_events;     //!< Joins and leaves after, weakly ascending in time
         // int64_t m_to_node_id;
         double m_target_rate_megabit_per_s;
         int64_t m_start_time_ns;
@@ -60,6 +71,13 @@ namespace ns3 {
         Ptr<Topology> topology,
         const int64_t simulation_end_time_ns
     );
+
+    void read_multicast_membership_schedule(
+        const std::string& filename,
+        Ptr<Topology> topology,
+        const int64_t simulation_end_time_ns,
+        std::vector<MulticastUdpInfo>& schedule
+    );
 }
 
 #endif /* MULTICAST_UDP_SCHEDULE_READER_H */
@@ -26,6 +26,10 @@ namespace ns3 {
         return m_schedule;
     }
 
+    const std::vector<std::pair<MulticastUdpInfo, Ptr<MulticastUdpApplication>>>& MulticastUdpScheduler::GetResponsibleForIncomingMulticasts() {
+        return m_responsible_for_incoming_multicasts;
+    }
+
     MulticastUdpScheduler::MulticastUdpScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Topology> topology) {
         printf("MULTICAST UDP SCHEDULER\n");
 
@@ -39,11 +43,49 @@ namespace ns3 {
 
         } else {
             std::cout << "  > Multicast UDP scheduler is enabled" << std::endl;
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Setup Multicast UDP scheduler");
 
             // Properties we will use often
             m_nodes = m_topology->GetNodes();
             m_simulation_end_time_ns = m_basicSimulation->GetSimulationEndTimeNs();
             m_enable_logging_for_multicast_udp_ids = parse_set_positive_int64(m_basicSimulation->GetConfigParamOrDefault("multicast_udp_enable_logging_for_multicast_udp_ids", "set()"));
+            m_enable_latency_histograms = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("multicast_udp_enable_latency_histograms", "false"));
+            m_enable_bier = m_basicSimulation->GetConfigParamOrDefault("multicast_mode", "tree") == "bier";
+
+            // Sending at the fixed target rate, or adapting it to the feedback of the receivers
+            std::string rate_adaptation = m_basicSimulation->GetConfigParamOrDefault("multicast_rate_adaptation", "fixed");
+            if (rate_adaptation == "fixed") {
+                m_enable_rate_adaptation = false;
+            } else if (rate_adaptation == "feedback") {
+                m_enable_rate_adaptation = true;
+                m_feedback_interval_ns = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault("multicast_feedback_interval_ns", "10000000"));
+                m_feedback_percentile = parse_double(m_basicSimulation->GetConfigParamOrDefault("multicast_feedback_percentile", "0"));
+                if (m_feedback_percentile < 0 || m_feedback_percentile > 100) {
+                    throw std::invalid_argument("Multicast feedback percentile must be in [0, 100]");
+                }
+                std::cout << "  > Rate adaptation to receiver feedback every " << m_feedback_interval_ns << " ns (percentile " << m_feedback_percentile << ")" << std::endl;
+            } else {
+                throw std::invalid_argument("Unknown multicast rate adaptation: " + rate_adaptation);
+            }
+
+            // Forward error correction: blocks of n data packets followed by k XOR repair packets
+            m_fec_block_size = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("multicast_fec_block_size", "0"));
+            m_fec_num_repair = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault("multicast_fec_num_repair", "1"));
+            if (m_fec_block_size > 64) {
+                throw std::invalid_argument("Multicast FEC block size cannot exceed 64");
+            }
+            if (m_fec_block_size > 0) {
+                if (m_fec_num_repair > m_fec_block_size) {
+                    throw std::invalid_argument("Multicast FEC cannot have more repair packets than data packets per block");
+                }
+                std::cout << "  > FEC enabled (" << m_fec_num_repair << " XOR repair packets per " << m_fec_block_size << " data packets)" << std::endl;
+            }
+
+            // Pacing: packets departing within this window are sent out together (0: one event per packet)
+            m_pacing_batch_window_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("multicast_udp_pacing_batch_window_ns", "0"));
+            if (m_pacing_batch_window_ns > 0) {
+                std::cout << "  > Pacing in batches of " << m_pacing_batch_window_ns << " ns" << std::endl;
+            }
 
             // Distributed run information
             m_system_id = m_basicSimulation->GetSystemId();
@@ -57,6 +99,17 @@ namespace ns3 {
                     m_simulation_end_time_ns
             );
 
+            // Membership changes (joins and leaves) during the bursts
+            std::string membership_filename = m_basicSimulation->GetConfigParamOrDefault("multicast_udp_membership_filename", "");
+            if (!membership_filename.empty()) {
+                read_multicast_membership_schedule(
+                        m_basicSimulation->GetRunDir() + "/" + membership_filename,
+                        m_topology,
+                        m_simulation_end_time_ns,
+                        m_schedule
+                );
+            }
+
             // Check that the UDP burst IDs exist in the logging
             for (int64_t udp_burst_id : m_enable_logging_for_multicast_udp_ids) {
                 if ((size_t) udp_burst_id >= m_schedule.size()) {
@@ -74,57 +127,140 @@ namespace ns3 {
                 m_multicast_udp_outgoing_txt_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_multicast_udp_outgoing.txt";
                 m_multicast_udp_incoming_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_multicast_udp_incoming.csv";
                 m_multicast_udp_incoming_txt_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_multicast_udp_incoming.txt";
+                m_multicast_udp_fec_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_multicast_udp_fec.csv";
+                m_multicast_udp_incoming_latency_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_multicast_udp_incoming_latency.csv";
             } else {
                 m_multicast_udp_outgoing_csv_filename = m_basicSimulation->GetLogsDir() + "/multicast_udp_outgoing.csv";
                 m_multicast_udp_outgoing_txt_filename = m_basicSimulation->GetLogsDir() + "/multicast_udp_outgoing.txt";
                 m_multicast_udp_incoming_csv_filename = m_basicSimulation->GetLogsDir() + "/multicast_udp_incoming.csv";
                 m_multicast_udp_incoming_txt_filename = m_basicSimulation->GetLogsDir() + "/multicast_udp_incoming.txt";
+                m_multicast_udp_fec_csv_filename = m_basicSimulation->GetLogsDir() + "/multicast_udp_fec.csv";
+                m_multicast_udp_incoming_latency_csv_filename = m_basicSimulation->GetLogsDir() + "/multicast_udp_incoming_latency.csv";
             }
             // Remove files if they are there
             remove_file_if_exists(m_multicast_udp_outgoing_csv_filename);
             remove_file_if_exists(m_multicast_udp_outgoing_txt_filename);
             remove_file_if_exists(m_multicast_udp_incoming_csv_filename);
             remove_file_if_exists(m_multicast_udp_incoming_txt_filename);
+            remove_file_if_exists(m_multicast_udp_fec_csv_filename);
+            remove_file_if_exists(m_multicast_udp_incoming_latency_csv_filename);
             printf("  > Removed previous Multicast UDP log files if present\n");
             m_basicSimulation->RegisterTimestamp("Remove previous Multicast UDP log files");
 
-            // Install sink on each endpoint node
+            // Precise logs are buffered and written in the background, and converted to CSV at the end
+            if (!m_enable_logging_for_multicast_udp_ids.empty()) {
+                int64_t buffer_num_records = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault("precise_log_buffer_num_records", "65536"));
+                if (buffer_num_records > UINT32_MAX) {
+                    throw std::invalid_argument("precise_log_buffer_num_records is too large: " + std::to_string(buffer_num_records));
+                }
+                m_precise_log_writer = CreateObject<PreciseLogWriter>((uint32_t) buffer_num_records);
+                printf("  > Precise logging with buffers of %" PRId64 " records\n", buffer_num_records);
+            }
+
+            // In BIER mode each endpoint has a bit in the bit string carried by the packets
+            std::vector<int64_t> bier_bit_positions_of_nodes;
+            uint32_t bier_num_words_per_string = 0;
+            if (m_enable_bier) {
+                bier_bit_positions_of_nodes = bier_bit_positions(m_topology->GetEndpoints(), m_topology->GetNumNodes());
+                bier_num_words_per_string = bier_num_words(m_topology->GetEndpoints().size());
+                std::cout << "  > BIER enabled (bit string of " << bier_num_words_per_string * 64 << " bits)" << std::endl;
+            }
+
+            // Install an application on each endpoint node
             std::cout << "  > Setting up Multicast UDP applications on all endpoint nodes" << std::endl;
+            std::map<int64_t, Ptr<MulticastUdpApplication>> endpoint_to_app;
+            int64_t num_outgoing_registered = 0;
+            int64_t num_incoming_registered = 0;
             for (int64_t endpoint : m_topology->GetEndpoints()) {
                 if (!m_enable_distributed || m_distributed_node_system_id_assignment[endpoint] == m_system_id) {
 
                     // Setup the application
                     MulticastUdpHelper multicastUdpHelper(3026, m_basicSimulation->GetLogsDir());
+                    multicastUdpHelper.SetAttribute("EnableBier", BooleanValue(m_enable_bier));
+                    multicastUdpHelper.SetAttribute("EnableRateAdaptation", BooleanValue(m_enable_rate_adaptation));
+                    multicastUdpHelper.SetAttribute("FecBlockSize", UintegerValue(m_fec_block_size));
+                    multicastUdpHelper.SetAttribute("FecNumRepair", UintegerValue(m_fec_num_repair));
+                    multicastUdpHelper.SetAttribute("PacingBatchWindowNs", IntegerValue(m_pacing_batch_window_ns));
+                    if (m_enable_rate_adaptation) {
+                        multicastUdpHelper.SetAttribute("FeedbackIntervalNs", IntegerValue(m_feedback_interval_ns));
+                        multicastUdpHelper.SetAttribute("FeedbackPercentile", DoubleValue(m_feedback_percentile));
+                    }
                     ApplicationContainer app = multicastUdpHelper.Install(m_nodes.Get(endpoint));
                     app.Start(Seconds(0.0));
                     m_apps.push_back(app);
 
-                    // Register all bursts being sent from there and being received
+                    // Bursts are registered at the application of their endpoints
                     Ptr<MulticastUdpApplication> multicastUdpApp = app.Get(0)->GetObject<MulticastUdpApplication>();
-                    for (MulticastUdpInfo entry : m_schedule) {
-                        std::set<int64_t> to_node_ids = entry.GetToNodeIds();
-                        if (entry.GetFromNodeId() == endpoint) {
-                            std::cout << "    >>> Register multicast outgoing at " << endpoint << std::endl;
-                            multicastUdpApp->RegisterOutgoingBurst(
-                                    entry,
-                                    // InetSocketAddress(m_nodes.Get(entry.GetToNodeId())->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 1026),
-                                    InetSocketAddress(entry.GetMulticastGroup(), 3026),
-                                    m_enable_logging_for_multicast_udp_ids.find(entry.GetUdpBurstId()) != m_enable_logging_for_multicast_udp_ids.end()
-                            );
-                            m_responsible_for_outgoing_multicasts.push_back(std::make_pair(entry, multicastUdpApp));
+                    if (m_precise_log_writer != 0) {
+                        multicastUdpApp->SetPreciseLogWriter(m_precise_log_writer);
+                    }
+                    endpoint_to_app[endpoint] = multicastUdpApp;
+
+                }
+            }
+
+            // Register all bursts in one pass over the schedule, at the applications of their source and members
+            std::cout << "  > Registering Multicast UDP bursts at their endpoints" << std::endl;
+            for (MulticastUdpInfo& entry : m_schedule) {
+                bool enable_precise_logging = m_enable_logging_for_multicast_udp_ids.find(entry.GetUdpBurstId()) != m_enable_logging_for_multicast_udp_ids.end();
+
+                // Outgoing at the source
+                auto it_from = endpoint_to_app.find(entry.GetFromNodeId());
+                if (it_from != endpoint_to_app.end()) {
+                    Ptr<MulticastUdpApplication> multicastUdpApp = it_from->second;
+                    std::vector<uint64_t> bier_bit_string;
+                    if (m_enable_bier) {
+                        bier_bit_string = std::vector<uint64_t>(bier_num_words_per_string, 0);
+                        for (int64_t to_node_id : entry.GetToNodeIds()) {
+                            int64_t bit = bier_bit_positions_of_nodes[to_node_id];
+                            bier_bit_string[bit / 64] |= (1ULL << (bit % 64));
                         }
-                        if (to_node_ids.find(endpoint) != to_node_ids.end()) {
-                            std::cout << "    >>> Register multicast incoming at " << endpoint << std::endl;
-                            multicastUdpApp->RegisterIncomingBurst(
-                                    entry,
-                                    m_enable_logging_for_multicast_udp_ids.find(entry.GetUdpBurstId()) != m_enable_logging_for_multicast_udp_ids.end()
-                            );
-                            m_responsible_for_incoming_multicasts.push_back(std::make_pair(entry, multicastUdpApp));
+                    }
+                    multicastUdpApp->RegisterOutgoingBurst(
+                            entry,
+                            InetSocketAddress(entry.GetMulticastGroup(), 3026),
+                            enable_precise_logging,
+                            bier_bit_string
+                    );
+                    m_responsible_for_outgoing_multicasts.push_back(std::make_pair(entry, multicastUdpApp));
+                    num_outgoing_registered++;
+
+                    // With BIER the source itself changes who receives its packets
+                    if (m_enable_bier) {
+                        for (const MulticastMembershipEvent& event : entry.GetMembershipEvents()) {
+                            Simulator::Schedule(NanoSeconds(event.time_ns), &MulticastUdpApplication::SetOutgoingBurstBierBit, multicastUdpApp, entry.GetUdpBurstId(), bier_bit_positions_of_nodes[event.node_id], event.is_join);
                         }
                     }
+                }
+
+                // Incoming at every node which is a member at some point
+                for (int64_t to_node_id : entry.GetAllToNodeIds()) {
+                    auto it_to = endpoint_to_app.find(to_node_id);
+                    if (it_to == endpoint_to_app.end()) {
+                        continue;
+                    }
+                    Ptr<MulticastUdpApplication> multicastUdpApp = it_to->second;
+                    multicastUdpApp->RegisterIncomingBurst(entry, enable_precise_logging);
+                    m_responsible_for_incoming_multicasts.push_back(std::make_pair(entry, multicastUdpApp));
+                    num_incoming_registered++;
+                    if (m_enable_rate_adaptation) {
+                        multicastUdpApp->EnableIncomingBurstFeedback(
+                                entry.GetUdpBurstId(),
+                                InetSocketAddress(m_nodes.Get(entry.GetFromNodeId())->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 3027)
+                        );
+                    }
+                }
 
+                // Membership changes of the members
+                for (const MulticastMembershipEvent& event : entry.GetMembershipEvents()) {
+                    auto it_member = endpoint_to_app.find(event.node_id);
+                    if (it_member != endpoint_to_app.end()) {
+                        Simulator::Schedule(NanoSeconds(event.time_ns), &MulticastUdpApplication::SetIncomingBurstMember, it_member->second, entry.GetUdpBurstId(), event.is_join);
+                    }
                 }
+
             }
+            std::cout << "    >> Registered " << num_outgoing_registered << " outgoing and " << num_incoming_registered << " incoming" << std::endl;
 
             std::cout << "  > ByLul multicast app setup DONE!!!" << std::endl;
             
@@ -143,6 +279,7 @@ namespace ns3 {
             std::cout << "  > Not enabled, so no Multicast UDP results are written" << std::endl;
 
         } else {
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Write Multicast UDP results");
             // Open files
             std::cout << "  > Opening UDP burst log files:" << std::endl;
             FILE* file_outgoing_csv = fopen(m_multicast_udp_outgoing_csv_filename.c_str(), "w+");
@@ -177,8 +314,8 @@ namespace ns3 {
                     return (a.first.GetUdpBurstId() < b.first.GetUdpBurstId());
                 }
             };
-            std::sort(m_responsible_for_outgoing_multicasts.begin(), m_responsible_for_outgoing_multicasts.end(), ascending_paired_udp_burst_id_key());
-            std::sort(m_responsible_for_incoming_multicasts.begin(), m_responsible_for_incoming_multicasts.end(), ascending_paired_udp_burst_id_key());
+            std::stable_sort(m_responsible_for_outgoing_multicasts.begin(), m_responsible_for_outgoing_multicasts.end(), ascending_paired_udp_burst_id_key());
+            std::stable_sort(m_responsible_for_incoming_multicasts.begin(), m_responsible_for_incoming_multicasts.end(), ascending_paired_udp_burst_id_key());
 
             // Outgoing bursts
             std::cout << "  > Writing Multicast outgoing log files" << std::endl;
@@ -296,6 +433,47 @@ namespace ns3 {
 
             }
 
+            // Forward error correction of the incoming bursts
+            if (m_fec_block_size > 0) {
+                std::cout << "  > Writing Multicast FEC log file" << std::endl;
+                FILE* file_fec_csv = fopen(m_multicast_udp_fec_csv_filename.c_str(), "w+");
+                double repair_overhead = (double) m_fec_num_repair / (double) (m_fec_block_size + m_fec_num_repair);
+                for (std::pair<MulticastUdpInfo, Ptr<MulticastUdpApplication>> p : m_responsible_for_incoming_multicasts) {
+                    MulticastUdpInfo info = p.first;
+                    Ptr<MulticastUdpApplication> udpBurstAppIncoming = p.second;
+                    MulticastFecStats stats = udpBurstAppIncoming->GetFecStatsOf(info.GetUdpBurstId());
+                    int64_t effective_duration_ns = info.GetStartTimeNs() + info.GetDurationNs() >= m_simulation_end_time_ns ? m_simulation_end_time_ns - info.GetStartTimeNs() : info.GetDurationNs();
+                    double goodput_megabit_per_s = byte_to_megabit((stats.data_received + stats.data_recovered) * udpBurstAppIncoming->GetMaxUdpPayloadSizeByte()) / nanosec_to_sec(effective_duration_ns);
+                    fprintf(
+                            file_fec_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%f,%" PRIu64 ",%" PRIu64 ",%f,%f\n",
+                            info.GetUdpBurstId(), info.GetFromNodeId(), (int64_t) udpBurstAppIncoming->GetNode()->GetId(),
+                            stats.data_received, stats.repair_received, stats.data_recovered, goodput_megabit_per_s,
+                            stats.blocks_with_loss, stats.blocks_recovered,
+                            stats.blocks_with_loss == 0 ? 1.0 : (double) stats.blocks_recovered / (double) stats.blocks_with_loss,
+                            repair_overhead
+                    );
+                }
+                fclose(file_fec_csv);
+                std::cout << "    >> Written: " << m_multicast_udp_fec_csv_filename << std::endl;
+            }
+
+            // One-way latency at each member
+            if (m_enable_latency_histograms) {
+                std::cout << "  > Writing Multicast latency log file" << std::endl;
+                FILE* file_latency_csv = fopen(m_multicast_udp_incoming_latency_csv_filename.c_str(), "w+");
+                for (std::pair<MulticastUdpInfo, Ptr<MulticastUdpApplication>> p : m_responsible_for_incoming_multicasts) {
+                    const LatencyHistogram& histogram = p.second->GetLatencyHistogramOf(p.first.GetUdpBurstId());
+                    fprintf(
+                            file_latency_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRIu64 ",%" PRId64 ",%.1f,%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%.1f\n",
+                            p.first.GetUdpBurstId(), p.first.GetFromNodeId(), (int64_t) p.second->GetNode()->GetId(), histogram.GetCount(),
+                            histogram.GetMin(), histogram.GetMean(), histogram.GetPercentile(50), histogram.GetPercentile(99),
+                            histogram.GetPercentile(99.9), histogram.GetMax(), histogram.GetJitter()
+                    );
+                }
+                fclose(file_latency_csv);
+                std::cout << "    >> Written: " << m_multicast_udp_incoming_latency_csv_filename << std::endl;
+            }
+
             // Close files
             std::cout << "  > Closing UDP burst log files:" << std::endl;
             fclose(file_outgoing_csv);
@@ -307,6 +485,13 @@ namespace ns3 {
             fclose(file_incoming_txt);
             std::cout << "    >> Closed: " << m_multicast_udp_incoming_txt_filename << std::endl;
 
+            // Flush the precise logs and convert them to CSV
+            if (m_precise_log_writer != 0) {
+                m_precise_log_writer->Close();
+                m_precise_log_writer->ConvertToCsv();
+                std::cout << "  > Precise logs converted to CSV (" << m_precise_log_writer->GetNumRecordsWritten() << " records in " << m_precise_log_writer->GetNumWrites() << " writes)" << std::endl;
+            }
+
             std::cout << "  > ByLul multicast log write!!!" << std::endl;
             // Register completion
             std::cout << "  > Multicast UDP log files have been written" << std::endl;
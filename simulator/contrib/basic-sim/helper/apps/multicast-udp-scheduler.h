@@ -48,6 +48,8 @@
 
 #include "ns3/multicast-udp-schedule-reader.h"
 #include "ns3/multicast-udp-helper.h"
+#include "ns3/bier-header.h"
+#include "ns3/precise-log-writer.h"
 
 namespace ns3 {
 
@@ -57,6 +59,7 @@ namespace ns3 {
     public:
         MulticastUdpScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Topology> topology);
         std::vector<MulticastUdpInfo>& GetMulticastReqs();
+        const std::vector<std::pair<MulticastUdpInfo, Ptr<MulticastUdpApplication>>>& GetResponsibleForIncomingMulticasts();
         void WriteResults();
 
     protected:
@@ -73,11 +76,22 @@ namespace ns3 {
         NodeContainer m_nodes;
         std::vector<ApplicationContainer> m_apps;
         std::set<int64_t> m_enable_logging_for_multicast_udp_ids;
+        Ptr<PreciseLogWriter> m_precise_log_writer;
+        bool m_enable_bier;
+        bool m_enable_rate_adaptation;
+        int64_t m_feedback_interval_ns;
+        double m_feedback_percentile;
+        uint32_t m_fec_block_size;
+        uint32_t m_fec_num_repair;
+        int64_t m_pacing_batch_window_ns;
 
         std::string m_multicast_udp_outgoing_csv_filename;
         std::string m_multicast_udp_outgoing_txt_filename;
         std::string m_multicast_udp_incoming_csv_filename;
         std::string m_multicast_udp_incoming_txt_filename;
+        std::string m_multicast_udp_fec_csv_filename;
+        bool m_enable_latency_histograms;
+        std::string m_multicast_udp_incoming_latency_csv_filename;
 
         std::vector<std::pair<MulticastUdpInfo, Ptr<MulticastUdpApplication>>> m_responsible_for_outgoing_multicasts;
         std::vector<std::pair<MulticastUdpInfo, Ptr<MulticastUdpApplication>>> m_responsible_for_incoming_multicasts;
@@ -0,0 +1,238 @@
+#include "packet-trace-reader.h"
+
+namespace ns3 {
+
+static uint64_t read_le_u64(const uint8_t* p) {
+    uint64_t val = 0;
+    for (int i = 7; i >= 0; i--) {
+        val = (val << 8) | p[i];
+    }
+    return val;
+}
+
+static uint32_t read_le_u32(const uint8_t* p) {
+    return ((uint32_t) p[0]) | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+static void write_le(uint8_t* p, uint64_t val, size_t num_bytes) {
+    for (size_t i = 0; i < num_bytes; i++) {
+        p[i] = (uint8_t) (val >> (8 * i));
+    }
+}
+
+/**
+ * Memory map a binary packet trace.
+ *
+ * @param filename                  File name of the trace
+ * @param topology                  Topology
+ * @param simulation_end_time_ns    Simulation end time (ns) : reading stops at the first record at or after it
+ * @param window_num_records        Number of records paged in ahead
+ */
+PacketTraceReader::PacketTraceReader(const std::string& filename, Ptr<Topology> topology, int64_t simulation_end_time_ns, int64_t window_num_records) {
+    m_filename = filename;
+    m_topology = topology;
+    m_simulation_end_time_ns = simulation_end_time_ns;
+    if (window_num_records < 1) {
+        throw std::invalid_argument(format_string("Packet trace window must be at least one record: %" PRId64, window_num_records));
+    }
+    m_window_num_records = window_num_records;
+    m_num_read = 0;
+    m_window_end = 0;
+    m_released_up_to_byte = 0;
+    m_prev_time_ns = 0;
+
+    // Check that the file exists
+    if (!file_exists(filename)) {
+        throw std::runtime_error(format_string("File %s does not exist.", filename.c_str()));
+    }
+
+    // Open file
+    m_fd = open(filename.c_str(), O_RDONLY);
+    if (m_fd == -1) {
+        throw std::runtime_error(format_string("File %s could not be read.", filename.c_str()));
+    }
+    struct stat st;
+    if (fstat(m_fd, &st) == -1 || (size_t) st.st_size < PACKET_TRACE_HEADER_SIZE_BYTE) {
+        close(m_fd);
+        throw std::invalid_argument(format_string("File %s is too small to be a packet trace.", filename.c_str()));
+    }
+    m_map_size_byte = (size_t) st.st_size;
+
+    // Map it read-only, it is read front to back
+    void* map = mmap(nullptr, m_map_size_byte, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (map == MAP_FAILED) {
+        close(m_fd);
+        throw std::runtime_error(format_string("File %s could not be memory mapped.", filename.c_str()));
+    }
+    m_map = (const uint8_t*) map;
+    madvise(map, m_map_size_byte, MADV_SEQUENTIAL);
+    m_page_size_byte = (size_t) sysconf(_SC_PAGESIZE);
+
+    // Header
+    if (memcmp(m_map, PACKET_TRACE_MAGIC, sizeof(PACKET_TRACE_MAGIC)) != 0) {
+        munmap(map, m_map_size_byte);
+        close(m_fd);
+        throw std::invalid_argument(format_string("File %s is not a packet trace (magic mismatch).", filename.c_str()));
+    }
+    uint64_t num_records = read_le_u64(m_map + 8);
+    if (num_records != (m_map_size_byte - PACKET_TRACE_HEADER_SIZE_BYTE) / PACKET_TRACE_RECORD_SIZE_BYTE
+        || (m_map_size_byte - PACKET_TRACE_HEADER_SIZE_BYTE) % PACKET_TRACE_RECORD_SIZE_BYTE != 0) {
+        munmap(map, m_map_size_byte);
+        close(m_fd);
+        throw std::invalid_argument(format_string(
+                "Packet trace %s has %" PRIu64 " records in its header, which does not match its size of %zu byte.",
+                filename.c_str(), num_records, m_map_size_byte
+        ));
+    }
+    m_num_records = (int64_t) num_records;
+
+}
+
+PacketTraceReader::~PacketTraceReader() {
+    munmap((void*) m_map, m_map_size_byte);
+    close(m_fd);
+}
+
+/**
+ * Ask for the next window of records to be paged in, and release the pages of those already read.
+ */
+void PacketTraceReader::SlideWindow() {
+    size_t read_up_to_byte = PACKET_TRACE_HEADER_SIZE_BYTE + m_num_read * PACKET_TRACE_RECORD_SIZE_BYTE;
+    size_t release_up_to_byte = read_up_to_byte / m_page_size_byte * m_page_size_byte;
+    if (release_up_to_byte > m_released_up_to_byte) {
+        madvise((void*) (m_map + m_released_up_to_byte), release_up_to_byte - m_released_up_to_byte, MADV_DONTNEED);
+        m_released_up_to_byte = release_up_to_byte;
+    }
+    m_window_end = std::min(m_num_records, m_num_read + m_window_num_records);
+    size_t window_end_byte = PACKET_TRACE_HEADER_SIZE_BYTE + m_window_end * PACKET_TRACE_RECORD_SIZE_BYTE;
+    madvise((void*) (m_map + release_up_to_byte), window_end_byte - release_up_to_byte, MADV_WILLNEED);
+}
+
+/**
+ * Read the next record.
+ *
+ * @param record    (Output) Record
+ *
+ * @return True iff there is a next record before the end of the simulation
+ */
+bool PacketTraceReader::Next(PacketTraceRecord& record) {
+    if (m_num_read >= m_num_records) {
+        return false;
+    }
+    if (m_num_read >= m_window_end) {
+        SlideWindow();
+    }
+
+    // Decode
+    const uint8_t* p = m_map + PACKET_TRACE_HEADER_SIZE_BYTE + m_num_read * PACKET_TRACE_RECORD_SIZE_BYTE;
+    record.time_ns = (int64_t) read_le_u64(p);
+    record.flow_id = (int64_t) read_le_u64(p + 8);
+    record.from_node_id = read_le_u32(p + 16);
+    record.to_node_id = read_le_u32(p + 20);
+    record.size_byte = read_le_u32(p + 24);
+
+    // Packets at or after the end of the simulation are never sent
+    if (record.time_ns >= m_simulation_end_time_ns) {
+        return false;
+    }
+
+    // Check validity
+    if (record.time_ns < m_prev_time_ns) {
+        throw std::invalid_argument(format_string(
+                "Packet trace record %" PRId64 " has a time (%" PRId64 " ns) before the one of its predecessor (%" PRId64 " ns)",
+                m_num_read, record.time_ns, m_prev_time_ns
+        ));
+    }
+    if (record.flow_id < 0) {
+        throw std::invalid_argument(format_string("Packet trace record %" PRId64 " has a negative flow id", m_num_read));
+    }
+    if (record.from_node_id == record.to_node_id) {
+        throw std::invalid_argument(format_string("Packet trace record %" PRId64 " is from and to the same node %" PRId64, m_num_read, record.from_node_id));
+    }
+    if (!m_topology->IsValidEndpoint(record.from_node_id)) {
+        throw std::invalid_argument(format_string("Packet trace record %" PRId64 " has invalid source endpoint: %" PRId64, m_num_read, record.from_node_id));
+    }
+    if (!m_topology->IsValidEndpoint(record.to_node_id)) {
+        throw std::invalid_argument(format_string("Packet trace record %" PRId64 " has invalid destination endpoint: %" PRId64, m_num_read, record.to_node_id));
+    }
+    if (record.size_byte < PACKET_TRACE_MIN_SIZE_BYTE || record.size_byte > PACKET_TRACE_MAX_SIZE_BYTE) {
+        throw std::invalid_argument(format_string(
+                "Packet trace record %" PRId64 " has a size of %" PRId64 " byte, which is not within [%" PRId64 ", %" PRId64 "]",
+                m_num_read, record.size_byte, PACKET_TRACE_MIN_SIZE_BYTE, PACKET_TRACE_MAX_SIZE_BYTE
+        ));
+    }
+    m_prev_time_ns = record.time_ns;
+    m_num_read++;
+    return true;
+
+}
+
+int64_t PacketTraceReader::GetNumRecords() {
+    return m_num_records;
+}
+
+int64_t PacketTraceReader::GetNumRead() {
+    return m_num_read;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+PacketTraceWriter::PacketTraceWriter(const std::string& filename) {
+    m_filename = filename;
+    m_num_records = 0;
+    m_file = fopen(filename.c_str(), "wb");
+    if (m_file == nullptr) {
+        throw std::runtime_error(format_string("File %s could not be opened for writing.", filename.c_str()));
+    }
+    uint8_t header[PACKET_TRACE_HEADER_SIZE_BYTE];
+    memcpy(header, PACKET_TRACE_MAGIC, sizeof(PACKET_TRACE_MAGIC));
+    write_le(header + 8, 0, 8);
+    fwrite(header, 1, PACKET_TRACE_HEADER_SIZE_BYTE, m_file);
+}
+
+PacketTraceWriter::~PacketTraceWriter() {
+    if (m_file != nullptr) {
+        Close();
+    }
+}
+
+void PacketTraceWriter::Append(const PacketTraceRecord& record) {
+    if (record.from_node_id < 0 || record.from_node_id > UINT32_MAX || record.to_node_id < 0 || record.to_node_id > UINT32_MAX
+        || record.size_byte < 0 || record.size_byte > UINT32_MAX) {
+        throw std::invalid_argument("Packet trace record does not fit in the binary format");
+    }
+    uint8_t buffer[PACKET_TRACE_RECORD_SIZE_BYTE];
+    write_le(buffer, (uint64_t) record.time_ns, 8);
+    write_le(buffer + 8, (uint64_t) record.flow_id, 8);
+    write_le(buffer + 16, (uint64_t) record.from_node_id, 4);
+    write_le(buffer + 20, (uint64_t) record.to_node_id, 4);
+    write_le(buffer + 24, (uint64_t) record.size_byte, 4);
+    write_le(buffer + 28, 0, 4);
+    fwrite(buffer, 1, PACKET_TRACE_RECORD_SIZE_BYTE, m_file);
+    m_num_records++;
+}
+
+void PacketTraceWriter::Close() {
+    uint8_t num_records[8];
+    write_le(num_records, m_num_records, 8);
+    fseek(m_file, 8, SEEK_SET);
+    fwrite(num_records, 1, 8, m_file);
+    fclose(m_file);
+    m_file = nullptr;
+}
+
+/**
+ * Write a complete binary packet trace.
+ *
+ * @param filename  File name of the trace
+ * @param records   Records (in order)
+ */
+void write_packet_trace(const std::string& filename, const std::vector<PacketTraceRecord>& records) {
+    PacketTraceWriter writer(filename);
+    for (const PacketTraceRecord& record : records) {
+        writer.Append(record);
+    }
+    writer.Close();
+}
+
+}
@@ -0,0 +1,100 @@
+#ifndef PACKET_TRACE_READER_H
+#define PACKET_TRACE_READER_H
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdio>
+#include <cinttypes>
+#include <algorithm>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ns3/exp-util.h"
+#include "ns3/topology.h"
+
+namespace ns3 {
+
+/**
+ * Packet of a trace to replay.
+ */
+struct PacketTraceRecord {
+    int64_t time_ns;        //!< Time it is sent (ns)
+    int64_t flow_id;        //!< Flow it belongs to (always between the same endpoints)
+    int64_t from_node_id;   //!< Source endpoint
+    int64_t to_node_id;     //!< Destination endpoint
+    int64_t size_byte;      //!< UDP payload size (byte)
+};
+
+/**
+ * Binary packet trace format (all integers little endian):
+ *
+ * Header (16 byte):    [magic "BSPKTRC1", 8 byte][number of records, uint64]
+ * Record (32 byte):    [time (ns), int64][flow id, int64][from node id, uint32]
+ *                      [to node id, uint32][UDP payload size (byte), uint32][reserved, uint32]
+ */
+const char PACKET_TRACE_MAGIC[8] = {'B', 'S', 'P', 'K', 'T', 'R', 'C', '1'};
+const size_t PACKET_TRACE_HEADER_SIZE_BYTE = 16;
+const size_t PACKET_TRACE_RECORD_SIZE_BYTE = 32;
+const int64_t PACKET_TRACE_MIN_SIZE_BYTE = 24; // The header of every replayed packet (flow id, sequence number, send time)
+const int64_t PACKET_TRACE_MAX_SIZE_BYTE = 65507;
+
+/**
+ * Reads the records of a binary packet trace in order from a memory map of the file,
+ * such that the trace is never read into memory as a whole. Only a window of the next
+ * records is asked to be paged in ahead, and the pages of the records already read are
+ * released again, such that the resident memory stays bounded by the window.
+ *
+ * Each record is checked once it is read: the times must be weakly ascending, the
+ * nodes must be different endpoints, and the size must be within [24, 65507] byte.
+ * Reading stops at the first record at or after the end of the simulation.
+ */
+class PacketTraceReader
+{
+public:
+    PacketTraceReader(const std::string& filename, Ptr<Topology> topology, int64_t simulation_end_time_ns, int64_t window_num_records);
+    ~PacketTraceReader();
+    bool Next(PacketTraceRecord& record);
+    int64_t GetNumRecords();
+    int64_t GetNumRead();
+private:
+    void SlideWindow();
+    std::string m_filename;
+    Ptr<Topology> m_topology;
+    int64_t m_simulation_end_time_ns;
+    int64_t m_window_num_records;
+    int m_fd;
+    size_t m_map_size_byte;
+    const uint8_t* m_map;
+    size_t m_page_size_byte;
+    int64_t m_num_records;
+    int64_t m_num_read;
+    int64_t m_window_end;
+    size_t m_released_up_to_byte;
+    int64_t m_prev_time_ns;
+};
+
+/**
+ * Writes a binary packet trace record by record, such that a trace can be converted
+ * without holding it in memory. The number of records is filled in by Close().
+ */
+class PacketTraceWriter
+{
+public:
+    PacketTraceWriter(const std::string& filename);
+    ~PacketTraceWriter();
+    void Append(const PacketTraceRecord& record);
+    void Close();
+private:
+    std::string m_filename;
+    FILE* m_file;
+    uint64_t m_num_records;
+};
+
+void write_packet_trace(const std::string& filename, const std::vector<PacketTraceRecord>& records);
+
+}
+
+#endif //PACKET_TRACE_READER_H
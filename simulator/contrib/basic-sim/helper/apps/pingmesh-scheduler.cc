@@ -15,6 +15,7 @@ PingmeshScheduler::PingmeshScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<T
 
     } else {
         std::cout << "  > Pingmesh scheduler is enabled" << std::endl;
+        ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Setup pingmesh scheduler");
 
         m_nodes = m_topology->GetNodes();
         m_simulation_end_time_ns = m_basicSimulation->GetSimulationEndTimeNs();
@@ -24,7 +25,11 @@ PingmeshScheduler::PingmeshScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<T
         m_enable_distributed = m_basicSimulation->IsDistributedEnabled();
         m_distributed_node_system_id_assignment = m_basicSimulation->GetDistributedNodeSystemIdAssignment();
 
+        // Whether every ping is kept (pingmesh.csv), or only the statistics of each pair
+        m_keep_all_pings = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("pingmesh_keep_all_pings", "true"));
+
         // Pairs
+        m_num_pairs_per_source = m_topology->GetEndpoints().size() - 1;
         if (pingmesh_endpoints_pair_str == "all") {
 
             // All-to-all for all endpoints
@@ -39,6 +44,35 @@ PingmeshScheduler::PingmeshScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<T
                 }
             }
 
+        } else if (starts_with(pingmesh_endpoints_pair_str, "random(") && ends_with(pingmesh_endpoints_pair_str, ")")) {
+
+            // Each endpoint to k random other endpoints
+            int64_t k = parse_geq_one_int64(pingmesh_endpoints_pair_str.substr(7, pingmesh_endpoints_pair_str.size() - 8));
+            if (k > m_num_pairs_per_source) {
+                throw std::invalid_argument(format_string("Cannot sample %" PRId64 " pingmesh destinations out of %" PRId64 " other endpoints", k, m_num_pairs_per_source));
+            }
+            m_num_pairs_per_source = k;
+
+            // The pairs of all endpoints are drawn (also those of other systems), such that every system draws the same
+            std::mt19937_64 rng((uint64_t) parse_positive_int64(basicSimulation->GetConfigParamOrDefault(
+                    "pingmesh_pair_sampling_seed", basicSimulation->GetConfigParamOrFail("simulation_seed")
+            )));
+            std::set<int64_t> endpoints = m_topology->GetEndpoints();
+            for (int64_t i : endpoints) {
+                std::vector<int64_t> others;
+                for (int64_t j : endpoints) {
+                    if (i != j) {
+                        others.push_back(j);
+                    }
+                }
+                for (int64_t x = 0; x < k; x++) { // Partial Fisher-Yates shuffle
+                    std::swap(others[x], others[x + rng() % (others.size() - x)]);
+                    if (!m_enable_distributed || m_distributed_node_system_id_assignment[i] == m_system_id) {
+                        m_pingmesh_endpoint_pairs.push_back(std::make_pair(i, others[x]));
+                    }
+                }
+            }
+
         } else {
 
             // Only between select pairs
@@ -70,12 +104,13 @@ PingmeshScheduler::PingmeshScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<T
         printf("  > Determined pingmesh pairs (size: %lu)\n", m_pingmesh_endpoint_pairs.size());
         m_basicSimulation->RegisterTimestamp("Determined pingmesh pairs");
 
-        // Determine filenames
+        // Determine filenames (without every ping, the csv has one line per pair)
+        std::string csv_name = m_keep_all_pings ? "pingmesh.csv" : "pingmesh_summary.csv";
         if (m_enable_distributed) {
-            m_pingmesh_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_pingmesh.csv";
+            m_pingmesh_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_" + csv_name;
             m_pingmesh_txt_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_pingmesh.txt";
         } else {
-            m_pingmesh_csv_filename = m_basicSimulation->GetLogsDir() + "/pingmesh.csv";
+            m_pingmesh_csv_filename = m_basicSimulation->GetLogsDir() + "/" + csv_name;
             m_pingmesh_txt_filename = m_basicSimulation->GetLogsDir() + "/pingmesh.txt";
         }
 
@@ -104,7 +139,7 @@ PingmeshScheduler::PingmeshScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<T
 
         // Install echo client from each node to each other node
         std::cout << "  > Setting up " << m_pingmesh_endpoint_pairs.size() << " pingmesh clients" << std::endl;
-        int64_t in_between_ns = m_interval_ns / (endpoints.size() - 1);
+        int64_t in_between_ns = m_interval_ns / m_num_pairs_per_source;
         int counter = 0;
         int64_t prev_i = -1;
         for (std::pair<int64_t, int64_t>& p : m_pingmesh_endpoint_pairs) {
@@ -122,6 +157,7 @@ PingmeshScheduler::PingmeshScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<T
                     p.second
             );
             source.SetAttribute("Interval", TimeValue(NanoSeconds(m_interval_ns)));
+            source.SetAttribute("KeepAllPings", BooleanValue(m_keep_all_pings));
 
             // Install it on the node and start it right now
             ApplicationContainer app = source.Install(m_nodes.Get(p.first));
@@ -145,6 +181,7 @@ void PingmeshScheduler::WriteResults() {
         std::cout << "  > Not enabled, so no pingmesh results are written" << std::endl;
 
     } else {
+        ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Write pingmesh results");
 
         // Open files
         std::cout << "  > Opening pingmesh log files:" << std::endl;
@@ -167,67 +204,94 @@ void PingmeshScheduler::WriteResults() {
             int64_t from_node_id = client->GetFromNodeId();
             int64_t to_node_id = client->GetToNodeId();
             uint32_t sent = client->GetSent();
-            std::vector<int64_t> sendRequestTimestamps = client->GetSendRequestTimestamps();
-            std::vector<int64_t> replyTimestamps = client->GetReplyTimestamps();
-            std::vector<int64_t> receiveReplyTimestamps = client->GetReceiveReplyTimestamps();
-
-            int total = 0;
-            double sum_latency_to_there_ns = 0.0;
-            double sum_latency_from_there_ns = 0.0;
-            std::vector<int64_t> rtts_ns;
-            for (uint32_t j = 0; j < sent; j++) {
-
-                // Outcome
-                bool reply_arrived = replyTimestamps[j] != -1;
-                std::string reply_arrived_str = reply_arrived ? "YES" : "LOST";
-
-                // Latencies
-                int64_t latency_to_there_ns = reply_arrived ? replyTimestamps[j] - sendRequestTimestamps[j] : -1;
-                int64_t latency_from_there_ns = reply_arrived ? receiveReplyTimestamps[j] - replyTimestamps[j] : -1;
-                int64_t rtt_ns = reply_arrived ? latency_to_there_ns + latency_from_there_ns : -1;
-
-                // Write plain to the csv
-                fprintf(
-                        file_csv,
-                        "%" PRId64 ",%" PRId64 ",%u,%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%s\n",
-                        from_node_id, to_node_id, j, sendRequestTimestamps[j], replyTimestamps[j], receiveReplyTimestamps[j],
-                        latency_to_there_ns, latency_from_there_ns, rtt_ns, reply_arrived_str.c_str()
-                );
-
-                // Add to statistics
-                if (reply_arrived) {
-                    total++;
-                    sum_latency_to_there_ns += latency_to_there_ns;
-                    sum_latency_from_there_ns += latency_from_there_ns;
-                    rtts_ns.push_back(rtt_ns);
-                }
 
-            }
-
-            // Finalize the statistics
-            int64_t min_rtt_ns = 10000000000000; // 10000s should be sufficiently high
-            int64_t max_rtt_ns = -1;
-            double mean_rtt_ns = (sum_latency_to_there_ns + sum_latency_from_there_ns) / total;
-            double sum_sq = 0.0;
-            for (uint32_t j = 0; j < rtts_ns.size(); j++) {
-                min_rtt_ns = std::min(min_rtt_ns, rtts_ns[j]);
-                max_rtt_ns = std::max(max_rtt_ns, rtts_ns[j]);
-                sum_sq += std::pow(rtts_ns[j] - mean_rtt_ns, 2);
-            }
-            double sample_std_rtt_ns;
+            int total;
             double mean_latency_to_there_ns;
             double mean_latency_from_there_ns;
-            if (rtts_ns.size() == 0) { // If no measurements came through, it should all be -1
-                mean_latency_to_there_ns = -1;
-                mean_latency_from_there_ns = -1;
-                min_rtt_ns = -1;
+            int64_t min_rtt_ns;
+            int64_t max_rtt_ns;
+            double mean_rtt_ns;
+            double sample_std_rtt_ns;
+            if (m_keep_all_pings) {
+                std::vector<int64_t> sendRequestTimestamps = client->GetSendRequestTimestamps();
+                std::vector<int64_t> replyTimestamps = client->GetReplyTimestamps();
+                std::vector<int64_t> receiveReplyTimestamps = client->GetReceiveReplyTimestamps();
+
+                total = 0;
+                double sum_latency_to_there_ns = 0.0;
+                double sum_latency_from_there_ns = 0.0;
+                std::vector<int64_t> rtts_ns;
+                for (uint32_t j = 0; j < sent; j++) {
+
+                    // Outcome
+                    bool reply_arrived = replyTimestamps[j] != -1;
+                    std::string reply_arrived_str = reply_arrived ? "YES" : "LOST";
+
+                    // Latencies
+                    int64_t latency_to_there_ns = reply_arrived ? replyTimestamps[j] - sendRequestTimestamps[j] : -1;
+                    int64_t latency_from_there_ns = reply_arrived ? receiveReplyTimestamps[j] - replyTimestamps[j] : -1;
+                    int64_t rtt_ns = reply_arrived ? latency_to_there_ns + latency_from_there_ns : -1;
+
+                    // Write plain to the csv
+                    fprintf(
+                            file_csv,
+                            "%" PRId64 ",%" PRId64 ",%u,%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%s\n",
+                            from_node_id, to_node_id, j, sendRequestTimestamps[j], replyTimestamps[j], receiveReplyTimestamps[j],
+                            latency_to_there_ns, latency_from_there_ns, rtt_ns, reply_arrived_str.c_str()
+                    );
+
+                    // Add to statistics
+                    if (reply_arrived) {
+                        total++;
+                        sum_latency_to_there_ns += latency_to_there_ns;
+                        sum_latency_from_there_ns += latency_from_there_ns;
+                        rtts_ns.push_back(rtt_ns);
+                    }
+
+                }
+
+                // Finalize the statistics
+                min_rtt_ns = 10000000000000; // 10000s should be sufficiently high
                 max_rtt_ns = -1;
-                mean_rtt_ns = -1;
-                sample_std_rtt_ns = -1;
+                mean_rtt_ns = (sum_latency_to_there_ns + sum_latency_from_there_ns) / total;
+                double sum_sq = 0.0;
+                for (uint32_t j = 0; j < rtts_ns.size(); j++) {
+                    min_rtt_ns = std::min(min_rtt_ns, rtts_ns[j]);
+                    max_rtt_ns = std::max(max_rtt_ns, rtts_ns[j]);
+                    sum_sq += std::pow(rtts_ns[j] - mean_rtt_ns, 2);
+                }
+                if (rtts_ns.size() == 0) { // If no measurements came through, it should all be -1
+                    mean_latency_to_there_ns = -1;
+                    mean_latency_from_there_ns = -1;
+                    min_rtt_ns = -1;
+                    max_rtt_ns = -1;
+                    mean_rtt_ns = -1;
+                    sample_std_rtt_ns = -1;
+                } else {
+                    mean_latency_to_there_ns = sum_latency_to_there_ns / total;
+                    mean_latency_from_there_ns = sum_latency_from_there_ns / total;
+                    sample_std_rtt_ns = rtts_ns.size() > 1 ? std::sqrt((1.0 / (rtts_ns.size() - 1)) * sum_sq) : 0.0;
+                }
+
             } else {
-                mean_latency_to_there_ns = sum_latency_to_there_ns / total;
-                mean_latency_from_there_ns = sum_latency_from_there_ns / total;
-                sample_std_rtt_ns = rtts_ns.size() > 1 ? std::sqrt((1.0 / (rtts_ns.size() - 1)) * sum_sq) : 0.0;
+
+                // Statistics aggregated by the client itself
+                total = client->GetReceived();
+                mean_latency_to_there_ns = client->GetMeanLatencyToThereNs();
+                mean_latency_from_there_ns = client->GetMeanLatencyFromThereNs();
+                min_rtt_ns = client->GetMinRttNs();
+                max_rtt_ns = client->GetMaxRttNs();
+                mean_rtt_ns = client->GetMeanRttNs();
+                sample_std_rtt_ns = client->GetSampleStdRttNs();
+
+                // Write one line for the pair to the csv
+                fprintf(
+                        file_csv,
+                        "%" PRId64 ",%" PRId64 ",%u,%d,%f,%f,%" PRId64 ",%f,%" PRId64 ",%f\n",
+                        from_node_id, to_node_id, sent, total, mean_latency_to_there_ns, mean_latency_from_there_ns,
+                        min_rtt_ns, mean_rtt_ns, max_rtt_ns, sample_std_rtt_ns
+                );
+
             }
 
             // Write nicely formatted to the text
@@ -3,6 +3,7 @@
 #define PINGMESH_SCHEDULER_H
 
 #include <map>
+#include <random>
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -52,6 +53,8 @@ protected:
     std::vector<ApplicationContainer> m_apps;
     int64_t m_interval_ns;
     std::vector<std::pair<int64_t, int64_t>> m_pingmesh_endpoint_pairs;
+    int64_t m_num_pairs_per_source;
+    bool m_keep_all_pings;
     uint32_t m_system_id;
     bool m_enable_distributed;
     std::vector<int64_t> m_distributed_node_system_id_assignment;
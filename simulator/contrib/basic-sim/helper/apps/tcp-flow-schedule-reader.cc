@@ -49,16 +49,13 @@ std::string TcpFlowScheduleEntry::GetMetadata() {
 }
 
 /**
- * Read in the flow schedule.
+ * Open the flow schedule for reading.
  *
  * @param filename                  File name of the schedule.csv
  * @param topology                  Topology
  * @param simulation_end_time_ns    Simulation end time (ns) : all flows must start less than this value
-*/
-std::vector<TcpFlowScheduleEntry> read_tcp_flow_schedule(const std::string& filename, Ptr<Topology> topology, const int64_t simulation_end_time_ns) {
-
-    // Schedule to put in the data
-    std::vector<TcpFlowScheduleEntry> schedule;
+ */
+TcpFlowScheduleReader::TcpFlowScheduleReader(const std::string& filename, Ptr<Topology> topology, const int64_t simulation_end_time_ns) {
 
     // Check that the file exists
     if (!file_exists(filename)) {
@@ -66,74 +63,103 @@ std::vector<TcpFlowScheduleEntry> read_tcp_flow_schedule(const std::string& file
     }
 
     // Open file
+    m_filename = filename;
+    m_schedule_file.open(filename);
+    if (!m_schedule_file) {
+        throw std::runtime_error(format_string("File %s could not be read.", filename.c_str()));
+    }
+    m_topology = topology;
+    m_simulation_end_time_ns = simulation_end_time_ns;
+    m_line_counter = 0;
+    m_prev_start_time_ns = 0;
+
+}
+
+/**
+ * Read the next lines of the flow schedule.
+ *
+ * @param chunk             (Output) Vector the entries are appended to
+ * @param max_num_entries   Maximum number of entries to read
+ *
+ * @return Number of entries read (0 iff the end of the schedule is reached)
+ */
+size_t TcpFlowScheduleReader::ReadChunk(std::vector<TcpFlowScheduleEntry>& chunk, size_t max_num_entries) {
+    size_t num_read = 0;
     std::string line;
-    std::ifstream schedule_file(filename);
-    if (schedule_file) {
-
-        // Go over each line
-        size_t line_counter = 0;
-        int64_t prev_start_time_ns = 0;
-        while (getline(schedule_file, line)) {
-
-            // Split on ,
-            std::vector<std::string> comma_split = split_string(line, ",", 7);
-
-            // Fill entry
-            int64_t tcp_flow_id = parse_positive_int64(comma_split[0]);
-            if (tcp_flow_id != (int64_t) line_counter) {
-                throw std::invalid_argument(format_string("TCP flow ID is not ascending by one each line (violation: %" PRId64 ")\n", tcp_flow_id));
-            }
-            int64_t from_node_id = parse_positive_int64(comma_split[1]);
-            int64_t to_node_id = parse_positive_int64(comma_split[2]);
-            int64_t size_byte = parse_positive_int64(comma_split[3]);
-            int64_t start_time_ns = parse_positive_int64(comma_split[4]);
-            std::string additional_parameters = comma_split[5];
-            std::string metadata = comma_split[6];
-
-            // Must be weakly ascending start time
-            if (prev_start_time_ns > start_time_ns) {
-                throw std::invalid_argument(format_string("Start time is not weakly ascending (on line with TCP flow ID: %" PRId64 ", violation: %" PRId64 ")\n", tcp_flow_id, start_time_ns));
-            }
-            prev_start_time_ns = start_time_ns;
-
-            // Check node IDs
-            if (from_node_id == to_node_id) {
-                throw std::invalid_argument(format_string("TCP flow to itself at node ID: %" PRId64 ".", to_node_id));
-            }
-
-            // Check endpoint validity
-            if (!topology->IsValidEndpoint(from_node_id)) {
-                throw std::invalid_argument(format_string("Invalid from-endpoint for a schedule entry based on topology: %d", from_node_id));
-            }
-            if (!topology->IsValidEndpoint(to_node_id)) {
-                throw std::invalid_argument(format_string("Invalid to-endpoint for a schedule entry based on topology: %d", to_node_id));
-            }
-
-            // Check start time
-            if (start_time_ns >= simulation_end_time_ns) {
-                throw std::invalid_argument(format_string(
-                        "TCP flow %" PRId64 " has invalid start time %" PRId64 " >= %" PRId64 ".",
-                        tcp_flow_id, start_time_ns, simulation_end_time_ns
-                ));
-            }
-
-            // Put into schedule
-            schedule.push_back(TcpFlowScheduleEntry(tcp_flow_id, from_node_id, to_node_id, size_byte, start_time_ns, additional_parameters, metadata));
-
-            // Next line
-            line_counter++;
+    while (num_read < max_num_entries && getline(m_schedule_file, line)) {
 
+        // Split on ,
+        std::vector<std::string> comma_split = split_string(line, ",", 7);
+
+        // Fill entry
+        int64_t tcp_flow_id = parse_positive_int64(comma_split[0]);
+        if (tcp_flow_id != m_line_counter) {
+            throw std::invalid_argument(format_string("TCP flow ID is not ascending by one each line (violation: %" PRId64 ")\n", tcp_flow_id));
+        }
+        int64_t from_node_id = parse_positive_int64(comma_split[1]);
+        int64_t to_node_id = parse_positive_int64(comma_split[2]);
+        int64_t size_byte = parse_positive_int64(comma_split[3]);
+        int64_t start_time_ns = parse_positive_int64(comma_split[4]);
+        std::string additional_parameters = comma_split[5];
+        std::string metadata = comma_split[6];
+
+        // Must be weakly ascending start time
+        if (m_prev_start_time_ns > start_time_ns) {
+            throw std::invalid_argument(format_string("Start time is not weakly ascending (on line with TCP flow ID: %" PRId64 ", violation: %" PRId64 ")\n", tcp_flow_id, start_time_ns));
         }
+        m_prev_start_time_ns = start_time_ns;
 
-        // Close file
-        schedule_file.close();
+        // Check node IDs
+        if (from_node_id == to_node_id) {
+            throw std::invalid_argument(format_string("TCP flow to itself at node ID: %" PRId64 ".", to_node_id));
+        }
+
+        // Check endpoint validity
+        if (!m_topology->IsValidEndpoint(from_node_id)) {
+            throw std::invalid_argument(format_string("Invalid from-endpoint for a schedule entry based on topology: %d", from_node_id));
+        }
+        if (!m_topology->IsValidEndpoint(to_node_id)) {
+            throw std::invalid_argument(format_string("Invalid to-endpoint for a schedule entry based on topology: %d", to_node_id));
+        }
+
+        // Check start time
+        if (start_time_ns >= m_simulation_end_time_ns) {
+            throw std::invalid_argument(format_string(
+                    "TCP flow %" PRId64 " has invalid start time %" PRId64 " >= %" PRId64 ".",
+                    tcp_flow_id, start_time_ns, m_simulation_end_time_ns
+            ));
+        }
+
+        // Put into chunk
+        chunk.push_back(TcpFlowScheduleEntry(tcp_flow_id, from_node_id, to_node_id, size_byte, start_time_ns, additional_parameters, metadata));
+
+        // Next line
+        m_line_counter++;
+        num_read++;
 
-    } else {
-        throw std::runtime_error(format_string("File %s could not be read.", filename.c_str()));
     }
+    return num_read;
+}
 
-    return schedule;
+/**
+ * Number of entries read so far.
+ */
+int64_t TcpFlowScheduleReader::GetNumRead() {
+    return m_line_counter;
+}
 
+/**
+ * Read in the flow schedule.
+ *
+ * @param filename                  File name of the schedule.csv
+ * @param topology                  Topology
+ * @param simulation_end_time_ns    Simulation end time (ns) : all flows must start less than this value
+*/
+std::vector<TcpFlowScheduleEntry> read_tcp_flow_schedule(const std::string& filename, Ptr<Topology> topology, const int64_t simulation_end_time_ns) {
+    std::vector<TcpFlowScheduleEntry> schedule;
+    TcpFlowScheduleReader reader(filename, topology, simulation_end_time_ns);
+    reader.ReadChunk(schedule, SIZE_MAX);
+    return schedule;
 }
 
 }
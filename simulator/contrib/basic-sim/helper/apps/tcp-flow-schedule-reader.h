@@ -44,6 +44,38 @@ private:
     std::string m_metadata;
 };
 
+/**
+ * Source of the flow schedule, from which the flows are taken in chunks
+ * (ascending flow ID and weakly ascending start time).
+ */
+class TcpFlowScheduleSource
+{
+public:
+    virtual ~TcpFlowScheduleSource() {};
+    virtual size_t ReadChunk(std::vector<TcpFlowScheduleEntry>& chunk, size_t max_num_entries) = 0;
+    virtual int64_t GetNumRead() = 0;
+};
+
+/**
+ * Reads the flow schedule from a file cursor in chunks, such that only the entries of
+ * the chunk are in memory. Each line is checked the same as by read_tcp_flow_schedule(),
+ * but only once it is read.
+ */
+class TcpFlowScheduleReader : public TcpFlowScheduleSource
+{
+public:
+    TcpFlowScheduleReader(const std::string& filename, Ptr<Topology> topology, const int64_t simulation_end_time_ns);
+    size_t ReadChunk(std::vector<TcpFlowScheduleEntry>& chunk, size_t max_num_entries);
+    int64_t GetNumRead();
+private:
+    std::string m_filename;
+    std::ifstream m_schedule_file;
+    Ptr<Topology> m_topology;
+    int64_t m_simulation_end_time_ns;
+    int64_t m_line_counter;
+    int64_t m_prev_start_time_ns;
+};
+
 std::vector<TcpFlowScheduleEntry> read_tcp_flow_schedule(
         const std::string& filename,
         Ptr<Topology> topology,
@@ -43,9 +43,20 @@ void TcpFlowScheduler::StartNextFlow(int i) {
 
     // Install it on the node and start it right now
     ApplicationContainer app = source.Install(m_nodes.Get(entry.GetFromNodeId()));
+    if (m_detailed_log_writer != 0) {
+        Ptr<TcpFlowSendApplication> flowSendApp = app.Get(0)->GetObject<TcpFlowSendApplication>();
+        flowSendApp->SetDetailedLogWriter(m_detailed_log_writer);
+        flowSendApp->SetAttribute("DetailedLoggingMinIntervalNs", IntegerValue(m_detailed_logging_min_interval_ns));
+        flowSendApp->SetAttribute("DetailedLoggingOnlyChanges", BooleanValue(m_detailed_logging_only_changes));
+    }
     app.Start(NanoSeconds(0));
     m_apps.push_back(app);
 
+    // If streaming, read the next chunk once the last flow of the current one has started
+    if (i + 1 == (int) m_schedule.size() && m_schedule_reader != nullptr && ReadNextChunk()) {
+        i = -1;
+    }
+
     // If there is a next flow to start, schedule its start
     if (i + 1 != (int) m_schedule.size()) {
         int64_t next_flow_ns = m_schedule[i + 1].GetStartTimeNs();
@@ -54,6 +65,54 @@ void TcpFlowScheduler::StartNextFlow(int i) {
 
 }
 
+/**
+ * Open the streamed schedule from the start: either the schedule file or the workload generator.
+ */
+std::unique_ptr<TcpFlowScheduleSource> TcpFlowScheduler::OpenScheduleSource() {
+    if (m_enable_workload_generator) {
+        return std::unique_ptr<TcpFlowScheduleSource>(new TcpFlowWorkloadGenerator(create_workload_generator_from_config(m_basicSimulation, m_topology, "tcp_flow_")));
+    } else {
+        return std::unique_ptr<TcpFlowScheduleSource>(new TcpFlowScheduleReader(m_schedule_filename, m_topology, m_simulation_end_time_ns));
+    }
+}
+
+/**
+ * Replace the current chunk of the schedule with the next flows read from the schedule file
+ * (only those starting at nodes of this system), skipping over chunks of which none are.
+ *
+ * @return True iff there is at least one flow in the new chunk
+ */
+bool TcpFlowScheduler::ReadNextChunk() {
+    m_schedule.clear();
+    while (m_schedule.empty()) {
+        std::vector<TcpFlowScheduleEntry> chunk;
+        if (m_schedule_reader->ReadChunk(chunk, m_streaming_lookahead) == 0) {
+            CheckLoggingIds(m_schedule_reader->GetNumRead());
+            m_schedule_reader = nullptr;
+            return false;
+        }
+        for (TcpFlowScheduleEntry &entry : chunk) {
+            if (!m_enable_distributed || m_distributed_node_system_id_assignment[entry.GetFromNodeId()] == m_system_id) {
+                m_schedule.push_back(entry);
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Check that the TCP flow IDs exist in the logging.
+ *
+ * @param num_flows     Number of flows in the complete schedule
+ */
+void TcpFlowScheduler::CheckLoggingIds(int64_t num_flows) {
+    for (int64_t tcp_flow_id : m_enable_logging_for_tcp_flow_ids) {
+        if (tcp_flow_id >= num_flows) {
+            throw std::invalid_argument("Invalid TCP flow ID in tcp_flow_enable_logging_for_tcp_flow_ids: " + std::to_string(tcp_flow_id));
+        }
+    }
+}
+
 TcpFlowScheduler::TcpFlowScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Topology> topology) {
     printf("TCP FLOW SCHEDULER\n");
 
@@ -67,6 +126,7 @@ TcpFlowScheduler::TcpFlowScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Top
 
     } else {
         std::cout << "  > TCP flow scheduler is enabled" << std::endl;
+        ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Setup TCP flow scheduler");
 
         // Properties we will use often
         m_nodes = m_topology->GetNodes();
@@ -77,35 +137,52 @@ TcpFlowScheduler::TcpFlowScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Top
         m_enable_distributed = m_basicSimulation->IsDistributedEnabled();
         m_distributed_node_system_id_assignment = m_basicSimulation->GetDistributedNodeSystemIdAssignment();
 
+        // Streaming: only this many flows of the schedule are read ahead at a time (0: the complete schedule upfront)
+        // The workload generator is always streamed, as its flows are generated on the fly
+        m_enable_workload_generator = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("tcp_flow_enable_workload_generator", "false"));
+        if (m_enable_workload_generator) {
+            m_streaming_lookahead = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault("tcp_flow_schedule_streaming_lookahead", "10000"));
+        } else {
+            m_schedule_filename = m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("tcp_flow_schedule_filename");
+            m_streaming_lookahead = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("tcp_flow_schedule_streaming_lookahead", "0"));
+        }
+
         // Read schedule
-        std::vector<TcpFlowScheduleEntry> complete_schedule = read_tcp_flow_schedule(
-                m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("tcp_flow_schedule_filename"),
-                m_topology,
-                m_simulation_end_time_ns
-        );
+        if (m_streaming_lookahead > 0) {
+            m_schedule_reader = OpenScheduleSource();
+            ReadNextChunk();
+            printf(
+                    "  > Streaming schedule from %s (look-ahead: %" PRId64 " flows, first chunk flow start events: %lu)\n",
+                    m_enable_workload_generator ? "workload generator" : "file", m_streaming_lookahead, m_schedule.size()
+            );
 
-        // Check that the TCP flow IDs exist in the logging
-        for (int64_t tcp_flow_id : m_enable_logging_for_tcp_flow_ids) {
-            if ((size_t) tcp_flow_id >= complete_schedule.size()) {
-                throw std::invalid_argument("Invalid TCP flow ID in tcp_flow_enable_logging_for_tcp_flow_ids: " + std::to_string(tcp_flow_id));
-            }
-        }
+        } else {
+            std::vector<TcpFlowScheduleEntry> complete_schedule = read_tcp_flow_schedule(
+                    m_schedule_filename,
+                    m_topology,
+                    m_simulation_end_time_ns
+            );
 
-        // Filter the schedule to only have applications starting at nodes which are part of this system
-        if (m_enable_distributed) {
-            std::vector<TcpFlowScheduleEntry> filtered_schedule;
-            for (TcpFlowScheduleEntry &entry : complete_schedule) {
-                if (m_distributed_node_system_id_assignment[entry.GetFromNodeId()] == m_system_id) {
-                    filtered_schedule.push_back(entry);
+            // Check that the TCP flow IDs exist in the logging
+            CheckLoggingIds(complete_schedule.size());
+
+            // Filter the schedule to only have applications starting at nodes which are part of this system
+            if (m_enable_distributed) {
+                std::vector<TcpFlowScheduleEntry> filtered_schedule;
+                for (TcpFlowScheduleEntry &entry : complete_schedule) {
+                    if (m_distributed_node_system_id_assignment[entry.GetFromNodeId()] == m_system_id) {
+                        filtered_schedule.push_back(entry);
+                    }
                 }
+                m_schedule = filtered_schedule;
+            } else {
+                m_schedule = complete_schedule;
             }
-            m_schedule = filtered_schedule;
-        } else {
-            m_schedule = complete_schedule;
+            printf("  > Read schedule (total flow start events: %lu)\n", m_schedule.size());
+
         }
 
         // Schedule read
-        printf("  > Read schedule (total flow start events: %lu)\n", m_schedule.size());
         m_basicSimulation->RegisterTimestamp("Read flow schedule");
 
         // Determine filenames
@@ -125,6 +202,18 @@ TcpFlowScheduler::TcpFlowScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Top
         printf("  > Removed previous flow log files if present\n");
         m_basicSimulation->RegisterTimestamp("Remove previous flow log files");
 
+        // Detailed logs are written in the background, optionally decimated
+        if (!m_enable_logging_for_tcp_flow_ids.empty()) {
+            int64_t ring_capacity = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault("tcp_flow_detailed_logging_ring_capacity", "1048576"));
+            if (ring_capacity > UINT32_MAX) {
+                throw std::invalid_argument("tcp_flow_detailed_logging_ring_capacity is too large: " + std::to_string(ring_capacity));
+            }
+            m_detailed_logging_min_interval_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("tcp_flow_detailed_logging_min_interval_ns", "0"));
+            m_detailed_logging_only_changes = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("tcp_flow_detailed_logging_only_changes", "false"));
+            m_detailed_log_writer = CreateObject<AsyncLogWriter>((uint32_t) ring_capacity);
+            printf("  > Detailed logging (min. interval: %" PRId64 " ns, only changes: %s)\n", m_detailed_logging_min_interval_ns, m_detailed_logging_only_changes ? "yes" : "no");
+        }
+
         // Install sink on each endpoint node
         std::cout << "  > Setting up TCP flow sinks" << std::endl;
         for (int64_t endpoint : m_topology->GetEndpoints()) {
@@ -148,6 +237,74 @@ TcpFlowScheduler::TcpFlowScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Top
     std::cout << std::endl;
 }
 
+/**
+ * Write the result of a flow to the log files.
+ *
+ * @param file_csv      tcp_flows.csv
+ * @param file_txt      tcp_flows.txt
+ * @param entry         Schedule entry of the flow
+ * @param flowSendApp   Application which sent the flow
+ *
+ * @return Number of detailed log values which were coalesced
+ */
+uint64_t TcpFlowScheduler::WriteFlowResult(FILE* file_csv, FILE* file_txt, TcpFlowScheduleEntry& entry, Ptr<TcpFlowSendApplication> flowSendApp) {
+
+    // Finalize the detailed logs (if they are enabled)
+    flowSendApp->FinalizeDetailedLogs();
+
+    // Retrieve statistics
+    bool is_completed = flowSendApp->IsCompleted();
+    bool is_conn_failed = flowSendApp->IsConnFailed();
+    bool is_closed_err = flowSendApp->IsClosedByError();
+    bool is_closed_normal = flowSendApp->IsClosedNormally();
+    int64_t sent_byte = flowSendApp->GetAckedBytes();
+    int64_t fct_ns;
+    if (is_completed) {
+        fct_ns = flowSendApp->GetCompletionTimeNs() - entry.GetStartTimeNs();
+    } else {
+        fct_ns = m_simulation_end_time_ns - entry.GetStartTimeNs();
+    }
+    std::string finished_state;
+    if (is_completed) {
+        finished_state = "YES";
+    } else if (is_conn_failed) {
+        finished_state = "NO_CONN_FAIL";
+    } else if (is_closed_normal) {
+        finished_state = "NO_BAD_CLOSE";
+    } else if (is_closed_err) {
+        finished_state = "NO_ERR_CLOSE";
+    } else {
+        finished_state = "NO_ONGOING";
+    }
+
+    // Write plain to the csv
+    fprintf(
+            file_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%s,%s\n",
+            entry.GetTcpFlowId(), entry.GetFromNodeId(), entry.GetToNodeId(), entry.GetSizeByte(), entry.GetStartTimeNs(),
+            entry.GetStartTimeNs() + fct_ns, fct_ns, sent_byte, finished_state.c_str(), entry.GetMetadata().c_str()
+    );
+
+    // Write nicely formatted to the text
+    char str_size_megabit[100];
+    sprintf(str_size_megabit, "%.2f Mbit", byte_to_megabit(entry.GetSizeByte()));
+    char str_duration_ms[100];
+    sprintf(str_duration_ms, "%.2f ms", nanosec_to_millisec(fct_ns));
+    char str_sent_megabit[100];
+    sprintf(str_sent_megabit, "%.2f Mbit", byte_to_megabit(sent_byte));
+    char str_progress_perc[100];
+    sprintf(str_progress_perc, "%.1f%%", ((double) sent_byte) / ((double) entry.GetSizeByte()) * 100.0);
+    char str_avg_rate_megabit_per_s[100];
+    sprintf(str_avg_rate_megabit_per_s, "%.1f Mbit/s", byte_to_megabit(sent_byte) / nanosec_to_sec(fct_ns));
+    fprintf(
+            file_txt, "%-16" PRId64 "%-10" PRId64 "%-10" PRId64 "%-16s%-18" PRId64 "%-18" PRId64 "%-16s%-16s%-13s%-16s%-14s%s\n",
+            entry.GetTcpFlowId(), entry.GetFromNodeId(), entry.GetToNodeId(), str_size_megabit, entry.GetStartTimeNs(),
+            entry.GetStartTimeNs() + fct_ns, str_duration_ms, str_sent_megabit, str_progress_perc, str_avg_rate_megabit_per_s,
+            finished_state.c_str(), entry.GetMetadata().c_str()
+    );
+
+    return flowSendApp->GetNumDetailedLogsCoalesced();
+}
+
 void TcpFlowScheduler::WriteResults() {
     std::cout << "STORE TCP FLOW RESULTS" << std::endl;
 
@@ -156,6 +313,7 @@ void TcpFlowScheduler::WriteResults() {
         std::cout << "  > Not enabled, so no TCP flow results are written" << std::endl;
 
     } else {
+        ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Write TCP flow results");
 
         // Open files
         std::cout << "  > Opening TCP flow log files:" << std::endl;
@@ -176,67 +334,29 @@ void TcpFlowScheduler::WriteResults() {
         std::cout << "  > Writing log files line-by-line" << std::endl;
         std::cout << "  > Total TCP flow log entries to write... " << m_apps.size() << std::endl;
         uint32_t app_idx = 0;
-        for (TcpFlowScheduleEntry& entry : m_schedule) {
-
-            // Retrieve application
-            Ptr<TcpFlowSendApplication> flowSendApp = m_apps.at(app_idx).Get(0)->GetObject<TcpFlowSendApplication>();
-
-            // Finalize the detailed logs (if they are enabled)
-            flowSendApp->FinalizeDetailedLogs();
-
-            // Retrieve statistics
-            bool is_completed = flowSendApp->IsCompleted();
-            bool is_conn_failed = flowSendApp->IsConnFailed();
-            bool is_closed_err = flowSendApp->IsClosedByError();
-            bool is_closed_normal = flowSendApp->IsClosedNormally();
-            int64_t sent_byte = flowSendApp->GetAckedBytes();
-            int64_t fct_ns;
-            if (is_completed) {
-                fct_ns = flowSendApp->GetCompletionTimeNs() - entry.GetStartTimeNs();
-            } else {
-                fct_ns = m_simulation_end_time_ns - entry.GetStartTimeNs();
-            }
-            std::string finished_state;
-            if (is_completed) {
-                finished_state = "YES";
-            } else if (is_conn_failed) {
-                finished_state = "NO_CONN_FAIL";
-            } else if (is_closed_normal) {
-                finished_state = "NO_BAD_CLOSE";
-            } else if (is_closed_err) {
-                finished_state = "NO_ERR_CLOSE";
-            } else {
-                finished_state = "NO_ONGOING";
+        uint64_t num_detailed_logs_coalesced = 0;
+        if (m_streaming_lookahead > 0) {
+
+            // The schedule is streamed once more, only the flows which were started have an application
+            std::unique_ptr<TcpFlowScheduleSource> source = OpenScheduleSource();
+            std::vector<TcpFlowScheduleEntry> chunk;
+            while (app_idx < m_apps.size() && source->ReadChunk(chunk, m_streaming_lookahead) > 0) {
+                for (TcpFlowScheduleEntry& entry : chunk) {
+                    if (app_idx < m_apps.size() && (!m_enable_distributed || m_distributed_node_system_id_assignment[entry.GetFromNodeId()] == m_system_id)) {
+                        Ptr<TcpFlowSendApplication> flowSendApp = m_apps.at(app_idx).Get(0)->GetObject<TcpFlowSendApplication>();
+                        num_detailed_logs_coalesced += WriteFlowResult(file_csv, file_txt, entry, flowSendApp);
+                        app_idx += 1;
+                    }
+                }
+                chunk.clear();
             }
 
-            // Write plain to the csv
-            fprintf(
-                    file_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%s,%s\n",
-                    entry.GetTcpFlowId(), entry.GetFromNodeId(), entry.GetToNodeId(), entry.GetSizeByte(), entry.GetStartTimeNs(),
-                    entry.GetStartTimeNs() + fct_ns, fct_ns, sent_byte, finished_state.c_str(), entry.GetMetadata().c_str()
-            );
-
-            // Write nicely formatted to the text
-            char str_size_megabit[100];
-            sprintf(str_size_megabit, "%.2f Mbit", byte_to_megabit(entry.GetSizeByte()));
-            char str_duration_ms[100];
-            sprintf(str_duration_ms, "%.2f ms", nanosec_to_millisec(fct_ns));
-            char str_sent_megabit[100];
-            sprintf(str_sent_megabit, "%.2f Mbit", byte_to_megabit(sent_byte));
-            char str_progress_perc[100];
-            sprintf(str_progress_perc, "%.1f%%", ((double) sent_byte) / ((double) entry.GetSizeByte()) * 100.0);
-            char str_avg_rate_megabit_per_s[100];
-            sprintf(str_avg_rate_megabit_per_s, "%.1f Mbit/s", byte_to_megabit(sent_byte) / nanosec_to_sec(fct_ns));
-            fprintf(
-                    file_txt, "%-16" PRId64 "%-10" PRId64 "%-10" PRId64 "%-16s%-18" PRId64 "%-18" PRId64 "%-16s%-16s%-13s%-16s%-14s%s\n",
-                    entry.GetTcpFlowId(), entry.GetFromNodeId(), entry.GetToNodeId(), str_size_megabit, entry.GetStartTimeNs(),
-                    entry.GetStartTimeNs() + fct_ns, str_duration_ms, str_sent_megabit, str_progress_perc, str_avg_rate_megabit_per_s,
-                    finished_state.c_str(), entry.GetMetadata().c_str()
-            );
-
-            // Move on application index
-            app_idx += 1;
-
+        } else {
+            for (TcpFlowScheduleEntry& entry : m_schedule) {
+                Ptr<TcpFlowSendApplication> flowSendApp = m_apps.at(app_idx).Get(0)->GetObject<TcpFlowSendApplication>();
+                num_detailed_logs_coalesced += WriteFlowResult(file_csv, file_txt, entry, flowSendApp);
+                app_idx += 1;
+            }
         }
 
         // Close files
@@ -246,6 +366,13 @@ void TcpFlowScheduler::WriteResults() {
         fclose(file_txt);
         std::cout << "    >> Closed: " << m_flows_txt_filename << std::endl;
 
+        // Wait for the detailed logs to be written
+        if (m_detailed_log_writer != 0) {
+            m_detailed_log_writer->Close();
+            std::cout << "  > Detailed logs written: " << m_detailed_log_writer->GetNumWritten() << " (dropped: "
+                      << m_detailed_log_writer->GetNumDropped() << ", coalesced: " << num_detailed_logs_coalesced << ")" << std::endl;
+        }
+
         // Register completion
         std::cout << "  > TCP flow log files have been written" << std::endl;
         m_basicSimulation->RegisterTimestamp("Write TCP flow log files");
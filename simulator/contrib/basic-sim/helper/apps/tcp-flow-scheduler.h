@@ -32,6 +32,7 @@
 #include <dirent.h>
 #include <unistd.h>
 #include <chrono>
+#include <memory>
 #include <stdexcept>
 
 #include "ns3/core-module.h"
@@ -47,10 +48,12 @@
 #include "ns3/topology.h"
 
 #include "ns3/tcp-flow-schedule-reader.h"
+#include "ns3/workload-generator.h"
 #include "ns3/tcp-flow-send-helper.h"
 #include "ns3/tcp-flow-send-application.h"
 #include "ns3/tcp-flow-sink-helper.h"
 #include "ns3/tcp-flow-sink.h"
+#include "ns3/async-log-writer.h"
 
 namespace ns3 {
 
@@ -63,15 +66,26 @@ public:
 
 protected:
     void StartNextFlow(int i);
+    std::unique_ptr<TcpFlowScheduleSource> OpenScheduleSource();
+    bool ReadNextChunk();
+    void CheckLoggingIds(int64_t num_flows);
+    uint64_t WriteFlowResult(FILE* file_csv, FILE* file_txt, TcpFlowScheduleEntry& entry, Ptr<TcpFlowSendApplication> flowSendApp);
     Ptr<BasicSimulation> m_basicSimulation;
     int64_t m_simulation_end_time_ns;
     Ptr<Topology> m_topology = nullptr;
     bool m_enabled;
 
-    std::vector<TcpFlowScheduleEntry> m_schedule;
+    std::vector<TcpFlowScheduleEntry> m_schedule;  //!< Complete schedule, or only the current chunk if streaming
+    std::string m_schedule_filename;
+    bool m_enable_workload_generator;
+    int64_t m_streaming_lookahead;
+    std::unique_ptr<TcpFlowScheduleSource> m_schedule_reader;
     NodeContainer m_nodes;
     std::vector<ApplicationContainer> m_apps;
     std::set<int64_t> m_enable_logging_for_tcp_flow_ids;
+    Ptr<AsyncLogWriter> m_detailed_log_writer;
+    int64_t m_detailed_logging_min_interval_ns;
+    bool m_detailed_logging_only_changes;
     uint32_t m_system_id;
     bool m_enable_distributed;
     std::vector<int64_t> m_distributed_node_system_id_assignment;
@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "trace-replay-scheduler.h"
+
+namespace ns3 {
+
+    TraceReplayScheduler::TraceReplayScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Topology> topology) {
+        printf("TRACE REPLAY SCHEDULER\n");
+
+        m_basicSimulation = basicSimulation;
+        m_topology = topology;
+
+        // Check if it is enabled explicitly
+        m_enabled = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("enable_trace_replay_scheduler", "false"));
+        if (!m_enabled) {
+            std::cout << "  > Not enabled explicitly, so disabled" << std::endl;
+
+        } else {
+            std::cout << "  > Trace replay scheduler is enabled" << std::endl;
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Setup trace replay scheduler");
+
+            // Properties we will use often
+            m_nodes = m_topology->GetNodes();
+            m_simulation_end_time_ns = m_basicSimulation->GetSimulationEndTimeNs();
+            m_num_packets_sent = 0;
+
+            // Distributed run information
+            m_system_id = m_basicSimulation->GetSystemId();
+            m_enable_distributed = m_basicSimulation->IsDistributedEnabled();
+            m_distributed_node_system_id_assignment = m_basicSimulation->GetDistributedNodeSystemIdAssignment();
+
+            // Determine filenames
+            if (m_enable_distributed) {
+                m_trace_replay_outgoing_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_trace_replay_outgoing.csv";
+                m_trace_replay_incoming_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_trace_replay_incoming.csv";
+            } else {
+                m_trace_replay_outgoing_csv_filename = m_basicSimulation->GetLogsDir() + "/trace_replay_outgoing.csv";
+                m_trace_replay_incoming_csv_filename = m_basicSimulation->GetLogsDir() + "/trace_replay_incoming.csv";
+            }
+
+            // Remove files if they are there
+            remove_file_if_exists(m_trace_replay_outgoing_csv_filename);
+            remove_file_if_exists(m_trace_replay_incoming_csv_filename);
+            printf("  > Removed previous trace replay log files if present\n");
+            m_basicSimulation->RegisterTimestamp("Remove previous trace replay log files");
+
+            // Install an application on each endpoint node
+            std::cout << "  > Setting up trace replay applications on all endpoint nodes" << std::endl;
+            m_node_to_app = std::vector<Ptr<TraceReplayApplication>>(m_nodes.GetN());
+            m_node_to_address = std::vector<Ipv4Address>(m_nodes.GetN());
+            for (int64_t endpoint : m_topology->GetEndpoints()) {
+                m_node_to_address[endpoint] = m_nodes.Get(endpoint)->GetObject<Ipv4>()->GetAddress(1,0).GetLocal();
+                if (!m_enable_distributed || m_distributed_node_system_id_assignment[endpoint] == m_system_id) {
+                    TraceReplayHelper traceReplayHelper(1027);
+                    ApplicationContainer app = traceReplayHelper.Install(m_nodes.Get(endpoint));
+                    app.Start(Seconds(0.0));
+                    m_apps.push_back(app);
+                    m_node_to_app[endpoint] = app.Get(0)->GetObject<TraceReplayApplication>();
+                }
+            }
+            m_basicSimulation->RegisterTimestamp("Setup trace replay applications");
+
+            // Memory map the trace, of which only a window of records is paged in at a time
+            int64_t window_num_records = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault("trace_replay_window_num_records", "65536"));
+            m_reader = std::unique_ptr<PacketTraceReader>(new PacketTraceReader(
+                    m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("trace_replay_filename"),
+                    m_topology,
+                    m_simulation_end_time_ns,
+                    window_num_records
+            ));
+            printf("  > Memory mapped trace (total packets: %" PRId64 ", window: %" PRId64 " packets)\n", m_reader->GetNumRecords(), window_num_records);
+
+            // The first packet
+            if (m_reader->Next(m_next_record)) {
+                Simulator::Schedule(NanoSeconds(m_next_record.time_ns), &TraceReplayScheduler::ReplayNext, this);
+            } else {
+                m_reader = nullptr;
+            }
+            m_basicSimulation->RegisterTimestamp("Open packet trace");
+
+        }
+
+        std::cout << std::endl;
+    }
+
+    /**
+     * Send all packets of the trace at the current time, and schedule the next time there are.
+     */
+    void TraceReplayScheduler::ReplayNext() {
+        int64_t now_ns = Simulator::Now().GetNanoSeconds();
+        bool has_next;
+        do {
+
+            // A flow is always between the same endpoints
+            auto it = m_flow_endpoints.find(m_next_record.flow_id);
+            if (it == m_flow_endpoints.end()) {
+                m_flow_endpoints.emplace(m_next_record.flow_id, std::make_pair(m_next_record.from_node_id, m_next_record.to_node_id));
+            } else if (it->second.first != m_next_record.from_node_id || it->second.second != m_next_record.to_node_id) {
+                throw std::invalid_argument(format_string(
+                        "Packet trace flow %" PRId64 " is not always from %" PRId64 " to %" PRId64,
+                        m_next_record.flow_id, it->second.first, it->second.second
+                ));
+            }
+
+            // Sent by the source if it is part of this system
+            Ptr<TraceReplayApplication> app = m_node_to_app[m_next_record.from_node_id];
+            if (app != 0) {
+                app->SendPacket(
+                        m_next_record.flow_id,
+                        InetSocketAddress(m_node_to_address[m_next_record.to_node_id], 1027),
+                        (uint32_t) m_next_record.size_byte
+                );
+                m_num_packets_sent++;
+            }
+
+            has_next = m_reader->Next(m_next_record);
+        } while (has_next && m_next_record.time_ns == now_ns);
+
+        // Next time in the trace, or close it
+        if (has_next) {
+            Simulator::Schedule(NanoSeconds(m_next_record.time_ns - now_ns), &TraceReplayScheduler::ReplayNext, this);
+        } else {
+            m_reader = nullptr;
+        }
+    }
+
+    void TraceReplayScheduler::WriteResults() {
+        std::cout << "STORE TRACE REPLAY RESULTS" << std::endl;
+
+        // Check if it is enabled explicitly
+        if (!m_enabled) {
+            std::cout << "  > Not enabled, so no trace replay results are written" << std::endl;
+
+        } else {
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Write trace replay results");
+            std::cout << "  > Replayed " << m_num_packets_sent << " packets of " << m_flow_endpoints.size() << " flows" << std::endl;
+
+            // Flows in ascending order
+            std::vector<int64_t> flow_ids;
+            for (const std::pair<const int64_t, std::pair<int64_t, int64_t>>& entry : m_flow_endpoints) {
+                flow_ids.push_back(entry.first);
+            }
+            std::sort(flow_ids.begin(), flow_ids.end());
+
+            // Outgoing: [flow id],[from],[to],[packets sent],[payload sent (byte)]
+            FILE* file_outgoing_csv = fopen(m_trace_replay_outgoing_csv_filename.c_str(), "w+");
+            std::cout << "  > Opened: " << m_trace_replay_outgoing_csv_filename << std::endl;
+            for (int64_t flow_id : flow_ids) {
+                std::pair<int64_t, int64_t> endpoints = m_flow_endpoints.at(flow_id);
+                Ptr<TraceReplayApplication> app = m_node_to_app[endpoints.first];
+                if (app != 0) {
+                    const TraceReplayFlowStats& stats = app->GetOutgoingFlowStats().at(flow_id);
+                    fprintf(
+                            file_outgoing_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRIu64 ",%" PRIu64 "\n",
+                            flow_id, endpoints.first, endpoints.second, stats.packets, stats.bytes
+                    );
+                }
+            }
+            fclose(file_outgoing_csv);
+
+            // Incoming: [flow id],[from],[to],[packets received],[payload received (byte)],[mean one-way latency (ns), -1 if none]
+            FILE* file_incoming_csv = fopen(m_trace_replay_incoming_csv_filename.c_str(), "w+");
+            std::cout << "  > Opened: " << m_trace_replay_incoming_csv_filename << std::endl;
+            for (int64_t flow_id : flow_ids) {
+                std::pair<int64_t, int64_t> endpoints = m_flow_endpoints.at(flow_id);
+                Ptr<TraceReplayApplication> app = m_node_to_app[endpoints.second];
+                if (app != 0) {
+                    const std::map<int64_t, TraceReplayFlowStats>& incoming = app->GetIncomingFlowStats();
+                    auto it = incoming.find(flow_id);
+                    TraceReplayFlowStats stats = it == incoming.end() ? TraceReplayFlowStats{0, 0, 0} : it->second;
+                    fprintf(
+                            file_incoming_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRIu64 ",%" PRIu64 ",%.2f\n",
+                            flow_id, endpoints.first, endpoints.second, stats.packets, stats.bytes,
+                            stats.packets == 0 ? -1.0 : (double) stats.latency_sum_ns / (double) stats.packets
+                    );
+                }
+            }
+            fclose(file_incoming_csv);
+
+            std::cout << "  > Closed trace replay log files" << std::endl;
+            m_basicSimulation->RegisterTimestamp("Write trace replay results");
+
+        }
+
+        std::cout << std::endl;
+    }
+
+}
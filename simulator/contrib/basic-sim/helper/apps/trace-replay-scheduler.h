@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TRACE_REPLAY_SCHEDULER_H
+#define TRACE_REPLAY_SCHEDULER_H
+
+#include <map>
+#include <unordered_map>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+#include "ns3/basic-simulation.h"
+#include "ns3/exp-util.h"
+#include "ns3/topology.h"
+
+#include "ns3/packet-trace-reader.h"
+#include "ns3/trace-replay-helper.h"
+#include "ns3/trace-replay-application.h"
+
+namespace ns3 {
+
+    /**
+     * Replays a binary packet trace: every packet is sent by the application of its source
+     * endpoint at its time, to its destination endpoint over UDP. The trace is read in
+     * order from a memory map, with a single pending event for the next time in the trace.
+     */
+    class TraceReplayScheduler
+    {
+
+    public:
+        TraceReplayScheduler(Ptr<BasicSimulation> basicSimulation, Ptr<Topology> topology);
+        void WriteResults();
+
+    protected:
+        void ReplayNext();
+        Ptr<BasicSimulation> m_basicSimulation;
+        int64_t m_simulation_end_time_ns;
+        Ptr<Topology> m_topology = nullptr;
+        bool m_enabled;
+
+        uint32_t m_system_id;
+        bool m_enable_distributed;
+        std::vector<int64_t> m_distributed_node_system_id_assignment;
+
+        NodeContainer m_nodes;
+        std::vector<ApplicationContainer> m_apps;
+        std::vector<Ptr<TraceReplayApplication>> m_node_to_app;   //!< Application of each endpoint of this system (else null)
+        std::vector<Ipv4Address> m_node_to_address;               //!< Address of each endpoint
+        std::unique_ptr<PacketTraceReader> m_reader;
+        PacketTraceRecord m_next_record;
+        std::unordered_map<int64_t, std::pair<int64_t, int64_t>> m_flow_endpoints;
+        int64_t m_num_packets_sent;
+
+        std::string m_trace_replay_outgoing_csv_filename;
+        std::string m_trace_replay_incoming_csv_filename;
+
+    };
+
+}
+
+#endif /* TRACE_REPLAY_SCHEDULER_H */
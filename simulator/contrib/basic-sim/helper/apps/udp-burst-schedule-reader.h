@@ -16,6 +16,38 @@
 
 namespace ns3 {
 
+/**
+ * Source of the UDP burst schedule, from which the bursts are taken in chunks
+ * (ascending UDP burst ID and weakly ascending start time).
+ */
+class UdpBurstScheduleSource
+{
+public:
+    virtual ~UdpBurstScheduleSource() {};
+    virtual size_t ReadChunk(std::vector<UdpBurstInfo>& chunk, size_t max_num_entries) = 0;
+    virtual int64_t GetNumRead() = 0;
+};
+
+/**
+ * Reads the UDP burst schedule from a file cursor in chunks, such that only the entries
+ * of the chunk are in memory. Each line is checked the same as by read_udp_burst_schedule(),
+ * but only once it is read.
+ */
+class UdpBurstScheduleReader : public UdpBurstScheduleSource
+{
+public:
+    UdpBurstScheduleReader(const std::string& filename, Ptr<Topology> topology, const int64_t simulation_end_time_ns);
+    size_t ReadChunk(std::vector<UdpBurstInfo>& chunk, size_t max_num_entries);
+    int64_t GetNumRead();
+private:
+    std::string m_filename;
+    std::ifstream m_schedule_file;
+    Ptr<Topology> m_topology;
+    int64_t m_simulation_end_time_ns;
+    int64_t m_line_counter;
+    int64_t m_prev_start_time_ns;
+};
+
 std::vector<UdpBurstInfo> read_udp_burst_schedule(
         const std::string& filename,
         Ptr<Topology> topology,
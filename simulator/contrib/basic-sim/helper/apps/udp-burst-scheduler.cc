@@ -36,46 +36,38 @@ namespace ns3 {
 
         } else {
             std::cout << "  > UDP burst scheduler is enabled" << std::endl;
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Setup UDP burst scheduler");
 
             // Properties we will use often
             m_nodes = m_topology->GetNodes();
             m_simulation_end_time_ns = m_basicSimulation->GetSimulationEndTimeNs();
             m_enable_logging_for_udp_burst_ids = parse_set_positive_int64(m_basicSimulation->GetConfigParamOrDefault("udp_burst_enable_logging_for_udp_burst_ids", "set()"));
+            m_enable_latency_histograms = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("udp_burst_enable_latency_histograms", "false"));
+
+            // Pacing: packets departing within this window are sent out together (0: one event per packet)
+            m_pacing_batch_window_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("udp_burst_pacing_batch_window_ns", "0"));
+            if (m_pacing_batch_window_ns > 0) {
+                std::cout << "  > Pacing in batches of " << m_pacing_batch_window_ns << " ns" << std::endl;
+            }
 
             // Distributed run information
             m_system_id = m_basicSimulation->GetSystemId();
             m_enable_distributed = m_basicSimulation->IsDistributedEnabled();
             m_distributed_node_system_id_assignment = m_basicSimulation->GetDistributedNodeSystemIdAssignment();
 
-            // Read schedule
-            m_schedule = read_udp_burst_schedule(
-                    m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("udp_burst_schedule_filename"),
-                    m_topology,
-                    m_simulation_end_time_ns
-            );
-
-            // Check that the UDP burst IDs exist in the logging
-            for (int64_t udp_burst_id : m_enable_logging_for_udp_burst_ids) {
-                if ((size_t) udp_burst_id >= m_schedule.size()) {
-                    throw std::invalid_argument("Invalid UDP burst ID in udp_burst_enable_logging_for_udp_burst_ids: " + std::to_string(udp_burst_id));
-                }
-            }
-
-            // Schedule read
-            printf("  > Read schedule (total UDP bursts: %lu)\n", m_schedule.size());
-            m_basicSimulation->RegisterTimestamp("Read UDP burst schedule");
-
             // Determine filenames
             if (m_enable_distributed) {
                 m_udp_bursts_outgoing_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_udp_bursts_outgoing.csv";
                 m_udp_bursts_outgoing_txt_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_udp_bursts_outgoing.txt";
                 m_udp_bursts_incoming_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_udp_bursts_incoming.csv";
                 m_udp_bursts_incoming_txt_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_udp_bursts_incoming.txt";
+                m_udp_bursts_incoming_latency_csv_filename = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_system_id) + "_udp_bursts_incoming_latency.csv";
             } else {
                 m_udp_bursts_outgoing_csv_filename = m_basicSimulation->GetLogsDir() + "/udp_bursts_outgoing.csv";
                 m_udp_bursts_outgoing_txt_filename = m_basicSimulation->GetLogsDir() + "/udp_bursts_outgoing.txt";
                 m_udp_bursts_incoming_csv_filename = m_basicSimulation->GetLogsDir() + "/udp_bursts_incoming.csv";
                 m_udp_bursts_incoming_txt_filename = m_basicSimulation->GetLogsDir() + "/udp_bursts_incoming.txt";
+                m_udp_bursts_incoming_latency_csv_filename = m_basicSimulation->GetLogsDir() + "/udp_bursts_incoming_latency.csv";
             }
 
             // Remove files if they are there
@@ -83,49 +75,140 @@ namespace ns3 {
             remove_file_if_exists(m_udp_bursts_outgoing_txt_filename);
             remove_file_if_exists(m_udp_bursts_incoming_csv_filename);
             remove_file_if_exists(m_udp_bursts_incoming_txt_filename);
+            remove_file_if_exists(m_udp_bursts_incoming_latency_csv_filename);
             printf("  > Removed previous UDP burst log files if present\n");
             m_basicSimulation->RegisterTimestamp("Remove previous UDP burst log files");
 
-            // Install sink on each endpoint node
+            // Precise logs are buffered and written in the background, and converted to CSV at the end
+            if (!m_enable_logging_for_udp_burst_ids.empty()) {
+                int64_t buffer_num_records = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault("precise_log_buffer_num_records", "65536"));
+                if (buffer_num_records > UINT32_MAX) {
+                    throw std::invalid_argument("precise_log_buffer_num_records is too large: " + std::to_string(buffer_num_records));
+                }
+                m_precise_log_writer = CreateObject<PreciseLogWriter>((uint32_t) buffer_num_records);
+                printf("  > Precise logging with buffers of %" PRId64 " records\n", buffer_num_records);
+            }
+
+            // Install an application on each endpoint node
             std::cout << "  > Setting up UDP burst applications on all endpoint nodes" << std::endl;
             for (int64_t endpoint : m_topology->GetEndpoints()) {
                 if (!m_enable_distributed || m_distributed_node_system_id_assignment[endpoint] == m_system_id) {
 
                     // Setup the application
                     UdpBurstHelper udpBurstHelper(1026, m_basicSimulation->GetLogsDir());
+                    udpBurstHelper.SetAttribute("PacingBatchWindowNs", IntegerValue(m_pacing_batch_window_ns));
                     ApplicationContainer app = udpBurstHelper.Install(m_nodes.Get(endpoint));
                     app.Start(Seconds(0.0));
                     m_apps.push_back(app);
 
-                    // Register all bursts being sent from there and being received
+                    // Bursts are registered at the application of their endpoints
                     Ptr<UdpBurstApplication> udpBurstApp = app.Get(0)->GetObject<UdpBurstApplication>();
-                    for (UdpBurstInfo entry : m_schedule) {
-                        if (entry.GetFromNodeId() == endpoint) {
-                            udpBurstApp->RegisterOutgoingBurst(
-                                    entry,
-                                    InetSocketAddress(m_nodes.Get(entry.GetToNodeId())->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 1026),
-                                    m_enable_logging_for_udp_burst_ids.find(entry.GetUdpBurstId()) != m_enable_logging_for_udp_burst_ids.end()
-                            );
-                            m_responsible_for_outgoing_bursts.push_back(std::make_pair(entry, udpBurstApp));
-                        }
-                        if (entry.GetToNodeId() == endpoint) {
-                            udpBurstApp->RegisterIncomingBurst(
-                                    entry,
-                                    m_enable_logging_for_udp_burst_ids.find(entry.GetUdpBurstId()) != m_enable_logging_for_udp_burst_ids.end()
-                            );
-                            m_responsible_for_incoming_bursts.push_back(std::make_pair(entry, udpBurstApp));
-                        }
+                    if (m_precise_log_writer != 0) {
+                        udpBurstApp->SetPreciseLogWriter(m_precise_log_writer);
                     }
+                    m_endpoint_to_app[endpoint] = udpBurstApp;
 
                 }
             }
             m_basicSimulation->RegisterTimestamp("Setup UDP burst applications");
 
+            // Streaming: only this many bursts of the schedule are read ahead at a time (0: the complete schedule upfront)
+            // The workload generator is always streamed, as its bursts are generated on the fly
+            bool enable_workload_generator = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("udp_burst_enable_workload_generator", "false"));
+            std::string schedule_filename;
+            if (enable_workload_generator) {
+                m_streaming_lookahead = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault("udp_burst_schedule_streaming_lookahead", "10000"));
+            } else {
+                schedule_filename = m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("udp_burst_schedule_filename");
+                m_streaming_lookahead = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("udp_burst_schedule_streaming_lookahead", "0"));
+            }
+
+            // Read schedule
+            if (enable_workload_generator) {
+                m_schedule_reader = std::unique_ptr<UdpBurstScheduleSource>(new UdpBurstWorkloadGenerator(
+                        create_workload_generator_from_config(m_basicSimulation, m_topology, "udp_burst_"),
+                        parse_positive_double(m_basicSimulation->GetConfigParamOrFail("udp_burst_workload_target_rate_megabit_per_s"))
+                ));
+                ReadNextChunk();
+                printf("  > Streaming schedule from workload generator (look-ahead: %" PRId64 " UDP bursts)\n", m_streaming_lookahead);
+
+            } else if (m_streaming_lookahead > 0) {
+                m_schedule_reader = std::unique_ptr<UdpBurstScheduleSource>(new UdpBurstScheduleReader(schedule_filename, m_topology, m_simulation_end_time_ns));
+                ReadNextChunk();
+                printf("  > Streaming schedule from file (look-ahead: %" PRId64 " UDP bursts)\n", m_streaming_lookahead);
+
+            } else {
+                std::vector<UdpBurstInfo> schedule = read_udp_burst_schedule(
+                        schedule_filename,
+                        m_topology,
+                        m_simulation_end_time_ns
+                );
+                CheckLoggingIds(schedule.size());
+                RegisterBursts(schedule);
+                printf("  > Read schedule (total UDP bursts: %lu)\n", schedule.size());
+
+            }
+            m_basicSimulation->RegisterTimestamp("Read UDP burst schedule");
+
         }
 
         std::cout << std::endl;
     }
 
+    /**
+     * Register the bursts at the applications of their endpoints which are part of this system.
+     *
+     * @param bursts    Bursts (weakly ascending start time, and not before those registered before)
+     */
+    void UdpBurstScheduler::RegisterBursts(const std::vector<UdpBurstInfo>& bursts) {
+        for (const UdpBurstInfo& entry : bursts) {
+            bool enable_precise_logging = m_enable_logging_for_udp_burst_ids.find(entry.GetUdpBurstId()) != m_enable_logging_for_udp_burst_ids.end();
+            auto it_from = m_endpoint_to_app.find(entry.GetFromNodeId());
+            if (it_from != m_endpoint_to_app.end()) {
+                it_from->second->RegisterOutgoingBurst(
+                        entry,
+                        InetSocketAddress(m_nodes.Get(entry.GetToNodeId())->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 1026),
+                        enable_precise_logging
+                );
+                m_responsible_for_outgoing_bursts.push_back(std::make_pair(entry, it_from->second));
+            }
+            auto it_to = m_endpoint_to_app.find(entry.GetToNodeId());
+            if (it_to != m_endpoint_to_app.end()) {
+                it_to->second->RegisterIncomingBurst(entry, enable_precise_logging);
+                m_responsible_for_incoming_bursts.push_back(std::make_pair(entry, it_to->second));
+            }
+        }
+    }
+
+    /**
+     * Read and register the next chunk of the streamed schedule, and schedule reading the one
+     * after it at the start of the last burst of this chunk.
+     */
+    void UdpBurstScheduler::ReadNextChunk() {
+        std::vector<UdpBurstInfo> chunk;
+        if (m_schedule_reader->ReadChunk(chunk, m_streaming_lookahead) == 0) {
+            CheckLoggingIds(m_schedule_reader->GetNumRead());
+            m_schedule_reader = nullptr;
+            return;
+        }
+        RegisterBursts(chunk);
+        int64_t now_ns = Simulator::Now().GetNanoSeconds();
+        Simulator::Schedule(NanoSeconds(chunk.back().GetStartTimeNs() - now_ns), &UdpBurstScheduler::ReadNextChunk, this);
+    }
+
+    /**
+     * Check that the UDP burst IDs exist in the logging.
+     *
+     * @param num_bursts    Number of bursts in the complete schedule
+     */
+    void UdpBurstScheduler::CheckLoggingIds(int64_t num_bursts) {
+        for (int64_t udp_burst_id : m_enable_logging_for_udp_burst_ids) {
+            if (udp_burst_id >= num_bursts) {
+                throw std::invalid_argument("Invalid UDP burst ID in udp_burst_enable_logging_for_udp_burst_ids: " + std::to_string(udp_burst_id));
+            }
+        }
+    }
+
     void UdpBurstScheduler::WriteResults() {
         std::cout << "STORE UDP BURST RESULTS" << std::endl;
 
@@ -134,6 +217,7 @@ namespace ns3 {
             std::cout << "  > Not enabled, so no UDP burst results are written" << std::endl;
 
         } else {
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Write UDP burst results");
 
             // Open files
             std::cout << "  > Opening UDP burst log files:" << std::endl;
@@ -298,6 +382,29 @@ namespace ns3 {
             fclose(file_incoming_txt);
             std::cout << "    >> Closed: " << m_udp_bursts_incoming_txt_filename << std::endl;
 
+            // Flush the precise logs and convert them to CSV
+            if (m_precise_log_writer != 0) {
+                m_precise_log_writer->Close();
+                m_precise_log_writer->ConvertToCsv();
+                std::cout << "  > Precise logs converted to CSV (" << m_precise_log_writer->GetNumRecordsWritten() << " records in " << m_precise_log_writer->GetNumWrites() << " writes)" << std::endl;
+            }
+
+            // One-way latency of the incoming bursts
+            if (m_enable_latency_histograms) {
+                FILE* file_latency_csv = fopen(m_udp_bursts_incoming_latency_csv_filename.c_str(), "w+");
+                for (std::pair<UdpBurstInfo, Ptr<UdpBurstApplication>> p : m_responsible_for_incoming_bursts) {
+                    const LatencyHistogram& histogram = p.second->GetLatencyHistogramOf(p.first.GetUdpBurstId());
+                    fprintf(
+                            file_latency_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRIu64 ",%" PRId64 ",%.1f,%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%.1f\n",
+                            p.first.GetUdpBurstId(), p.first.GetFromNodeId(), p.first.GetToNodeId(), histogram.GetCount(),
+                            histogram.GetMin(), histogram.GetMean(), histogram.GetPercentile(50), histogram.GetPercentile(99),
+                            histogram.GetPercentile(99.9), histogram.GetMax(), histogram.GetJitter()
+                    );
+                }
+                fclose(file_latency_csv);
+                std::cout << "    >> Written: " << m_udp_bursts_incoming_latency_csv_filename << std::endl;
+            }
+
             // Register completion
             std::cout << "  > UDP burst log files have been written" << std::endl;
             m_basicSimulation->RegisterTimestamp("Write UDP burst log files");
@@ -32,6 +32,7 @@
 #include <dirent.h>
 #include <unistd.h>
 #include <chrono>
+#include <memory>
 #include <stdexcept>
 
 #include "ns3/core-module.h"
@@ -47,8 +48,10 @@
 #include "ns3/topology.h"
 
 #include "ns3/udp-burst-schedule-reader.h"
+#include "ns3/workload-generator.h"
 #include "ns3/udp-burst-helper.h"
 #include "ns3/udp-burst-info.h"
+#include "ns3/precise-log-writer.h"
 
 namespace ns3 {
 
@@ -60,6 +63,9 @@ namespace ns3 {
         void WriteResults();
 
     protected:
+        void RegisterBursts(const std::vector<UdpBurstInfo>& bursts);
+        void ReadNextChunk();
+        void CheckLoggingIds(int64_t num_bursts);
         Ptr<BasicSimulation> m_basicSimulation;
         int64_t m_simulation_end_time_ns;
         Ptr<Topology> m_topology = nullptr;
@@ -69,15 +75,21 @@ namespace ns3 {
         bool m_enable_distributed;
         std::vector<int64_t> m_distributed_node_system_id_assignment;
 
-        std::vector<UdpBurstInfo> m_schedule;
         NodeContainer m_nodes;
         std::vector<ApplicationContainer> m_apps;
+        std::map<int64_t, Ptr<UdpBurstApplication>> m_endpoint_to_app;
+        int64_t m_streaming_lookahead;
+        std::unique_ptr<UdpBurstScheduleSource> m_schedule_reader;
         std::set<int64_t> m_enable_logging_for_udp_burst_ids;
+        Ptr<PreciseLogWriter> m_precise_log_writer;
 
         std::string m_udp_bursts_outgoing_csv_filename;
         std::string m_udp_bursts_outgoing_txt_filename;
         std::string m_udp_bursts_incoming_csv_filename;
         std::string m_udp_bursts_incoming_txt_filename;
+        bool m_enable_latency_histograms;
+        int64_t m_pacing_batch_window_ns;
+        std::string m_udp_bursts_incoming_latency_csv_filename;
 
         std::vector<std::pair<UdpBurstInfo, Ptr<UdpBurstApplication>>> m_responsible_for_outgoing_bursts;
         std::vector<std::pair<UdpBurstInfo, Ptr<UdpBurstApplication>>> m_responsible_for_incoming_bursts;
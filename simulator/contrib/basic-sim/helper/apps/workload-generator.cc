@@ -0,0 +1,254 @@
+#include "workload-generator.h"
+
+namespace ns3 {
+
+/**
+ * Read in the size CDF of a workload.
+ *
+ * Each line is: [size (byte)],[cumulative probability]
+ * Both must be weakly ascending, and the last cumulative probability must be 1.
+ *
+ * @param filename      File name of the CDF
+ *
+ * @return CDF points
+ */
+WorkloadSizeCdf read_workload_size_cdf(const std::string& filename) {
+
+    // Check that the file exists
+    if (!file_exists(filename)) {
+        throw std::runtime_error(format_string("File %s does not exist.", filename.c_str()));
+    }
+
+    // Open file
+    std::ifstream cdf_file(filename);
+    if (!cdf_file) {
+        throw std::runtime_error(format_string("File %s could not be read.", filename.c_str()));
+    }
+
+    // Go over each line
+    WorkloadSizeCdf cdf;
+    std::string line;
+    while (getline(cdf_file, line)) {
+        std::vector<std::string> comma_split = split_string(line, ",", 2);
+        double size_byte = parse_positive_double(comma_split[0]);
+        double cumulative_probability = parse_double_between_zero_and_one(comma_split[1]);
+        if (!cdf.empty() && (size_byte < cdf.back().first || cumulative_probability < cdf.back().second)) {
+            throw std::invalid_argument(format_string("Size CDF is not weakly ascending (violation: %s)", line.c_str()));
+        }
+        cdf.push_back(std::make_pair(size_byte, cumulative_probability));
+    }
+    cdf_file.close();
+
+    // It must end at 1
+    if (cdf.empty() || cdf.back().second != 1.0) {
+        throw std::invalid_argument(format_string("Size CDF in %s does not end at a cumulative probability of 1.", filename.c_str()));
+    }
+    return cdf;
+
+}
+
+/**
+ * Set up the generator.
+ *
+ * @param endpoints             Endpoints between which the arrivals go (at least two)
+ * @param arrival_rate_per_s    Mean number of arrivals per second
+ * @param size_cdf              Size CDF
+ * @param pair_model            Pair model (uniform or permutation)
+ * @param seed                  Seed of the random number generator
+ * @param end_time_ns           Arrivals all start before this time
+ * @param max_num_arrivals      Maximum number of arrivals (-1: no limit)
+ */
+WorkloadGenerator::WorkloadGenerator(
+        std::set<int64_t> endpoints,
+        double arrival_rate_per_s,
+        WorkloadSizeCdf size_cdf,
+        const std::string& pair_model,
+        int64_t seed,
+        int64_t end_time_ns,
+        int64_t max_num_arrivals
+) : m_rng((uint64_t) seed) {
+    m_endpoints = std::vector<int64_t>(endpoints.begin(), endpoints.end());
+    if (m_endpoints.size() < 2) {
+        throw std::invalid_argument("Workload generator requires at least two endpoints.");
+    }
+    if (arrival_rate_per_s <= 0) {
+        throw std::invalid_argument(format_string("Workload arrival rate must be positive: %f", arrival_rate_per_s));
+    }
+    if (size_cdf.empty() || size_cdf.back().second != 1.0) {
+        throw std::invalid_argument("Workload size CDF must end at a cumulative probability of 1.");
+    }
+    m_arrival_rate_per_ns = arrival_rate_per_s / 1e9;
+    m_size_cdf = size_cdf;
+    m_end_time_ns = end_time_ns;
+    m_max_num_arrivals = max_num_arrivals;
+    m_num_generated = 0;
+
+    // Pair model
+    if (pair_model == "uniform") {
+        m_pair_model_permutation = false;
+    } else if (pair_model == "permutation") {
+        m_pair_model_permutation = true;
+
+        // Uniform random derangement (no endpoint is its own partner): shuffle until there is
+        // no fixed point, which takes e (about 2.7) shuffles on average
+        std::vector<size_t> partner_idx(m_endpoints.size());
+        bool has_fixed_point = true;
+        while (has_fixed_point) {
+            for (size_t i = 0; i < partner_idx.size(); i++) {
+                partner_idx[i] = i;
+            }
+            for (size_t i = partner_idx.size() - 1; i > 0; i--) {
+                std::swap(partner_idx[i], partner_idx[(size_t) (NextUniform() * (i + 1))]);
+            }
+            has_fixed_point = false;
+            for (size_t i = 0; i < partner_idx.size(); i++) {
+                has_fixed_point = has_fixed_point || partner_idx[i] == i;
+            }
+        }
+        m_permutation_partner = std::vector<int64_t>(m_endpoints.size());
+        for (size_t i = 0; i < partner_idx.size(); i++) {
+            m_permutation_partner[i] = m_endpoints[partner_idx[i]];
+        }
+
+    } else {
+        throw std::invalid_argument("Unknown workload pair model: " + pair_model);
+    }
+
+    // First arrival
+    m_next_time_ns = -std::log(1.0 - NextUniform()) / m_arrival_rate_per_ns;
+
+}
+
+/**
+ * Uniform in [0, 1) from the 53 most significant bits, which is the same on every platform.
+ */
+double WorkloadGenerator::NextUniform() {
+    return (double) (m_rng() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * Inverse transform sampling of the size CDF.
+ */
+double WorkloadGenerator::SampleSize() {
+    double u = NextUniform();
+    size_t i = 0;
+    while (m_size_cdf[i].second <= u) {
+        i++;
+    }
+    if (i == 0) {
+        return m_size_cdf[0].first;
+    }
+    double p0 = m_size_cdf[i - 1].second;
+    double p1 = m_size_cdf[i].second;
+    double s0 = m_size_cdf[i - 1].first;
+    double s1 = m_size_cdf[i].first;
+    return s0 + (s1 - s0) * (u - p0) / (p1 - p0);
+}
+
+/**
+ * Generate the next arrival.
+ *
+ * @param arrival   (Output) Arrival
+ *
+ * @return True iff there is a next arrival (false once past the end time or the maximum)
+ */
+bool WorkloadGenerator::Next(WorkloadArrival& arrival) {
+    int64_t start_time_ns = (int64_t) std::floor(m_next_time_ns);
+    if (start_time_ns >= m_end_time_ns || (m_max_num_arrivals >= 0 && m_num_generated >= m_max_num_arrivals)) {
+        return false;
+    }
+    arrival.id = m_num_generated;
+    arrival.start_time_ns = start_time_ns;
+    size_t from_idx = (size_t) (NextUniform() * m_endpoints.size());
+    arrival.from_node_id = m_endpoints[from_idx];
+    if (m_pair_model_permutation) {
+        arrival.to_node_id = m_permutation_partner[from_idx];
+    } else {
+        size_t to_idx = (size_t) (NextUniform() * (m_endpoints.size() - 1));
+        arrival.to_node_id = m_endpoints[to_idx >= from_idx ? to_idx + 1 : to_idx];
+    }
+    arrival.size_byte = SampleSize();
+    m_num_generated++;
+    m_next_time_ns += -std::log(1.0 - NextUniform()) / m_arrival_rate_per_ns;
+    return true;
+}
+
+int64_t WorkloadGenerator::GetNumGenerated() {
+    return m_num_generated;
+}
+
+/**
+ * Set up a generator from the run configuration, with the keys:
+ *
+ * - <prefix>workload_arrival_rate_per_s        Mean number of arrivals per second
+ * - <prefix>workload_size_cdf_filename         Size CDF file in the run directory
+ * - <prefix>workload_pair_model                uniform (default) or permutation
+ * - <prefix>workload_seed                      Seed (default: simulation_seed)
+ * - <prefix>workload_max_num_arrivals          Maximum number of arrivals (default: -1, no limit)
+ *
+ * Arrivals are between all endpoints of the topology, until the end of the simulation.
+ *
+ * @param basicSimulation   Basic simulation
+ * @param topology          Topology
+ * @param prefix            Prefix of the keys (e.g., "tcp_flow_")
+ *
+ * @return Generator
+ */
+WorkloadGenerator create_workload_generator_from_config(Ptr<BasicSimulation> basicSimulation, Ptr<Topology> topology, const std::string& prefix) {
+    return WorkloadGenerator(
+            topology->GetEndpoints(),
+            parse_positive_double(basicSimulation->GetConfigParamOrFail(prefix + "workload_arrival_rate_per_s")),
+            read_workload_size_cdf(basicSimulation->GetRunDir() + "/" + basicSimulation->GetConfigParamOrFail(prefix + "workload_size_cdf_filename")),
+            basicSimulation->GetConfigParamOrDefault(prefix + "workload_pair_model", "uniform"),
+            parse_positive_int64(basicSimulation->GetConfigParamOrDefault(prefix + "workload_seed", basicSimulation->GetConfigParamOrFail("simulation_seed"))),
+            basicSimulation->GetSimulationEndTimeNs(),
+            parse_int64(basicSimulation->GetConfigParamOrDefault(prefix + "workload_max_num_arrivals", "-1"))
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+TcpFlowWorkloadGenerator::TcpFlowWorkloadGenerator(const WorkloadGenerator& generator) : m_generator(generator) {
+    // Left empty intentionally
+}
+
+size_t TcpFlowWorkloadGenerator::ReadChunk(std::vector<TcpFlowScheduleEntry>& chunk, size_t max_num_entries) {
+    size_t num_read = 0;
+    WorkloadArrival arrival;
+    while (num_read < max_num_entries && m_generator.Next(arrival)) {
+        int64_t size_byte = std::max((int64_t) 1, (int64_t) std::llround(arrival.size_byte));
+        chunk.push_back(TcpFlowScheduleEntry(arrival.id, arrival.from_node_id, arrival.to_node_id, size_byte, arrival.start_time_ns, "", ""));
+        num_read++;
+    }
+    return num_read;
+}
+
+int64_t TcpFlowWorkloadGenerator::GetNumRead() {
+    return m_generator.GetNumGenerated();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+UdpBurstWorkloadGenerator::UdpBurstWorkloadGenerator(const WorkloadGenerator& generator, double target_rate_megabit_per_s)
+        : m_generator(generator), m_target_rate_megabit_per_s(target_rate_megabit_per_s) {
+    if (target_rate_megabit_per_s <= 0) {
+        throw std::invalid_argument(format_string("UDP burst workload target rate must be positive: %f", target_rate_megabit_per_s));
+    }
+}
+
+size_t UdpBurstWorkloadGenerator::ReadChunk(std::vector<UdpBurstInfo>& chunk, size_t max_num_entries) {
+    size_t num_read = 0;
+    WorkloadArrival arrival;
+    while (num_read < max_num_entries && m_generator.Next(arrival)) {
+        int64_t duration_ns = std::max((int64_t) 1, (int64_t) std::ceil(arrival.size_byte * 8000.0 / m_target_rate_megabit_per_s));
+        chunk.push_back(UdpBurstInfo(arrival.id, arrival.from_node_id, arrival.to_node_id, m_target_rate_megabit_per_s, arrival.start_time_ns, duration_ns, "", ""));
+        num_read++;
+    }
+    return num_read;
+}
+
+int64_t UdpBurstWorkloadGenerator::GetNumRead() {
+    return m_generator.GetNumGenerated();
+}
+
+}
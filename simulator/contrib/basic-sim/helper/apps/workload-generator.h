@@ -0,0 +1,118 @@
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include <string>
+#include <vector>
+#include <set>
+#include <cstring>
+#include <fstream>
+#include <cinttypes>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include "ns3/exp-util.h"
+#include "ns3/topology.h"
+#include "ns3/basic-simulation.h"
+#include "ns3/tcp-flow-schedule-reader.h"
+#include "ns3/udp-burst-schedule-reader.h"
+
+namespace ns3 {
+
+/**
+ * Empirical cumulative distribution function of a (flow or burst) size,
+ * given as points (size, cumulative probability) ascending in both.
+ */
+typedef std::vector<std::pair<double, double>> WorkloadSizeCdf;
+
+WorkloadSizeCdf read_workload_size_cdf(const std::string& filename);
+
+/**
+ * Arrival of the workload generator.
+ */
+struct WorkloadArrival {
+    int64_t id;
+    int64_t from_node_id;
+    int64_t to_node_id;
+    int64_t start_time_ns;
+    double size_byte;
+};
+
+/**
+ * Generates a stochastic workload lazily: Poisson arrivals with a size drawn from an
+ * empirical CDF (linear interpolation between the points), between endpoint pairs
+ * chosen by the pair model:
+ *
+ * - uniform:       from and to are drawn uniformly at random among the endpoints (from != to)
+ * - permutation:   a uniform random permutation of the endpoints without fixed points
+ *                  (derangement) is drawn once, and every arrival goes from a uniform
+ *                  random endpoint to its partner
+ *
+ * Its random number generator is independent from that of ns-3, such that
+ * generating again with the same seed yields the exact same arrivals.
+ */
+class WorkloadGenerator
+{
+public:
+    WorkloadGenerator(
+            std::set<int64_t> endpoints,
+            double arrival_rate_per_s,
+            WorkloadSizeCdf size_cdf,
+            const std::string& pair_model,
+            int64_t seed,
+            int64_t end_time_ns,
+            int64_t max_num_arrivals
+    );
+    bool Next(WorkloadArrival& arrival);
+    int64_t GetNumGenerated();
+private:
+    double NextUniform();
+    double SampleSize();
+    std::vector<int64_t> m_endpoints;
+    std::vector<int64_t> m_permutation_partner;
+    double m_arrival_rate_per_ns;
+    WorkloadSizeCdf m_size_cdf;
+    bool m_pair_model_permutation;
+    std::mt19937_64 m_rng;
+    int64_t m_end_time_ns;
+    int64_t m_max_num_arrivals;
+    double m_next_time_ns;
+    int64_t m_num_generated;
+};
+
+WorkloadGenerator create_workload_generator_from_config(
+        Ptr<BasicSimulation> basicSimulation,
+        Ptr<Topology> topology,
+        const std::string& prefix
+);
+
+/**
+ * TCP flows from the workload generator, the size being the flow size.
+ */
+class TcpFlowWorkloadGenerator : public TcpFlowScheduleSource
+{
+public:
+    TcpFlowWorkloadGenerator(const WorkloadGenerator& generator);
+    size_t ReadChunk(std::vector<TcpFlowScheduleEntry>& chunk, size_t max_num_entries);
+    int64_t GetNumRead();
+private:
+    WorkloadGenerator m_generator;
+};
+
+/**
+ * UDP bursts from the workload generator, all at the same target rate. The size is the
+ * amount of data of the burst, which determines its duration at the target rate.
+ */
+class UdpBurstWorkloadGenerator : public UdpBurstScheduleSource
+{
+public:
+    UdpBurstWorkloadGenerator(const WorkloadGenerator& generator, double target_rate_megabit_per_s);
+    size_t ReadChunk(std::vector<UdpBurstInfo>& chunk, size_t max_num_entries);
+    int64_t GetNumRead();
+private:
+    WorkloadGenerator m_generator;
+    double m_target_rate_megabit_per_s;
+};
+
+}
+
+#endif //WORKLOAD_GENERATOR_H
@@ -4,6 +4,7 @@ namespace ns3 {
 
 void ArbiterEcmpHelper::InstallArbiters (Ptr<BasicSimulation> basicSimulation, Ptr<TopologyPtop> topology) {
     std::cout << "SETUP ECMP ROUTING" << std::endl;
+    ScopedPhase phase(basicSimulation->GetPhaseProfiler(), "Setup ECMP routing");
 
     NodeContainer nodes = topology->GetNodes();
 
@@ -7,8 +7,10 @@ ArbiterMulticastHelper::ArbiterMulticastHelper(Ptr<BasicSimulation> basicSimulat
     m_topology = topology;
     m_multicast_reqs = multicast_reqs;
     m_nodes = topology->GetNodes();
+    m_num_membership_links_changed = 0;
 
     std::cout << "SETUP MULTICAST ROUTING" << std::endl;
+    ScopedPhase phase(basicSimulation->GetPhaseProfiler(), "Setup multicast routing");
 
     // Calculate and instantiate the routing
     std::cout << "  > ArbiterMulticastHelper:Calculating ECMP routing for unicast" << std::endl;
@@ -27,7 +29,17 @@ ArbiterMulticastHelper::ArbiterMulticastHelper(Ptr<BasicSimulation> basicSimulat
 
     basicSimulation->RegisterTimestamp("Setup multicast routing state");
     // ReadGlobalMulticastState();
-    CalGlobalMulticastState(global_ecmp_state);
+    m_global_ecmp_state = std::move(global_ecmp_state);
+    std::string multicast_mode = m_basicSimulation->GetConfigParamOrDefault("multicast_mode", "tree");
+    if (multicast_mode == "tree") {
+        CalGlobalMulticastState(m_global_ecmp_state);
+        AggregateMulticastState();
+        ScheduleMembershipEvents();
+    } else if (multicast_mode == "bier") {
+        CalGlobalBierState(m_global_ecmp_state);
+    } else {
+        throw std::invalid_argument("Unknown multicast mode: " + multicast_mode);
+    }
 
     std::cout << std::endl;
 
@@ -143,50 +155,383 @@ void ArbiterMulticastHelper::ReadGlobalMulticastState() {
 
 void ArbiterMulticastHelper::CalGlobalMulticastState(std::vector<std::vector<std::vector<uint32_t>>> &global_ecmp_state) {
     m_basicSimulation->GetConfigParamOrFail("multicast_route_filename"); //lazily activate Config key 'multicast_route_filename'
-    std::cout << "  > Calculating multicast route from ecmp states" << std::endl;
 
-    for (MulticastUdpInfo req : m_multicast_reqs) {
-        //cal oifs for every req separately
-        std::set<uint32_t> nodes_ids_to_install;
-        std::map<uint32_t, std::set<uint32_t>> node_id_to_oifs;
-        std::map<uint32_t, uint32_t> node_id_to_iif;
+    // Tree construction strategy
+    std::string tree_builder_name = m_basicSimulation->GetConfigParamOrDefault("multicast_tree_builder", "ecmp_union");
+    Ptr<MulticastTreeBuilder> tree_builder;
+    if (tree_builder_name == "ecmp_union") {
+        tree_builder = CreateObject<MulticastTreeBuilderEcmpUnion>(global_ecmp_state);
+    } else if (tree_builder_name == "spt") {
+        tree_builder = CreateObject<MulticastTreeBuilderSpt>();
+    } else if (tree_builder_name == "steiner_tm") {
+        tree_builder = CreateObject<MulticastTreeBuilderSteiner>();
+    } else {
+        throw std::invalid_argument("Unknown multicast tree builder: " + tree_builder_name);
+    }
+    // Placement: every tree on its own, or all of them jointly taking into account the load of earlier trees
+    std::string placement = m_basicSimulation->GetConfigParamOrDefault("multicast_tree_placement", "independent");
+    bool load_aware;
+    if (placement == "independent") {
+        load_aware = false;
+    } else if (placement == "load_aware") {
+        if (tree_builder_name == "ecmp_union") {
+            throw std::invalid_argument("Load-aware multicast tree placement requires a builder which uses link weights (spt or steiner_tm)");
+        }
+        load_aware = true;
+    } else {
+        throw std::invalid_argument("Unknown multicast tree placement: " + placement);
+    }
+    std::cout << "  > Calculating multicast trees (builder: " << tree_builder->GetName() << ", placement: " << placement << ")" << std::endl;
+
+    // Every link has weight 1, such that the tree cost is the number of link copies of each packet
+    WeightedAdjacencyList adjacency(m_topology->GetNumNodes());
+    for (int64_t i = 0; i < m_topology->GetNumNodes(); i++) {
+        for (int64_t nbr : m_topology->GetAdjacencyList(i)) {
+            adjacency[i].push_back(std::make_pair(nbr, 1.0));
+        }
+    }
+
+    // Per directed link: number of trees and their total target rate
+    std::map<std::pair<int64_t, int64_t>, std::pair<int64_t, double>> link_to_num_trees_and_load;
+    std::vector<std::tuple<int64_t, int64_t, int64_t, double>> req_tree_statistics; // (req id, tree links, unicast equivalent links, rate)
+
+    // The installed trees are kept for incremental membership changes
+    m_group_tree_states = std::vector<MulticastGroupTreeState>(m_multicast_reqs.size());
+
+    // Load-aware placement commits the largest requests first
+    std::vector<size_t> req_order(m_multicast_reqs.size());
+    for (size_t i = 0; i < req_order.size(); i++) {
+        req_order[i] = i;
+    }
+    if (load_aware) {
+        std::stable_sort(req_order.begin(), req_order.end(), [this](size_t a, size_t b) {
+            return m_multicast_reqs[a].GetTargetRateMegabitPerSec() > m_multicast_reqs[b].GetTargetRateMegabitPerSec();
+        });
+    }
+
+    for (size_t req_idx : req_order) {
+        MulticastUdpInfo& req = m_multicast_reqs[req_idx];
         int64_t src_id = req.GetFromNodeId();
-        std::set<int64_t> dst_ids = req.GetToNodeIds();
-        uint32_t cur_node_id, nxt_node_id, cur_to_nxt_oif_id=0;
-        for (auto dst_id : dst_ids) {
-            cur_node_id = src_id;
-            while (cur_node_id != (uint32_t)dst_id) {
-                nxt_node_id = global_ecmp_state[cur_node_id][dst_id][0]; //select the first ecmp candidate by default
-                cur_to_nxt_oif_id = m_node_to_nbr_if_idx[cur_node_id][nxt_node_id];
-                nodes_ids_to_install.insert(cur_node_id); // auto filter duplicate element
-                if (node_id_to_oifs.find(cur_node_id) != node_id_to_oifs.end()) { //cur_node_id has been recorded
-                    node_id_to_oifs[cur_node_id].insert(cur_to_nxt_oif_id); // add oif id to set
-                }
-                else {
-                    node_id_to_oifs.insert({cur_node_id, {cur_to_nxt_oif_id}}); // init a set
+
+        // Weigh each link by how full it would be with this request committed to it as well
+        // (1 / (1 - utilization)), such that the trees move away from links with little headroom
+        if (load_aware) {
+            for (int64_t i = 0; i < m_topology->GetNumNodes(); i++) {
+                for (std::pair<int64_t, double>& nbr : adjacency[i]) {
+                    std::pair<int64_t, int64_t> link = std::make_pair(i, nbr.first);
+                    auto it = link_to_num_trees_and_load.find(link);
+                    double committed = it == link_to_num_trees_and_load.end() ? 0.0 : it->second.second;
+                    double utilization = (committed + req.GetTargetRateMegabitPerSec()) / m_topology->GetLinkDataRateMegabitPerSec(link);
+                    nbr.second = utilization < 1.0 - 1e-6 ? 1.0 / (1.0 - utilization) : 1e6 * (1.0 + utilization);
                 }
-                node_id_to_iif[nxt_node_id] = m_node_to_nbr_if_idx[nxt_node_id][cur_node_id];
-                cur_node_id = nxt_node_id; //hop to next
             }
         }
-        //add multicast route for this req
-        if (node_id_to_oifs[src_id].size() != 1) {
-            throw std::runtime_error("CalGlobalMulticastState: Src oif num != 1(not supported by ns3 routing protocol)");
+
+        MulticastTree tree = tree_builder->BuildTree(adjacency, src_id, req.GetToNodeIds());
+
+        //add multicast route for this req, the source IP is that of its first out interface
+        if (tree.node_to_children[src_id].empty()) {
+            throw std::runtime_error("CalGlobalMulticastState: source has no out interface in the multicast tree");
         }
-        Ipv4Address origin = m_nodes.Get(src_id)->GetObject<Ipv4>()->GetAddress(*node_id_to_oifs[src_id].begin(), 0).GetLocal();
+        uint32_t src_oif_id = m_node_to_nbr_if_idx[src_id][*tree.node_to_children[src_id].begin()];
+        Ipv4Address origin = m_nodes.Get(src_id)->GetObject<Ipv4>()->GetAddress(src_oif_id, 0).GetLocal();
         Ipv4Address group = Ipv4Address(m_topology->GetMulticastGroupBase().Get() + req.GetUdpBurstId());
-        uint32_t iif_id;
-        for (auto node_id_to_install : nodes_ids_to_install) {
-            if (node_id_to_install == src_id) {
-                iif_id = 0;
+        MulticastGroupTreeState& tree_state = m_group_tree_states.at(req.GetUdpBurstId());
+        tree_state.origin = origin;
+        tree_state.group = group;
+        tree_state.src_node_id = src_id;
+        tree_state.members = req.GetToNodeIds();
+        tree_state.node_to_children = tree.node_to_children;
+        for (const std::pair<const int64_t, std::set<int64_t>>& entry : tree.node_to_children) {
+            for (int64_t child : entry.second) {
+                tree_state.node_to_parents[child].insert(entry.first);
+                tree_state.node_to_parent[child] = entry.first;
             }
-            else {
-                iif_id = node_id_to_iif[node_id_to_install]; // use 0 for simplicity
+        }
+        for (const std::pair<const int64_t, std::set<int64_t>>& entry : tree.node_to_children) {
+            uint32_t iif_id = 0;
+            if (entry.first != src_id) {
+                iif_id = m_node_to_nbr_if_idx[entry.first][tree_state.node_to_parent.at(entry.first)];
             }
-            std::vector<uint32_t> out_if_ids(node_id_to_oifs[node_id_to_install].begin(), node_id_to_oifs[node_id_to_install].end());
-            m_arbiters[node_id_to_install]->AddMulticastRoute(origin, group, iif_id, out_if_ids);
+            std::vector<uint32_t> out_if_ids;
+            for (int64_t child : entry.second) {
+                out_if_ids.push_back(m_node_to_nbr_if_idx[entry.first][child]);
+                std::pair<int64_t, double>& link_load = link_to_num_trees_and_load[std::make_pair(entry.first, child)];
+                link_load.first += 1;
+                link_load.second += req.GetTargetRateMegabitPerSec();
+            }
+            m_arbiters[entry.first]->AddMulticastRoute(origin, group, iif_id, out_if_ids);
+        }
+
+        // Unicast equivalent: one copy over the shortest path to each destination
+        std::vector<int64_t> hops(m_topology->GetNumNodes(), -1);
+        std::queue<int64_t> frontier;
+        hops[src_id] = 0;
+        frontier.push(src_id);
+        while (!frontier.empty()) {
+            int64_t cur = frontier.front();
+            frontier.pop();
+            for (int64_t nbr : m_topology->GetAdjacencyList(cur)) {
+                if (hops[nbr] == -1) {
+                    hops[nbr] = hops[cur] + 1;
+                    frontier.push(nbr);
+                }
+            }
+        }
+        int64_t unicast_links = 0;
+        for (int64_t dst_id : req.GetToNodeIds()) {
+            unicast_links += hops[dst_id];
+        }
+        req_tree_statistics.push_back(std::make_tuple(req.GetUdpBurstId(), tree.GetNumLinks(), unicast_links, req.GetTargetRateMegabitPerSec()));
+
+    }
+    m_basicSimulation->RegisterTimestamp("Calculate multicast trees");
+
+    // Tree cost per request
+    std::sort(req_tree_statistics.begin(), req_tree_statistics.end());
+    std::string filename_trees_csv = m_basicSimulation->GetLogsDir() + "/multicast_trees.csv";
+    FILE* file_trees_csv = fopen(filename_trees_csv.c_str(), "w+");
+    int64_t total_tree_links = 0;
+    int64_t total_unicast_links = 0;
+    for (const std::tuple<int64_t, int64_t, int64_t, double>& stat : req_tree_statistics) {
+        fprintf(
+                file_trees_csv, "%" PRId64 ",%s,%" PRId64 ",%" PRId64 ",%f,%f\n",
+                std::get<0>(stat), tree_builder->GetName().c_str(), std::get<1>(stat), std::get<2>(stat),
+                std::get<1>(stat) * std::get<3>(stat), std::get<2>(stat) * std::get<3>(stat)
+        );
+        total_tree_links += std::get<1>(stat);
+        total_unicast_links += std::get<2>(stat);
+    }
+    fclose(file_trees_csv);
+
+    // Committed load on every directed link
+    std::string filename_link_load_csv = m_basicSimulation->GetLogsDir() + "/multicast_link_load.csv";
+    FILE* file_link_load_csv = fopen(filename_link_load_csv.c_str(), "w+");
+    double max_utilization = 0.0;
+    for (int64_t i = 0; i < m_topology->GetNumNodes(); i++) {
+        for (int64_t nbr : m_topology->GetAdjacencyList(i)) {
+            std::pair<int64_t, int64_t> link = std::make_pair(i, nbr);
+            auto it = link_to_num_trees_and_load.find(link);
+            int64_t num_trees = it == link_to_num_trees_and_load.end() ? 0 : it->second.first;
+            double load = it == link_to_num_trees_and_load.end() ? 0.0 : it->second.second;
+            double capacity = m_topology->GetLinkDataRateMegabitPerSec(link);
+            fprintf(
+                    file_link_load_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%f,%f,%f\n",
+                    link.first, link.second, num_trees, load, capacity, load / capacity
+            );
+            max_utilization = std::max(max_utilization, load / capacity);
         }
     }
+    fclose(file_link_load_csv);
+
+    std::cout << "  > Multicast tree links........ " << total_tree_links << " (unicast equivalent: " << total_unicast_links << ")" << std::endl;
+    std::cout << "  > Links carrying multicast.... " << link_to_num_trees_and_load.size() << std::endl;
+    std::cout << "  > Max. committed utilization.. " << max_utilization << std::endl;
+    std::cout << "  > Written to: " << filename_trees_csv << " and " << filename_link_load_csv << std::endl;
+    m_basicSimulation->RegisterTimestamp("Write multicast tree statistics");
+}
+
+void ArbiterMulticastHelper::CalGlobalBierState(std::vector<std::vector<std::vector<uint32_t>>> &global_ecmp_state) {
+    std::cout << "  > Calculating BIER forwarding bit masks (stateless multicast)" << std::endl;
+    std::vector<int64_t> bit_positions = bier_bit_positions(m_topology->GetEndpoints(), m_topology->GetNumNodes());
+    uint32_t num_words = bier_num_words(m_topology->GetEndpoints().size());
+
+    // Each endpoint bit goes to the neighbor which is the (first ECMP candidate) next hop towards it
+    int64_t total_neighbors = 0;
+    for (int64_t i = 0; i < m_topology->GetNumNodes(); i++) {
+        BierForwardingState state;
+        state.own_bit_position = bit_positions[i];
+        std::map<int64_t, size_t> nbr_to_neighbor_idx;
+        for (int64_t endpoint : m_topology->GetEndpoints()) {
+            if (endpoint == i || global_ecmp_state[i][endpoint].empty()) {
+                continue;
+            }
+            int64_t nbr = global_ecmp_state[i][endpoint][0];
+            auto it = nbr_to_neighbor_idx.find(nbr);
+            if (it == nbr_to_neighbor_idx.end()) {
+                BierNeighbor neighbor;
+                neighbor.out_if_idx = m_node_to_nbr_if_idx[i][nbr];
+                neighbor.gateway_ip_address = m_nodes.Get(nbr)->GetObject<Ipv4>()->GetAddress(m_node_to_nbr_if_idx[nbr][i], 0).GetLocal().Get();
+                neighbor.forwarding_bit_mask = std::vector<uint64_t>(num_words, 0);
+                it = nbr_to_neighbor_idx.insert(std::make_pair(nbr, state.neighbors.size())).first;
+                state.neighbors.push_back(neighbor);
+            }
+            int64_t bit = bit_positions[endpoint];
+            state.neighbors[it->second].forwarding_bit_mask[bit / 64] |= (1ULL << (bit % 64));
+        }
+        total_neighbors += state.neighbors.size();
+        m_arbiters[i]->SetBierForwardingState(std::move(state));
+    }
+
+    std::cout << "  > BIER bit string length...... " << num_words * 64 << " bits (" << m_topology->GetEndpoints().size() << " endpoints)" << std::endl;
+    std::cout << "  > BIER forwarding entries..... " << total_neighbors << " (independent of the number of groups)" << std::endl;
+    m_basicSimulation->RegisterTimestamp("Calculate BIER forwarding state");
+}
+
+/**
+ * Groups with the same output interfaces at a node share a single interned output interface
+ * set. If enabled, runs of consecutive groups with the same forwarding are additionally
+ * aggregated into a single group range entry. The resulting size per node is written to
+ * logs_ns3/multicast_state_compression.csv.
+ */
+void ArbiterMulticastHelper::AggregateMulticastState() {
+    bool enable_aggregation = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("enable_multicast_group_aggregation", "true"));
+    std::cout << "  > Multicast group range aggregation: " << (enable_aggregation ? "enabled" : "disabled") << std::endl;
+
+    std::string filename_compression_csv = m_basicSimulation->GetLogsDir() + "/multicast_state_compression.csv";
+    FILE* file_compression_csv = fopen(filename_compression_csv.c_str(), "w+");
+    uint64_t total_size_byte = 0;
+    uint64_t total_uncompressed_size_byte = 0;
+    int64_t total_routes = 0;
+    int64_t total_entries = 0;
+    for (int64_t i = 0; i < m_topology->GetNumNodes(); i++) {
+        Ptr<ArbiterMulticast> arbiter = m_arbiters[i];
+        if (enable_aggregation) {
+            arbiter->AggregateMulticastRoutes();
+        }
+        uint64_t size_byte = arbiter->GetMulticastStateSizeByte();
+        uint64_t uncompressed_size_byte = arbiter->GetMulticastStateUncompressedSizeByte();
+        fprintf(
+                file_compression_csv, "%" PRId64 ",%zu,%zu,%zu,%zu,%" PRIu64 ",%" PRIu64 ",%f\n",
+                i, arbiter->GetNumMulticastRoutes(), arbiter->GetNumMulticastForwardingEntries(),
+                arbiter->GetNumMulticastGroupRanges(), arbiter->GetNumMulticastOifSets(),
+                uncompressed_size_byte, size_byte,
+                size_byte == 0 ? 1.0 : (double) uncompressed_size_byte / (double) size_byte
+        );
+        total_size_byte += size_byte;
+        total_uncompressed_size_byte += uncompressed_size_byte;
+        total_routes += arbiter->GetNumMulticastRoutes();
+        total_entries += arbiter->GetNumMulticastForwardingEntries();
+    }
+    fclose(file_compression_csv);
+
+    std::cout << "  > Multicast routes............ " << total_routes << " in " << total_entries << " forwarding entries" << std::endl;
+    std::cout << "  > Multicast state size........ " << total_size_byte << " byte (uncompressed: " << total_uncompressed_size_byte << " byte)" << std::endl;
+    std::cout << "  > Written to: " << filename_compression_csv << std::endl;
+    m_basicSimulation->RegisterTimestamp("Aggregate multicast state");
+}
+
+void ArbiterMulticastHelper::ScheduleMembershipEvents() {
+    int64_t num_events = 0;
+    for (MulticastUdpInfo& req : m_multicast_reqs) {
+        for (const MulticastMembershipEvent& event : req.GetMembershipEvents()) {
+            Simulator::Schedule(NanoSeconds(event.time_ns), &ArbiterMulticastHelper::ApplyMembershipEvent, this, req.GetUdpBurstId(), event.node_id, event.is_join);
+            num_events++;
+        }
+    }
+    if (num_events > 0) {
+        std::cout << "  > Scheduled " << num_events << " multicast membership change(s) (graft/prune)" << std::endl;
+    }
+}
+
+void ArbiterMulticastHelper::ApplyMembershipEvent(int64_t udp_burst_id, int64_t node_id, bool is_join) {
+    if (is_join) {
+        Graft(udp_burst_id, node_id);
+    } else {
+        Prune(udp_burst_id, node_id);
+    }
+}
+
+void ArbiterMulticastHelper::AddTreeLink(MulticastGroupTreeState& state, int64_t from_node_id, int64_t to_node_id) {
+    uint32_t iif_id = 0;
+    if (from_node_id != state.src_node_id) {
+        iif_id = m_node_to_nbr_if_idx[from_node_id][state.node_to_parent.at(from_node_id)];
+    }
+    m_arbiters[from_node_id]->AddMulticastOutputInterface(state.origin, state.group, iif_id, m_node_to_nbr_if_idx[from_node_id][to_node_id]);
+    state.node_to_children[from_node_id].insert(to_node_id);
+    state.node_to_parents[to_node_id].insert(from_node_id);
+    state.node_to_parent.emplace(to_node_id, from_node_id);
+    m_num_membership_links_changed++;
+}
+
+/**
+ * Join: add the node to the tree of the group. The new branch follows the unicast path
+ * (first ECMP candidate) from the source, from the last node on it which is already in the
+ * tree. Only the arbiters on the new branch are changed.
+ *
+ * @param udp_burst_id  Multicast UDP identifier
+ * @param node_id       Node which joins
+ */
+void ArbiterMulticastHelper::Graft(int64_t udp_burst_id, int64_t node_id) {
+    MulticastGroupTreeState& state = m_group_tree_states.at(udp_burst_id);
+    if (!state.members.insert(node_id).second) {
+        throw std::runtime_error(format_string("Node %" PRId64 " is already a member of multicast UDP %" PRId64, node_id, udp_burst_id));
+    }
+
+    // Unicast path from the source
+    std::vector<int64_t> path = {state.src_node_id};
+    while (path.back() != node_id) {
+        const std::vector<uint32_t>& candidates = m_global_ecmp_state[path.back()][node_id];
+        if (candidates.empty()) {
+            throw std::runtime_error(format_string("Node %" PRId64 " is not reachable from node %" PRId64, node_id, state.src_node_id));
+        }
+        path.push_back(candidates[0]);
+    }
+
+    // Graft from the last node which is already in the tree
+    size_t graft_idx = 0;
+    for (size_t i = 0; i < path.size(); i++) {
+        if (path[i] == state.src_node_id || state.node_to_parents.find(path[i]) != state.node_to_parents.end()) {
+            graft_idx = i;
+        }
+    }
+    for (size_t i = graft_idx; i + 1 < path.size(); i++) {
+        AddTreeLink(state, path[i], path[i + 1]);
+    }
+}
+
+/**
+ * Leave: remove the node from the group. If it does not forward to other members, its branch
+ * is removed up to the first node which is a member itself or still forwards to others.
+ * Only the arbiters on the removed branch are changed.
+ *
+ * @param udp_burst_id  Multicast UDP identifier
+ * @param node_id       Node which leaves
+ */
+void ArbiterMulticastHelper::Prune(int64_t udp_burst_id, int64_t node_id) {
+    MulticastGroupTreeState& state = m_group_tree_states.at(udp_burst_id);
+    if (state.members.erase(node_id) == 0) {
+        throw std::runtime_error(format_string("Node %" PRId64 " is not a member of multicast UDP %" PRId64, node_id, udp_burst_id));
+    }
+
+    // Walk up from the node, removing every node which no longer has a reason to receive
+    std::vector<int64_t> to_check = {node_id};
+    while (!to_check.empty()) {
+        int64_t cur = to_check.back();
+        to_check.pop_back();
+        if (cur == state.src_node_id || state.members.count(cur) > 0) {
+            continue;
+        }
+        auto children_it = state.node_to_children.find(cur);
+        if (children_it != state.node_to_children.end() && !children_it->second.empty()) {
+            continue;
+        }
+        auto parents_it = state.node_to_parents.find(cur);
+        if (parents_it == state.node_to_parents.end()) {
+            continue; // Already removed via another parent
+        }
+        for (int64_t parent : parents_it->second) {
+            m_arbiters[parent]->RemoveMulticastOutputInterface(state.origin, state.group, m_node_to_nbr_if_idx[parent][cur]);
+            state.node_to_children.at(parent).erase(cur);
+            m_num_membership_links_changed++;
+            to_check.push_back(parent);
+        }
+        state.node_to_parents.erase(parents_it);
+        state.node_to_parent.erase(cur);
+        state.node_to_children.erase(cur);
+    }
+}
+
+const MulticastGroupTreeState& ArbiterMulticastHelper::GetGroupTreeState(int64_t udp_burst_id) {
+    return m_group_tree_states.at(udp_burst_id);
+}
+
+int64_t ArbiterMulticastHelper::GetNumMembershipLinksChanged() {
+    return m_num_membership_links_changed;
+}
+
+const std::vector<std::vector<std::vector<uint32_t>>>& ArbiterMulticastHelper::GetGlobalEcmpState() {
+    return m_global_ecmp_state;
 }
 
 } // namespace ns3
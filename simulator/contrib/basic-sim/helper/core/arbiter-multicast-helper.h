@@ -8,15 +8,36 @@
 #include "ns3/arbiter-multicast.h"
 #include "ns3/arbiter-ecmp-helper.h"
 #include "ns3/multicast-udp-schedule-reader.h"
+#include "ns3/multicast-tree-builder.h"
+#include "ns3/bier-header.h"
 
 namespace ns3 {
     class Ipv4MulticastRoutingTableEntry;
     class ArbiterEcmpHelper;
 
+    /**
+     * Installed tree of a multicast group, kept such that membership changes
+     * can be applied to it incrementally (graft and prune).
+     */
+    struct MulticastGroupTreeState {
+        Ipv4Address origin;
+        Ipv4Address group;
+        int64_t src_node_id;
+        std::set<int64_t> members;
+        std::map<int64_t, std::set<int64_t>> node_to_children;
+        std::map<int64_t, std::set<int64_t>> node_to_parents;   //!< Can be more than one for the ECMP union
+        std::map<int64_t, int64_t> node_to_parent;              //!< The one parent of which packets pass the input interface (RPF) check
+    };
+
     class ArbiterMulticastHelper : public ArbiterEcmpHelper
     {
     public:
         ArbiterMulticastHelper(Ptr<BasicSimulation> basicSimulation, Ptr<TopologyPtop> topology, const std::vector<MulticastUdpInfo> &multicast_reqs);
+        void Graft(int64_t udp_burst_id, int64_t node_id);
+        void Prune(int64_t udp_burst_id, int64_t node_id);
+        const MulticastGroupTreeState& GetGroupTreeState(int64_t udp_burst_id);
+        int64_t GetNumMembershipLinksChanged();
+        const std::vector<std::vector<std::vector<uint32_t>>>& GetGlobalEcmpState();
     private:
         // Parameters
         Ptr<BasicSimulation> m_basicSimulation;
@@ -26,12 +47,23 @@ namespace ns3 {
         int64_t m_dynamicStateUpdateIntervalNs;
         std::vector<Ptr<ArbiterMulticast>> m_arbiters;
         std::vector<std::vector<uint32_t>> m_node_to_nbr_if_idx;
+        std::vector<std::vector<std::vector<uint32_t>>> m_global_ecmp_state;
+        std::vector<MulticastGroupTreeState> m_group_tree_states;   //!< Index is the multicast UDP ID
+        int64_t m_num_membership_links_changed;
 
         void testMulticast(Ptr<TopologyPtop> topology, Ptr<ArbiterMulticast> arbiterMulticast, uint32_t node_id);
         //read multicast state from file
         void ReadGlobalMulticastState();
         //cal multicast state based on multicast_reqs and unicast state
         void CalGlobalMulticastState(std::vector<std::vector<std::vector<uint32_t>>> &global_ecmp_state);
+        //cal stateless (BIER) forwarding bit masks based on unicast state only
+        void CalGlobalBierState(std::vector<std::vector<std::vector<uint32_t>>> &global_ecmp_state);
+        //aggregate group ranges and write the size of the multicast state of every node
+        void AggregateMulticastState();
+        //schedule the joins and leaves of the multicast schedule as graft and prune
+        void ScheduleMembershipEvents();
+        void ApplyMembershipEvent(int64_t udp_burst_id, int64_t node_id, bool is_join);
+        void AddTreeLink(MulticastGroupTreeState& state, int64_t from_node_id, int64_t to_node_id);
     };
 
 } // namespace ns3
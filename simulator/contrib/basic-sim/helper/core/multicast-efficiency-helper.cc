@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multicast-efficiency-helper.h"
+
+namespace ns3 {
+
+    MulticastEfficiencyHelper::MulticastEfficiencyHelper(Ptr<BasicSimulation> basicSimulation, Ptr<TopologyPtop> topology, ArbiterMulticastHelper& arbiterHelper)
+            : m_global_ecmp_state(arbiterHelper.GetGlobalEcmpState()) {
+        std::cout << "MULTICAST EFFICIENCY ACCOUNTING" << std::endl;
+
+        // Save for writing results later after simulation is done
+        m_basicSimulation = basicSimulation;
+        m_topology = topology;
+
+        // Check if it is enabled explicitly
+        m_enabled = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("enable_multicast_efficiency_accounting", "false"));
+        if (!m_enabled) {
+            std::cout << "  > Not enabled explicitly, so disabled" << std::endl;
+
+        } else {
+            std::cout << "  > Enabled for all nodes" << std::endl;
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Setup multicast efficiency");
+
+            // The unicast equivalent of a link needs the deliveries at all the nodes
+            if (m_basicSimulation->IsDistributedEnabled()) {
+                throw std::invalid_argument("Multicast efficiency accounting is not supported in a distributed run");
+            }
+
+            // Written next to the multicast UDP logs
+            m_filename_efficiency_csv = m_basicSimulation->GetLogsDir() + "/multicast_efficiency.csv";
+            remove_file_if_exists(m_filename_efficiency_csv);
+            std::cout << "  > Efficiency file................ " << m_filename_efficiency_csv << std::endl;
+
+            // One counter shared by all the nodes
+            m_counter = CreateObject<MulticastReplicationCounter>(m_topology->GetNumNodes());
+            const NodeContainer& nodes = m_topology->GetNodes();
+            for (uint32_t i = 0; i < nodes.GetN(); i++) {
+                nodes.Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->SetMulticastReplicationCounter(m_counter);
+            }
+            m_basicSimulation->RegisterTimestamp("Install multicast replication counters");
+
+        }
+
+        std::cout << std::endl;
+    }
+
+    void MulticastEfficiencyHelper::WriteResults(MulticastUdpScheduler& multicastUdpScheduler) {
+        std::cout << "MULTICAST EFFICIENCY RESULTS" << std::endl;
+
+        // Check if it is enabled explicitly
+        if (!m_enabled) {
+            std::cout << "  > Not enabled, so no results are written" << std::endl;
+
+        } else {
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Write multicast efficiency results");
+
+            // Neighbor at the other end of each interface
+            std::vector<std::map<uint32_t, int64_t>> node_if_to_nbr(m_topology->GetNumNodes());
+            const std::vector<std::pair<int64_t, int64_t>>& edges = m_topology->GetUndirectedEdges();
+            const std::vector<std::pair<uint32_t, uint32_t>>& if_idxs = m_topology->GetInterfaceIdxsForEdges();
+            for (size_t i = 0; i < edges.size(); i++) {
+                node_if_to_nbr[edges[i].first][if_idxs[i].first] = edges[i].second;
+                node_if_to_nbr[edges[i].second][if_idxs[i].second] = edges[i].first;
+            }
+
+            // Multicast group to burst
+            std::map<uint32_t, int64_t> group_to_udp_burst_id;
+            const std::vector<MulticastUdpInfo>& schedule = multicastUdpScheduler.GetMulticastReqs();
+            for (const MulticastUdpInfo& info : schedule) {
+                group_to_udp_burst_id[info.GetMulticastGroup().Get()] = info.GetUdpBurstId();
+            }
+
+            // Bytes actually replicated, per directed link and per burst
+            std::map<std::pair<int64_t, int64_t>, uint64_t> link_multicast_bytes;
+            std::vector<uint64_t> burst_multicast_bytes(schedule.size(), 0);
+            for (int64_t node_id = 0; node_id < m_topology->GetNumNodes(); node_id++) {
+                for (const std::pair<const uint64_t, MulticastReplicationCount>& entry : m_counter->GetCountsOfNode(node_id)) {
+                    int64_t nbr = node_if_to_nbr[node_id].at(MulticastReplicationCounter::GetOutIfIdxOfKey(entry.first));
+                    link_multicast_bytes[std::make_pair(node_id, nbr)] += entry.second.num_bytes;
+                    auto it = group_to_udp_burst_id.find(MulticastReplicationCounter::GetGroupOfKey(entry.first));
+                    if (it != group_to_udp_burst_id.end()) {
+                        burst_multicast_bytes[it->second] += entry.second.num_bytes;
+                    }
+                }
+            }
+
+            // Unicast equivalent: every packet delivered would have crossed the links of the ECMP path on its own
+            uint32_t complete_packet_size = 1500;
+            std::map<std::pair<int64_t, int64_t>, uint64_t> link_unicast_bytes;
+            std::vector<uint64_t> burst_unicast_bytes(schedule.size(), 0);
+            std::vector<uint64_t> burst_num_delivered(schedule.size(), 0);
+            for (const std::pair<MulticastUdpInfo, Ptr<MulticastUdpApplication>>& p : multicastUdpScheduler.GetResponsibleForIncomingMulticasts()) {
+                int64_t udp_burst_id = p.first.GetUdpBurstId();
+                uint64_t received_counter = p.second->GetReceivedCounterOf(udp_burst_id);
+                uint64_t received_bytes = received_counter * complete_packet_size;
+                burst_num_delivered[udp_burst_id] += received_counter;
+                int64_t dst_node_id = p.second->GetNode()->GetId();
+                int64_t cur_node_id = p.first.GetFromNodeId();
+                while (cur_node_id != dst_node_id && received_bytes > 0) {
+                    if (m_global_ecmp_state[cur_node_id][dst_node_id].empty()) {
+                        throw std::runtime_error(format_string("Node %" PRId64 " is not reachable from node %" PRId64, dst_node_id, p.first.GetFromNodeId()));
+                    }
+                    int64_t nxt_node_id = m_global_ecmp_state[cur_node_id][dst_node_id][0]; // Select the first ECMP candidate
+                    link_unicast_bytes[std::make_pair(cur_node_id, nxt_node_id)] += received_bytes;
+                    burst_unicast_bytes[udp_burst_id] += received_bytes;
+                    cur_node_id = nxt_node_id;
+                }
+            }
+
+            // Write to file
+            FILE* file_csv = fopen(m_filename_efficiency_csv.c_str(), "w+");
+            uint64_t total_multicast_bytes = 0;
+            uint64_t total_unicast_bytes = 0;
+            for (const MulticastUdpInfo& info : schedule) {
+                int64_t id = info.GetUdpBurstId();
+                fprintf(
+                        file_csv, "group,%" PRId64 ",%" PRId64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRId64 ",%f\n",
+                        id, info.GetFromNodeId(), burst_num_delivered[id], burst_multicast_bytes[id], burst_unicast_bytes[id],
+                        (int64_t) burst_unicast_bytes[id] - (int64_t) burst_multicast_bytes[id],
+                        burst_unicast_bytes[id] == 0 ? 0.0 : 1.0 - (double) burst_multicast_bytes[id] / (double) burst_unicast_bytes[id]
+                );
+                total_multicast_bytes += burst_multicast_bytes[id];
+                total_unicast_bytes += burst_unicast_bytes[id];
+            }
+            for (const std::pair<int64_t, int64_t>& edge : edges) {
+                for (const std::pair<int64_t, int64_t>& link : {edge, std::make_pair(edge.second, edge.first)}) {
+                    uint64_t multicast_bytes = link_multicast_bytes[link];
+                    uint64_t unicast_bytes = link_unicast_bytes[link];
+                    fprintf(
+                            file_csv, "link,%" PRId64 ",%" PRId64 ",%" PRIu64 ",%" PRIu64 ",%" PRId64 ",%f\n",
+                            link.first, link.second, multicast_bytes, unicast_bytes,
+                            (int64_t) unicast_bytes - (int64_t) multicast_bytes,
+                            unicast_bytes == 0 ? 0.0 : 1.0 - (double) multicast_bytes / (double) unicast_bytes
+                    );
+                }
+            }
+            fclose(file_csv);
+
+            std::cout << "  > Multicast bytes on links....... " << total_multicast_bytes << std::endl;
+            std::cout << "  > Unicast equivalent bytes....... " << total_unicast_bytes << std::endl;
+            std::cout << "  > Written to: " << m_filename_efficiency_csv << std::endl;
+            m_basicSimulation->RegisterTimestamp("Write multicast efficiency");
+
+        }
+
+        std::cout << std::endl;
+    }
+
+}
@@ -0,0 +1,57 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTICAST_EFFICIENCY_HELPER_H
+#define MULTICAST_EFFICIENCY_HELPER_H
+
+#include "ns3/basic-simulation.h"
+#include "ns3/topology-ptop.h"
+#include "ns3/multicast-replication-counter.h"
+#include "ns3/ipv4-arbiter-routing.h"
+#include "ns3/arbiter-multicast-helper.h"
+#include "ns3/multicast-udp-scheduler.h"
+
+namespace ns3 {
+
+    /**
+     * Compares the bytes the multicast bursts actually put onto each link with
+     * the bytes the same deliveries would have taken as separate unicast UDP
+     * bursts from the source to each destination over the ECMP paths (first
+     * candidate, like the multicast trees).
+     *
+     * The global ECMP state is held by reference, so the arbiter helper must
+     * outlive this helper.
+     */
+    class MulticastEfficiencyHelper
+    {
+
+    public:
+        MulticastEfficiencyHelper(Ptr<BasicSimulation> basicSimulation, Ptr<TopologyPtop> topology, ArbiterMulticastHelper& arbiterHelper);
+        void WriteResults(MulticastUdpScheduler& multicastUdpScheduler);
+
+    private:
+        Ptr<BasicSimulation> m_basicSimulation;
+        Ptr<TopologyPtop> m_topology;
+        const std::vector<std::vector<std::vector<uint32_t>>>& m_global_ecmp_state;
+        Ptr<MulticastReplicationCounter> m_counter;
+        bool m_enabled;
+        std::string m_filename_efficiency_csv;
+
+    };
+
+} // namespace ns3
+
+#endif /* MULTICAST_EFFICIENCY_HELPER_H */
@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multicast-trace-helper.h"
+
+namespace ns3 {
+
+    MulticastTraceHelper::MulticastTraceHelper(Ptr<BasicSimulation> basicSimulation, Ptr<Topology> topology) {
+        std::cout << "MULTICAST FORWARDING TRACE" << std::endl;
+
+        // Save for writing results later after simulation is done
+        m_basicSimulation = basicSimulation;
+        m_topology = topology;
+
+        // Check if it is enabled explicitly
+        m_enabled = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("enable_multicast_trace", "false"));
+        if (!m_enabled) {
+            std::cout << "  > Not enabled explicitly, so disabled" << std::endl;
+
+        } else {
+            std::cout << "  > Enabled for all nodes" << std::endl;
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Setup multicast trace");
+
+            // Distributed information
+            uint32_t system_id = m_basicSimulation->GetSystemId();
+            bool enable_distributed = m_basicSimulation->IsDistributedEnabled();
+            std::vector<int64_t> distributed_node_system_id_assignment = m_basicSimulation->GetDistributedNodeSystemIdAssignment();
+
+            // Ring capacity in records (each record is 32 bytes)
+            int64_t ring_capacity = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault("multicast_trace_ring_capacity", "1048576"));
+            if (ring_capacity > 0x80000000LL) {
+                throw std::invalid_argument("multicast_trace_ring_capacity cannot exceed 2^31 records");
+            }
+            std::cout << "  > Ring capacity.................. " << ring_capacity << " records" << std::endl;
+
+            // Determine filename
+            if (enable_distributed) {
+                m_filename_trace_bin = m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(system_id) + "_multicast_trace.bin";
+            } else {
+                m_filename_trace_bin = m_basicSimulation->GetLogsDir() + "/multicast_trace.bin";
+            }
+            remove_file_if_exists(m_filename_trace_bin);
+            std::cout << "  > Trace file..................... " << m_filename_trace_bin << std::endl;
+
+            // One trace shared by all the nodes of this system
+            m_trace = CreateObject<MulticastTrace>(m_filename_trace_bin, (uint32_t) ring_capacity);
+            const NodeContainer& nodes = m_topology->GetNodes();
+            for (uint32_t i = 0; i < nodes.GetN(); i++) {
+                if (!enable_distributed || distributed_node_system_id_assignment[i] == system_id) {
+                    nodes.Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->SetMulticastTrace(m_trace);
+                }
+            }
+            m_basicSimulation->RegisterTimestamp("Install multicast trace");
+
+        }
+
+        std::cout << std::endl;
+    }
+
+    void MulticastTraceHelper::WriteResults() {
+        std::cout << "MULTICAST FORWARDING TRACE RESULTS" << std::endl;
+
+        // Check if it is enabled explicitly
+        if (!m_enabled) {
+            std::cout << "  > Not enabled, so no results are written" << std::endl;
+
+        } else {
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Write multicast trace results");
+
+            // Stop the writer and flush whatever is still in the ring
+            m_trace->Close();
+            std::cout << "  > Records recorded............. " << m_trace->GetNumRecorded() << std::endl;
+            std::cout << "  > Records written.............. " << m_trace->GetNumWritten() << std::endl;
+            std::cout << "  > Records dropped (ring full).. " << m_trace->GetNumDropped() << std::endl;
+            std::cout << "  > Written to: " << m_filename_trace_bin << std::endl;
+            m_basicSimulation->RegisterTimestamp("Write multicast trace");
+
+        }
+
+        std::cout << std::endl;
+    }
+
+}
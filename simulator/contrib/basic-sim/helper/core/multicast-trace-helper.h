@@ -0,0 +1,45 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTICAST_TRACE_HELPER_H
+#define MULTICAST_TRACE_HELPER_H
+
+#include "ns3/basic-simulation.h"
+#include "ns3/topology.h"
+#include "ns3/multicast-trace.h"
+#include "ns3/ipv4-arbiter-routing.h"
+
+namespace ns3 {
+
+    class MulticastTraceHelper
+    {
+
+    public:
+        MulticastTraceHelper(Ptr<BasicSimulation> basicSimulation, Ptr<Topology> topology);
+        void WriteResults();
+
+    private:
+        Ptr<BasicSimulation> m_basicSimulation;
+        Ptr<Topology> m_topology;
+        Ptr<MulticastTrace> m_trace;
+        bool m_enabled;
+        std::string m_filename_trace_bin;
+
+    };
+
+} // namespace ns3
+
+#endif /* MULTICAST_TRACE_HELPER_H */
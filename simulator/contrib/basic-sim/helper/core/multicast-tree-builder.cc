@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "multicast-tree-builder.h"
+
+namespace ns3 {
+
+int64_t MulticastTree::GetNumLinks() const {
+    int64_t num_links = 0;
+    for (const std::pair<const int64_t, std::set<int64_t>>& entry : node_to_children) {
+        num_links += entry.second.size();
+    }
+    return num_links;
+}
+
+NS_OBJECT_ENSURE_REGISTERED (MulticastTreeBuilder);
+TypeId MulticastTreeBuilder::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::MulticastTreeBuilder")
+            .SetParent<Object> ()
+            .SetGroupName("BasicSim")
+    ;
+    return tid;
+}
+
+/**
+ * Weight of the directed link a -> b.
+ */
+static double GetLinkWeight(const WeightedAdjacencyList& adjacency, int64_t a, int64_t b) {
+    for (const std::pair<int64_t, double>& nbr : adjacency[a]) {
+        if (nbr.first == b) {
+            return nbr.second;
+        }
+    }
+    throw std::runtime_error(format_string("There is no link from node %" PRId64 " to node %" PRId64, a, b));
+}
+
+/**
+ * Dijkstra from a set of source nodes (all at distance 0).
+ *
+ * @param adjacency     Weighted adjacency list
+ * @param sources       Source nodes
+ * @param dist          (Output) Distance to the closest source (infinity if unreachable)
+ * @param parent        (Output) Previous node on the shortest path (-1 for the sources and unreachable nodes)
+ */
+static void MultiSourceDijkstra(const WeightedAdjacencyList& adjacency, const std::vector<int64_t>& sources, std::vector<double>& dist, std::vector<int64_t>& parent) {
+    dist.assign(adjacency.size(), std::numeric_limits<double>::infinity());
+    parent.assign(adjacency.size(), -1);
+    std::priority_queue<std::pair<double, int64_t>, std::vector<std::pair<double, int64_t>>, std::greater<std::pair<double, int64_t>>> queue;
+    for (int64_t s : sources) {
+        dist[s] = 0;
+        queue.push(std::make_pair(0.0, s));
+    }
+    while (!queue.empty()) {
+        std::pair<double, int64_t> top = queue.top();
+        queue.pop();
+        if (top.first > dist[top.second]) {
+            continue; // Stale entry
+        }
+        for (const std::pair<int64_t, double>& nbr : adjacency[top.second]) {
+            double d = top.first + nbr.second;
+            if (d < dist[nbr.first]) {
+                dist[nbr.first] = d;
+                parent[nbr.first] = top.second;
+                queue.push(std::make_pair(d, nbr.first));
+            }
+        }
+    }
+}
+
+/**
+ * Walk back from the node along the parent pointers until a node already in the tree,
+ * and add the links of that path to the tree.
+ */
+static void AttachPath(const WeightedAdjacencyList& adjacency, const std::vector<int64_t>& parent, int64_t node_id, std::vector<bool>& in_tree, std::vector<int64_t>& tree_nodes, MulticastTree& tree) {
+    int64_t cur = node_id;
+    while (!in_tree[cur]) {
+        int64_t prev = parent[cur];
+        tree.node_to_children[prev].insert(cur);
+        tree.cost += GetLinkWeight(adjacency, prev, cur);
+        in_tree[cur] = true;
+        tree_nodes.push_back(cur);
+        cur = prev;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+NS_OBJECT_ENSURE_REGISTERED (MulticastTreeBuilderEcmpUnion);
+TypeId MulticastTreeBuilderEcmpUnion::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::MulticastTreeBuilderEcmpUnion")
+            .SetParent<MulticastTreeBuilder> ()
+            .SetGroupName("BasicSim")
+    ;
+    return tid;
+}
+
+MulticastTreeBuilderEcmpUnion::MulticastTreeBuilderEcmpUnion(const std::vector<std::vector<std::vector<uint32_t>>>& global_ecmp_state)
+        : m_global_ecmp_state(global_ecmp_state) {
+    // Left empty intentionally
+}
+
+std::string MulticastTreeBuilderEcmpUnion::GetName() {
+    return "ecmp_union";
+}
+
+MulticastTree MulticastTreeBuilderEcmpUnion::BuildTree(const WeightedAdjacencyList& adjacency, int64_t src_node_id, const std::set<int64_t>& dst_node_ids) {
+    MulticastTree tree;
+    tree.src_node_id = src_node_id;
+    tree.cost = 0;
+    for (int64_t dst_id : dst_node_ids) {
+        int64_t cur_node_id = src_node_id;
+        while (cur_node_id != dst_id) {
+            if (m_global_ecmp_state[cur_node_id][dst_id].empty()) {
+                throw std::runtime_error(format_string("Node %" PRId64 " is not reachable from node %" PRId64, dst_id, src_node_id));
+            }
+            int64_t nxt_node_id = m_global_ecmp_state[cur_node_id][dst_id][0]; // Select the first ECMP candidate
+            if (tree.node_to_children[cur_node_id].insert(nxt_node_id).second) {
+                tree.cost += GetLinkWeight(adjacency, cur_node_id, nxt_node_id);
+            }
+            cur_node_id = nxt_node_id;
+        }
+    }
+    return tree;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+NS_OBJECT_ENSURE_REGISTERED (MulticastTreeBuilderSpt);
+TypeId MulticastTreeBuilderSpt::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::MulticastTreeBuilderSpt")
+            .SetParent<MulticastTreeBuilder> ()
+            .SetGroupName("BasicSim")
+    ;
+    return tid;
+}
+
+std::string MulticastTreeBuilderSpt::GetName() {
+    return "spt";
+}
+
+MulticastTree MulticastTreeBuilderSpt::BuildTree(const WeightedAdjacencyList& adjacency, int64_t src_node_id, const std::set<int64_t>& dst_node_ids) {
+    MulticastTree tree;
+    tree.src_node_id = src_node_id;
+    tree.cost = 0;
+
+    // Single shortest-path tree rooted at the source
+    std::vector<double> dist;
+    std::vector<int64_t> parent;
+    MultiSourceDijkstra(adjacency, {src_node_id}, dist, parent);
+
+    // Keep only the branches which lead to a destination
+    std::vector<bool> in_tree(adjacency.size(), false);
+    std::vector<int64_t> tree_nodes = {src_node_id};
+    in_tree[src_node_id] = true;
+    for (int64_t dst_id : dst_node_ids) {
+        if (dist[dst_id] == std::numeric_limits<double>::infinity()) {
+            throw std::runtime_error(format_string("Node %" PRId64 " is not reachable from node %" PRId64, dst_id, src_node_id));
+        }
+        AttachPath(adjacency, parent, dst_id, in_tree, tree_nodes, tree);
+    }
+    return tree;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+NS_OBJECT_ENSURE_REGISTERED (MulticastTreeBuilderSteiner);
+TypeId MulticastTreeBuilderSteiner::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::MulticastTreeBuilderSteiner")
+            .SetParent<MulticastTreeBuilder> ()
+            .SetGroupName("BasicSim")
+    ;
+    return tid;
+}
+
+std::string MulticastTreeBuilderSteiner::GetName() {
+    return "steiner_tm";
+}
+
+MulticastTree MulticastTreeBuilderSteiner::BuildTree(const WeightedAdjacencyList& adjacency, int64_t src_node_id, const std::set<int64_t>& dst_node_ids) {
+    MulticastTree tree;
+    tree.src_node_id = src_node_id;
+    tree.cost = 0;
+
+    std::vector<bool> in_tree(adjacency.size(), false);
+    std::vector<int64_t> tree_nodes = {src_node_id};
+    in_tree[src_node_id] = true;
+    std::set<int64_t> remaining(dst_node_ids);
+    remaining.erase(src_node_id);
+
+    std::vector<double> dist;
+    std::vector<int64_t> parent;
+    while (!remaining.empty()) {
+
+        // Distance of every node to the current tree
+        MultiSourceDijkstra(adjacency, tree_nodes, dist, parent);
+
+        // Closest destination not yet in the tree (lowest node id on a tie)
+        int64_t closest = -1;
+        for (int64_t dst_id : remaining) {
+            if (closest == -1 || dist[dst_id] < dist[closest]) {
+                closest = dst_id;
+            }
+        }
+        if (dist[closest] == std::numeric_limits<double>::infinity()) {
+            throw std::runtime_error(format_string("Node %" PRId64 " is not reachable from node %" PRId64, closest, src_node_id));
+        }
+
+        // Attach it, which can attach other destinations on the way as well
+        AttachPath(adjacency, parent, closest, in_tree, tree_nodes, tree);
+        for (auto it = remaining.begin(); it != remaining.end(); ) {
+            it = in_tree[*it] ? remaining.erase(it) : std::next(it);
+        }
+
+    }
+    return tree;
+}
+
+}
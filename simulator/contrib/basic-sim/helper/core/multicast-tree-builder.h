@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef MULTICAST_TREE_BUILDER_H
+#define MULTICAST_TREE_BUILDER_H
+
+#include <vector>
+#include <set>
+#include <map>
+#include <queue>
+#include <tuple>
+#include <limits>
+#include "ns3/core-module.h"
+#include "ns3/exp-util.h"
+
+namespace ns3 {
+
+// adjacency[a] = [(b, weight of link a -> b), ...], sorted ascending by b
+typedef std::vector<std::vector<std::pair<int64_t, double>>> WeightedAdjacencyList;
+
+/**
+ * Multicast distribution tree. The links are directed away from the source.
+ */
+struct MulticastTree {
+    int64_t src_node_id;
+    std::map<int64_t, std::set<int64_t>> node_to_children;  //!< Only nodes which forward to at least one child
+    double cost;                                            //!< Sum of the weights of all links in the tree
+    int64_t GetNumLinks() const;
+};
+
+/**
+ * Strategy to construct the multicast tree of a request from the weighted topology graph.
+ */
+class MulticastTreeBuilder : public Object {
+public:
+    static TypeId GetTypeId(void);
+    virtual std::string GetName() = 0;
+    virtual MulticastTree BuildTree(const WeightedAdjacencyList& adjacency, int64_t src_node_id, const std::set<int64_t>& dst_node_ids) = 0;
+};
+
+/**
+ * Union of the unicast paths towards each destination, each time taking the
+ * first ECMP candidate. This ignores the link weights, and the result is not
+ * necessarily a tree (a node can be reached via two parents).
+ *
+ * The global ECMP state is held by reference, so it must outlive the builder.
+ */
+class MulticastTreeBuilderEcmpUnion : public MulticastTreeBuilder {
+public:
+    static TypeId GetTypeId(void);
+    MulticastTreeBuilderEcmpUnion(const std::vector<std::vector<std::vector<uint32_t>>>& global_ecmp_state);
+    std::string GetName();
+    MulticastTree BuildTree(const WeightedAdjacencyList& adjacency, int64_t src_node_id, const std::set<int64_t>& dst_node_ids);
+private:
+    const std::vector<std::vector<std::vector<uint32_t>>>& m_global_ecmp_state;
+};
+
+/**
+ * Shortest-path tree: the union of the paths in a single Dijkstra tree rooted
+ * at the source (ties are broken towards the lowest node id).
+ */
+class MulticastTreeBuilderSpt : public MulticastTreeBuilder {
+public:
+    static TypeId GetTypeId(void);
+    std::string GetName();
+    MulticastTree BuildTree(const WeightedAdjacencyList& adjacency, int64_t src_node_id, const std::set<int64_t>& dst_node_ids);
+};
+
+/**
+ * Steiner tree heuristic of Takahashi and Matsuyama: starting from the source,
+ * repeatedly attach the destination closest to the current tree via its
+ * shortest path to the tree. Its cost is at most 2x the optimal Steiner tree.
+ */
+class MulticastTreeBuilderSteiner : public MulticastTreeBuilder {
+public:
+    static TypeId GetTypeId(void);
+    std::string GetName();
+    MulticastTree BuildTree(const WeightedAdjacencyList& adjacency, int64_t src_node_id, const std::set<int64_t>& dst_node_ids);
+};
+
+}
+
+#endif //MULTICAST_TREE_BUILDER_H
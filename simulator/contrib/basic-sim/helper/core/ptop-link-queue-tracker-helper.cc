@@ -36,6 +36,7 @@ namespace ns3 {
 
         } else {
             std::cout << "  > Enabled for all point-to-point links (net-devices) in the topology" << std::endl;
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Setup link queue tracking");
 
             // Distributed information
             m_system_id = m_basicSimulation->GetSystemId();
@@ -95,6 +96,7 @@ namespace ns3 {
             std::cout << "  > Not enabled, so no results are written" << std::endl;
 
         } else {
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Write link queue tracking results");
 
             // Open CSV files
             std::cout << "  > Opening link (net-device) queue log files:" << std::endl;
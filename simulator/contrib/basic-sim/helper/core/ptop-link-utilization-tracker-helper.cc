@@ -36,6 +36,7 @@ namespace ns3 {
 
         } else {
             std::cout << "  > Enabled for all point-to-point links in the topology" << std::endl;
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Setup link utilization tracking");
 
             // Distributed information
             m_system_id = m_basicSimulation->GetSystemId();
@@ -105,6 +106,7 @@ namespace ns3 {
             std::cout << "  > Not enabled, so no results are written" << std::endl;
 
         } else {
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Write link utilization tracking results");
 
             // Open CSV file
             std::cout << "  > Opening utilization log files:" << std::endl;
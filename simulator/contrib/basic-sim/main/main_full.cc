@@ -14,6 +14,7 @@
 #include "ns3/tcp-flow-scheduler.h"
 #include "ns3/udp-burst-scheduler.h"
 #include "ns3/pingmesh-scheduler.h"
+#include "ns3/trace-replay-scheduler.h"
 #include "ns3/topology-ptop.h"
 #include "ns3/tcp-optimizer.h"
 #include "ns3/arbiter-ecmp-helper.h"
@@ -64,6 +65,9 @@ int main(int argc, char *argv[]) {
     // Schedule pings
     PingmeshScheduler pingmeshScheduler(basicSimulation, topology); // Requires enable_pingmesh_scheduler=true
 
+    // Replay packet trace
+    TraceReplayScheduler traceReplayScheduler(basicSimulation, topology); // Requires enable_trace_replay_scheduler=true
+
     // Run simulation
     basicSimulation->Run();
 
@@ -76,6 +80,9 @@ int main(int argc, char *argv[]) {
     // Write pingmesh results
     pingmeshScheduler.WriteResults();
 
+    // Write trace replay results
+    traceReplayScheduler.WriteResults();
+
     // Write link utilization results
     linkUtilizationTrackerHelper.WriteResults();
 
@@ -45,7 +45,8 @@ IdSeqHeader::GetTypeId (void)
 
 IdSeqHeader::IdSeqHeader ()
   : m_id (0),
-    m_seq (0)
+    m_seq (0),
+    m_ts (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -78,6 +79,20 @@ IdSeqHeader::GetSeq (void) const
   return m_seq;
 }
 
+void
+IdSeqHeader::SetTs (int64_t ts)
+{
+  NS_LOG_FUNCTION (this << ts);
+  m_ts = ts;
+}
+
+int64_t
+IdSeqHeader::GetTs (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_ts;
+}
+
 TypeId
 IdSeqHeader::GetInstanceTypeId (void) const
 {
@@ -88,14 +103,14 @@ void
 IdSeqHeader::Print (std::ostream &os) const
 {
   NS_LOG_FUNCTION (this << &os);
-  os << "(id=" << m_id << ", seq=" << m_seq << ")";
+  os << "(id=" << m_id << ", seq=" << m_seq << ", ts=" << m_ts << ")";
 }
 
 uint32_t
 IdSeqHeader::GetSerializedSize (void) const
 {
   NS_LOG_FUNCTION (this);
-  return 8+8;
+  return 8+8+8;
 }
 
 void
@@ -105,6 +120,7 @@ IdSeqHeader::Serialize (Buffer::Iterator start) const
   Buffer::Iterator i = start;
   i.WriteHtonU64 (m_id);
   i.WriteHtonU64 (m_seq);
+  i.WriteHtonU64 ((uint64_t) m_ts);
 }
 
 uint32_t
@@ -114,6 +130,7 @@ IdSeqHeader::Deserialize (Buffer::Iterator start)
   Buffer::Iterator i = start;
   m_id = i.ReadNtohU64 ();
   m_seq = i.ReadNtohU64 ();
+  m_ts = (int64_t) i.ReadNtohU64 ();
   return GetSerializedSize ();
 }
 
@@ -35,8 +35,10 @@ public:
   IdSeqHeader ();
   void SetId (uint64_t id);
   void SetSeq (uint64_t seq);
+  void SetTs (int64_t ts);
   uint64_t GetId (void) const;
   uint64_t GetSeq (void) const;
+  int64_t GetTs (void) const;
 
   virtual TypeId GetInstanceTypeId (void) const;
   virtual void Print (std::ostream &os) const;
@@ -47,6 +49,7 @@ public:
 private:
   uint64_t m_id;  //!< Identifier of what these sequences belong to
   uint64_t m_seq; //!< Sequence number
+  int64_t m_ts;   //!< Time it was sent (ns)
 };
 
 } // namespace ns3
@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/header.h"
+#include "multicast-fec-header.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MulticastFecHeader");
+
+NS_OBJECT_ENSURE_REGISTERED (MulticastFecHeader);
+
+TypeId
+MulticastFecHeader::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MulticastFecHeader")
+          .SetParent<Header> ()
+          .SetGroupName("BasicSim")
+          .AddConstructor<MulticastFecHeader> ()
+  ;
+  return tid;
+}
+
+MulticastFecHeader::MulticastFecHeader ()
+  : m_block (0),
+    m_index (0),
+    m_block_size (0),
+    m_num_repair (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MulticastFecHeader::SetBlock (uint64_t block)
+{
+  m_block = block;
+}
+
+void
+MulticastFecHeader::SetIndex (uint16_t index)
+{
+  m_index = index;
+}
+
+void
+MulticastFecHeader::SetBlockSize (uint16_t block_size)
+{
+  m_block_size = block_size;
+}
+
+void
+MulticastFecHeader::SetNumRepair (uint16_t num_repair)
+{
+  m_num_repair = num_repair;
+}
+
+uint64_t
+MulticastFecHeader::GetBlock (void) const
+{
+  return m_block;
+}
+
+uint16_t
+MulticastFecHeader::GetIndex (void) const
+{
+  return m_index;
+}
+
+uint16_t
+MulticastFecHeader::GetBlockSize (void) const
+{
+  return m_block_size;
+}
+
+uint16_t
+MulticastFecHeader::GetNumRepair (void) const
+{
+  return m_num_repair;
+}
+
+bool
+MulticastFecHeader::IsRepair (void) const
+{
+  return m_index >= m_block_size;
+}
+
+TypeId
+MulticastFecHeader::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+void
+MulticastFecHeader::Print (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this << &os);
+  os << "(block=" << m_block << ", index=" << m_index << ", n=" << m_block_size << ", k=" << m_num_repair << ")";
+}
+
+uint32_t
+MulticastFecHeader::GetSerializedSize (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return 8+2+2+2;
+}
+
+void
+MulticastFecHeader::Serialize (Buffer::Iterator start) const
+{
+  NS_LOG_FUNCTION (this << &start);
+  Buffer::Iterator i = start;
+  i.WriteHtonU64 (m_block);
+  i.WriteHtonU16 (m_index);
+  i.WriteHtonU16 (m_block_size);
+  i.WriteHtonU16 (m_num_repair);
+}
+
+uint32_t
+MulticastFecHeader::Deserialize (Buffer::Iterator start)
+{
+  NS_LOG_FUNCTION (this << &start);
+  Buffer::Iterator i = start;
+  m_block = i.ReadNtohU64 ();
+  m_index = i.ReadNtohU16 ();
+  m_block_size = i.ReadNtohU16 ();
+  m_num_repair = i.ReadNtohU16 ();
+  return GetSerializedSize ();
+}
+
+uint64_t
+multicast_fec_xor_recover(uint64_t data_received, uint64_t repair_received, uint32_t block_size, uint32_t num_repair, uint64_t data_expected)
+{
+  if (block_size < 1 || block_size > 64 || num_repair < 1 || num_repair > block_size) {
+      throw std::invalid_argument("FEC block size must be in [1, 64] and the number of repair packets in [1, block size]");
+  }
+  uint64_t recovered = 0;
+  for (uint32_t j = 0; j < num_repair; j++) {
+      if (!(repair_received & (1ULL << j))) {
+          continue;
+      }
+      uint64_t missing = 0;
+      for (uint32_t i = j; i < block_size; i += num_repair) {
+          missing |= (1ULL << i);
+      }
+      missing &= data_expected & ~data_received;
+      if (missing != 0 && (missing & (missing - 1)) == 0) { // Exactly one
+          recovered |= missing;
+      }
+  }
+  return recovered;
+}
+
+} // namespace ns3
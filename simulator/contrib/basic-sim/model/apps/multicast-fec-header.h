@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTICAST_FEC_HEADER_H
+#define MULTICAST_FEC_HEADER_H
+
+#include <stdexcept>
+
+#include "ns3/header.h"
+
+namespace ns3 {
+
+/**
+ * Forward error correction header of a multicast packet, which follows the burst identifier.
+ * The packets are sent in blocks of n data packets followed by k XOR repair packets. Repair
+ * packet j is the XOR of the data packets i of the block with i % k = j, such that any single
+ * lost data packet of each of these k parity groups can be recovered.
+ *
+ * Format: [block, uint64][index in block, uint16][n, uint16][k, uint16]
+ *         (index < n is data packet index, index >= n is repair packet index - n)
+ */
+class MulticastFecHeader : public Header
+{
+public:
+  static TypeId GetTypeId (void);
+
+  MulticastFecHeader ();
+  void SetBlock (uint64_t block);
+  void SetIndex (uint16_t index);
+  void SetBlockSize (uint16_t block_size);
+  void SetNumRepair (uint16_t num_repair);
+  uint64_t GetBlock (void) const;
+  uint16_t GetIndex (void) const;
+  uint16_t GetBlockSize (void) const;
+  uint16_t GetNumRepair (void) const;
+  bool IsRepair (void) const;
+
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual void Print (std::ostream &os) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+private:
+  uint64_t m_block;      //!< Block number
+  uint16_t m_index;      //!< Index in the block (data packets first, then the repair packets)
+  uint16_t m_block_size; //!< Number of data packets per block (n)
+  uint16_t m_num_repair; //!< Number of repair packets per block (k)
+};
+
+/**
+ * Data packets of a block which can be recovered with the XOR repair packets: those which
+ * are the only missing one of their parity group, of which the repair packet did arrive.
+ *
+ * @param data_received     Bit i set iff data packet i arrived
+ * @param repair_received   Bit j set iff repair packet j arrived
+ * @param block_size        Number of data packets per block (n, at most 64)
+ * @param num_repair        Number of repair packets per block (k, at most n)
+ * @param data_expected     Bit i set iff data packet i was sent
+ *
+ * @return Bit i set iff data packet i is recovered
+ */
+uint64_t multicast_fec_xor_recover(uint64_t data_received, uint64_t repair_received, uint32_t block_size, uint32_t num_repair, uint64_t data_expected);
+
+} // namespace ns3
+
+#endif /* MULTICAST_FEC_HEADER_H */
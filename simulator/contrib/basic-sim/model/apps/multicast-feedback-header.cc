@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/header.h"
+#include "ns3/exp-util.h"
+#include "multicast-feedback-header.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MulticastFeedbackHeader");
+
+NS_OBJECT_ENSURE_REGISTERED (MulticastFeedbackHeader);
+
+TypeId
+MulticastFeedbackHeader::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MulticastFeedbackHeader")
+          .SetParent<Header> ()
+          .SetGroupName("BasicSim")
+          .AddConstructor<MulticastFeedbackHeader> ()
+  ;
+  return tid;
+}
+
+MulticastFeedbackHeader::MulticastFeedbackHeader ()
+  : m_id (0),
+    m_receiver_node_id (0),
+    m_num_received (0),
+    m_num_expected (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MulticastFeedbackHeader::SetId (uint64_t id)
+{
+  m_id = id;
+}
+
+void
+MulticastFeedbackHeader::SetReceiverNodeId (uint64_t receiver_node_id)
+{
+  m_receiver_node_id = receiver_node_id;
+}
+
+void
+MulticastFeedbackHeader::SetNumReceived (uint64_t num_received)
+{
+  m_num_received = num_received;
+}
+
+void
+MulticastFeedbackHeader::SetNumExpected (uint64_t num_expected)
+{
+  m_num_expected = num_expected;
+}
+
+uint64_t
+MulticastFeedbackHeader::GetId (void) const
+{
+  return m_id;
+}
+
+uint64_t
+MulticastFeedbackHeader::GetReceiverNodeId (void) const
+{
+  return m_receiver_node_id;
+}
+
+uint64_t
+MulticastFeedbackHeader::GetNumReceived (void) const
+{
+  return m_num_received;
+}
+
+uint64_t
+MulticastFeedbackHeader::GetNumExpected (void) const
+{
+  return m_num_expected;
+}
+
+TypeId
+MulticastFeedbackHeader::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+void
+MulticastFeedbackHeader::Print (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this << &os);
+  os << "(id=" << m_id << ", receiver=" << m_receiver_node_id << ", received=" << m_num_received << ", expected=" << m_num_expected << ")";
+}
+
+uint32_t
+MulticastFeedbackHeader::GetSerializedSize (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return 8+8+8+8;
+}
+
+void
+MulticastFeedbackHeader::Serialize (Buffer::Iterator start) const
+{
+  NS_LOG_FUNCTION (this << &start);
+  Buffer::Iterator i = start;
+  i.WriteHtonU64 (m_id);
+  i.WriteHtonU64 (m_receiver_node_id);
+  i.WriteHtonU64 (m_num_received);
+  i.WriteHtonU64 (m_num_expected);
+}
+
+uint32_t
+MulticastFeedbackHeader::Deserialize (Buffer::Iterator start)
+{
+  NS_LOG_FUNCTION (this << &start);
+  Buffer::Iterator i = start;
+  m_id = i.ReadNtohU64 ();
+  m_receiver_node_id = i.ReadNtohU64 ();
+  m_num_received = i.ReadNtohU64 ();
+  m_num_expected = i.ReadNtohU64 ();
+  return GetSerializedSize ();
+}
+
+double
+multicast_feedback_receiver_rate(double current_rate_megabit_per_s, uint64_t num_received, uint64_t num_expected, int64_t interval_ns, double increase_megabit_per_s)
+{
+  if (interval_ns <= 0) {
+      throw std::invalid_argument("Feedback interval must be positive");
+  }
+  if (num_received >= num_expected) {
+      return current_rate_megabit_per_s + increase_megabit_per_s;
+  }
+  return 0.95 * byte_to_megabit(num_received * 1500) / nanosec_to_sec(interval_ns);
+}
+
+double
+multicast_feedback_select_rate(std::vector<double> receiver_rates, double percentile)
+{
+  if (receiver_rates.empty()) {
+      throw std::invalid_argument("There must be at least one receiver rate");
+  }
+  if (percentile < 0 || percentile > 100) {
+      throw std::invalid_argument("Percentile must be in [0, 100]");
+  }
+  std::sort(receiver_rates.begin(), receiver_rates.end());
+  return receiver_rates[(size_t) (percentile / 100.0 * (receiver_rates.size() - 1))];
+}
+
+} // namespace ns3
@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTICAST_FEEDBACK_HEADER_H
+#define MULTICAST_FEEDBACK_HEADER_H
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "ns3/header.h"
+
+namespace ns3 {
+
+/**
+ * Report of a multicast receiver to the source over unicast, covering the packets
+ * of one burst since its previous report.
+ *
+ * Format: [UDP burst id, uint64][receiver node id, uint64][packets received, uint64][packets expected, uint64]
+ */
+class MulticastFeedbackHeader : public Header
+{
+public:
+  static TypeId GetTypeId (void);
+
+  MulticastFeedbackHeader ();
+  void SetId (uint64_t id);
+  void SetReceiverNodeId (uint64_t receiver_node_id);
+  void SetNumReceived (uint64_t num_received);
+  void SetNumExpected (uint64_t num_expected);
+  uint64_t GetId (void) const;
+  uint64_t GetReceiverNodeId (void) const;
+  uint64_t GetNumReceived (void) const;
+  uint64_t GetNumExpected (void) const;
+
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual void Print (std::ostream &os) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+private:
+  uint64_t m_id;               //!< UDP burst identifier
+  uint64_t m_receiver_node_id; //!< Node identifier of the receiver
+  uint64_t m_num_received;     //!< Packets received since the previous report
+  uint64_t m_num_expected;     //!< Packets sent since the previous report (by the highest sequence number, 0 if none arrived)
+};
+
+/**
+ * Rate a receiver can sustain according to its report. If it lost packets, it is the
+ * rate at which it actually received them, lowered by 5% such that the queue which
+ * built up can drain. Without losses, the current rate is increased by a step.
+ *
+ * @param current_rate_megabit_per_s    Rate the source currently sends at
+ * @param num_received                  Packets received in the interval
+ * @param num_expected                  Packets expected in the interval
+ * @param interval_ns                   Interval between two reports (ns)
+ * @param increase_megabit_per_s        Additive increase if there were no losses
+ *
+ * @return Sustainable rate (Mbit/s)
+ */
+double multicast_feedback_receiver_rate(double current_rate_megabit_per_s, uint64_t num_received, uint64_t num_expected, int64_t interval_ns, double increase_megabit_per_s);
+
+/**
+ * Rate for the group: the percentile of the sustainable rates of the receivers,
+ * such that percentile 0 adapts to the slowest receiver.
+ *
+ * @param receiver_rates    Sustainable rate of each receiver (at least one)
+ * @param percentile        Percentile in [0, 100] (the lower value if it falls in between)
+ *
+ * @return Rate (Mbit/s)
+ */
+double multicast_feedback_select_rate(std::vector<double> receiver_rates, double percentile);
+
+} // namespace ns3
+
+#endif /* MULTICAST_FEEDBACK_HEADER_H */
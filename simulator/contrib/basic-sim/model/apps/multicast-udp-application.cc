@@ -29,6 +29,9 @@
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/integer.h"
+#include "ns3/double.h"
 
 #include "multicast-udp-application.h"
 
@@ -56,7 +59,43 @@ namespace ns3 {
                 .AddAttribute("MaxUdpPayloadSizeByte", "Total UDP payload size (byte) before it gets fragmented.",
                               UintegerValue(1472), // 1500 (point-to-point default) - 20 (IP) - 8 (UDP) = 1472
                               MakeUintegerAccessor(&MulticastUdpApplication::m_max_udp_payload_size_byte),
-                              MakeUintegerChecker<uint32_t>());
+                              MakeUintegerChecker<uint32_t>())
+                .AddAttribute("PacingBatchWindowNs", "Packets of a burst departing within this window (ns) are sent out in a single event (0: one event per packet).",
+                              IntegerValue(0),
+                              MakeIntegerAccessor(&MulticastUdpApplication::m_pacing_batch_window_ns),
+                              MakeIntegerChecker<int64_t>(0))
+                .AddAttribute("EnableBier", "True iff every packet carries a BIER header with the bit string of the destinations.",
+                              BooleanValue(false),
+                              MakeBooleanAccessor(&MulticastUdpApplication::m_enable_bier),
+                              MakeBooleanChecker())
+                .AddAttribute("EnableRateAdaptation", "True iff the receivers report their losses to the source, which adapts its rate to them.",
+                              BooleanValue(false),
+                              MakeBooleanAccessor(&MulticastUdpApplication::m_enable_rate_adaptation),
+                              MakeBooleanChecker())
+                .AddAttribute("FeedbackIntervalNs", "Interval (ns) between two feedback reports of a receiver, and between two rate adaptations of the source.",
+                              IntegerValue(10000000),
+                              MakeIntegerAccessor(&MulticastUdpApplication::m_feedback_interval_ns),
+                              MakeIntegerChecker<int64_t>(1))
+                .AddAttribute("FeedbackPercentile", "Percentile of the sustainable rates of the receivers the source sends at (0 = slowest receiver).",
+                              DoubleValue(0.0),
+                              MakeDoubleAccessor(&MulticastUdpApplication::m_feedback_percentile),
+                              MakeDoubleChecker<double>(0.0, 100.0))
+                .AddAttribute("FeedbackTimeoutIntervals", "Feedback intervals without a report after which a receiver is no longer taken into account by the source (e.g., because it left).",
+                              UintegerValue(3),
+                              MakeUintegerAccessor(&MulticastUdpApplication::m_feedback_timeout_intervals),
+                              MakeUintegerChecker<uint32_t>(1))
+                .AddAttribute("FeedbackPort", "Port on which the source listens for feedback reports.",
+                              UintegerValue(3027),
+                              MakeUintegerAccessor(&MulticastUdpApplication::m_feedback_port),
+                              MakeUintegerChecker<uint16_t>())
+                .AddAttribute("FecBlockSize", "Data packets per forward error correction block (0 to disable FEC).",
+                              UintegerValue(0),
+                              MakeUintegerAccessor(&MulticastUdpApplication::m_fec_block_size),
+                              MakeUintegerChecker<uint32_t>(0, 64))
+                .AddAttribute("FecNumRepair", "XOR repair packets per forward error correction block (at most the block size).",
+                              UintegerValue(1),
+                              MakeUintegerAccessor(&MulticastUdpApplication::m_fec_num_repair),
+                              MakeUintegerChecker<uint32_t>(1, 64));
         return tid;
     }
 
@@ -68,14 +107,19 @@ namespace ns3 {
     MulticastUdpApplication::~MulticastUdpApplication() {
         NS_LOG_FUNCTION(this);
         m_socket = 0;
+        m_feedback_socket = 0;
     }
 
     uint32_t MulticastUdpApplication::GetMaxUdpPayloadSizeByte() {
         return m_max_udp_payload_size_byte;
     }
 
+    void MulticastUdpApplication::SetPreciseLogWriter(Ptr<PreciseLogWriter> preciseLogWriter) {
+        m_precise_log_writer = preciseLogWriter;
+    }
+
     void
-    MulticastUdpApplication::RegisterOutgoingBurst(MulticastUdpInfo burstInfo, InetSocketAddress targetAddress, bool enable_precise_logging) {
+    MulticastUdpApplication::RegisterOutgoingBurst(MulticastUdpInfo burstInfo, InetSocketAddress targetAddress, bool enable_precise_logging, std::vector<uint64_t> bier_bit_string) {
         //check src
         NS_ABORT_MSG_IF(burstInfo.GetFromNodeId() != this->GetNode()->GetId(), "Source node identifier is not that of this node.");
         //check burstinfo start time order
@@ -87,11 +131,36 @@ namespace ns3 {
         m_outgoing_bursts_packets_sent_counter.push_back(0);
         m_outgoing_bursts_event_id.push_back(EventId());
         m_outgoing_bursts_enable_precise_logging.push_back(enable_precise_logging);
+        m_outgoing_bursts_precise_log_file.push_back(0);
+        if (m_fec_block_size > 0 && m_fec_num_repair > m_fec_block_size) {
+            throw std::invalid_argument("There cannot be more FEC repair packets than data packets per block");
+        }
+        if (m_enable_bier && bier_bit_string.empty()) {
+            throw std::invalid_argument("A BIER bit string is required for every multicast burst if BIER is enabled");
+        }
+        BierHeader bierHeader;
+        bierHeader.SetBitString(bier_bit_string);
+        m_outgoing_bursts_bier_header.push_back(bierHeader);
+        m_outgoing_bursts_rate_megabit_per_s.push_back(burstInfo.GetTargetRateMegabitPerSec());
+        m_outgoing_bursts_receiver_rates.push_back(std::map<int64_t, double>());
+        m_outgoing_bursts_receiver_report_time_ns.push_back(std::map<int64_t, int64_t>());
+        m_outgoing_bursts_sent_at_adapt.push_back(0);
+        m_outgoing_bursts_interval_sent.push_back(0);
+        m_outgoing_bursts_adapt_event_id.push_back(EventId());
         //create log file
         if (enable_precise_logging) {
+            std::string filename = m_baseLogsDir + "/" + format_string("multicast_udp_%" PRIu64 "_outgoing.csv", burstInfo.GetUdpBurstId());
             std::ofstream ofs;
-            ofs.open(m_baseLogsDir + "/" + format_string("multicast_udp_%" PRIu64 "_outgoing.csv", burstInfo.GetUdpBurstId()));
-            ofs.close();
+            if (m_precise_log_writer != 0) {
+                m_outgoing_bursts_precise_log_file.back() = m_precise_log_writer->OpenFile(filename);
+            } else {
+                ofs.open(filename);
+                ofs.close();
+            }
+            if (m_enable_rate_adaptation) {
+                ofs.open(m_baseLogsDir + "/" + format_string("multicast_udp_%" PRIu64 "_rate.csv", burstInfo.GetUdpBurstId()));
+                ofs.close();
+            }
         }
     }
 
@@ -99,22 +168,94 @@ namespace ns3 {
     MulticastUdpApplication::RegisterIncomingBurst(MulticastUdpInfo burstInfo, bool enable_precise_logging) {
         //check dst
         // NS_ABORT_MSG_IF(burstInfo.GetToNodeId() != this->GetNode()->GetId(), "Destination node identifier is not that of this node.");
-        std::set<int64_t> to_node_ids = burstInfo.GetToNodeIds();
+        std::set<int64_t> to_node_ids = burstInfo.GetAllToNodeIds();
         int64_t cur_node_id = this->GetNode()->GetId();
         NS_ABORT_MSG_IF(to_node_ids.find(cur_node_id) == to_node_ids.end(), "Destination node identifier is not that of this node."); //find() returns set.end() means not found
         m_incoming_bursts.push_back(burstInfo);
         m_incoming_bursts_received_counter[burstInfo.GetUdpBurstId()] = 0;
+        m_incoming_bursts_is_member[burstInfo.GetUdpBurstId()] = burstInfo.GetToNodeIds().count(cur_node_id) > 0; // Else it joins later
         m_incoming_bursts_enable_precise_logging[burstInfo.GetUdpBurstId()] = enable_precise_logging;
+        m_incoming_bursts_latency[burstInfo.GetUdpBurstId()] = LatencyHistogram();
+        m_incoming_bursts_interval_received[burstInfo.GetUdpBurstId()] = 0;
+        m_incoming_bursts_highest_seq[burstInfo.GetUdpBurstId()] = -1;
+        m_incoming_bursts_reported_seq[burstInfo.GetUdpBurstId()] = -1;
+        m_incoming_bursts_join_time_ns[burstInfo.GetUdpBurstId()] = burstInfo.GetStartTimeNs();
+        m_incoming_bursts_awaiting_first[burstInfo.GetUdpBurstId()] = true;
+        m_incoming_bursts_fec_blocks[burstInfo.GetUdpBurstId()] = std::map<uint64_t, MulticastFecBlock>();
+        m_incoming_bursts_fec_next_block[burstInfo.GetUdpBurstId()] = -1;
+        m_incoming_bursts_fec_stats[burstInfo.GetUdpBurstId()] = {0, 0, 0, 0, 0};
         if (enable_precise_logging) {
-            std::ofstream ofs;
-            ofs.open(m_baseLogsDir + "/" + format_string("multicast_udp_%" PRIu64 "_incoming.csv", burstInfo.GetUdpBurstId()));
-            ofs.close();
+            std::string filename = m_baseLogsDir + "/" + format_string("multicast_udp_%" PRIu64 "_incoming.csv", burstInfo.GetUdpBurstId());
+            if (m_precise_log_writer != 0) {
+                m_incoming_bursts_precise_log_file[burstInfo.GetUdpBurstId()] = m_precise_log_writer->OpenFile(filename);
+            } else {
+                std::ofstream ofs;
+                ofs.open(filename);
+                ofs.close();
+            }
+        }
+    }
+
+    void
+    MulticastUdpApplication::SetIncomingBurstMember(int64_t udp_burst_id, bool is_member) {
+
+        // After a (re)join, the losses are counted from the first packet received onwards
+        if (is_member && !m_incoming_bursts_is_member.at(udp_burst_id)) {
+            m_incoming_bursts_join_time_ns.at(udp_burst_id) = Simulator::Now().GetNanoSeconds();
+            m_incoming_bursts_awaiting_first.at(udp_burst_id) = true;
+            m_incoming_bursts_interval_received.at(udp_burst_id) = 0;
+        }
+        m_incoming_bursts_is_member.at(udp_burst_id) = is_member;
+
+        // Blocks are decoded up to the leave, and from the first packet after the join
+        if (!is_member && m_fec_block_size > 0) {
+            DecodePendingFecBlocks(udp_burst_id);
+        }
+    }
+
+    void
+    MulticastUdpApplication::EnableIncomingBurstFeedback(int64_t udp_burst_id, InetSocketAddress sourceAddress) {
+        if (!m_enable_rate_adaptation) {
+            throw std::runtime_error("Feedback can only be enabled if rate adaptation is enabled");
+        }
+        for (MulticastUdpInfo& info : m_incoming_bursts) {
+            if (info.GetUdpBurstId() == udp_burst_id) {
+                m_incoming_bursts_feedback_address.erase(udp_burst_id);
+                m_incoming_bursts_feedback_address.emplace(udp_burst_id, sourceAddress);
+                m_incoming_bursts_feedback_event_id[udp_burst_id] = Simulator::Schedule(
+                        NanoSeconds(info.GetStartTimeNs() + m_feedback_interval_ns - Simulator::Now().GetNanoSeconds()),
+                        &MulticastUdpApplication::SendFeedback, this, udp_burst_id
+                );
+                return;
+            }
+        }
+        throw std::runtime_error("Feedback of unknown incoming multicast UDP burst ID was requested");
+    }
+
+    void
+    MulticastUdpApplication::SetOutgoingBurstBierBit(int64_t udp_burst_id, uint32_t bit_position, bool is_set) {
+        for (size_t i = 0; i < m_outgoing_bursts.size(); i++) {
+            if (std::get<0>(m_outgoing_bursts[i]).GetUdpBurstId() == udp_burst_id) {
+                std::vector<uint64_t> bit_string = m_outgoing_bursts_bier_header[i].GetBitString();
+                if (bit_position / 64 >= bit_string.size()) {
+                    throw std::out_of_range("BIER bit position is beyond the bit string");
+                }
+                if (is_set) {
+                    bit_string[bit_position / 64] |= (1ULL << (bit_position % 64));
+                } else {
+                    bit_string[bit_position / 64] &= ~(1ULL << (bit_position % 64));
+                }
+                m_outgoing_bursts_bier_header[i].SetBitString(bit_string);
+                return;
+            }
         }
+        throw std::runtime_error("BIER bit string of unknown outgoing multicast UDP burst ID was requested");
     }
 
     void
     MulticastUdpApplication::DoDispose(void) {
         NS_LOG_FUNCTION(this);
+        m_precise_log_writer = 0;
         Application::DoDispose();
     }
 
@@ -137,6 +278,16 @@ namespace ns3 {
         // Receive of packets
         m_socket->SetRecvCallback(MakeCallback(&MulticastUdpApplication::HandleRead, this));
 
+        // Feedback of the receivers of the bursts sent from here
+        if (m_enable_rate_adaptation && m_outgoing_bursts.size() > 0 && m_feedback_socket == 0) {
+            TypeId tid = TypeId::LookupByName("ns3::UdpSocketFactory");
+            m_feedback_socket = Socket::CreateSocket(GetNode(), tid);
+            if (m_feedback_socket->Bind(InetSocketAddress(Ipv4Address::GetAny(), m_feedback_port)) == -1) {
+                NS_FATAL_ERROR("Failed to bind feedback socket");
+            }
+            m_feedback_socket->SetRecvCallback(MakeCallback(&MulticastUdpApplication::HandleFeedback, this));
+        }
+
         // First process call is for the start of the first burst
         if (m_outgoing_bursts.size() > 0) {
             m_startNextBurstEvent = Simulator::Schedule(NanoSeconds(std::get<0>(m_outgoing_bursts[0]).GetStartTimeNs()), &MulticastUdpApplication::StartNextBurst, this);
@@ -157,6 +308,11 @@ namespace ns3 {
         // Start the self-calling (and self-ending) process of sending out packets of the burst
         BurstSendOut(m_next_internal_burst_idx);
 
+        // As well as that of adapting its rate
+        if (m_enable_rate_adaptation) {
+            m_outgoing_bursts_adapt_event_id.at(m_next_internal_burst_idx) = Simulator::Schedule(NanoSeconds(m_feedback_interval_ns), &MulticastUdpApplication::AdaptRate, this, m_next_internal_burst_idx);
+        }
+
         // Schedule the start of the next burst if there are more
         m_next_internal_burst_idx += 1;
         if (m_next_internal_burst_idx < m_outgoing_bursts.size()) {
@@ -169,20 +325,145 @@ namespace ns3 {
     MulticastUdpApplication::BurstSendOut(size_t internal_burst_idx)
     {
 
-        // Send out the packet as desired
-        TransmitFullPacket(internal_burst_idx);
-
-        // Schedule the next if the packet gap would not exceed the rate
-        uint64_t now_ns = Simulator::Now().GetNanoSeconds();
+        // Send out the packet departing now, and all others departing within the pacing batch window
+        // (the rate can only be adapted in between two batches)
+        int64_t now_ns = Simulator::Now().GetNanoSeconds();
         MulticastUdpInfo info = std::get<0>(m_outgoing_bursts[internal_burst_idx]);
-        uint64_t packet_gap_nanoseconds = std::ceil(1500.0 / (info.GetTargetRateMegabitPerSec() / 8000.0)); //pkt trans dura
+        int64_t end_ns = info.GetStartTimeNs() + info.GetDurationNs();
+        int64_t packet_gap_nanoseconds = std::ceil(1500.0 / (m_outgoing_bursts_rate_megabit_per_s[internal_burst_idx] / 8000.0)); //pkt trans dura
+        int64_t departure_time_ns = now_ns;
+        do {
+            TransmitFullPacket(internal_burst_idx);
+            departure_time_ns += packet_gap_nanoseconds;
+        } while (departure_time_ns < end_ns && departure_time_ns < now_ns + m_pacing_batch_window_ns);
+
         //if a single pkt is not enough, schedule next send
-        if (now_ns + packet_gap_nanoseconds < (uint64_t) (info.GetStartTimeNs() + info.GetDurationNs())) {
-            m_outgoing_bursts_event_id.at(internal_burst_idx) = Simulator::Schedule(NanoSeconds(packet_gap_nanoseconds), &MulticastUdpApplication::BurstSendOut, this, internal_burst_idx);
+        if (departure_time_ns < end_ns) {
+            m_outgoing_bursts_event_id.at(internal_burst_idx) = Simulator::Schedule(NanoSeconds(departure_time_ns - now_ns), &MulticastUdpApplication::BurstSendOut, this, internal_burst_idx);
+        }
+
+    }
+
+    void
+    MulticastUdpApplication::AdaptRate(size_t internal_burst_idx)
+    {
+        MulticastUdpInfo info = std::get<0>(m_outgoing_bursts[internal_burst_idx]);
+
+        // Packets sent out during the interval which just ended
+        uint64_t sent_counter = m_outgoing_bursts_packets_sent_counter[internal_burst_idx];
+        m_outgoing_bursts_interval_sent[internal_burst_idx] = sent_counter - m_outgoing_bursts_sent_at_adapt[internal_burst_idx];
+        m_outgoing_bursts_sent_at_adapt[internal_burst_idx] = sent_counter;
+
+        // Receivers which have not reported for a while (e.g., because they left) no longer count
+        std::map<int64_t, double>& receiver_rates = m_outgoing_bursts_receiver_rates[internal_burst_idx];
+        std::map<int64_t, int64_t>& receiver_report_time_ns = m_outgoing_bursts_receiver_report_time_ns[internal_burst_idx];
+        int64_t expire_before_ns = Simulator::Now().GetNanoSeconds() - m_feedback_timeout_intervals * m_feedback_interval_ns;
+        for (auto it = receiver_report_time_ns.begin(); it != receiver_report_time_ns.end(); ) {
+            if (it->second < expire_before_ns) {
+                receiver_rates.erase(it->first);
+                it = receiver_report_time_ns.erase(it);
+            } else {
+                it++;
+            }
+        }
+
+        // Rate of the receivers which have reported recently, within [1%, 100%] of the target rate
+        if (!receiver_rates.empty()) {
+            std::vector<double> rates;
+            for (const std::pair<const int64_t, double>& entry : receiver_rates) {
+                rates.push_back(entry.second);
+            }
+            double rate = multicast_feedback_select_rate(rates, m_feedback_percentile);
+            m_outgoing_bursts_rate_megabit_per_s[internal_burst_idx] = std::max(info.GetTargetRateMegabitPerSec() / 100.0, std::min(info.GetTargetRateMegabitPerSec(), rate));
+        }
+
+        // Log the rate if needed
+        if (m_outgoing_bursts_enable_precise_logging[internal_burst_idx]) {
+            std::ofstream ofs;
+            ofs.open(m_baseLogsDir + "/" + format_string("multicast_udp_%" PRIu64 "_rate.csv", info.GetUdpBurstId()), std::ofstream::out | std::ofstream::app);
+            ofs << info.GetUdpBurstId() << "," << Simulator::Now().GetNanoSeconds() << "," << m_outgoing_bursts_rate_megabit_per_s[internal_burst_idx] << std::endl;
+            ofs.close();
+        }
+
+        // Until the end of the burst
+        if (Simulator::Now().GetNanoSeconds() + m_feedback_interval_ns < info.GetStartTimeNs() + info.GetDurationNs()) {
+            m_outgoing_bursts_adapt_event_id.at(internal_burst_idx) = Simulator::Schedule(NanoSeconds(m_feedback_interval_ns), &MulticastUdpApplication::AdaptRate, this, internal_burst_idx);
+        }
+    }
+
+    void
+    MulticastUdpApplication::SendFeedback(int64_t udp_burst_id)
+    {
+
+        // Report the packets since the previous report (only while a member, not before it has been
+        // one for a full interval since its (re)join, and not before it received its first packet)
+        bool awaiting_first = m_incoming_bursts_awaiting_first.at(udp_burst_id);
+        if (m_incoming_bursts_is_member.at(udp_burst_id) && !awaiting_first
+            && Simulator::Now().GetNanoSeconds() - m_incoming_bursts_join_time_ns.at(udp_burst_id) >= m_feedback_interval_ns) {
+            MulticastFeedbackHeader feedback;
+            feedback.SetId(udp_burst_id);
+            feedback.SetReceiverNodeId(GetNode()->GetId());
+            feedback.SetNumReceived(m_incoming_bursts_interval_received.at(udp_burst_id));
+            feedback.SetNumExpected(m_incoming_bursts_highest_seq.at(udp_burst_id) - m_incoming_bursts_reported_seq.at(udp_burst_id));
+            Ptr<Packet> p = Create<Packet>(0);
+            p->AddHeader(feedback);
+            m_socket->SendTo(p, 0, m_incoming_bursts_feedback_address.at(udp_burst_id));
+        }
+        m_incoming_bursts_interval_received.at(udp_burst_id) = 0;
+        if (!awaiting_first) {
+            m_incoming_bursts_reported_seq.at(udp_burst_id) = m_incoming_bursts_highest_seq.at(udp_burst_id);
+        }
+
+        // Until the end of the burst
+        for (MulticastUdpInfo& info : m_incoming_bursts) {
+            if (info.GetUdpBurstId() == udp_burst_id && Simulator::Now().GetNanoSeconds() + m_feedback_interval_ns <= info.GetStartTimeNs() + info.GetDurationNs()) {
+                m_incoming_bursts_feedback_event_id[udp_burst_id] = Simulator::Schedule(NanoSeconds(m_feedback_interval_ns), &MulticastUdpApplication::SendFeedback, this, udp_burst_id);
+            }
         }
 
     }
 
+    void
+    MulticastUdpApplication::HandleFeedback(Ptr <Socket> socket) {
+        NS_LOG_FUNCTION(this << socket);
+        Ptr <Packet> packet;
+        Address from;
+        while ((packet = socket->RecvFrom(from))) {
+            MulticastFeedbackHeader feedback;
+            packet->RemoveHeader(feedback);
+
+            // Receivers report data packets only, whereas the rate also covers the repair packets
+            uint64_t num_received = feedback.GetNumReceived();
+            uint64_t num_expected = feedback.GetNumExpected();
+            if (m_fec_block_size > 0) {
+                num_received = num_received * (m_fec_block_size + m_fec_num_repair) / m_fec_block_size;
+                num_expected = num_expected * (m_fec_block_size + m_fec_num_repair) / m_fec_block_size;
+            }
+
+            for (size_t i = 0; i < m_outgoing_bursts.size(); i++) {
+                if (std::get<0>(m_outgoing_bursts[i]).GetUdpBurstId() == (int64_t) feedback.GetId()) {
+
+                    // A receiver which did not get a single packet in the interval cannot tell how many
+                    // it missed, which are then those the source sent out in its previous interval
+                    // (except the last one, which might not have arrived yet at the end of the interval)
+                    uint64_t num_expected_of_burst = num_expected;
+                    if (num_expected_of_burst == 0 && m_outgoing_bursts_interval_sent[i] > 0) {
+                        num_expected_of_burst = m_outgoing_bursts_interval_sent[i] - 1;
+                    }
+
+                    m_outgoing_bursts_receiver_rates[i][feedback.GetReceiverNodeId()] = multicast_feedback_receiver_rate(
+                            m_outgoing_bursts_rate_megabit_per_s[i],
+                            num_received,
+                            num_expected_of_burst,
+                            m_feedback_interval_ns,
+                            std::get<0>(m_outgoing_bursts[i]).GetTargetRateMegabitPerSec() / 20.0
+                    );
+                    m_outgoing_bursts_receiver_report_time_ns[i][feedback.GetReceiverNodeId()] = Simulator::Now().GetNanoSeconds();
+                }
+            }
+        }
+    }
+
     void
     MulticastUdpApplication::TransmitFullPacket(size_t internal_burst_idx) {
 
@@ -190,21 +471,42 @@ namespace ns3 {
         IdSeqHeader idSeq;
         idSeq.SetId(std::get<0>(m_outgoing_bursts[internal_burst_idx]).GetUdpBurstId());
         idSeq.SetSeq(m_outgoing_bursts_packets_sent_counter[internal_burst_idx]);
+        idSeq.SetTs(Simulator::Now().GetNanoSeconds());
 
         // One more packet will be sent out
         m_outgoing_bursts_packets_sent_counter[internal_burst_idx] += 1;
 
         // Log precise timestamp sent away of the sequence packet if needed
-        if (m_outgoing_bursts_enable_precise_logging[internal_burst_idx]) {
+        // (within a pacing batch, that is the start of the batch window)
+        if (m_outgoing_bursts_enable_precise_logging[internal_burst_idx] && m_precise_log_writer != 0) {
+            m_precise_log_writer->Append(m_outgoing_bursts_precise_log_file[internal_burst_idx], idSeq.GetId(), idSeq.GetSeq(), Simulator::Now().GetNanoSeconds());
+        } else if (m_outgoing_bursts_enable_precise_logging[internal_burst_idx]) {
             std::ofstream ofs;
             ofs.open(m_baseLogsDir + "/" + format_string("multicast_udp_%" PRIu64 "_outgoing.csv", idSeq.GetId()), std::ofstream::out | std::ofstream::app);
             ofs << idSeq.GetId() << "," << idSeq.GetSeq() << "," << Simulator::Now().GetNanoSeconds() << std::endl;
             ofs.close();
         }
 
+        // Position in its FEC block: first the data packets, then the repair packets
+        MulticastFecHeader fec;
+        if (m_fec_block_size > 0) {
+            fec.SetBlock(idSeq.GetSeq() / (m_fec_block_size + m_fec_num_repair));
+            fec.SetIndex(idSeq.GetSeq() % (m_fec_block_size + m_fec_num_repair));
+            fec.SetBlockSize(m_fec_block_size);
+            fec.SetNumRepair(m_fec_num_repair);
+        }
+
         // A full payload packet
-        Ptr<Packet> p = Create<Packet>(m_max_udp_payload_size_byte - idSeq.GetSerializedSize());
+        uint32_t bier_header_size = m_enable_bier ? m_outgoing_bursts_bier_header[internal_burst_idx].GetSerializedSize() : 0;
+        uint32_t fec_header_size = m_fec_block_size > 0 ? fec.GetSerializedSize() : 0;
+        Ptr<Packet> p = Create<Packet>(m_max_udp_payload_size_byte - idSeq.GetSerializedSize() - bier_header_size - fec_header_size);
+        if (m_fec_block_size > 0) {
+            p->AddHeader(fec);
+        }
         p->AddHeader(idSeq);
+        if (m_enable_bier) {
+            p->AddHeader(m_outgoing_bursts_bier_header[internal_burst_idx]);
+        }
 
         // Send out the packet to the target address
         m_socket->SendTo(p, 0, std::get<1>(m_outgoing_bursts[internal_burst_idx]));
@@ -221,6 +523,16 @@ namespace ns3 {
             for (EventId& eventId : m_outgoing_bursts_event_id) {
                 Simulator::Cancel(eventId);
             }
+            for (EventId& eventId : m_outgoing_bursts_adapt_event_id) {
+                Simulator::Cancel(eventId);
+            }
+            for (std::pair<const int64_t, EventId>& entry : m_incoming_bursts_feedback_event_id) {
+                Simulator::Cancel(entry.second);
+            }
+        }
+        if (m_feedback_socket != 0) {
+            m_feedback_socket->Close();
+            m_feedback_socket->SetRecvCallback(MakeNullCallback < void, Ptr < Socket > > ());
         }
     }
 
@@ -230,16 +542,83 @@ namespace ns3 {
         Ptr <Packet> packet;
         Address from;
         while ((packet = socket->RecvFrom(from))) {
-            std::cout << "[App-Recv]Multicast App socket recv a pkt at node " << m_node->GetId() << " from " << from << std::endl;
+            NS_LOG_LOGIC ("Received multicast packet at node " << m_node->GetId() << " from " << from);
+            // The BIER header (if any) comes before the burst identifier
+            if (m_enable_bier) {
+                BierHeader incomingBier;
+                packet->RemoveHeader (incomingBier);
+            }
+
             // Extract burst identifier and packet sequence number
             IdSeqHeader incomingIdSeq;
             packet->RemoveHeader (incomingIdSeq);
 
-            // Count packets from incoming bursts
-            m_incoming_bursts_received_counter.at(incomingIdSeq.GetId()) += 1;
+            // Count packets from incoming bursts (not if it has left, or not yet joined)
+            if (!m_incoming_bursts_is_member.at(incomingIdSeq.GetId())) {
+                continue;
+            }
+
+            // Forward error correction
+            bool is_repair = false;
+            int64_t data_seq = incomingIdSeq.GetSeq(); // Sequence number among the data packets only
+            if (m_fec_block_size > 0) {
+                MulticastFecHeader incomingFec;
+                packet->RemoveHeader (incomingFec);
+                is_repair = incomingFec.IsRepair();
+                data_seq = incomingFec.GetBlock() * m_fec_block_size + incomingFec.GetIndex();
+                MulticastFecStats& stats = m_incoming_bursts_fec_stats.at(incomingIdSeq.GetId());
+                if (is_repair) {
+                    stats.repair_received += 1;
+                } else {
+                    stats.data_received += 1;
+                }
+                int64_t& next_block = m_incoming_bursts_fec_next_block.at(incomingIdSeq.GetId());
+                if (next_block == -1) {
+                    next_block = incomingFec.GetBlock();
+                }
+                if ((int64_t) incomingFec.GetBlock() >= next_block) { // Else it arrived after its block was decoded
+                    std::map<uint64_t, MulticastFecBlock>& blocks = m_incoming_bursts_fec_blocks.at(incomingIdSeq.GetId());
+                    auto it = blocks.emplace(incomingFec.GetBlock(), MulticastFecBlock{0, 0, -1}).first;
+                    if (is_repair) {
+                        it->second.repair_received |= (1ULL << (incomingFec.GetIndex() - m_fec_block_size));
+                    } else {
+                        it->second.data_received |= (1ULL << incomingFec.GetIndex());
+                    }
+                    it->second.highest_index = std::max(it->second.highest_index, (int32_t) incomingFec.GetIndex());
+
+                    // Decode the blocks which are too far behind to still receive packets (reordering)
+                    while (next_block + 4 <= (int64_t) incomingFec.GetBlock()) {
+                        auto pending = blocks.find(next_block);
+                        if (pending == blocks.end()) {
+                            DecodeFecBlock(stats, MulticastFecBlock{0, 0, -1}, false); // Entirely lost
+                        } else {
+                            DecodeFecBlock(stats, pending->second, false);
+                            blocks.erase(pending);
+                        }
+                        next_block++;
+                    }
+                }
+            }
+
+            // Only data packets count as received, and towards the latency and the feedback
+            // (repair packets are only counted in the FEC statistics)
+            if (!is_repair) {
+                m_incoming_bursts_received_counter.at(incomingIdSeq.GetId()) += 1;
+                m_incoming_bursts_latency.at(incomingIdSeq.GetId()).Record(Simulator::Now().GetNanoSeconds() - incomingIdSeq.GetTs());
+                m_incoming_bursts_interval_received.at(incomingIdSeq.GetId()) += 1;
+                if (m_incoming_bursts_awaiting_first.at(incomingIdSeq.GetId())) {
+                    m_incoming_bursts_reported_seq.at(incomingIdSeq.GetId()) = data_seq - 1;
+                    m_incoming_bursts_highest_seq.at(incomingIdSeq.GetId()) = data_seq;
+                    m_incoming_bursts_awaiting_first.at(incomingIdSeq.GetId()) = false;
+                } else {
+                    m_incoming_bursts_highest_seq.at(incomingIdSeq.GetId()) = std::max(m_incoming_bursts_highest_seq.at(incomingIdSeq.GetId()), data_seq);
+                }
+            }
 
             // Log precise timestamp received of the sequence packet if needed
-            if (m_incoming_bursts_enable_precise_logging[incomingIdSeq.GetId()]) {
+            if (m_incoming_bursts_enable_precise_logging[incomingIdSeq.GetId()] && m_precise_log_writer != 0) {
+                m_precise_log_writer->Append(m_incoming_bursts_precise_log_file.at(incomingIdSeq.GetId()), incomingIdSeq.GetId(), incomingIdSeq.GetSeq(), Simulator::Now().GetNanoSeconds());
+            } else if (m_incoming_bursts_enable_precise_logging[incomingIdSeq.GetId()]) {
                 std::ofstream ofs;
                 ofs.open(m_baseLogsDir + "/" + format_string("multicast_udp_%" PRIu64 "_incoming.csv", incomingIdSeq.GetId()), std::ofstream::out | std::ofstream::app);
                 ofs << incomingIdSeq.GetId() << "," << incomingIdSeq.GetSeq() << "," << Simulator::Now().GetNanoSeconds() << std::endl;
@@ -283,5 +662,73 @@ namespace ns3 {
         return m_incoming_bursts_received_counter.at(udp_burst_id);
     }
 
+    const LatencyHistogram&
+    MulticastUdpApplication::GetLatencyHistogramOf(int64_t udp_burst_id) {
+        return m_incoming_bursts_latency.at(udp_burst_id);
+    }
+
+    void
+    MulticastUdpApplication::DecodeFecBlock(MulticastFecStats& stats, const MulticastFecBlock& block, bool is_last) {
+        uint64_t data_expected = m_fec_block_size == 64 ? ~0ULL : ((1ULL << m_fec_block_size) - 1);
+
+        // The burst can end in the middle of the last block, which is then only sent up to the highest index received
+        if (is_last && block.highest_index < (int32_t) m_fec_block_size) {
+            data_expected = block.highest_index == 63 ? ~0ULL : ((1ULL << (block.highest_index + 1)) - 1);
+        }
+
+        uint64_t missing = data_expected & ~block.data_received;
+        if (missing != 0) {
+            uint64_t recovered = multicast_fec_xor_recover(block.data_received, block.repair_received, m_fec_block_size, m_fec_num_repair, data_expected);
+            stats.blocks_with_loss += 1;
+            stats.data_recovered += __builtin_popcountll(recovered);
+            if ((missing & ~recovered) == 0) {
+                stats.blocks_recovered += 1;
+            }
+        }
+    }
+
+    void
+    MulticastUdpApplication::DecodePendingFecBlocks(int64_t udp_burst_id) {
+        std::map<uint64_t, MulticastFecBlock>& blocks = m_incoming_bursts_fec_blocks.at(udp_burst_id);
+        int64_t& next_block = m_incoming_bursts_fec_next_block.at(udp_burst_id);
+        if (!blocks.empty()) {
+            uint64_t last_block = blocks.rbegin()->first;
+            for (uint64_t b = next_block; b <= last_block; b++) {
+                auto pending = blocks.find(b);
+                DecodeFecBlock(m_incoming_bursts_fec_stats.at(udp_burst_id), pending == blocks.end() ? MulticastFecBlock{0, 0, -1} : pending->second, b == last_block);
+            }
+            blocks.clear();
+        }
+        next_block = -1;
+    }
+
+    uint32_t
+    MulticastUdpApplication::GetFecBlockSize() {
+        return m_fec_block_size;
+    }
+
+    uint32_t
+    MulticastUdpApplication::GetFecNumRepair() {
+        return m_fec_num_repair;
+    }
+
+    MulticastFecStats
+    MulticastUdpApplication::GetFecStatsOf(int64_t udp_burst_id) {
+        if (m_fec_block_size > 0) {
+            DecodePendingFecBlocks(udp_burst_id);
+        }
+        return m_incoming_bursts_fec_stats.at(udp_burst_id);
+    }
+
+    double
+    MulticastUdpApplication::GetRateOf(int64_t udp_burst_id) {
+        for (size_t i = 0; i < m_outgoing_bursts.size(); i++) {
+            if (std::get<0>(m_outgoing_bursts[i]).GetUdpBurstId() == udp_burst_id) {
+                return m_outgoing_bursts_rate_megabit_per_s[i];
+            }
+        }
+        throw std::runtime_error("Rate of unknown UDP burst ID was requested");
+    }
+
 } // namespace ns3
 
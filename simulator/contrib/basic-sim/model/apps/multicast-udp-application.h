@@ -28,8 +28,13 @@
 #include "ns3/traced-callback.h"
 #include "ns3/seq-ts-header.h"
 #include "ns3/id-seq-header.h"
+#include "ns3/bier-header.h"
+#include "ns3/multicast-feedback-header.h"
+#include "ns3/multicast-fec-header.h"
 #include "ns3/string.h"
 #include "ns3/exp-util.h"
+#include "ns3/precise-log-writer.h"
+#include "ns3/latency-histogram.h"
 
 #include "ns3/multicast-udp-schedule-reader.h"
 
@@ -38,6 +43,22 @@ namespace ns3 {
     class Socket;
     class Packet;
 
+    // Forward error correction result of an incoming burst
+    struct MulticastFecStats {
+        uint64_t data_received;     //!< Data packets received
+        uint64_t repair_received;   //!< Repair packets received
+        uint64_t data_recovered;    //!< Lost data packets recovered from the repair packets
+        uint64_t blocks_with_loss;  //!< Blocks of which at least one data packet was lost
+        uint64_t blocks_recovered;  //!< Blocks with loss of which all lost data packets were recovered
+    };
+
+    // Block of an incoming burst which is not yet decoded
+    struct MulticastFecBlock {
+        uint64_t data_received;     //!< Bit i set iff data packet i arrived
+        uint64_t repair_received;   //!< Bit j set iff repair packet j arrived
+        int32_t highest_index;      //!< Highest index in the block which arrived
+    };
+
     class MulticastUdpApplication : public Application
     {
     public:
@@ -45,8 +66,12 @@ namespace ns3 {
         MulticastUdpApplication ();
         virtual ~MulticastUdpApplication ();
         uint32_t GetMaxUdpPayloadSizeByte();
-        void RegisterOutgoingBurst(MulticastUdpInfo burstInfo, InetSocketAddress targetAddress, bool enable_precise_logging);
+        void SetPreciseLogWriter(Ptr<PreciseLogWriter> preciseLogWriter);
+        void RegisterOutgoingBurst(MulticastUdpInfo burstInfo, InetSocketAddress targetAddress, bool enable_precise_logging, std::vector<uint64_t> bier_bit_string = std::vector<uint64_t>());
         void RegisterIncomingBurst(MulticastUdpInfo burstInfo, bool enable_precise_logging);
+        void SetIncomingBurstMember(int64_t udp_burst_id, bool is_member);
+        void SetOutgoingBurstBierBit(int64_t udp_burst_id, uint32_t bit_position, bool is_set);
+        void EnableIncomingBurstFeedback(int64_t udp_burst_id, InetSocketAddress sourceAddress);
         void StartNextBurst();
         void BurstSendOut(size_t internal_burst_idx);
         void TransmitFullPacket(size_t internal_burst_idx);
@@ -54,6 +79,11 @@ namespace ns3 {
         std::vector<std::tuple<MulticastUdpInfo, uint64_t>> GetIncomingBurstsInformation();
         uint64_t GetSentCounterOf(int64_t udp_burst_id);
         uint64_t GetReceivedCounterOf(int64_t udp_burst_id);
+        const LatencyHistogram& GetLatencyHistogramOf(int64_t udp_burst_id);
+        double GetRateOf(int64_t udp_burst_id);
+        uint32_t GetFecBlockSize();
+        uint32_t GetFecNumRepair();
+        MulticastFecStats GetFecStatsOf(int64_t udp_burst_id);
 
     protected:
         virtual void DoDispose (void);
@@ -62,25 +92,62 @@ namespace ns3 {
         virtual void StartApplication (void);
         virtual void StopApplication (void);
         void HandleRead (Ptr<Socket> socket);
+        void HandleFeedback (Ptr<Socket> socket);
+        void SendFeedback (int64_t udp_burst_id);
+        void AdaptRate (size_t internal_burst_idx);
+        void DecodeFecBlock (MulticastFecStats& stats, const MulticastFecBlock& block, bool is_last);
+        void DecodePendingFecBlocks (int64_t udp_burst_id);
 
         uint16_t m_port;      //!< Port on which we listen for incoming packets.
         uint32_t m_max_udp_payload_size_byte;  //!< Maximum size of UDP payload before getting fragmented
+        int64_t m_pacing_batch_window_ns; //!< Packets departing within this window are sent in one event (0: one event per packet)
+        bool m_enable_bier;   //!< True iff every packet carries a BIER header (stateless multicast)
+        bool m_enable_rate_adaptation;  //!< True iff the sending rate adapts to the feedback of the receivers
+        int64_t m_feedback_interval_ns; //!< Interval between two feedback reports (and rate adaptations)
+        double m_feedback_percentile;   //!< Percentile of the receivers' sustainable rates to send at (0 = slowest)
+        uint32_t m_feedback_timeout_intervals; //!< Intervals without report after which a receiver no longer counts
+        uint16_t m_feedback_port;       //!< Port on which the source listens for feedback
+        uint32_t m_fec_block_size;      //!< Data packets per FEC block (n, 0 if FEC is disabled)
+        uint32_t m_fec_num_repair;      //!< XOR repair packets per FEC block (k)
         Ptr<Socket> m_socket; //!< IPv4 Socket
+        Ptr<Socket> m_feedback_socket; //!< IPv4 Socket for feedback (only if rate adaptation is enabled)
         std::string m_baseLogsDir; //!< Where the UDP burst logs will be written to:
                                    //!<   logs_dir/udp_burst_[id]_{incoming, outgoing}.csv
         EventId m_startNextBurstEvent; //!< Event to start next burst
+        Ptr<PreciseLogWriter> m_precise_log_writer; //!< If set, precise logs are appended to it instead of to the files directly
 
         // Outgoing bursts
         std::vector<std::tuple<MulticastUdpInfo, InetSocketAddress>> m_outgoing_bursts; //!< Weakly ascending on start time list of bursts
         std::vector<uint64_t> m_outgoing_bursts_packets_sent_counter; //!< Amount of UDP packets sent out already for each burst
         std::vector<EventId> m_outgoing_bursts_event_id; //!< Event ID of the outgoing burst send loop
         std::vector<bool> m_outgoing_bursts_enable_precise_logging; //!< True iff enable precise logging for each burst
+        std::vector<uint32_t> m_outgoing_bursts_precise_log_file; //!< File of the precise log writer for each burst
+        std::vector<BierHeader> m_outgoing_bursts_bier_header; //!< BIER header of each burst (only used if BIER is enabled)
+        std::vector<double> m_outgoing_bursts_rate_megabit_per_s; //!< Current sending rate of each burst (the target rate if not adapted)
+        std::vector<std::map<int64_t, double>> m_outgoing_bursts_receiver_rates; //!< Latest sustainable rate reported by each receiver
+        std::vector<std::map<int64_t, int64_t>> m_outgoing_bursts_receiver_report_time_ns; //!< Time of the latest report of each receiver
+        std::vector<uint64_t> m_outgoing_bursts_sent_at_adapt; //!< Packets sent out at the latest rate adaptation
+        std::vector<uint64_t> m_outgoing_bursts_interval_sent; //!< Packets sent out in the interval before the latest rate adaptation
+        std::vector<EventId> m_outgoing_bursts_adapt_event_id; //!< Event ID of the rate adaptation loop
         size_t m_next_internal_burst_idx; //!< Next burst index to send out
 
         // Incoming bursts
         std::vector<MulticastUdpInfo> m_incoming_bursts;
-        std::map<int64_t, uint64_t> m_incoming_bursts_received_counter;       //!< Counter for how many packets received
+        std::map<int64_t, uint64_t> m_incoming_bursts_received_counter;       //!< Counter for how many data packets received (repair packets excluded)
         std::map<int64_t, uint64_t> m_incoming_bursts_enable_precise_logging; //!< True iff enable precise logging for each burst
+        std::map<int64_t, uint32_t> m_incoming_bursts_precise_log_file; //!< File of the precise log writer for each burst
+        std::map<int64_t, LatencyHistogram> m_incoming_bursts_latency; //!< One-way latency of the packets received while a member
+        std::map<int64_t, bool> m_incoming_bursts_is_member;                  //!< True iff currently a member (only then packets are counted)
+        std::map<int64_t, InetSocketAddress> m_incoming_bursts_feedback_address; //!< Where to report to (only if feedback is enabled)
+        std::map<int64_t, uint64_t> m_incoming_bursts_interval_received;      //!< Data packets received since the previous report
+        std::map<int64_t, int64_t> m_incoming_bursts_highest_seq;             //!< Highest data sequence number received (-1 if none yet)
+        std::map<int64_t, int64_t> m_incoming_bursts_reported_seq;            //!< Highest sequence number at the previous report
+        std::map<int64_t, int64_t> m_incoming_bursts_join_time_ns;            //!< Time of the latest (re)join (the start for initial members)
+        std::map<int64_t, bool> m_incoming_bursts_awaiting_first;             //!< True iff no packet was received yet since the latest (re)join
+        std::map<int64_t, EventId> m_incoming_bursts_feedback_event_id;       //!< Event ID of each feedback loop
+        std::map<int64_t, std::map<uint64_t, MulticastFecBlock>> m_incoming_bursts_fec_blocks; //!< FEC blocks not yet decoded
+        std::map<int64_t, int64_t> m_incoming_bursts_fec_next_block;          //!< First block not yet decoded (-1 if none received yet)
+        std::map<int64_t, MulticastFecStats> m_incoming_bursts_fec_stats;     //!< FEC result of the decoded blocks
 
     };
 
@@ -30,6 +30,8 @@
 #include "ns3/socket-factory.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/integer.h"
+#include "ns3/boolean.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/tcp-socket-factory.h"
 #include "ns3/tcp-socket-base.h"
@@ -44,6 +46,8 @@ NS_LOG_COMPONENT_DEFINE ("TcpFlowSendApplication");
 
 NS_OBJECT_ENSURE_REGISTERED (TcpFlowSendApplication);
 
+static const char* DETAILED_LOG_NAMES[3] = {"progress", "cwnd", "rtt"};
+
 TypeId
 TcpFlowSendApplication::GetTypeId(void) {
     static TypeId tid = TypeId("ns3::TcpFlowSendApplication")
@@ -85,6 +89,17 @@ TcpFlowSendApplication::GetTypeId(void) {
                            StringValue (""),
                            MakeStringAccessor (&TcpFlowSendApplication::m_baseLogsDir),
                            MakeStringChecker ())
+            .AddAttribute("DetailedLoggingMinIntervalNs",
+                          "Minimum time (ns) between two logged values of the same detailed log; values in between are "
+                          "not logged (0 means every value is logged). The final value is always logged.",
+                          IntegerValue(0),
+                          MakeIntegerAccessor(&TcpFlowSendApplication::m_detailedLoggingMinIntervalNs),
+                          MakeIntegerChecker<int64_t>(0))
+            .AddAttribute("DetailedLoggingOnlyChanges",
+                          "True iff a value equal to the previously logged value of the same detailed log is not logged.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&TcpFlowSendApplication::m_detailedLoggingOnlyChanges),
+                          MakeBooleanChecker())
             .AddAttribute ("AdditionalParameters",
                            "Additional parameter string; this might be parsed in another version of this application to "
                            "do slightly different behavior (e.g., set priority on TCP socket etc.)",
@@ -107,8 +122,14 @@ TcpFlowSendApplication::TcpFlowSendApplication()
           m_closedNormally(false),
           m_closedByError(false),
           m_ackedBytes(0),
-          m_isCompleted(false) {
+          m_isCompleted(false),
+          m_numDetailedLogsCoalesced(0) {
     NS_LOG_FUNCTION(this);
+    for (int i = 0; i < 3; i++) {
+        m_detailedLogFile[i] = 0;
+        m_lastDetailedLogTimeNs[i] = -1;
+        m_lastDetailedLogValue[i] = 0;
+    }
 }
 
 TcpFlowSendApplication::~TcpFlowSendApplication() {
@@ -120,6 +141,7 @@ TcpFlowSendApplication::DoDispose(void) {
     NS_LOG_FUNCTION(this);
 
     m_socket = 0;
+    m_detailedLogWriter = 0;
     // chain up
     Application::DoDispose();
 }
@@ -165,22 +187,28 @@ void TcpFlowSendApplication::StartApplication(void) { // Called at time specifie
                 MakeCallback(&TcpFlowSendApplication::SocketClosedError, this)
         );
         if (m_enableDetailedLogging) {
-            std::ofstream ofs;
 
-            ofs.open(m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_progress.csv", m_tcpFlowId));
-            ofs << m_tcpFlowId << "," << Simulator::Now ().GetNanoSeconds () << "," << GetAckedBytes() << std::endl;
-            ofs.close();
+            // Create the (empty) log files
+            for (int i = 0; i < 3; i++) {
+                std::string filename = m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_%s.csv", m_tcpFlowId, DETAILED_LOG_NAMES[i]);
+                if (m_detailedLogWriter != 0) {
+                    m_detailedLogFile[i] = m_detailedLogWriter->OpenFile(filename);
+                } else {
+                    std::ofstream ofs;
+                    ofs.open(filename);
+                    ofs.close();
+                }
+            }
+
+            // Initial progress
+            InsertDetailedLog(DETAILED_LOG_PROGRESS, Simulator::Now ().GetNanoSeconds (), GetAckedBytes(), true);
 
-            ofs.open(m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_cwnd.csv", m_tcpFlowId));
             // Congestion window is only set upon SYN reception, so retrieving it early will just yield 0
             // As such there "is" basically no congestion window till then, so we are not going to write 0
-            ofs.close();
             m_socket->TraceConnectWithoutContext ("CongestionWindow", MakeCallback (&TcpFlowSendApplication::CwndChange, this));
 
-            ofs.open(m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_rtt.csv", m_tcpFlowId));
             // At the socket creation, there is no RTT measurement, so retrieving it early will just yield 0
             // As such there "is" basically no RTT measurement till then, so we are not going to write 0
-            ofs.close();
             m_socket->TraceConnectWithoutContext ("RTT", MakeCallback (&TcpFlowSendApplication::RttChange, this));
         }
     }
@@ -334,29 +362,56 @@ TcpFlowSendApplication::RttChange (Time oldRtt, Time newRtt)
 void
 TcpFlowSendApplication::InsertCwndLog(int64_t timestamp, uint32_t cwnd_byte)
 {
-    std::ofstream ofs;
-    ofs.open (m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_cwnd.csv", m_tcpFlowId), std::ofstream::out | std::ofstream::app);
-    ofs << m_tcpFlowId << "," << timestamp << "," << cwnd_byte << std::endl;
     m_current_cwnd_byte = cwnd_byte;
-    ofs.close();
+    InsertDetailedLog(DETAILED_LOG_CWND, timestamp, cwnd_byte, false);
 }
 
 void
 TcpFlowSendApplication::InsertRttLog (int64_t timestamp, int64_t rtt_ns)
 {
-    std::ofstream ofs;
-    ofs.open (m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_rtt.csv", m_tcpFlowId), std::ofstream::out | std::ofstream::app);
-    ofs << m_tcpFlowId << "," << timestamp << "," << rtt_ns << std::endl;
     m_current_rtt_ns = rtt_ns;
-    ofs.close();
+    InsertDetailedLog(DETAILED_LOG_RTT, timestamp, rtt_ns, false);
 }
 
 void
 TcpFlowSendApplication::InsertProgressLog (int64_t timestamp, int64_t progress_byte) {
-    std::ofstream ofs;
-    ofs.open (m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_progress.csv", m_tcpFlowId), std::ofstream::out | std::ofstream::app);
-    ofs << m_tcpFlowId << "," << timestamp << "," << progress_byte << std::endl;
-    ofs.close();
+    InsertDetailedLog(DETAILED_LOG_PROGRESS, timestamp, progress_byte, false);
+}
+
+void
+TcpFlowSendApplication::InsertDetailedLog (DetailedLog log, int64_t timestamp, int64_t value, bool always) {
+
+    // Decimation: a value too soon after or equal to the previously logged one is coalesced into it
+    if (!always && m_lastDetailedLogTimeNs[log] != -1) {
+        if (timestamp - m_lastDetailedLogTimeNs[log] < m_detailedLoggingMinIntervalNs
+            || (m_detailedLoggingOnlyChanges && value == m_lastDetailedLogValue[log])) {
+            m_numDetailedLogsCoalesced++;
+            return;
+        }
+    }
+    m_lastDetailedLogTimeNs[log] = timestamp;
+    m_lastDetailedLogValue[log] = value;
+
+    // Either handed over to the writer, or appended to the file right away
+    if (m_detailedLogWriter != 0) {
+        m_detailedLogWriter->Record(m_detailedLogFile[log], m_tcpFlowId, timestamp, value);
+    } else {
+        std::ofstream ofs;
+        ofs.open (m_baseLogsDir + "/" + format_string("tcp_flow_%" PRIu64 "_%s.csv", m_tcpFlowId, DETAILED_LOG_NAMES[log]), std::ofstream::out | std::ofstream::app);
+        ofs << m_tcpFlowId << "," << timestamp << "," << value << std::endl;
+        ofs.close();
+    }
+
+}
+
+void
+TcpFlowSendApplication::SetDetailedLogWriter(Ptr<AsyncLogWriter> detailedLogWriter) {
+    m_detailedLogWriter = detailedLogWriter;
+}
+
+uint64_t
+TcpFlowSendApplication::GetNumDetailedLogsCoalesced() {
+    return m_numDetailedLogsCoalesced;
 }
 
 void
@@ -368,9 +423,9 @@ TcpFlowSendApplication::FinalizeDetailedLogs() {
         } else {
             timestamp = Simulator::Now ().GetNanoSeconds ();
         }
-        InsertCwndLog(timestamp, m_current_cwnd_byte);
-        InsertRttLog(timestamp, m_current_rtt_ns);
-        InsertProgressLog(timestamp, GetAckedBytes());
+        InsertDetailedLog(DETAILED_LOG_CWND, timestamp, m_current_cwnd_byte, true);
+        InsertDetailedLog(DETAILED_LOG_RTT, timestamp, m_current_rtt_ns, true);
+        InsertDetailedLog(DETAILED_LOG_PROGRESS, timestamp, GetAckedBytes(), true);
     }
 }
 
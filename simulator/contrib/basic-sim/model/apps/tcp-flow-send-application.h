@@ -29,6 +29,7 @@
 #include "ns3/ptr.h"
 #include "ns3/string.h"
 #include "ns3/traced-callback.h"
+#include "ns3/async-log-writer.h"
 
 namespace ns3 {
 
@@ -51,6 +52,8 @@ public:
   bool IsClosedByError();
   bool IsClosedNormally();
   void FinalizeDetailedLogs();
+  void SetDetailedLogWriter(Ptr<AsyncLogWriter> detailedLogWriter);
+  uint64_t GetNumDetailedLogsCoalesced();
 
 protected:
   virtual void DoDispose (void);
@@ -85,9 +88,21 @@ private:
   bool m_enableDetailedLogging;            //!< True iff you want to write detailed logs
   std::string m_baseLogsDir;               //!< Where the logs will be written to:
                                            //!<   logs_dir/tcp_flow_[id]_{progress, cwnd, rtt}.csv
+  Ptr<AsyncLogWriter> m_detailedLogWriter; //!< If set, the logs are recorded into it instead of written to the files directly
+  int64_t m_detailedLoggingMinIntervalNs;  //!< Minimum time between two logged values of the same log
+  bool m_detailedLoggingOnlyChanges;       //!< True iff a value equal to the previously logged one is not logged
+  uint32_t m_detailedLogFile[3];           //!< File index in the writer of each log
+  int64_t m_lastDetailedLogTimeNs[3];      //!< Time of the previously logged value of each log (-1 if none yet)
+  int64_t m_lastDetailedLogValue[3];       //!< Previously logged value of each log
+  uint64_t m_numDetailedLogsCoalesced;     //!< Values not logged due to the minimum interval or being unchanged
   TracedCallback<Ptr<const Packet> > m_txTrace;
 
 private:
+  enum DetailedLog {
+    DETAILED_LOG_PROGRESS = 0,
+    DETAILED_LOG_CWND = 1,
+    DETAILED_LOG_RTT = 2
+  };
   void ConnectionSucceeded (Ptr<Socket> socket);
   void ConnectionFailed (Ptr<Socket> socket);
   void DataSend (Ptr<Socket>, uint32_t);
@@ -98,6 +113,7 @@ private:
   void InsertCwndLog(int64_t timestamp, uint32_t cwnd_byte);
   void InsertRttLog (int64_t timestamp, int64_t rtt_ns);
   void InsertProgressLog (int64_t timestamp, int64_t progress_byte);
+  void InsertDetailedLog (DetailedLog log, int64_t timestamp, int64_t value, bool always);
 
 };
 
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/address-utils.h"
+#include "ns3/nstime.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/socket.h"
+#include "ns3/udp-socket.h"
+#include "ns3/simulator.h"
+#include "ns3/socket-factory.h"
+#include "ns3/packet.h"
+#include "ns3/uinteger.h"
+
+#include "trace-replay-application.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE ("TraceReplayApplication");
+
+    NS_OBJECT_ENSURE_REGISTERED (TraceReplayApplication);
+
+    TypeId
+    TraceReplayApplication::GetTypeId(void) {
+        static TypeId tid = TypeId("ns3::TraceReplayApplication")
+                .SetParent<Application>()
+                .SetGroupName("Applications")
+                .AddConstructor<TraceReplayApplication>()
+                .AddAttribute("Port", "Port on which we listen for incoming packets.",
+                              UintegerValue(1027),
+                              MakeUintegerAccessor(&TraceReplayApplication::m_port),
+                              MakeUintegerChecker<uint16_t>());
+        return tid;
+    }
+
+    TraceReplayApplication::TraceReplayApplication() {
+        NS_LOG_FUNCTION(this);
+    }
+
+    TraceReplayApplication::~TraceReplayApplication() {
+        NS_LOG_FUNCTION(this);
+        m_socket = 0;
+    }
+
+    void
+    TraceReplayApplication::DoDispose(void) {
+        NS_LOG_FUNCTION(this);
+        Application::DoDispose();
+    }
+
+    void
+    TraceReplayApplication::SetupSocket(void) {
+
+        // Bind a socket to the UDP port
+        if (m_socket == 0) {
+            TypeId tid = TypeId::LookupByName("ns3::UdpSocketFactory");
+            m_socket = Socket::CreateSocket(GetNode(), tid);
+            InetSocketAddress local = InetSocketAddress(Ipv4Address::GetAny(), m_port);
+            if (m_socket->Bind(local) == -1) {
+                NS_FATAL_ERROR("Failed to bind socket");
+            }
+        }
+
+        // Receive of packets
+        m_socket->SetRecvCallback(MakeCallback(&TraceReplayApplication::HandleRead, this));
+
+    }
+
+    void
+    TraceReplayApplication::StartApplication(void) {
+        NS_LOG_FUNCTION(this);
+        SetupSocket();
+    }
+
+    void
+    TraceReplayApplication::StopApplication() {
+        NS_LOG_FUNCTION(this);
+        if (m_socket != 0) {
+            m_socket->Close();
+            m_socket->SetRecvCallback(MakeNullCallback < void, Ptr < Socket > > ());
+        }
+    }
+
+    /**
+     * Send a packet of a flow now.
+     *
+     * @param flow_id               Flow identifier
+     * @param targetAddress         Address of the destination endpoint
+     * @param payload_size_byte     UDP payload size (byte), at least the size of the header
+     */
+    void
+    TraceReplayApplication::SendPacket(int64_t flow_id, InetSocketAddress targetAddress, uint32_t payload_size_byte) {
+
+        // A packet at the start of the run can come before the application is started
+        if (m_socket == 0) {
+            SetupSocket();
+        }
+
+        // Header with (flow_id, seq_no, send time)
+        TraceReplayFlowStats& stats = m_outgoing_flows.emplace(flow_id, TraceReplayFlowStats{0, 0, 0}).first->second;
+        IdSeqHeader idSeq;
+        idSeq.SetId(flow_id);
+        idSeq.SetSeq(stats.packets);
+        idSeq.SetTs(Simulator::Now().GetNanoSeconds());
+        if (payload_size_byte < idSeq.GetSerializedSize()) {
+            throw std::invalid_argument(format_string("Replayed packet payload (%u byte) cannot be smaller than its header", payload_size_byte));
+        }
+        stats.packets += 1;
+        stats.bytes += payload_size_byte;
+
+        // Send out the packet to the target address
+        Ptr<Packet> p = Create<Packet>(payload_size_byte - idSeq.GetSerializedSize());
+        p->AddHeader(idSeq);
+        m_socket->SendTo(p, 0, targetAddress);
+
+    }
+
+    void
+    TraceReplayApplication::HandleRead(Ptr <Socket> socket) {
+        NS_LOG_FUNCTION(this << socket);
+        Ptr <Packet> packet;
+        Address from;
+        while ((packet = socket->RecvFrom(from))) {
+            uint32_t payload_size_byte = packet->GetSize();
+            IdSeqHeader incomingIdSeq;
+            packet->RemoveHeader(incomingIdSeq);
+            TraceReplayFlowStats& stats = m_incoming_flows.emplace(incomingIdSeq.GetId(), TraceReplayFlowStats{0, 0, 0}).first->second;
+            stats.packets += 1;
+            stats.bytes += payload_size_byte;
+            stats.latency_sum_ns += Simulator::Now().GetNanoSeconds() - incomingIdSeq.GetTs();
+        }
+    }
+
+    const std::map<int64_t, TraceReplayFlowStats>&
+    TraceReplayApplication::GetOutgoingFlowStats() {
+        return m_outgoing_flows;
+    }
+
+    const std::map<int64_t, TraceReplayFlowStats>&
+    TraceReplayApplication::GetIncomingFlowStats() {
+        return m_incoming_flows;
+    }
+
+} // Namespace ns3
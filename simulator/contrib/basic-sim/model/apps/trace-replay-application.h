@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TRACE_REPLAY_APPLICATION_H
+#define TRACE_REPLAY_APPLICATION_H
+
+#include <map>
+
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/application.h"
+#include "ns3/ptr.h"
+#include "ns3/address.h"
+#include "ns3/id-seq-header.h"
+#include "ns3/exp-util.h"
+
+namespace ns3 {
+
+    class Socket;
+    class Packet;
+
+    /**
+     * Packets and bytes (UDP payload) of a replayed flow which were sent or received,
+     * and the sum of their one-way latencies (only when received).
+     */
+    struct TraceReplayFlowStats {
+        uint64_t packets;
+        uint64_t bytes;
+        int64_t latency_sum_ns;
+    };
+
+    /**
+     * Sends the packets of a replayed trace when told to, and counts what it receives.
+     * The packets are not scheduled by the application itself, but injected one at a
+     * time by the scheduler which reads the trace in order.
+     */
+    class TraceReplayApplication : public Application
+    {
+    public:
+        static TypeId GetTypeId (void);
+        TraceReplayApplication ();
+        virtual ~TraceReplayApplication ();
+        void SendPacket(int64_t flow_id, InetSocketAddress targetAddress, uint32_t payload_size_byte);
+        const std::map<int64_t, TraceReplayFlowStats>& GetOutgoingFlowStats();
+        const std::map<int64_t, TraceReplayFlowStats>& GetIncomingFlowStats();
+
+    protected:
+        virtual void DoDispose (void);
+
+    private:
+        virtual void StartApplication (void);
+        virtual void StopApplication (void);
+        void SetupSocket (void);
+        void HandleRead (Ptr<Socket> socket);
+
+        uint16_t m_port;      //!< Port on which we listen for incoming packets.
+        Ptr<Socket> m_socket; //!< IPv4 Socket
+        std::map<int64_t, TraceReplayFlowStats> m_outgoing_flows; //!< Sent of each flow
+        std::map<int64_t, TraceReplayFlowStats> m_incoming_flows; //!< Received of each flow
+
+    };
+
+} // namespace ns3
+
+#endif /* TRACE_REPLAY_APPLICATION_H */
@@ -27,6 +27,7 @@
 #include "ns3/socket-factory.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/integer.h"
 #include "ns3/abort.h"
 
 #include "udp-burst-application.h"
@@ -55,7 +56,11 @@ namespace ns3 {
                 .AddAttribute("MaxUdpPayloadSizeByte", "Total UDP payload size (byte) before it gets fragmented.",
                               UintegerValue(1472), // 1500 (point-to-point default) - 20 (IP) - 8 (UDP) = 1472
                               MakeUintegerAccessor(&UdpBurstApplication::m_max_udp_payload_size_byte),
-                              MakeUintegerChecker<uint32_t>());
+                              MakeUintegerChecker<uint32_t>())
+                .AddAttribute("PacingBatchWindowNs", "Packets of a burst departing within this window (ns) are sent out in a single event (0: one event per packet).",
+                              IntegerValue(0),
+                              MakeIntegerAccessor(&UdpBurstApplication::m_pacing_batch_window_ns),
+                              MakeIntegerChecker<int64_t>(0));
         return tid;
     }
 
@@ -73,20 +78,43 @@ namespace ns3 {
         return m_max_udp_payload_size_byte;
     }
 
+    void UdpBurstApplication::SetPreciseLogWriter(Ptr<PreciseLogWriter> preciseLogWriter) {
+        m_precise_log_writer = preciseLogWriter;
+    }
+
     void
     UdpBurstApplication::RegisterOutgoingBurst(UdpBurstInfo burstInfo, InetSocketAddress targetAddress, bool enable_precise_logging) {
         NS_ABORT_MSG_IF(burstInfo.GetFromNodeId() != this->GetNode()->GetId(), "Source node identifier is not that of this node.");
         if (m_outgoing_bursts.size() >= 1 && burstInfo.GetStartTimeNs() < std::get<0>(m_outgoing_bursts[m_outgoing_bursts.size() - 1]).GetStartTimeNs()) {
             throw std::runtime_error("Bursts must be added weakly ascending on start time");
         }
+
+        // Registered after the application started (e.g., from a streamed schedule) while it has no next burst scheduled
+        int64_t now_ns = Simulator::Now().GetNanoSeconds();
+        bool schedule_start = m_socket != 0 && m_next_internal_burst_idx == m_outgoing_bursts.size() && !m_startNextBurstEvent.IsRunning();
+        if (schedule_start && burstInfo.GetStartTimeNs() < now_ns) {
+            throw std::runtime_error("Burst is registered after its start time");
+        }
+
         m_outgoing_bursts.push_back(std::make_tuple(burstInfo, targetAddress));
         m_outgoing_bursts_packets_sent_counter.push_back(0);
         m_outgoing_bursts_event_id.push_back(EventId());
         m_outgoing_bursts_enable_precise_logging.push_back(enable_precise_logging);
+        m_outgoing_bursts_precise_log_file.push_back(0);
         if (enable_precise_logging) {
-            std::ofstream ofs;
-            ofs.open(m_baseLogsDir + "/" + format_string("udp_burst_%" PRIu64 "_outgoing.csv", burstInfo.GetUdpBurstId()));
-            ofs.close();
+            std::string filename = m_baseLogsDir + "/" + format_string("udp_burst_%" PRIu64 "_outgoing.csv", burstInfo.GetUdpBurstId());
+            if (m_precise_log_writer != 0) {
+                m_outgoing_bursts_precise_log_file.back() = m_precise_log_writer->OpenFile(filename);
+            } else {
+                std::ofstream ofs;
+                ofs.open(filename);
+                ofs.close();
+            }
+        }
+
+        // Its start is not scheduled by a previous burst, so it is scheduled here
+        if (schedule_start) {
+            m_startNextBurstEvent = Simulator::Schedule(NanoSeconds(burstInfo.GetStartTimeNs() - now_ns), &UdpBurstApplication::StartNextBurst, this);
         }
     }
 
@@ -96,16 +124,23 @@ namespace ns3 {
         m_incoming_bursts.push_back(burstInfo);
         m_incoming_bursts_received_counter[burstInfo.GetUdpBurstId()] = 0;
         m_incoming_bursts_enable_precise_logging[burstInfo.GetUdpBurstId()] = enable_precise_logging;
+        m_incoming_bursts_latency[burstInfo.GetUdpBurstId()] = LatencyHistogram();
         if (enable_precise_logging) {
-            std::ofstream ofs;
-            ofs.open(m_baseLogsDir + "/" + format_string("udp_burst_%" PRIu64 "_incoming.csv", burstInfo.GetUdpBurstId()));
-            ofs.close();
+            std::string filename = m_baseLogsDir + "/" + format_string("udp_burst_%" PRIu64 "_incoming.csv", burstInfo.GetUdpBurstId());
+            if (m_precise_log_writer != 0) {
+                m_incoming_bursts_precise_log_file[burstInfo.GetUdpBurstId()] = m_precise_log_writer->OpenFile(filename);
+            } else {
+                std::ofstream ofs;
+                ofs.open(filename);
+                ofs.close();
+            }
         }
     }
 
     void
     UdpBurstApplication::DoDispose(void) {
         NS_LOG_FUNCTION(this);
+        m_precise_log_writer = 0;
         Application::DoDispose();
     }
 
@@ -158,15 +193,20 @@ namespace ns3 {
     UdpBurstApplication::BurstSendOut(size_t internal_burst_idx)
     {
 
-        // Send out the packet as desired
-        TransmitFullPacket(internal_burst_idx);
+        // Send out the packet departing now, and all others departing within the pacing batch window
+        int64_t now_ns = Simulator::Now().GetNanoSeconds();
+        UdpBurstInfo info = std::get<0>(m_outgoing_bursts[internal_burst_idx]);
+        int64_t end_ns = info.GetStartTimeNs() + info.GetDurationNs();
+        int64_t packet_gap_nanoseconds = std::ceil(1500.0 / (info.GetTargetRateMegabitPerSec() / 8000.0));
+        int64_t departure_time_ns = now_ns;
+        do {
+            TransmitFullPacket(internal_burst_idx);
+            departure_time_ns += packet_gap_nanoseconds;
+        } while (departure_time_ns < end_ns && departure_time_ns < now_ns + m_pacing_batch_window_ns);
 
         // Schedule the next if the packet gap would not exceed the rate
-        uint64_t now_ns = Simulator::Now().GetNanoSeconds();
-        UdpBurstInfo info = std::get<0>(m_outgoing_bursts[internal_burst_idx]);
-        uint64_t packet_gap_nanoseconds = std::ceil(1500.0 / (info.GetTargetRateMegabitPerSec() / 8000.0));
-        if (now_ns + packet_gap_nanoseconds < (uint64_t) (info.GetStartTimeNs() + info.GetDurationNs())) {
-            m_outgoing_bursts_event_id.at(internal_burst_idx) = Simulator::Schedule(NanoSeconds(packet_gap_nanoseconds), &UdpBurstApplication::BurstSendOut, this, internal_burst_idx);
+        if (departure_time_ns < end_ns) {
+            m_outgoing_bursts_event_id.at(internal_burst_idx) = Simulator::Schedule(NanoSeconds(departure_time_ns - now_ns), &UdpBurstApplication::BurstSendOut, this, internal_burst_idx);
         }
 
     }
@@ -178,12 +218,16 @@ namespace ns3 {
         IdSeqHeader idSeq;
         idSeq.SetId(std::get<0>(m_outgoing_bursts[internal_burst_idx]).GetUdpBurstId());
         idSeq.SetSeq(m_outgoing_bursts_packets_sent_counter[internal_burst_idx]);
+        idSeq.SetTs(Simulator::Now().GetNanoSeconds());
 
         // One more packet will be sent out
         m_outgoing_bursts_packets_sent_counter[internal_burst_idx] += 1;
 
         // Log precise timestamp sent away of the sequence packet if needed
-        if (m_outgoing_bursts_enable_precise_logging[internal_burst_idx]) {
+        // (within a pacing batch, that is the start of the batch window)
+        if (m_outgoing_bursts_enable_precise_logging[internal_burst_idx] && m_precise_log_writer != 0) {
+            m_precise_log_writer->Append(m_outgoing_bursts_precise_log_file[internal_burst_idx], idSeq.GetId(), idSeq.GetSeq(), Simulator::Now().GetNanoSeconds());
+        } else if (m_outgoing_bursts_enable_precise_logging[internal_burst_idx]) {
             std::ofstream ofs;
             ofs.open(m_baseLogsDir + "/" + format_string("udp_burst_%" PRIu64 "_outgoing.csv", idSeq.GetId()), std::ofstream::out | std::ofstream::app);
             ofs << idSeq.GetId() << "," << idSeq.GetSeq() << "," << Simulator::Now().GetNanoSeconds() << std::endl;
@@ -226,9 +270,12 @@ namespace ns3 {
 
             // Count packets from incoming bursts
             m_incoming_bursts_received_counter.at(incomingIdSeq.GetId()) += 1;
+            m_incoming_bursts_latency.at(incomingIdSeq.GetId()).Record(Simulator::Now().GetNanoSeconds() - incomingIdSeq.GetTs());
 
             // Log precise timestamp received of the sequence packet if needed
-            if (m_incoming_bursts_enable_precise_logging[incomingIdSeq.GetId()]) {
+            if (m_incoming_bursts_enable_precise_logging[incomingIdSeq.GetId()] && m_precise_log_writer != 0) {
+                m_precise_log_writer->Append(m_incoming_bursts_precise_log_file.at(incomingIdSeq.GetId()), incomingIdSeq.GetId(), incomingIdSeq.GetSeq(), Simulator::Now().GetNanoSeconds());
+            } else if (m_incoming_bursts_enable_precise_logging[incomingIdSeq.GetId()]) {
                 std::ofstream ofs;
                 ofs.open(m_baseLogsDir + "/" + format_string("udp_burst_%" PRIu64 "_incoming.csv", incomingIdSeq.GetId()), std::ofstream::out | std::ofstream::app);
                 ofs << incomingIdSeq.GetId() << "," << incomingIdSeq.GetSeq() << "," << Simulator::Now().GetNanoSeconds() << std::endl;
@@ -272,4 +319,8 @@ namespace ns3 {
         return m_incoming_bursts_received_counter.at(udp_burst_id);
     }
 
+    const LatencyHistogram& UdpBurstApplication::GetLatencyHistogramOf(int64_t udp_burst_id) {
+        return m_incoming_bursts_latency.at(udp_burst_id);
+    }
+
 } // Namespace ns3
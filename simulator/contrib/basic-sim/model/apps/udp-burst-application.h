@@ -31,6 +31,8 @@
 #include "ns3/id-seq-header.h"
 #include "ns3/string.h"
 #include "ns3/exp-util.h"
+#include "ns3/precise-log-writer.h"
+#include "ns3/latency-histogram.h"
 
 namespace ns3 {
 
@@ -44,6 +46,7 @@ namespace ns3 {
         UdpBurstApplication ();
         virtual ~UdpBurstApplication ();
         uint32_t GetMaxUdpPayloadSizeByte();
+        void SetPreciseLogWriter(Ptr<PreciseLogWriter> preciseLogWriter);
         void RegisterOutgoingBurst(UdpBurstInfo burstInfo, InetSocketAddress targetAddress, bool enable_precise_logging);
         void RegisterIncomingBurst(UdpBurstInfo burstInfo, bool enable_precise_logging);
         void StartNextBurst();
@@ -53,6 +56,7 @@ namespace ns3 {
         std::vector<std::tuple<UdpBurstInfo, uint64_t>> GetIncomingBurstsInformation();
         uint64_t GetSentCounterOf(int64_t udp_burst_id);
         uint64_t GetReceivedCounterOf(int64_t udp_burst_id);
+        const LatencyHistogram& GetLatencyHistogramOf(int64_t udp_burst_id);
 
     protected:
         virtual void DoDispose (void);
@@ -64,22 +68,27 @@ namespace ns3 {
 
         uint16_t m_port;      //!< Port on which we listen for incoming packets.
         uint32_t m_max_udp_payload_size_byte;  //!< Maximum size of UDP payload before getting fragmented
+        int64_t m_pacing_batch_window_ns; //!< Packets departing within this window are sent in one event (0: one event per packet)
         Ptr<Socket> m_socket; //!< IPv4 Socket
         std::string m_baseLogsDir; //!< Where the UDP burst logs will be written to:
                                    //!<   logs_dir/udp_burst_[id]_{incoming, outgoing}.csv
         EventId m_startNextBurstEvent; //!< Event to start next burst
+        Ptr<PreciseLogWriter> m_precise_log_writer; //!< If set, precise logs are appended to it instead of to the files directly
 
         // Outgoing bursts
         std::vector<std::tuple<UdpBurstInfo, InetSocketAddress>> m_outgoing_bursts; //!< Weakly ascending on start time list of bursts
         std::vector<uint64_t> m_outgoing_bursts_packets_sent_counter; //!< Amount of UDP packets sent out already for each burst
         std::vector<EventId> m_outgoing_bursts_event_id; //!< Event ID of the outgoing burst send loop
         std::vector<bool> m_outgoing_bursts_enable_precise_logging; //!< True iff enable precise logging for each burst
+        std::vector<uint32_t> m_outgoing_bursts_precise_log_file; //!< File of the precise log writer for each burst
         size_t m_next_internal_burst_idx; //!< Next burst index to send out
 
         // Incoming bursts
         std::vector<UdpBurstInfo> m_incoming_bursts;
         std::map<int64_t, uint64_t> m_incoming_bursts_received_counter;       //!< Counter for how many packets received
         std::map<int64_t, uint64_t> m_incoming_bursts_enable_precise_logging; //!< True iff enable precise logging for each burst
+        std::map<int64_t, uint32_t> m_incoming_bursts_precise_log_file;       //!< File of the precise log writer for each burst
+        std::map<int64_t, LatencyHistogram> m_incoming_bursts_latency;        //!< One-way latency of the packets received
 
     };
 
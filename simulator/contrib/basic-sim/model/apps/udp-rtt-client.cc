@@ -26,7 +26,10 @@
 #include "ns3/socket-factory.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/trace-source-accessor.h"
+#include <cmath>
+#include <algorithm>
 #include "udp-rtt-client.h"
 
 namespace ns3 {
@@ -65,7 +68,12 @@ UdpRttClient::GetTypeId(void) {
                           "To node identifier",
                           UintegerValue(0),
                           MakeUintegerAccessor(&UdpRttClient::m_toNodeId),
-                          MakeUintegerChecker<uint64_t>());
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("KeepAllPings",
+                          "Keep the timestamps of every ping (else only the statistics are kept)",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&UdpRttClient::m_keepAllPings),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -74,6 +82,14 @@ UdpRttClient::UdpRttClient() {
     m_socket = 0;
     m_sent = 0;
     m_sendEvent = EventId();
+    m_firstSendTimeNs = 0;
+    m_received = 0;
+    m_sumLatencyToThereNs = 0.0;
+    m_sumLatencyFromThereNs = 0.0;
+    m_minRttNs = -1;
+    m_maxRttNs = -1;
+    m_rttMeanNs = 0.0;
+    m_rttM2 = 0.0;
 }
 
 UdpRttClient::~UdpRttClient() {
@@ -141,9 +157,13 @@ UdpRttClient::Send(void) {
     p->AddHeader(seqTs);
 
     // Timestamps
-    m_sendRequestTimestamps.push_back(Simulator::Now().GetNanoSeconds());
-    m_replyTimestamps.push_back(-1);
-    m_receiveReplyTimestamps.push_back(-1);
+    if (m_keepAllPings) {
+        m_sendRequestTimestamps.push_back(Simulator::Now().GetNanoSeconds());
+        m_replyTimestamps.push_back(-1);
+        m_receiveReplyTimestamps.push_back(-1);
+    } else if (m_sent == 0) {
+        m_firstSendTimeNs = Simulator::Now().GetNanoSeconds();
+    }
     m_sent++;
 
     // Send out
@@ -168,8 +188,27 @@ UdpRttClient::HandleRead(Ptr <Socket> socket) {
         uint32_t seqNo = incomingSeqTs.GetSeq();
 
         // Update the local timestamps
-        m_replyTimestamps[seqNo] = incomingSeqTs.GetTs().GetNanoSeconds();
-        m_receiveReplyTimestamps[seqNo] = Simulator::Now().GetNanoSeconds();
+        int64_t send_request_ns;
+        int64_t reply_ns = incomingSeqTs.GetTs().GetNanoSeconds();
+        int64_t receive_reply_ns = Simulator::Now().GetNanoSeconds();
+        if (m_keepAllPings) {
+            send_request_ns = m_sendRequestTimestamps[seqNo];
+            m_replyTimestamps[seqNo] = reply_ns;
+            m_receiveReplyTimestamps[seqNo] = receive_reply_ns;
+        } else {
+            send_request_ns = m_firstSendTimeNs + seqNo * m_interval.GetNanoSeconds();
+        }
+
+        // Update the statistics
+        int64_t rtt_ns = receive_reply_ns - send_request_ns;
+        m_received++;
+        m_sumLatencyToThereNs += reply_ns - send_request_ns;
+        m_sumLatencyFromThereNs += receive_reply_ns - reply_ns;
+        m_minRttNs = m_minRttNs == -1 ? rtt_ns : std::min(m_minRttNs, rtt_ns);
+        m_maxRttNs = std::max(m_maxRttNs, rtt_ns);
+        double delta = rtt_ns - m_rttMeanNs;
+        m_rttMeanNs += delta / m_received;
+        m_rttM2 += delta * (rtt_ns - m_rttMeanNs);
 
 
     }
@@ -199,4 +238,35 @@ std::vector<int64_t> UdpRttClient::GetReceiveReplyTimestamps() {
     return m_receiveReplyTimestamps;
 }
 
+uint32_t UdpRttClient::GetReceived() {
+    return m_received;
+}
+
+double UdpRttClient::GetMeanLatencyToThereNs() {
+    return m_received == 0 ? -1 : m_sumLatencyToThereNs / m_received;
+}
+
+double UdpRttClient::GetMeanLatencyFromThereNs() {
+    return m_received == 0 ? -1 : m_sumLatencyFromThereNs / m_received;
+}
+
+int64_t UdpRttClient::GetMinRttNs() {
+    return m_minRttNs;
+}
+
+int64_t UdpRttClient::GetMaxRttNs() {
+    return m_maxRttNs;
+}
+
+double UdpRttClient::GetMeanRttNs() {
+    return m_received == 0 ? -1 : m_rttMeanNs;
+}
+
+double UdpRttClient::GetSampleStdRttNs() {
+    if (m_received == 0) {
+        return -1;
+    }
+    return m_received > 1 ? std::sqrt(m_rttM2 / (m_received - 1)) : 0.0;
+}
+
 } // Namespace ns3
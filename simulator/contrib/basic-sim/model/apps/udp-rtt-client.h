@@ -44,6 +44,13 @@ public:
   std::vector<int64_t> GetSendRequestTimestamps();
   std::vector<int64_t> GetReplyTimestamps();
   std::vector<int64_t> GetReceiveReplyTimestamps();
+  uint32_t GetReceived();
+  double GetMeanLatencyToThereNs();
+  double GetMeanLatencyFromThereNs();
+  int64_t GetMinRttNs();
+  int64_t GetMaxRttNs();
+  double GetMeanRttNs();
+  double GetSampleStdRttNs();
 
 protected:
   virtual void DoDispose (void);
@@ -69,6 +76,17 @@ private:
   std::vector<int64_t> m_replyTimestamps;
   std::vector<int64_t> m_receiveReplyTimestamps;
 
+  // Statistics aggregated online, such that the timestamps need not be kept
+  bool m_keepAllPings; //!< Whether to keep the timestamps of every ping
+  int64_t m_firstSendTimeNs; //!< Pings are sent at this time plus a multiple of the interval
+  uint32_t m_received;
+  double m_sumLatencyToThereNs;
+  double m_sumLatencyFromThereNs;
+  int64_t m_minRttNs;
+  int64_t m_maxRttNs;
+  double m_rttMeanNs; //!< Running mean (Welford)
+  double m_rttM2; //!< Running sum of squared differences from the mean (Welford)
+
 };
 
 } // namespace ns3
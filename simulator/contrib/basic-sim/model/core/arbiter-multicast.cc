@@ -17,81 +17,500 @@ ArbiterMulticast::ArbiterMulticast(
         NodeContainer nodes,
         Ptr<TopologyPtop> topology,
         std::vector<std::vector<uint32_t>> candidate_list
-) : ArbiterEcmp(this_node, nodes, topology, candidate_list) {}
+) : ArbiterEcmp(this_node, nodes, topology, candidate_list) {
+    m_multicast_slot_keys = std::vector<uint64_t>(16, 0);
+    m_multicast_slot_entry_idxs = std::vector<int32_t>(16, -1);
+}
+
+/**
+ * Mix the 64-bit (origin, group) key such that consecutive group addresses
+ * do not end up in consecutive slots (splitmix64 finalizer).
+ *
+ * @param key   (origin << 32) | group
+ *
+ * @return Hash value
+ */
+static inline uint64_t HashMulticastKey(uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+static inline uint64_t MakeMulticastKey(uint32_t origin, uint32_t group) {
+    return (((uint64_t) origin) << 32) | group;
+}
+
+int32_t ArbiterMulticast::FindMulticastSlot(uint64_t key) {
+    size_t mask = m_multicast_slot_keys.size() - 1;
+    size_t slot = HashMulticastKey(key) & mask;
+    while (m_multicast_slot_entry_idxs[slot] != -1) {
+        if (m_multicast_slot_keys[slot] == key) {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+void ArbiterMulticast::InsertMulticastSlot(uint64_t key, int32_t entry_idx) {
+
+    // Keep the load factor at most 1/2 such that probe sequences stay short
+    if ((m_multicast_num_used_slots + 1) * 2 > m_multicast_slot_keys.size()) {
+        GrowMulticastSlots();
+    }
+
+    size_t mask = m_multicast_slot_keys.size() - 1;
+    size_t slot = HashMulticastKey(key) & mask;
+    while (m_multicast_slot_entry_idxs[slot] != -1) {
+        if (m_multicast_slot_keys[slot] == key) {
+            m_multicast_slot_entry_idxs[slot] = entry_idx;
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+    m_multicast_slot_keys[slot] = key;
+    m_multicast_slot_entry_idxs[slot] = entry_idx;
+    m_multicast_num_used_slots++;
+
+}
+
+void ArbiterMulticast::GrowMulticastSlots() {
+    std::vector<uint64_t> old_keys = std::move(m_multicast_slot_keys);
+    std::vector<int32_t> old_entry_idxs = std::move(m_multicast_slot_entry_idxs);
+    m_multicast_slot_keys = std::vector<uint64_t>(old_keys.size() * 2, 0);
+    m_multicast_slot_entry_idxs = std::vector<int32_t>(old_keys.size() * 2, -1);
+    size_t mask = m_multicast_slot_keys.size() - 1;
+    for (size_t i = 0; i < old_keys.size(); i++) {
+        if (old_entry_idxs[i] != -1) {
+            size_t slot = HashMulticastKey(old_keys[i]) & mask;
+            while (m_multicast_slot_entry_idxs[slot] != -1) {
+                slot = (slot + 1) & mask;
+            }
+            m_multicast_slot_keys[slot] = old_keys[i];
+            m_multicast_slot_entry_idxs[slot] = old_entry_idxs[i];
+        }
+    }
+}
+
+void ArbiterMulticast::RebuildMulticastSlots() {
+    size_t num_slots = 16;
+    while (m_multicast_entries.size() * 2 * 2 > num_slots) {
+        num_slots *= 2;
+    }
+    m_multicast_slot_keys = std::vector<uint64_t>(num_slots, 0);
+    m_multicast_slot_entry_idxs = std::vector<int32_t>(num_slots, -1);
+    m_multicast_num_used_slots = 0;
+    for (size_t i = 0; i < m_multicast_entries.size(); i++) {
+        const MulticastForwardingEntry& entry = m_multicast_entries[i];
+        InsertMulticastSlot(MakeMulticastKey(entry.origin, entry.group), i);
+        if (entry.origin != 0 && FindMulticastSlot(MakeMulticastKey(0, entry.group)) == -1) {
+            InsertMulticastSlot(MakeMulticastKey(0, entry.group), i);
+        }
+    }
+}
+
+/**
+ * Find the group range which contains the group.
+ *
+ * @param group     Multicast group
+ *
+ * @return Index of the range, or -1 if the group is not in a range
+ */
+int32_t ArbiterMulticast::FindMulticastRange(uint32_t group) {
+    auto it = std::upper_bound(m_multicast_ranges.begin(), m_multicast_ranges.end(), group, [](uint32_t g, const MulticastGroupRange& range) {
+        return g < range.group_lo;
+    });
+    if (it == m_multicast_ranges.begin()) {
+        return -1;
+    }
+    --it;
+    return group <= it->group_hi ? (int32_t) (it - m_multicast_ranges.begin()) : -1;
+}
+
+/**
+ * Take the group out of its range (if it is in one) and give it its own entry again,
+ * such that it can be changed without affecting the other groups of the range.
+ *
+ * @param group     Multicast group
+ */
+void ArbiterMulticast::SplitMulticastRange(uint32_t group) {
+    int32_t range_idx = FindMulticastRange(group);
+    if (range_idx == -1) {
+        return;
+    }
+    MulticastGroupRange range = m_multicast_ranges[range_idx];
+
+    // Remaining parts on either side
+    std::vector<MulticastGroupRange> parts;
+    if (range.group_lo < group) {
+        parts.push_back({range.origin, range.group_lo, group - 1, range.input_if_idx, range.oif_set_idx});
+    }
+    if (group < range.group_hi) {
+        parts.push_back({range.origin, group + 1, range.group_hi, range.input_if_idx, range.oif_set_idx});
+    }
+    m_multicast_ranges.erase(m_multicast_ranges.begin() + range_idx);
+    m_multicast_ranges.insert(m_multicast_ranges.begin() + range_idx, parts.begin(), parts.end());
+    m_multicast_num_range_groups--;
+
+    // The group gets its own entry (each part and the entry refer to the set)
+    m_multicast_oif_sets[range.oif_set_idx].ref_count += parts.size();
+    m_multicast_entries.push_back({range.origin, group, range.input_if_idx, range.oif_set_idx});
+    int32_t entry_idx = m_multicast_entries.size() - 1;
+    InsertMulticastSlot(MakeMulticastKey(range.origin, group), entry_idx);
+    if (range.origin != 0) {
+        InsertMulticastSlot(MakeMulticastKey(0, group), entry_idx);
+    }
+}
+
+/**
+ * Get the output interface set, adding it if there is none yet which is the same.
+ * The caller holds a reference to it, which must be released with ReleaseOifSet().
+ *
+ * @param out_if_idxs   Output interfaces (any order, duplicates are ignored)
+ *
+ * @return Index of the output interface set
+ */
+uint32_t ArbiterMulticast::InternOifSet(std::vector<uint32_t> out_if_idxs) {
+    std::sort(out_if_idxs.begin(), out_if_idxs.end());
+    out_if_idxs.erase(std::unique(out_if_idxs.begin(), out_if_idxs.end()), out_if_idxs.end());
+
+    // Already there
+    auto it = m_multicast_oif_set_index.find(out_if_idxs);
+    if (it != m_multicast_oif_set_index.end()) {
+        m_multicast_oif_sets[it->second].ref_count++;
+        return it->second;
+    }
+
+    // Re-use a free set of the same capacity, else append to the arena
+    uint32_t capacity = 1;
+    while (capacity < out_if_idxs.size()) {
+        capacity *= 2;
+    }
+    uint32_t oif_set_idx;
+    std::vector<uint32_t>& free_sets = m_multicast_free_oif_sets[capacity];
+    if (!free_sets.empty()) {
+        oif_set_idx = free_sets.back();
+        free_sets.pop_back();
+    } else {
+        m_multicast_oif_sets.push_back({(uint32_t) m_multicast_out_if_arena.size(), 0, capacity, 0});
+        m_multicast_out_if_arena.resize(m_multicast_out_if_arena.size() + capacity, 0);
+        oif_set_idx = m_multicast_oif_sets.size() - 1;
+    }
+    MulticastOifSet& oif_set = m_multicast_oif_sets[oif_set_idx];
+    std::copy(out_if_idxs.begin(), out_if_idxs.end(), m_multicast_out_if_arena.begin() + oif_set.offset);
+    oif_set.num_out_ifs = out_if_idxs.size();
+    oif_set.ref_count = 1;
+    m_multicast_oif_set_index[out_if_idxs] = oif_set_idx;
+    return oif_set_idx;
+}
+
+void ArbiterMulticast::ReleaseOifSet(uint32_t oif_set_idx) {
+    MulticastOifSet& oif_set = m_multicast_oif_sets[oif_set_idx];
+    oif_set.ref_count--;
+    if (oif_set.ref_count == 0) {
+        m_multicast_oif_set_index.erase(GetOifSet(oif_set_idx));
+        m_multicast_free_oif_sets[oif_set.capacity].push_back(oif_set_idx);
+    }
+}
+
+std::vector<uint32_t> ArbiterMulticast::GetOifSet(uint32_t oif_set_idx) {
+    const MulticastOifSet& oif_set = m_multicast_oif_sets[oif_set_idx];
+    return std::vector<uint32_t>(
+            m_multicast_out_if_arena.begin() + oif_set.offset,
+            m_multicast_out_if_arena.begin() + oif_set.offset + oif_set.num_out_ifs
+    );
+}
+
+void ArbiterMulticast::SetEntryOifSet(MulticastForwardingEntry& entry, std::vector<uint32_t> out_if_idxs) {
+    uint32_t new_oif_set_idx = InternOifSet(out_if_idxs); // Before release, as it can be the same set
+    ReleaseOifSet(entry.oif_set_idx);
+    entry.oif_set_idx = new_oif_set_idx;
+}
+
+/**
+ * Look up the forwarding entry of (origin, group).
+ *
+ * @param origin            Origin (source IP address)
+ * @param group             Multicast group
+ * @param input_if_idx      (Output) Input interface of the entry, only set if there is one
+ *
+ * @return Index of the output interface set, or -1 if there is no entry
+ */
+int32_t ArbiterMulticast::LookupMulticastOifSet(uint32_t origin, uint32_t group, uint32_t& input_if_idx) {
+
+    // Source specific first
+    int32_t slot = FindMulticastSlot(MakeMulticastKey(origin, group));
+    if (slot == -1) {
+        slot = FindMulticastSlot(MakeMulticastKey(0, group)); // Any source
+    }
+    if (slot != -1) {
+        const MulticastForwardingEntry& entry = m_multicast_entries[m_multicast_slot_entry_idxs[slot]];
+        input_if_idx = entry.input_if_idx;
+        return entry.oif_set_idx;
+    }
+
+    // Aggregated (the only entry of the group, so both source specific and any source)
+    if (!m_multicast_ranges.empty()) {
+        int32_t range_idx = FindMulticastRange(group);
+        if (range_idx != -1) {
+            input_if_idx = m_multicast_ranges[range_idx].input_if_idx;
+            return m_multicast_ranges[range_idx].oif_set_idx;
+        }
+    }
+
+    return -1;
+}
 
 void ArbiterMulticast::AddMulticastRoute(Ipv4Address origin, Ipv4Address group, uint32_t inputInterface, std::vector<uint32_t> outputInterfaces) {
-    //print mutlicast route
-    std::cout << " > Adding a multicast route for node " << ArbiterMulticast::m_node_id;
-    std::cout << "  >>> " << origin << " " << group << " " << inputInterface << " outputIf:";
-    for(int32_t oif: outputInterfaces){
-        std::cout << " " << oif;
+    // Interface 0 is the loop-back, it is never an output interface
+    std::vector<uint32_t> out_if_idxs;
+    for (uint32_t oif : outputInterfaces) {
+        if (oif != 0) {
+            out_if_idxs.push_back(oif);
+        }
+    }
+
+    // A group in a range cannot have other entries
+    SplitMulticastRange(group.Get());
+
+    // Replace the entry if there is already one for this (origin, group)
+    int32_t slot = FindMulticastSlot(MakeMulticastKey(origin.Get(), group.Get()));
+    if (slot != -1) {
+        MulticastForwardingEntry& entry = m_multicast_entries[m_multicast_slot_entry_idxs[slot]];
+        SetEntryOifSet(entry, out_if_idxs);
+        entry.input_if_idx = inputInterface;
+        return;
+    }
+
+    // New entry
+    MulticastForwardingEntry entry;
+    entry.origin = origin.Get();
+    entry.group = group.Get();
+    entry.input_if_idx = inputInterface;
+    entry.oif_set_idx = InternOifSet(out_if_idxs);
+    m_multicast_entries.push_back(entry);
+    int32_t entry_idx = m_multicast_entries.size() - 1;
+
+    // Index both source-specific and as any-source (if not yet taken for this group)
+    InsertMulticastSlot(MakeMulticastKey(entry.origin, entry.group), entry_idx);
+    if (entry.origin != 0 && FindMulticastSlot(MakeMulticastKey(0, entry.group)) == -1) {
+        InsertMulticastSlot(MakeMulticastKey(0, entry.group), entry_idx);
     }
-    std::cout << std::endl;
 
-    Ipv4MulticastRoutingTableEntry *route = new Ipv4MulticastRoutingTableEntry ();
-    *route = Ipv4MulticastRoutingTableEntry::CreateMulticastRoute (origin, group, inputInterface, outputInterfaces);
-    m_multicast_routes.push_back(route);
 }
 
 void ArbiterMulticast::SetMulticastRoutes(std::list<Ipv4MulticastRoutingTableEntry *> multicast_routes) {
-    m_multicast_routes = multicast_routes;
+    m_multicast_entries.clear();
+    m_multicast_slot_keys = std::vector<uint64_t>(16, 0);
+    m_multicast_slot_entry_idxs = std::vector<int32_t>(16, -1);
+    m_multicast_num_used_slots = 0;
+    m_multicast_ranges.clear();
+    m_multicast_num_range_groups = 0;
+    m_multicast_oif_sets.clear();
+    m_multicast_out_if_arena.clear();
+    m_multicast_oif_set_index.clear();
+    m_multicast_free_oif_sets.clear();
+    for (Ipv4MulticastRoutingTableEntry *route : multicast_routes) {
+        std::vector<uint32_t> out_if_idxs;
+        for (uint32_t j = 0; j < route->GetNOutputInterfaces(); j++) {
+            out_if_idxs.push_back(route->GetOutputInterface(j));
+        }
+        AddMulticastRoute(route->GetOrigin(), route->GetGroup(), route->GetInputInterface(), out_if_idxs);
+    }
+}
+
+/**
+ * Graft: add a single output interface to the entry of (origin, group), or create the entry
+ * if there is none yet. Other entries are not touched.
+ *
+ * @param origin            Origin (source IP address)
+ * @param group             Multicast group
+ * @param inputInterface    Input interface, only used if the entry is created or pruned empty (that of an entry in use is kept)
+ * @param outputInterface   Output interface to add (no-op if it is already one)
+ */
+void ArbiterMulticast::AddMulticastOutputInterface(Ipv4Address origin, Ipv4Address group, uint32_t inputInterface, uint32_t outputInterface) {
+    if (outputInterface == 0) {
+        throw std::invalid_argument("The loop-back interface cannot be a multicast output interface");
+    }
+    SplitMulticastRange(group.Get());
+    int32_t slot = FindMulticastSlot(MakeMulticastKey(origin.Get(), group.Get()));
+    if (slot == -1) {
+        AddMulticastRoute(origin, group, inputInterface, {outputInterface});
+        return;
+    }
+    MulticastForwardingEntry& entry = m_multicast_entries[m_multicast_slot_entry_idxs[slot]];
+    std::vector<uint32_t> out_if_idxs = GetOifSet(entry.oif_set_idx);
+    if (out_if_idxs.empty()) {
+        entry.input_if_idx = inputInterface;
+    }
+    out_if_idxs.push_back(outputInterface);
+    SetEntryOifSet(entry, out_if_idxs);
+}
+
+/**
+ * Prune: remove a single output interface from the entry of (origin, group). The entry itself
+ * is kept, such that it can be grafted again; without output interfaces it is a drop.
+ *
+ * @param origin            Origin (source IP address)
+ * @param group             Multicast group
+ * @param outputInterface   Output interface to remove (no-op if it is not one)
+ */
+void ArbiterMulticast::RemoveMulticastOutputInterface(Ipv4Address origin, Ipv4Address group, uint32_t outputInterface) {
+    SplitMulticastRange(group.Get());
+    int32_t slot = FindMulticastSlot(MakeMulticastKey(origin.Get(), group.Get()));
+    if (slot == -1) {
+        return;
+    }
+    MulticastForwardingEntry& entry = m_multicast_entries[m_multicast_slot_entry_idxs[slot]];
+    std::vector<uint32_t> out_if_idxs = GetOifSet(entry.oif_set_idx);
+    out_if_idxs.erase(std::remove(out_if_idxs.begin(), out_if_idxs.end(), outputInterface), out_if_idxs.end());
+    SetEntryOifSet(entry, out_if_idxs);
+}
+
+uint32_t ArbiterMulticast::GetNumMulticastOutputInterfaces(Ipv4Address origin, Ipv4Address group) {
+    uint32_t input_if_idx;
+    int32_t oif_set_idx = LookupMulticastOifSet(origin.Get(), group.Get(), input_if_idx);
+    return oif_set_idx == -1 ? 0 : m_multicast_oif_sets[oif_set_idx].num_out_ifs;
+}
+
+/**
+ * Replace every run of consecutive groups of the same origin, input interface and output
+ * interface set by a single group range. Only groups which have a single entry are aggregated.
+ * Lookups of the groups are unchanged.
+ */
+void ArbiterMulticast::AggregateMulticastRoutes() {
+
+    // Groups with a single entry
+    std::map<uint32_t, uint32_t> group_to_num_entries;
+    for (const MulticastForwardingEntry& entry : m_multicast_entries) {
+        group_to_num_entries[entry.group]++;
+    }
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < m_multicast_entries.size(); i++) {
+        if (group_to_num_entries[m_multicast_entries[i].group] == 1) {
+            candidates.push_back(i);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [this](size_t a, size_t b) {
+        const MulticastForwardingEntry& ea = m_multicast_entries[a];
+        const MulticastForwardingEntry& eb = m_multicast_entries[b];
+        return std::make_pair(ea.origin, ea.group) < std::make_pair(eb.origin, eb.group);
+    });
+
+    // Runs of at least two become a range
+    std::vector<bool> aggregated(m_multicast_entries.size(), false);
+    size_t run_start = 0;
+    for (size_t i = 1; i <= candidates.size(); i++) {
+        bool continues = false;
+        if (i < candidates.size()) {
+            const MulticastForwardingEntry& prev = m_multicast_entries[candidates[i - 1]];
+            const MulticastForwardingEntry& cur = m_multicast_entries[candidates[i]];
+            continues = cur.origin == prev.origin && cur.group == prev.group + 1
+                        && cur.input_if_idx == prev.input_if_idx && cur.oif_set_idx == prev.oif_set_idx;
+        }
+        if (!continues) {
+            size_t run_length = i - run_start;
+            if (run_length >= 2) {
+                const MulticastForwardingEntry& first = m_multicast_entries[candidates[run_start]];
+                const MulticastForwardingEntry& last = m_multicast_entries[candidates[i - 1]];
+                m_multicast_ranges.push_back({first.origin, first.group, last.group, first.input_if_idx, first.oif_set_idx});
+                m_multicast_num_range_groups += run_length;
+                m_multicast_oif_sets[first.oif_set_idx].ref_count -= run_length - 1;
+                for (size_t j = run_start; j < i; j++) {
+                    aggregated[candidates[j]] = true;
+                }
+            }
+            run_start = i;
+        }
+    }
+    std::sort(m_multicast_ranges.begin(), m_multicast_ranges.end(), [](const MulticastGroupRange& a, const MulticastGroupRange& b) {
+        return a.group_lo < b.group_lo;
+    });
+
+    // Keep the other entries (in order of addition) and index them again
+    std::vector<MulticastForwardingEntry> remaining;
+    for (size_t i = 0; i < m_multicast_entries.size(); i++) {
+        if (!aggregated[i]) {
+            remaining.push_back(m_multicast_entries[i]);
+        }
+    }
+    m_multicast_entries = std::move(remaining);
+    RebuildMulticastSlots();
+
+}
+
+size_t ArbiterMulticast::GetNumMulticastRoutes() {
+    return m_multicast_entries.size() + m_multicast_num_range_groups;
+}
+
+size_t ArbiterMulticast::GetNumMulticastForwardingEntries() {
+    return m_multicast_entries.size() + m_multicast_ranges.size();
+}
+
+size_t ArbiterMulticast::GetNumMulticastGroupRanges() {
+    return m_multicast_ranges.size();
+}
+
+size_t ArbiterMulticast::GetNumMulticastOifSets() {
+    return m_multicast_oif_set_index.size();
+}
+
+/**
+ * Size of the entries, group ranges and live output interface sets (excluding the hash table).
+ */
+uint64_t ArbiterMulticast::GetMulticastStateSizeByte() {
+    uint64_t size_byte = m_multicast_entries.size() * sizeof(MulticastForwardingEntry)
+                         + m_multicast_ranges.size() * sizeof(MulticastGroupRange);
+    for (const std::pair<const std::vector<uint32_t>, uint32_t>& it : m_multicast_oif_set_index) {
+        size_byte += sizeof(MulticastOifSet) + m_multicast_oif_sets[it.second].capacity * sizeof(uint32_t);
+    }
+    return size_byte;
+}
+
+/**
+ * Size the same state would have with an entry of its own for every group, each with its own
+ * output interface list (excluding the hash table).
+ */
+uint64_t ArbiterMulticast::GetMulticastStateUncompressedSizeByte() {
+    uint64_t size_byte = GetNumMulticastRoutes() * sizeof(MulticastForwardingEntry);
+    for (const MulticastForwardingEntry& entry : m_multicast_entries) {
+        size_byte += m_multicast_oif_sets[entry.oif_set_idx].num_out_ifs * sizeof(uint32_t);
+    }
+    for (const MulticastGroupRange& range : m_multicast_ranges) {
+        size_byte += (uint64_t) (range.group_hi - range.group_lo + 1) * m_multicast_oif_sets[range.oif_set_idx].num_out_ifs * sizeof(uint32_t);
+    }
+    return size_byte;
 }
 
 ArbiterResult ArbiterMulticast::DecideMulticast(int32_t source_node_id, Ptr<const Packet> pkt, Ipv4Header const &ipHeader) {
-    //look up without input interface, in other words, interface is IF_ANY
+    //look up without input interface, the routing checks it against the one of the entry (reverse path)
     Ipv4Address group = ipHeader.GetDestination();
     Ipv4Address origin = ipHeader.GetSource();
     int32_t origin_id = source_node_id;
-    uint32_t interface = Ipv4::IF_ANY;
-
-    NS_LOG_FUNCTION (this << origin << " " << group << " " << interface);
-
-    Ptr<Ipv4MulticastRoute> mrtentry = 0;
-
-    for (auto i = m_multicast_routes.begin (); 
-        i != m_multicast_routes.end (); 
-        i++) {
-        Ipv4MulticastRoutingTableEntry *route = *i;
-        //
-        // We've been passed an origin address, a multicast group address and an 
-        // interface index.  We have to decide if the current route in the list is
-        // a match.
-        //
-        // The first case is the restrictive case where the origin, group and index
-        // matches.
-        //
-        if (origin == route->GetOrigin () && group == route->GetGroup ()) {
-            // Skipping this case (SSM) for now
-            NS_LOG_LOGIC ("Found multicast source specific route" << *i);
-        }
-        if (group == route->GetGroup ()) {
-            if (interface == Ipv4::IF_ANY || interface == route->GetInputInterface ()) {
-                NS_LOG_LOGIC ("Found multicast route" << *i);
-                ArbiterResult result = ArbiterResult(false, 0, 0);
-                result.SetIsMulticast(true);
-                if(origin_id == m_node_id) { //outbound packet, turns to unicast
-                    result.SetIsMulticastOutbound(true);
-                    if (route->GetNOutputInterfaces() != 1){
-                        throw std::runtime_error("outbound multicast route num of out if != 1");
-                    }
-                    uint32_t out_if = route->GetOutputInterface(0);
-                    result.SetOutIfIdx(out_if);
-                }
-                else{ //multicast forwarding
-                    std::vector<uint32_t> out_if_idxs;
-                    for (uint32_t j = 0; j < route->GetNOutputInterfaces (); j++) {
-                        if (route->GetOutputInterface (j)) {
-                            NS_LOG_LOGIC ("Found output interface index " << route->GetOutputInterface (j));
-                            out_if_idxs.push_back(route->GetOutputInterface(j));
-                        }
-                    }
-                    result.SetOutIfIdxs(out_if_idxs);
-                }
-                return result;
-            }
+
+    NS_LOG_FUNCTION (this << origin << " " << group);
+
+    uint32_t input_if_idx = Ipv4::IF_ANY;
+    int32_t oif_set_idx = LookupMulticastOifSet(origin.Get(), group.Get(), input_if_idx);
+    if (oif_set_idx == -1 || m_multicast_oif_sets[oif_set_idx].num_out_ifs == 0) { // No entry, or all of it was pruned
+        return ArbiterResult(true, 0, 0);
+    }
+    const MulticastOifSet& oif_set = m_multicast_oif_sets[oif_set_idx];
+
+    ArbiterResult result = ArbiterResult(false, 0, 0);
+    result.SetIsMulticast(true);
+    result.SetOutIfIdxs(m_multicast_out_if_arena.data() + oif_set.offset, oif_set.num_out_ifs);
+    result.SetInputIfIdxMulticast(input_if_idx);
+    if (origin_id == m_node_id) { //outbound packet
+        result.SetIsMulticastOutbound(true);
+        if (oif_set.num_out_ifs == 1) { //turns to unicast
+            result.SetOutIfIdx(m_multicast_out_if_arena[oif_set.offset]);
         }
     }
-    return ArbiterResult(true, 0, 0);
+    return result;
 };
 
 }
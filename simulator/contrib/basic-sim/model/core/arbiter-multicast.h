@@ -1,6 +1,8 @@
 #ifndef ARBITER_MULTICAST_H
 #define ARBITER_MULTICAST_H
 
+#include <map>
+#include <algorithm>
 #include "ns3/arbiter-ptop.h"
 #include "ns3/topology-ptop.h"
 #include "ns3/arbiter-ecmp.h"
@@ -13,6 +15,42 @@
 namespace ns3 {
 class Ipv4MulticastRoutingTableEntry;
 
+/**
+ * Interned output interface set: a contiguous range [offset, offset + num_out_ifs) in the
+ * output interface arena of the arbiter, shared by every entry with exactly the same set
+ * of output interfaces (ascending). Once no entry refers to it anymore, its range is
+ * re-used for a new set of the same capacity.
+ */
+struct MulticastOifSet {
+    uint32_t offset;
+    uint32_t num_out_ifs;
+    uint32_t capacity;      //!< Power of two
+    uint32_t ref_count;     //!< Number of entries and group ranges which refer to it (0 if free)
+};
+
+/**
+ * Multicast forwarding entry for a single (origin, group).
+ */
+struct MulticastForwardingEntry {
+    uint32_t origin;
+    uint32_t group;
+    uint32_t input_if_idx;
+    uint32_t oif_set_idx;
+};
+
+/**
+ * Aggregated forwarding entry for the consecutive groups [group_lo, group_hi] of the same
+ * origin, which all have the same input interface and output interface set. A group in a
+ * range has no other entries (of any origin), such that it is found by group alone.
+ */
+struct MulticastGroupRange {
+    uint32_t origin;
+    uint32_t group_lo;
+    uint32_t group_hi;
+    uint32_t input_if_idx;
+    uint32_t oif_set_idx;
+};
+
 class ArbiterMulticast : public ArbiterEcmp
 {
 public:
@@ -26,16 +64,57 @@ public:
             std::vector<std::vector<uint32_t>> candidate_list
     );
 
-    //inputInterface is useless now
+    //inputInterface is the interface packets of the group must arrive on (0: loop-back at the source)
     void AddMulticastRoute(Ipv4Address origin, Ipv4Address group, uint32_t inputInterface, std::vector<uint32_t> outputInterfaces);
     void SetMulticastRoutes(std::list<Ipv4MulticastRoutingTableEntry *> multicast_routes);
+    void AddMulticastOutputInterface(Ipv4Address origin, Ipv4Address group, uint32_t inputInterface, uint32_t outputInterface);
+    void RemoveMulticastOutputInterface(Ipv4Address origin, Ipv4Address group, uint32_t outputInterface);
+    uint32_t GetNumMulticastOutputInterfaces(Ipv4Address origin, Ipv4Address group);
+    void AggregateMulticastRoutes();
     ArbiterResult DecideMulticast(int32_t source_node_id, Ptr<const Packet> pkt, Ipv4Header const &ipHeader);
 
+    // Size of the multicast forwarding state
+    size_t GetNumMulticastRoutes();
+    size_t GetNumMulticastForwardingEntries();
+    size_t GetNumMulticastGroupRanges();
+    size_t GetNumMulticastOifSets();
+    uint64_t GetMulticastStateSizeByte();
+    uint64_t GetMulticastStateUncompressedSizeByte();
+
     // get routing table
     // std::string StringReprOfForwardingState();
 
 private:
-    std::list<Ipv4MulticastRoutingTableEntry *> m_multicast_routes;
+    int32_t LookupMulticastOifSet(uint32_t origin, uint32_t group, uint32_t& input_if_idx);
+    int32_t FindMulticastSlot(uint64_t key);
+    void InsertMulticastSlot(uint64_t key, int32_t entry_idx);
+    void GrowMulticastSlots();
+    void RebuildMulticastSlots();
+    int32_t FindMulticastRange(uint32_t group);
+    void SplitMulticastRange(uint32_t group);
+    uint32_t InternOifSet(std::vector<uint32_t> out_if_idxs);
+    void ReleaseOifSet(uint32_t oif_set_idx);
+    void SetEntryOifSet(MulticastForwardingEntry& entry, std::vector<uint32_t> out_if_idxs);
+    std::vector<uint32_t> GetOifSet(uint32_t oif_set_idx);
+
+    // Entries are stored by value, the (origin, group) -> entry index mapping is a
+    // flat open-addressing hash table with linear probing. Every entry is also indexed
+    // under the wildcard origin 0.0.0.0 (first one added for a group wins), which is used
+    // when the packet source does not match exactly (e.g., socket source IP requests).
+    std::vector<MulticastForwardingEntry> m_multicast_entries;  //!< All entries in order of addition
+    std::vector<uint64_t> m_multicast_slot_keys;                //!< Hash table slot key: (origin << 32) | group
+    std::vector<int32_t> m_multicast_slot_entry_idxs;           //!< Hash table slot entry index (-1 if empty)
+    size_t m_multicast_num_used_slots = 0;                      //!< Number of occupied slots
+
+    // Aggregated group ranges, ascending and non-overlapping, searched if there is no entry
+    std::vector<MulticastGroupRange> m_multicast_ranges;
+    size_t m_multicast_num_range_groups = 0;                    //!< Total number of groups in all ranges
+
+    // Interned output interface sets
+    std::vector<MulticastOifSet> m_multicast_oif_sets;
+    std::vector<uint32_t> m_multicast_out_if_arena;             //!< Output interfaces of all sets back-to-back
+    std::map<std::vector<uint32_t>, uint32_t> m_multicast_oif_set_index;        //!< Live set -> its index
+    std::map<uint32_t, std::vector<uint32_t>> m_multicast_free_oif_sets;        //!< Capacity -> free set indices
 
 };
 
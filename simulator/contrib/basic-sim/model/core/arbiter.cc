@@ -29,15 +29,25 @@ bool ArbiterResult::IsMulticastOutbound() {
     return m_is_multicast_outbound;
 }
 
-std::vector<uint32_t> ArbiterResult::GetOutIfIdxMulticast() {
+uint32_t ArbiterResult::GetNumOutIfIdxMulticast() {
     if (m_is_multicast) {
-        return m_out_if_idxs;
+        return m_num_out_if_idxs;
     }
     else {
         throw std::runtime_error("Cannot retrieve out interface indexs if the arbiter did not succeed in finding a multicast route");
     }
 }
 
+uint32_t ArbiterResult::GetOutIfIdxMulticast(uint32_t i) {
+    if (!m_is_multicast) {
+        throw std::runtime_error("Cannot retrieve out interface indexs if the arbiter did not succeed in finding a multicast route");
+    }
+    if (i >= m_num_out_if_idxs) {
+        throw std::out_of_range("Multicast out interface index position is out of range");
+    }
+    return m_out_if_idxs[i];
+}
+
 void ArbiterResult::SetIsMulticast(bool is_multicast) {
     m_is_multicast = is_multicast;
 }
@@ -46,8 +56,32 @@ void ArbiterResult::SetIsMulticastOutbound(bool is_multicast_outbound) {
     m_is_multicast_outbound = is_multicast_outbound;
 }
 
-void ArbiterResult::SetOutIfIdxs(std::vector<uint32_t> out_if_idxs) {
+void ArbiterResult::SetOutIfIdxs(const uint32_t* out_if_idxs, uint32_t num_out_if_idxs, const uint32_t* gateway_ip_addresses) {
     m_out_if_idxs = out_if_idxs;
+    m_num_out_if_idxs = num_out_if_idxs;
+    m_gateway_ip_addresses = gateway_ip_addresses;
+}
+
+bool ArbiterResult::HasGatewayIpAddressesMulticast() {
+    return m_gateway_ip_addresses != nullptr;
+}
+
+uint32_t ArbiterResult::GetGatewayIpAddressMulticast(uint32_t i) {
+    if (m_gateway_ip_addresses == nullptr) {
+        throw std::runtime_error("Multicast result has no gateway IP addresses");
+    }
+    if (i >= m_num_out_if_idxs) {
+        throw std::out_of_range("Multicast out interface index position is out of range");
+    }
+    return m_gateway_ip_addresses[i];
+}
+
+void ArbiterResult::SetInputIfIdxMulticast(uint32_t input_if_idx) {
+    m_input_if_idx = input_if_idx;
+}
+
+uint32_t ArbiterResult::GetInputIfIdxMulticast() {
+    return m_input_if_idx;
 }
 
 void ArbiterResult::SetOutIfIdx(uint32_t out_if_idx) {
@@ -101,6 +135,65 @@ ArbiterResult Arbiter::DecideMulticast(int32_t source_node_id, Ptr<const Packet>
     throw std::runtime_error("Multicast not supported in this arbiter");
 }
 
+void Arbiter::SetBierForwardingState(BierForwardingState bier_forwarding_state) {
+    m_bier_forwarding_state = std::move(bier_forwarding_state);
+    m_bier_enabled = true;
+}
+
+bool Arbiter::IsBierEnabled() {
+    return m_bier_enabled;
+}
+
+uint32_t Arbiter::GetNumBierNeighbors() {
+    return m_bier_forwarding_state.neighbors.size();
+}
+
+const BierNeighbor& Arbiter::GetBierNeighbor(uint32_t i) {
+    return m_bier_forwarding_state.neighbors.at(i);
+}
+
+bool Arbiter::DecideBier(const std::vector<uint64_t>& bit_string, std::vector<uint32_t>& copy_neighbor_idxs, std::vector<uint64_t>& copy_bit_strings) {
+    if (!m_bier_enabled) {
+        throw std::runtime_error("BIER is not enabled in this arbiter");
+    }
+    size_t num_words = bit_string.size();
+    m_bier_remaining_bits.assign(bit_string.begin(), bit_string.end());
+    copy_neighbor_idxs.clear();
+    copy_bit_strings.clear();
+
+    // Local delivery
+    bool local = false;
+    int64_t own = m_bier_forwarding_state.own_bit_position;
+    if (own >= 0 && (size_t) own / 64 < num_words && ((m_bier_remaining_bits[own / 64] >> (own % 64)) & 1ULL)) {
+        local = true;
+        m_bier_remaining_bits[own / 64] &= ~(1ULL << (own % 64));
+    }
+
+    // A copy to every neighbor which leads to at least one of the remaining endpoints
+    for (uint32_t n = 0; n < m_bier_forwarding_state.neighbors.size(); n++) {
+        const std::vector<uint64_t>& mask = m_bier_forwarding_state.neighbors[n].forwarding_bit_mask;
+        if (mask.size() != num_words) {
+            throw std::invalid_argument("BIER bit string length does not match that of the forwarding bit masks");
+        }
+        uint64_t any = 0;
+        for (size_t w = 0; w < num_words; w++) {
+            uint64_t bits = m_bier_remaining_bits[w] & mask[w];
+            copy_bit_strings.push_back(bits);
+            any |= bits;
+        }
+        if (any) {
+            copy_neighbor_idxs.push_back(n);
+            for (size_t w = 0; w < num_words; w++) {
+                m_bier_remaining_bits[w] &= ~mask[w];
+            }
+        } else {
+            copy_bit_strings.resize(copy_bit_strings.size() - num_words);
+        }
+    }
+
+    return local;
+}
+
 ArbiterResult Arbiter::BaseDecide(Ptr<const Packet> pkt, Ipv4Header const &ipHeader) {
     //handle src
     // Retrieve the source node id
@@ -35,16 +35,42 @@ public:
     void SetIsMulticast(bool is_multicast);
     void SetIsMulticastOutbound(bool is_multicast_outbound);
     void SetOutIfIdx(uint32_t out_if_idx);
-    void SetOutIfIdxs(std::vector<uint32_t> out_if_idxs);
-    std::vector<uint32_t> GetOutIfIdxMulticast();
+    void SetOutIfIdxs(const uint32_t* out_if_idxs, uint32_t num_out_if_idxs, const uint32_t* gateway_ip_addresses = nullptr); //not copied, must outlive the result
+    uint32_t GetNumOutIfIdxMulticast();
+    uint32_t GetOutIfIdxMulticast(uint32_t i);
+    bool HasGatewayIpAddressesMulticast(); //true iff every out interface has its own next hop (e.g., shared GSL channel)
+    uint32_t GetGatewayIpAddressMulticast(uint32_t i);
+    void SetInputIfIdxMulticast(uint32_t input_if_idx);
+    uint32_t GetInputIfIdxMulticast(); //interface the packet is expected to arrive on (reverse path), Ipv4::IF_ANY if any
 
 private:
     bool m_failed;
     bool m_is_multicast = false; //default unicast
-    bool m_is_multicast_outbound = false; //if true, only used m_out_if_idx(unicast)
+    bool m_is_multicast_outbound = false; //if true, m_out_if_idx(unicast) if single out interface, else looped back to be replicated onto m_out_if_idxs
     uint32_t m_out_if_idx;
     uint32_t m_gateway_ip_address;
-    std::vector<uint32_t> m_out_if_idxs; //used by multicast
+    const uint32_t* m_out_if_idxs = nullptr; //used by multicast, points into the forwarding state of the arbiter
+    uint32_t m_num_out_if_idxs = 0;
+    const uint32_t* m_gateway_ip_addresses = nullptr; //used by multicast, parallel to m_out_if_idxs if set
+    uint32_t m_input_if_idx = Ipv4::IF_ANY; //used by multicast, for the reverse path forwarding check
+};
+
+/**
+ * BIER (stateless multicast) next hop: the bits of the endpoints which are reached via it.
+ */
+struct BierNeighbor {
+    uint32_t out_if_idx;
+    uint32_t gateway_ip_address;
+    std::vector<uint64_t> forwarding_bit_mask;
+};
+
+/**
+ * BIER forwarding state of a node, derived from its unicast forwarding state.
+ * It does not depend on the multicast groups at all.
+ */
+struct BierForwardingState {
+    int64_t own_bit_position = -1; //!< -1 if this node is not an endpoint
+    std::vector<BierNeighbor> neighbors;
 };
 
 class Arbiter : public Object
@@ -113,6 +139,30 @@ public:
     //used by BaseDecide for multicast, but raise error by default because not implement
     virtual ArbiterResult DecideMulticast(int32_t source_node_id, Ptr<const Packet> pkt, Ipv4Header const &ipHeader); //not pure for compatibility
 
+    /**
+     * Set the BIER forwarding state, which makes this arbiter replicate multicast
+     * packets by the bit string in their header instead of by per-group state.
+     *
+     * @param bier_forwarding_state     BIER forwarding state
+     */
+    void SetBierForwardingState(BierForwardingState bier_forwarding_state);
+    bool IsBierEnabled();
+    uint32_t GetNumBierNeighbors();
+    const BierNeighbor& GetBierNeighbor(uint32_t i);
+
+    /**
+     * Decide to which neighbors a BIER packet is replicated, by AND-ing its bit string
+     * with the forwarding bit mask of each neighbor. A bit is handled by only one
+     * neighbor; bits of endpoints which are not reachable are dropped.
+     *
+     * @param bit_string            Bit string of the packet
+     * @param copy_neighbor_idxs    (Output) Neighbor index of each copy
+     * @param copy_bit_strings      (Output) Bit string of each copy, back-to-back (each as long as the input)
+     *
+     * @return True iff the bit of this node itself is set (local delivery)
+     */
+    bool DecideBier(const std::vector<uint64_t>& bit_string, std::vector<uint32_t>& copy_neighbor_idxs, std::vector<uint64_t>& copy_bit_strings);
+
     /**
      * Convert the forwarding state (i.e., routing table) to a string representation.
      *
@@ -125,6 +175,9 @@ protected:
     ns3::NodeContainer m_nodes;
 
 private:
+    bool m_bier_enabled = false;
+    BierForwardingState m_bier_forwarding_state;
+    std::vector<uint64_t> m_bier_remaining_bits; //!< Re-used for every BIER decision
     std::map<uint32_t, uint32_t> m_ip_to_node_id;
     std::map<uint32_t, uint32_t>::iterator m_ip_to_node_id_it;
 
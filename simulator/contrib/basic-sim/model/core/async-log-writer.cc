@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "async-log-writer.h"
+
+namespace ns3 {
+
+    NS_OBJECT_ENSURE_REGISTERED (AsyncLogWriter);
+    TypeId AsyncLogWriter::GetTypeId (void)
+    {
+        static TypeId tid = TypeId ("ns3::AsyncLogWriter")
+                .SetParent<Object> ()
+                .SetGroupName("BasicSim")
+        ;
+        return tid;
+    }
+
+    AsyncLogWriter::AsyncLogWriter(uint32_t ring_capacity) {
+        static_assert(sizeof(AsyncLogRecord) == 32, "Asynchronous log record must be 32 bytes");
+
+        // Round the capacity up to a power of two such that a position maps to a slot with a mask
+        if (ring_capacity == 0) {
+            throw std::invalid_argument("Asynchronous log ring capacity must be at least 1");
+        }
+        uint64_t capacity = 1;
+        while (capacity < ring_capacity) {
+            capacity *= 2;
+        }
+        m_ring = std::vector<AsyncLogRecord>(capacity);
+        m_ring_mask = capacity - 1;
+        m_notify_every = std::max((uint64_t) 1, capacity / 4);
+        m_head = 0;
+        m_tail = 0;
+        m_num_dropped = 0;
+        m_stop = false;
+        m_closed = false;
+
+        // Writer which drains the ring in the background
+        m_writer = std::thread(&AsyncLogWriter::WriterLoop, this);
+
+    }
+
+    AsyncLogWriter::~AsyncLogWriter() {
+        try {
+            Close();
+        } catch (const std::exception& e) {
+            std::cerr << "Asynchronous log writer was not closed properly: " << e.what() << std::endl;
+        }
+    }
+
+    uint32_t AsyncLogWriter::OpenFile(std::string filename) {
+        if (m_closed) {
+            throw std::runtime_error("Cannot open a file for a closed asynchronous log writer");
+        }
+        FILE* file = fopen(filename.c_str(), "w");
+        if (file == nullptr) {
+            throw std::runtime_error("Could not open log file: " + filename);
+        }
+        std::lock_guard<std::mutex> lock(m_files_mutex);
+        m_files.push_back(file);
+        return m_files.size() - 1;
+    }
+
+    void AsyncLogWriter::Record(uint32_t file_idx, int64_t id, int64_t time_ns, int64_t value) {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) > m_ring_mask) {
+            m_num_dropped++;
+            return;
+        }
+        AsyncLogRecord& record = m_ring[head & m_ring_mask];
+        record.file_idx = file_idx;
+        record.reserved = 0;
+        record.id = id;
+        record.time_ns = time_ns;
+        record.value = value;
+        m_head.store(head + 1, std::memory_order_release);
+
+        // Wake up the writer once a chunk has accumulated (it also wakes up periodically itself)
+        if ((head + 1) % m_notify_every == 0) {
+            m_cv.notify_one();
+        }
+    }
+
+    void AsyncLogWriter::WriterLoop() {
+        try {
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_cv.wait_for(lock, std::chrono::milliseconds(50), [this] {
+                        return m_stop.load() || m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed) >= m_notify_every;
+                    });
+                }
+                DrainToFiles();
+                if (m_stop.load()) {
+                    DrainToFiles();
+                    return;
+                }
+            }
+        } catch (...) {
+            // An exception cannot leave the thread, it is thrown by Close() instead
+            // (the ring is no longer drained, so further records are dropped)
+            m_writer_error = std::current_exception();
+        }
+    }
+
+    void AsyncLogWriter::DrainToFiles() {
+        std::lock_guard<std::mutex> lock(m_files_mutex);
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        while (tail < head) {
+            const AsyncLogRecord& record = m_ring[tail & m_ring_mask];
+            if (fprintf(m_files[record.file_idx], "%" PRId64 ",%" PRId64 ",%" PRId64 "\n", record.id, record.time_ns, record.value) < 0) {
+                throw std::runtime_error("Failed to write to log file");
+            }
+            tail++;
+
+            // Free up the slots in chunks, such that the producer can continue
+            if (tail % 1024 == 0 || tail == head) {
+                m_tail.store(tail, std::memory_order_release);
+            }
+        }
+    }
+
+    void AsyncLogWriter::Close() {
+        if (m_closed) {
+            return;
+        }
+        m_stop = true;
+        m_cv.notify_one();
+        m_writer.join();
+        bool close_failed = false;
+        for (FILE* file : m_files) {
+            close_failed = fclose(file) != 0 || close_failed;
+        }
+        m_closed = true;
+        if (m_writer_error) {
+            std::rethrow_exception(m_writer_error);
+        }
+        if (close_failed) {
+            throw std::runtime_error("Failed to write to log file");
+        }
+    }
+
+    uint64_t AsyncLogWriter::GetNumRecorded() {
+        return m_head.load() + m_num_dropped;
+    }
+
+    uint64_t AsyncLogWriter::GetNumWritten() {
+        return m_tail.load();
+    }
+
+    uint64_t AsyncLogWriter::GetNumDropped() {
+        return m_num_dropped;
+    }
+
+}
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef ASYNC_LOG_WRITER_H
+#define ASYNC_LOG_WRITER_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include <stdexcept>
+#include <exception>
+#include <iostream>
+
+#include "ns3/core-module.h"
+
+namespace ns3 {
+
+    /**
+     * Record of a (id, time, value) log line, e.g., the congestion window of a TCP flow
+     * at a point in time, together with the file it belongs to (32 bytes).
+     */
+    struct AsyncLogRecord {
+        uint32_t file_idx;
+        uint32_t reserved;
+        int64_t id;
+        int64_t time_ns;
+        int64_t value;
+    };
+
+    /**
+     * Bounded single-producer single-consumer ring of log records, shared by the
+     * applications which log over time. The simulation thread only copies a record
+     * into the ring, a background thread drains it and appends each record as an
+     * "id,time,value" line to its CSV file. If the ring is full, the record is
+     * dropped (and counted) rather than stalling the simulation. If the writer fails,
+     * it stops and the error is thrown by Close() on the simulation thread.
+     */
+    class AsyncLogWriter : public Object {
+
+    public:
+        static TypeId GetTypeId (void);
+        AsyncLogWriter(uint32_t ring_capacity);
+        ~AsyncLogWriter();
+        uint32_t OpenFile(std::string filename);
+        void Record(uint32_t file_idx, int64_t id, int64_t time_ns, int64_t value);
+        void Close();
+        uint64_t GetNumRecorded();
+        uint64_t GetNumWritten();
+        uint64_t GetNumDropped();
+
+    private:
+        void WriterLoop();
+        void DrainToFiles();
+
+        std::vector<AsyncLogRecord> m_ring;
+        uint64_t m_ring_mask;
+        uint64_t m_notify_every;
+        std::atomic<uint64_t> m_head;   //!< Next write position (producer)
+        std::atomic<uint64_t> m_tail;   //!< Next read position (consumer)
+        uint64_t m_num_dropped;
+        std::atomic<bool> m_stop;
+        bool m_closed;
+        std::exception_ptr m_writer_error;  //!< Set by the writer if it failed, read after it is joined
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::mutex m_files_mutex;       //!< Files are opened by the simulation while the writer is running
+        std::vector<FILE*> m_files;
+        std::thread m_writer;
+
+    };
+
+}
+
+#endif // ASYNC_LOG_WRITER_H
@@ -63,6 +63,10 @@ void BasicSimulation::RegisterTimestamp(std::string label) {
     m_timestamps.push_back(std::make_pair(label, NowNsSinceEpoch()));
 }
 
+PhaseProfiler& BasicSimulation::GetPhaseProfiler() {
+    return m_phase_profiler;
+}
+
 void BasicSimulation::ConfigureRunDirectory() {
     std::cout << "CONFIGURE RUN DIRECTORY" << std::endl;
 
@@ -101,6 +105,15 @@ void BasicSimulation::ReadConfig() {
     // Seed
     m_simulation_seed = parse_positive_int64(GetConfigParamOrFail("simulation_seed"));
 
+    // Phase profile in the Chrome trace format
+    m_enable_timing_results_chrome_trace = parse_boolean(GetConfigParamOrDefault("enable_timing_results_chrome_trace", "false"));
+
+    // Event queue
+    m_simulator_scheduler_type = GetConfigParamOrDefault("simulator_scheduler_type", "map");
+
+    // Profile of the execution time per kind of event
+    m_enable_event_profiler = parse_boolean(GetConfigParamOrDefault("enable_event_profiler", "false"));
+
 }
 
 void BasicSimulation::ConfigureSimulation() {
@@ -175,6 +188,32 @@ void BasicSimulation::ConfigureSimulation() {
     ns3::RngSeedManager::SetSeed(m_simulation_seed);
     std::cout << "  > Seed............. " << m_simulation_seed << std::endl;
 
+    // Scheduler (event queue), wrapped by the event profiler if it is enabled
+    TypeId schedulerTypeId;
+    if (m_simulator_scheduler_type == "map") {
+        schedulerTypeId = MapScheduler::GetTypeId();
+    } else if (m_simulator_scheduler_type == "list") {
+        schedulerTypeId = ListScheduler::GetTypeId();
+    } else if (m_simulator_scheduler_type == "heap") {
+        schedulerTypeId = HeapScheduler::GetTypeId();
+    } else if (m_simulator_scheduler_type == "calendar") {
+        schedulerTypeId = CalendarScheduler::GetTypeId();
+    } else if (m_simulator_scheduler_type == "ladder") {
+        schedulerTypeId = LadderScheduler::GetTypeId();
+    } else {
+        throw std::runtime_error(format_string("Unknown simulator scheduler type: %s", m_simulator_scheduler_type.c_str()));
+    }
+    ObjectFactory schedulerFactory;
+    if (m_enable_event_profiler) {
+        schedulerFactory.SetTypeId(ProfilingScheduler::GetTypeId());
+        schedulerFactory.Set("WrappedSchedulerType", TypeIdValue(schedulerTypeId));
+    } else {
+        schedulerFactory.SetTypeId(schedulerTypeId);
+    }
+    Simulator::SetScheduler(schedulerFactory);
+    std::cout << "  > Scheduler........ " << m_simulator_scheduler_type << std::endl;
+    std::cout << "  > Event profiler... " << (m_enable_event_profiler ? "enabled" : "disabled") << std::endl;
+
     // Set end time
     Simulator::Stop(NanoSeconds(m_simulation_end_time_ns));
     printf("  > Duration......... %.2f s (%" PRId64 " ns)\n", m_simulation_end_time_ns / 1e9, m_simulation_end_time_ns);
@@ -188,14 +227,20 @@ void BasicSimulation::PrepareBasicSimulationLogFiles() {
         m_finished_filename = m_logs_dir + "/system_" + std::to_string(m_system_id) + "_finished.txt";
         m_timing_results_txt_filename = m_logs_dir + "/system_" + std::to_string(m_system_id) + "_timing_results.txt";
         m_timing_results_csv_filename = m_logs_dir + "/system_" + std::to_string(m_system_id) + "_timing_results.csv";
+        m_timing_results_json_filename = m_logs_dir + "/system_" + std::to_string(m_system_id) + "_timing_results.json";
+        m_event_profile_filename = m_logs_dir + "/system_" + std::to_string(m_system_id) + "_event_profile.csv";
     } else {
         m_finished_filename = m_logs_dir + "/finished.txt";
         m_timing_results_txt_filename = m_logs_dir + "/timing_results.txt";
         m_timing_results_csv_filename = m_logs_dir + "/timing_results.csv";
+        m_timing_results_json_filename = m_logs_dir + "/timing_results.json";
+        m_event_profile_filename = m_logs_dir + "/event_profile.csv";
     }
     remove_file_if_exists(m_finished_filename);
     remove_file_if_exists(m_timing_results_txt_filename);
     remove_file_if_exists(m_timing_results_csv_filename);
+    remove_file_if_exists(m_timing_results_json_filename);
+    remove_file_if_exists(m_event_profile_filename);
 }
 
 void BasicSimulation::WriteFinished(bool finished) {
@@ -267,15 +312,44 @@ void BasicSimulation::Run() {
 
     // Run
     printf("Running the simulation for %.2f simulation seconds...\n", (m_simulation_end_time_ns / 1e9));
+    m_phase_profiler.Begin("Run simulation");
     Simulator::Run();
+    m_phase_profiler.End();
     printf("Finished simulation.\n");
 
-    // Print final duration
+    // Print final duration and event rate
+    double wallclock_s = (NowNsSinceEpoch() - m_sim_start_time_ns_since_epoch) / 1e9;
+    uint64_t num_events = Simulator::GetEventCount();
     printf(
-            "Simulation of %.1f seconds took in wallclock time %.1f seconds.\n\n",
+            "Simulation of %.1f seconds took in wallclock time %.1f seconds.\n",
             m_simulation_end_time_ns / 1e9,
-            (NowNsSinceEpoch() - m_sim_start_time_ns_since_epoch) / 1e9
+            wallclock_s
     );
+    printf(
+            "Executed %" PRIu64 " events with the %s scheduler (%.0f events per wallclock second).\n\n",
+            num_events,
+            m_simulator_scheduler_type.c_str(),
+            num_events / wallclock_s
+    );
+
+    // Event profile, before the remaining events are removed when the simulator is destroyed
+    if (m_enable_event_profiler) {
+        ProfilingScheduler* profilingScheduler = ProfilingScheduler::GetCurrent();
+        if (profilingScheduler == nullptr) {
+            throw std::runtime_error("Event profiler is enabled but the simulator has no profiling scheduler");
+        }
+        profilingScheduler->StopProfiling();
+        profilingScheduler->WriteEventProfile(m_event_profile_filename);
+        std::vector<EventProfileEntry> profile = profilingScheduler->GetEventProfile();
+        printf("Event kinds with the highest total execution time (all in %s):\n", m_event_profile_filename.c_str());
+        for (size_t i = 0; i < std::min(profile.size(), (size_t) 10); i++) {
+            printf(
+                    "  %2d. %10.1f ms in %12" PRIu64 " events (mean: %8.1f ns) :: %s\n",
+                    (int) (i + 1), profile[i].total_ns / 1e6, profile[i].count, profile[i].mean_ns, profile[i].kind.c_str()
+            );
+        }
+        printf("\n");
+    }
 
     RegisterTimestamp("Run simulation");
 }
@@ -283,7 +357,9 @@ void BasicSimulation::Run() {
 void BasicSimulation::CleanUpSimulation() {
     std::cout << "CLEAN-UP" << std::endl;
 
+    m_phase_profiler.Begin("Destroy simulator");
     Simulator::Destroy();
+    m_phase_profiler.End();
     std::cout << "  > Simulator is destroyed" << std::endl;
     RegisterTimestamp("Destroy simulator");
 
@@ -330,9 +406,26 @@ void BasicSimulation::StoreTimingResults() {
             t_prev = ts.second;
         }
     }
-    file_txt.close();
     file_csv.close();
 
+    // Nested phases
+    if (!m_phase_profiler.GetPhases().empty()) {
+        std::cout << std::endl << "PHASES" << std::endl;
+        file_txt << std::endl << "PHASES" << std::endl;
+        for (const std::string& line : m_phase_profiler.FormatPhases(m_timestamps[0].second)) {
+            std::cout << line << std::endl;
+            file_txt << line << std::endl;
+        }
+    }
+    file_txt.close();
+
+    // timing_results.json (Chrome trace event format)
+    if (m_enable_timing_results_chrome_trace) {
+        std::ofstream file_json(m_timing_results_json_filename);
+        m_phase_profiler.WriteChromeTrace(file_json, m_timestamps[0].second, m_timestamps, m_system_id);
+        file_json.close();
+    }
+
     std::cout << std::endl;
 }
 
@@ -46,6 +46,9 @@
 #include "ns3/mpi-interface.h"
 
 #include "ns3/exp-util.h"
+#include "ns3/phase-profiler.h"
+#include "ns3/profiling-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 
 namespace ns3 {
 
@@ -62,6 +65,7 @@ public:
 
     // Timestamps to track performance
     void RegisterTimestamp(std::string label);
+    PhaseProfiler& GetPhaseProfiler();
 
     // Getters
     bool IsDistributedEnabled();
@@ -91,6 +95,8 @@ private:
     // Timestamp to identify which parts take long
     int64_t NowNsSinceEpoch();
     std::vector<std::pair<std::string, int64_t>> m_timestamps; // List of all important events happening in the pipeline
+    PhaseProfiler m_phase_profiler; // Nested phases with their wall time, CPU time, peak RSS increase and allocations
+    bool m_enable_timing_results_chrome_trace;
 
     // Run directory
     std::string m_run_dir;
@@ -98,6 +104,8 @@ private:
     std::string m_finished_filename;
     std::string m_timing_results_csv_filename;
     std::string m_timing_results_txt_filename;
+    std::string m_timing_results_json_filename;
+    std::string m_event_profile_filename;
 
     // Config variables
     std::map<std::string, std::string> m_config;
@@ -107,6 +115,8 @@ private:
     uint32_t m_system_id;
     uint32_t m_systems_count;
     bool m_enable_distributed;
+    bool m_enable_event_profiler;
+    std::string m_simulator_scheduler_type;
     std::vector<int64_t> m_distributed_node_system_id_assignment;
 
     // Progress show variables
@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "bier-header.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("BierHeader");
+
+NS_OBJECT_ENSURE_REGISTERED (BierHeader);
+
+TypeId
+BierHeader::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::BierHeader")
+            .SetParent<Header> ()
+            .SetGroupName("BasicSim")
+            .AddConstructor<BierHeader> ()
+    ;
+    return tid;
+}
+
+BierHeader::BierHeader ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+BierHeader::SetBitString (const std::vector<uint64_t>& bit_string)
+{
+  NS_LOG_FUNCTION (this);
+  if (bit_string.size() > 65535) {
+      throw std::invalid_argument("BIER bit string cannot exceed 65535 words");
+  }
+  m_bit_string = bit_string;
+}
+
+const std::vector<uint64_t>&
+BierHeader::GetBitString (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_bit_string;
+}
+
+void
+BierHeader::SetBit (uint32_t bit_position)
+{
+  NS_LOG_FUNCTION (this << bit_position);
+  if (bit_position / 64 >= m_bit_string.size()) {
+      throw std::out_of_range("BIER bit position is beyond the bit string");
+  }
+  m_bit_string[bit_position / 64] |= (1ULL << (bit_position % 64));
+}
+
+bool
+BierHeader::IsBitSet (uint32_t bit_position) const
+{
+  NS_LOG_FUNCTION (this << bit_position);
+  if (bit_position / 64 >= m_bit_string.size()) {
+      return false;
+  }
+  return (m_bit_string[bit_position / 64] >> (bit_position % 64)) & 1ULL;
+}
+
+TypeId
+BierHeader::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+void
+BierHeader::Print (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this << &os);
+  os << "(bits=";
+  bool first = true;
+  for (uint32_t i = 0; i < m_bit_string.size() * 64; i++) {
+      if (IsBitSet(i)) {
+          os << (first ? "" : " ") << i;
+          first = false;
+      }
+  }
+  os << ")";
+}
+
+uint32_t
+BierHeader::GetSerializedSize (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return 2 + 8 * m_bit_string.size();
+}
+
+void
+BierHeader::Serialize (Buffer::Iterator start) const
+{
+  NS_LOG_FUNCTION (this << &start);
+  Buffer::Iterator i = start;
+  i.WriteHtonU16 (m_bit_string.size());
+  for (uint64_t word : m_bit_string) {
+      i.WriteHtonU64 (word);
+  }
+}
+
+uint32_t
+BierHeader::Deserialize (Buffer::Iterator start)
+{
+  NS_LOG_FUNCTION (this << &start);
+  Buffer::Iterator i = start;
+  m_bit_string.resize(i.ReadNtohU16 ());
+  for (uint64_t& word : m_bit_string) {
+      word = i.ReadNtohU64 ();
+  }
+  return GetSerializedSize ();
+}
+
+std::vector<int64_t> bier_bit_positions(const std::set<int64_t>& endpoints, int64_t num_nodes) {
+    std::vector<int64_t> bit_positions(num_nodes, -1);
+    int64_t bit_position = 0;
+    for (int64_t endpoint : endpoints) {
+        bit_positions.at(endpoint) = bit_position;
+        bit_position++;
+    }
+    return bit_positions;
+}
+
+uint32_t bier_num_words(size_t num_endpoints) {
+    return (num_endpoints + 63) / 64;
+}
+
+} // namespace ns3
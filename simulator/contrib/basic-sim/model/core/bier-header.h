@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BIER_HEADER_H
+#define BIER_HEADER_H
+
+#include <set>
+#include <vector>
+#include <stdexcept>
+
+#include "ns3/header.h"
+
+namespace ns3 {
+
+/**
+ * Stateless multicast header in the style of BIER (bit index explicit replication).
+ * It follows the UDP header, and has a bit for every endpoint: bit i is set iff endpoint i
+ * still has to receive the packet. Each copy only carries the bits of the endpoints which
+ * are reached via the link it is sent over, such that no endpoint gets a duplicate.
+ *
+ * Format: [number of 64-bit words, uint16][bit string words, uint64 each (word 0 first)]
+ */
+class BierHeader : public Header
+{
+public:
+  static TypeId GetTypeId (void);
+
+  BierHeader ();
+  void SetBitString (const std::vector<uint64_t>& bit_string);
+  const std::vector<uint64_t>& GetBitString (void) const;
+  void SetBit (uint32_t bit_position);
+  bool IsBitSet (uint32_t bit_position) const;
+
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual void Print (std::ostream &os) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+private:
+  std::vector<uint64_t> m_bit_string; //!< Bit i is bit (i % 64) of word (i / 64)
+};
+
+/**
+ * BIER bit position of every node: the endpoints are numbered in ascending node id order,
+ * and all other nodes have no bit position (-1).
+ *
+ * @param endpoints     Endpoint node identifiers
+ * @param num_nodes     Number of nodes
+ *
+ * @return Bit position for each node identifier
+ */
+std::vector<int64_t> bier_bit_positions(const std::set<int64_t>& endpoints, int64_t num_nodes);
+
+/**
+ * Number of 64-bit words of a bit string with a bit for each endpoint.
+ *
+ * @param num_endpoints     Number of endpoints
+ *
+ * @return Number of words
+ */
+uint32_t bier_num_words(size_t num_endpoints);
+
+} // namespace ns3
+
+#endif /* BIER_HEADER_H */
@@ -93,9 +93,19 @@ namespace ns3 {
         // Decide interface index
         uint32_t if_idx;
         uint32_t gateway_ip_address;
+        uint32_t source_if_idx;
         if (loopbackMask.IsMatch(dest, loopbackIp)) { // Loop-back
             if_idx = 0;
             gateway_ip_address = 0;
+            source_if_idx = 0;
+
+        } else if (dest.IsMulticast() && m_arbiter->IsBierEnabled()) { // BIER source: replicated from the loop-back (see RouteInputBier)
+            if (m_arbiter->GetNumBierNeighbors() == 0) {
+                return 0;
+            }
+            if_idx = 0;
+            gateway_ip_address = 0;
+            source_if_idx = m_arbiter->GetBierNeighbor(0).out_if_idx;
 
         } else { // If not loop-back, it goes to the arbiter
                  // Local delivery has already been handled if it was input
@@ -103,9 +113,17 @@ namespace ns3 {
             ArbiterResult result = m_arbiter->BaseDecide(p, header);
             if (result.Failed()) {
                 return 0;
+            } else if (result.IsMulticastOutbound() && result.GetNumOutIfIdxMulticast() > 1) {
+                // A multicast source which replicates onto multiple interfaces hands it to the loop-back,
+                // such that it re-enters via RouteInput() on interface 0 and is forwarded from there.
+                // The source IP is still that of a real interface, as it identifies the source node.
+                if_idx = 0;
+                gateway_ip_address = 0;
+                source_if_idx = result.GetOutIfIdxMulticast(0);
             } else {
                 if_idx = result.GetOutIfIdx();
                 gateway_ip_address = result.GetGatewayIpAddress();
+                source_if_idx = if_idx;
             }
 
         }
@@ -113,7 +131,7 @@ namespace ns3 {
         // Create routing entry
         Ptr<Ipv4Route> rtentry = Create<Ipv4Route>();
         rtentry->SetDestination(dest);
-        rtentry->SetSource(m_ipv4->SourceAddressSelection(if_idx, dest)); // This is basically the IP of the interface
+        rtentry->SetSource(m_ipv4->SourceAddressSelection(source_if_idx, dest)); // This is basically the IP of the interface
                                                                           // It is used by a transport layer to
                                                                           // determine its source IP address
         rtentry->SetGateway(Ipv4Address(gateway_ip_address)); // If the network device does not care about ARP resolution,
@@ -123,8 +141,28 @@ namespace ns3 {
 
     }
 
+    /**
+     * Lookup the multicast route of a packet which arrived at an interface.
+     *
+     * If the arbiter gives a gateway for each output interface (e.g., because it is a shared
+     * channel on which the next hop must be addressed), the next hops are returned as unicast
+     * routes which each get a copy of the packet, instead of a multicast route.
+     *
+     * @param dest              Destination (group) IP address
+     * @param src               Source IP address
+     * @param header            IPv4 header
+     * @param p                 Packet
+     * @param input_if_idx      Input interface index
+     * @param next_hop_routes   (Output) Routes per next hop, only filled if the arbiter set gateways
+     * @param rpf_failed        (Output) True iff the packet did not arrive on the input interface of its entry
+     *
+     * @return Multicast route, or 0 if there is none, if it failed the reverse path check, or if it is forwarded per next hop
+     */
     Ptr<Ipv4MulticastRoute>
-    Ipv4ArbiterRouting::LookupArbiter (Ipv4Address dest, Ipv4Address src, const Ipv4Header &header, Ptr<const Packet> p, uint32_t input_if_idx) {
+    Ipv4ArbiterRouting::LookupArbiter (Ipv4Address dest, Ipv4Address src, const Ipv4Header &header, Ptr<const Packet> p, uint32_t input_if_idx, std::vector<Ptr<Ipv4Route>>& next_hop_routes, bool& rpf_failed) {
+        next_hop_routes.clear();
+        rpf_failed = false;
+
         // Arbiter must be set
         if (m_arbiter == 0) {
             throw std::runtime_error("Arbiter has not been set");
@@ -136,17 +174,33 @@ namespace ns3 {
         Ptr<Ipv4MulticastRoute> mrtentry = 0;
         ArbiterResult result = m_arbiter->BaseDecide(p, header);
         if (result.Failed()) return 0; //necessary because not all packet can be routed
-        if (!result.IsMulticast() || result.IsMulticastOutbound()) {
-            std::cout << m_nodeId << " " << src << " " << dest << std::endl;
-            throw std::runtime_error("Invalid multicast route");
+        if (result.IsMulticast() && result.GetInputIfIdxMulticast() != Ipv4::IF_ANY && result.GetInputIfIdxMulticast() != input_if_idx) {
+            rpf_failed = true; // Not from the parent in the tree, forwarding it could loop or duplicate
+            return 0;
+        }
+        if (!result.IsMulticast() || (result.IsMulticastOutbound() && input_if_idx != 0)) { // Outbound only via the loop-back
+            throw std::runtime_error("Invalid multicast route at node " + std::to_string(m_nodeId));
+        }
+        else if (result.HasGatewayIpAddressesMulticast()) {
+            uint32_t num_out_if_idxs = result.GetNumOutIfIdxMulticast();
+            for (uint32_t i = 0; i < num_out_if_idxs; i++) {
+                Ptr<Ipv4Route> rtentry = Create<Ipv4Route>();
+                rtentry->SetDestination(group);
+                rtentry->SetSource(origin);
+                rtentry->SetGateway(Ipv4Address(result.GetGatewayIpAddressMulticast(i)));
+                rtentry->SetOutputDevice(m_ipv4->GetNetDevice(result.GetOutIfIdxMulticast(i)));
+                next_hop_routes.push_back(rtentry);
+            }
+            return 0;
         }
         else {
             mrtentry = Create<Ipv4MulticastRoute> ();
             mrtentry->SetGroup(group);
             mrtentry->SetOrigin(origin);
             mrtentry->SetParent(input_if_idx);
-            std::vector<uint32_t> out_if_idxs = result.GetOutIfIdxMulticast();
-            for (uint32_t out_if: out_if_idxs) {
+            uint32_t num_out_if_idxs = result.GetNumOutIfIdxMulticast();
+            for (uint32_t i = 0; i < num_out_if_idxs; i++) {
+                uint32_t out_if = result.GetOutIfIdxMulticast(i);
                 NS_LOG_LOGIC ("Setting output interface index " << out_if);
                 mrtentry->SetOutputTtl(out_if, Ipv4MulticastRoute::MAX_TTL - 1);
             }
@@ -154,6 +208,78 @@ namespace ns3 {
         }
     }
 
+    /**
+     * Replicate a BIER multicast packet which arrived at an interface. Each copy gets the
+     * bit string of only the endpoints behind the neighbor it is sent to.
+     *
+     * @param p                 Packet (starting with the UDP header, followed by the BIER header)
+     * @param ipHeader          IPv4 header
+     * @param input_if_idx      Input interface index (0 if it is looped back by the source)
+     * @param ucb               Unicast forward call-back (one call per copy)
+     * @param lcb               Local delivery call-back
+     *
+     * @return True iff it was delivered locally or forwarded to at least one neighbor
+     */
+    bool
+    Ipv4ArbiterRouting::RouteInputBier(Ptr<const Packet> p, const Ipv4Header &ipHeader, uint32_t input_if_idx, UnicastForwardCallback ucb, LocalDeliverCallback lcb) {
+        uint32_t group = ipHeader.GetDestination().Get();
+        if (ipHeader.GetProtocol() != UdpL4Protocol::PROT_NUMBER) {
+            throw std::runtime_error("BIER multicast is only supported for UDP");
+        }
+
+        // The BIER header follows the UDP header
+        Ptr<Packet> payload = p->Copy();
+        UdpHeader udpHeader;
+        payload->RemoveHeader(udpHeader);
+        BierHeader bierHeader;
+        payload->RemoveHeader(bierHeader);
+        bool local = m_arbiter->DecideBier(bierHeader.GetBitString(), m_bier_copy_neighbor_idxs, m_bier_copy_bit_strings);
+
+        // Local delivery (not if it is the source, which loops back its own packets to replicate them)
+        if (local && input_if_idx != 0 && !lcb.IsNull()) {
+            lcb(p->Copy(), ipHeader, input_if_idx);
+            if (m_multicast_trace != 0) {
+                m_multicast_trace->Record(m_nodeId, group, input_if_idx, 0, 0, MULTICAST_TRACE_LOCAL_DELIVERY);
+            }
+        }
+
+        // One copy for each neighbor
+        size_t num_words = bierHeader.GetBitString().size();
+        uint64_t oif_bitmap = 0;
+        for (size_t c = 0; c < m_bier_copy_neighbor_idxs.size(); c++) {
+            const BierNeighbor& neighbor = m_arbiter->GetBierNeighbor(m_bier_copy_neighbor_idxs[c]);
+            BierHeader copyBierHeader;
+            copyBierHeader.SetBitString(std::vector<uint64_t>(
+                    m_bier_copy_bit_strings.begin() + c * num_words,
+                    m_bier_copy_bit_strings.begin() + (c + 1) * num_words
+            ));
+            Ptr<Packet> copy = payload->Copy();
+            copy->AddHeader(copyBierHeader);
+            copy->AddHeader(udpHeader);
+            Ptr<Ipv4Route> rtentry = Create<Ipv4Route>();
+            rtentry->SetDestination(ipHeader.GetDestination());
+            rtentry->SetSource(ipHeader.GetSource());
+            rtentry->SetGateway(Ipv4Address(neighbor.gateway_ip_address));
+            rtentry->SetOutputDevice(m_ipv4->GetNetDevice(neighbor.out_if_idx));
+            ucb(rtentry, copy, ipHeader);
+            if (m_multicast_replication_counter != 0) {
+                m_multicast_replication_counter->Count(m_nodeId, neighbor.out_if_idx, group, copy->GetSize() + ipHeader.GetSerializedSize());
+            }
+            if (neighbor.out_if_idx < 64) {
+                oif_bitmap |= (1ULL << neighbor.out_if_idx);
+            }
+        }
+        if (m_multicast_trace != 0) {
+            if (!m_bier_copy_neighbor_idxs.empty()) {
+                m_multicast_trace->Record(m_nodeId, group, input_if_idx, oif_bitmap, m_bier_copy_neighbor_idxs.size(), MULTICAST_TRACE_FORWARD);
+            } else if (!local) {
+                m_multicast_trace->Record(m_nodeId, group, input_if_idx, 0, 0, MULTICAST_TRACE_NO_ROUTE);
+            }
+        }
+
+        return local || !m_bier_copy_neighbor_idxs.empty();
+    }
+
     /**
      * Get an output route.
      *
@@ -181,11 +307,8 @@ namespace ns3 {
         NS_LOG_FUNCTION(this << p << header << oif << sockerr);
         Ipv4Address destination = header.GetDestination();
 
-        // std::cout << "  > ByLul:route output " << destination << std::endl;
-
-        // Multi-cast to multiple interfaces is not supported
+        // Multicast onto multiple interfaces at the source goes via the loop-back (see LookupArbiter)
         if (destination.IsMulticast()) {
-            // throw std::runtime_error("Multi-cast not supported");
             NS_LOG_LOGIC ("ByLul-Arbiter::RouteOutput()::Multicast destination");
         }
         // Perform lookup
@@ -198,6 +321,25 @@ namespace ns3 {
         } else {
             sockerr = Socket::ERROR_NOTERROR;
         }
+
+        // Multicast source decision
+        if (m_multicast_trace != 0 && destination.IsMulticast() && !destination.IsLocalMulticast()) {
+            if (route == 0) {
+                m_multicast_trace->Record(m_nodeId, destination.Get(), 0, 0, 0, MULTICAST_TRACE_NO_ROUTE);
+            } else {
+                uint32_t out_if = m_ipv4->GetInterfaceForDevice(route->GetOutputDevice());
+                m_multicast_trace->Record(m_nodeId, destination.Get(), 0, out_if < 64 ? (1ULL << out_if) : 0, 1, MULTICAST_TRACE_OUTBOUND);
+            }
+        }
+
+        // Multicast source transmission (the payload does not yet have the UDP header)
+        if (m_multicast_replication_counter != 0 && route != 0 && p != 0 && destination.IsMulticast() && !destination.IsLocalMulticast()) {
+            m_multicast_replication_counter->Count(
+                    m_nodeId, m_ipv4->GetInterfaceForDevice(route->GetOutputDevice()), destination.Get(),
+                    p->GetSize() + UdpHeader().GetSerializedSize() + header.GetSerializedSize()
+            );
+        }
+
         return route;
 
     }
@@ -214,16 +356,36 @@ namespace ns3 {
 
         // Multi-cast logic
         if (ipHeader.GetDestination().IsMulticast()) {
-            // throw std::runtime_error("Multi-cast not supported.");
-            std::cout << "    >>> + multicast arbiter routing: Get a multicast pkt at " << m_ipv4->GetAddress(1, 0).GetLocal() << std::endl << "          [HEADER]: " << ipHeader << std::endl;
-            if (m_ipv4->IsDestinationAddress (ipHeader.GetDestination (), iif)) {
-                std::cout << "     >>   multicast arbiter routing: LocalDelivery(lcb) deciding..." << std::endl;
+            uint32_t group = ipHeader.GetDestination().Get();
+
+            // Stateless multicast, replicated by the bit string in the packet
+            if (m_arbiter != 0 && m_arbiter->IsBierEnabled()) {
+                return RouteInputBier(p, ipHeader, iif, ucb, lcb);
+            }
+
+            // Multicast forwarding entry, which is looked up first as a packet which did not arrive
+            // on the input interface of the entry (reverse path forwarding check) is dropped entirely
+            bool rpf_failed;
+            Ptr<Ipv4MulticastRoute> mrtentry = LookupArbiter(ipHeader.GetDestination (), ipHeader.GetSource(), ipHeader, p, iif, m_multicast_next_hop_routes, rpf_failed);
+            if (rpf_failed) {
+                NS_LOG_LOGIC ("ByLul-Multicast reverse path check failed on interface " << iif);
+                if (m_multicast_trace != 0) {
+                    m_multicast_trace->Record(m_nodeId, group, iif, 0, 0, MULTICAST_TRACE_RPF_FAIL);
+                }
+                return false;
+            }
+
+            // Local delivery if this node is a member of the group
+            // (not if it is the source, which loops back its own packets to replicate them)
+            if (iif != 0 && m_ipv4->IsDestinationAddress (ipHeader.GetDestination (), iif)) {
                 if (!lcb.IsNull ()) {
-                    std::cout << "      > - multicast arbiter routing: valid lcb, pkt passed to app." << std::endl;
                     NS_LOG_LOGIC ("Local delivery to " << ipHeader.GetDestination ());
                     Ptr<Packet> packetCopy = p->Copy ();
                     lcb (packetCopy, ipHeader, iif);
-                    // return true; should not return, possibly lcb + mcb
+                    if (m_multicast_trace != 0) {
+                        m_multicast_trace->Record(m_nodeId, group, iif, 0, 0, MULTICAST_TRACE_LOCAL_DELIVERY);
+                    }
+                    // Do not return, it is possible it must be forwarded as well (lcb + mcb)
                 }
                 else {
                     // The local delivery callback is null.  This may be a multicast
@@ -231,30 +393,57 @@ namespace ns3 {
                     // multicast routing protocol can handle it.  It should be possible
                     // to extend this to explicitly check whether it is a unicast
                     // packet, and invoke the error callback if so
-                    std::cout << "      >   multicast arbiter routing: null lcb" << std::endl;
-                    // return false;
+                    NS_LOG_LOGIC ("Local delivery callback is null");
                 }
-            }    
-            NS_LOG_LOGIC ("ByLul-Multicast destination");
-            Ptr<Ipv4MulticastRoute> mrtentry = LookupArbiter(ipHeader.GetDestination (), ipHeader.GetSource(), ipHeader, p, iif); 
-            std::cout << "     >>   multicast arbiter routing: MulticastForwarding(mcb) deciding..." << std::endl;
-            // std::cout << "    >>> multicast arbiter routing: mcb decide at " << m_ipv4->GetAddress(1, 0).GetLocal() << std::endl;
-            if (mrtentry){
+            }
+
+            // Multicast forwarding
+            if (mrtentry) {
                 NS_LOG_LOGIC ("ByLul-Multicast route found");
-                //print start
-                std::cout << "      > - multicast arbiter routing: route found, pkt passed to output interfaces." << std::endl;
-                std::cout << "          [ENTRY]: in_if=" << mrtentry->GetParent() << " src_addr=" << mrtentry->GetOrigin() << " dest_addr=" << mrtentry->GetGroup() << std::endl << "                    ";
-                for(auto it : mrtentry->GetOutputTtlMap()){
-                    std::cout << "out_if:" << it.first << " ttl=" << it.second << "; ";
+                if (m_multicast_trace != 0) {
+                    uint64_t oif_bitmap = 0;
+                    uint16_t num_oifs = 0;
+                    for (const std::pair<const uint32_t, uint32_t>& it : mrtentry->GetOutputTtlMap()) {
+                        if (it.first < 64) {
+                            oif_bitmap |= (1ULL << it.first);
+                        }
+                        num_oifs++;
+                    }
+                    m_multicast_trace->Record(m_nodeId, group, iif, oif_bitmap, num_oifs, MULTICAST_TRACE_FORWARD);
+                }
+                if (m_multicast_replication_counter != 0) {
+                    for (const std::pair<const uint32_t, uint32_t>& it : mrtentry->GetOutputTtlMap()) {
+                        m_multicast_replication_counter->Count(m_nodeId, it.first, group, p->GetSize() + ipHeader.GetSerializedSize());
+                    }
                 }
-                std::cout << std::endl << std::endl;
-                //print end
                 mcb (mrtentry, p, ipHeader); // multicast forwarding callback
                 return true;
             }
-            else{
+            else if (!m_multicast_next_hop_routes.empty()) {
+                NS_LOG_LOGIC ("ByLul-Multicast route found (per next hop)");
+                if (m_multicast_trace != 0) {
+                    uint64_t oif_bitmap = 0;
+                    for (Ptr<Ipv4Route> route : m_multicast_next_hop_routes) {
+                        uint32_t out_if = m_ipv4->GetInterfaceForDevice(route->GetOutputDevice());
+                        if (out_if < 64) {
+                            oif_bitmap |= (1ULL << out_if);
+                        }
+                    }
+                    m_multicast_trace->Record(m_nodeId, group, iif, oif_bitmap, m_multicast_next_hop_routes.size(), MULTICAST_TRACE_FORWARD);
+                }
+                for (Ptr<Ipv4Route> route : m_multicast_next_hop_routes) {
+                    ucb (route, p, ipHeader); // unicast forwarding callback (copies the packet)
+                    if (m_multicast_replication_counter != 0) {
+                        m_multicast_replication_counter->Count(m_nodeId, m_ipv4->GetInterfaceForDevice(route->GetOutputDevice()), group, p->GetSize() + ipHeader.GetSerializedSize());
+                    }
+                }
+                return true;
+            }
+            else {
                 NS_LOG_LOGIC ("ByLul-Multicast route not found");
-                std::cout << "      >   multicast arbiter routing: multicast route not found." << std::endl << std::endl;
+                if (m_multicast_trace != 0) {
+                    m_multicast_trace->Record(m_nodeId, group, iif, 0, 0, MULTICAST_TRACE_NO_ROUTE);
+                }
                 return false; // Let other routing protocols try to handle this
             }
         }
@@ -379,4 +568,14 @@ namespace ns3 {
         return m_arbiter;
     }
 
+    void
+    Ipv4ArbiterRouting::SetMulticastTrace (Ptr<MulticastTrace> trace) {
+        m_multicast_trace = trace;
+    }
+
+    void
+    Ipv4ArbiterRouting::SetMulticastReplicationCounter (Ptr<MulticastReplicationCounter> counter) {
+        m_multicast_replication_counter = counter;
+    }
+
 } // namespace ns3
@@ -31,6 +31,11 @@
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/arbiter.h"
+#include "ns3/multicast-trace.h"
+#include "ns3/multicast-replication-counter.h"
+#include "ns3/bier-header.h"
+#include "ns3/udp-header.h"
+#include "ns3/udp-l4-protocol.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/point-to-point-channel.h"
 
@@ -99,12 +104,20 @@ public:
   virtual void SetIpv4 (Ptr<Ipv4> ipv4);
   void SetArbiter (Ptr<Arbiter> arbiter);
   Ptr<Arbiter> GetArbiter ();
+  void SetMulticastTrace (Ptr<MulticastTrace> trace);
+  void SetMulticastReplicationCounter (Ptr<MulticastReplicationCounter> counter);
 
 private:
     Ptr<Ipv4> m_ipv4;
     Ptr<Ipv4Route> LookupArbiter (const Ipv4Address& dest, const Ipv4Header &header, Ptr<const Packet> p, Ptr<NetDevice> oif = 0);
-    Ptr<Ipv4MulticastRoute> LookupArbiter (Ipv4Address dest, Ipv4Address src, const Ipv4Header &header, Ptr<const Packet> p, uint32_t input_if_idx);
+    Ptr<Ipv4MulticastRoute> LookupArbiter (Ipv4Address dest, Ipv4Address src, const Ipv4Header &header, Ptr<const Packet> p, uint32_t input_if_idx, std::vector<Ptr<Ipv4Route>>& next_hop_routes, bool& rpf_failed);
+    bool RouteInputBier (Ptr<const Packet> p, const Ipv4Header &header, uint32_t input_if_idx, UnicastForwardCallback ucb, LocalDeliverCallback lcb);
     Ptr<Arbiter> m_arbiter = 0;
+    Ptr<MulticastTrace> m_multicast_trace = 0; // Only set if multicast tracing is enabled
+    Ptr<MulticastReplicationCounter> m_multicast_replication_counter = 0; // Only set if multicast efficiency accounting is enabled
+    std::vector<Ptr<Ipv4Route>> m_multicast_next_hop_routes; // Re-used for every multicast packet forwarded per next hop
+    std::vector<uint32_t> m_bier_copy_neighbor_idxs; // Re-used for every BIER packet
+    std::vector<uint64_t> m_bier_copy_bit_strings;   // Re-used for every BIER packet
     Ipv4Address m_nodeSingleIpAddress;
     Ipv4Mask loopbackMask = Ipv4Mask("255.0.0.0");
     Ipv4Address loopbackIp = Ipv4Address("127.0.0.1");
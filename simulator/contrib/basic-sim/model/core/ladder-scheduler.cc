@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+
+#include <algorithm>
+
+namespace ns3 {
+
+    NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+    TypeId LadderScheduler::GetTypeId (void)
+    {
+        static TypeId tid = TypeId ("ns3::LadderScheduler")
+                .SetParent<Scheduler> ()
+                .SetGroupName("BasicSim")
+                .AddConstructor<LadderScheduler> ()
+        ;
+        return tid;
+    }
+
+    LadderScheduler::LadderScheduler() {
+        m_size = 0;
+        m_top_start = 0;
+        m_top_min_ts = 0;
+        m_top_max_ts = 0;
+    }
+
+    LadderScheduler::~LadderScheduler() {
+        // Left empty intentionally
+    }
+
+    void LadderScheduler::Insert (const Event &ev) {
+        m_size++;
+        uint64_t ts = ev.key.m_ts;
+
+        // Far in the future: unsorted in the top
+        if (ts >= m_top_start) {
+            if (m_top.empty()) {
+                m_top_min_ts = ts;
+                m_top_max_ts = ts;
+            } else {
+                m_top_min_ts = std::min(m_top_min_ts, ts);
+                m_top_max_ts = std::max(m_top_max_ts, ts);
+            }
+            m_top.push_back(ev);
+            return;
+        }
+
+        // In the first rung which has not yet consumed the bucket it falls in
+        for (Rung& rung : m_rungs) {
+            if (ts >= rung.start + rung.current * rung.width) {
+                size_t idx = (size_t) ((ts - rung.start) / rung.width);
+                if (idx < rung.buckets.size()) {
+                    rung.buckets[idx].push_back(ev);
+                    return;
+                }
+            }
+        }
+
+        // Very near in the future
+        InsertBottom(ev);
+    }
+
+    bool LadderScheduler::IsEmpty (void) const {
+        return m_size == 0;
+    }
+
+    Scheduler::Event LadderScheduler::PeekNext (void) const {
+        if (m_size == 0) {
+            throw std::runtime_error("Cannot peek the next event of an empty ladder scheduler");
+        }
+        const_cast<LadderScheduler*>(this)->FillBottom();
+        return m_bottom.back();
+    }
+
+    Scheduler::Event LadderScheduler::RemoveNext (void) {
+        if (m_size == 0) {
+            throw std::runtime_error("Cannot remove the next event of an empty ladder scheduler");
+        }
+        FillBottom();
+        Event ev = m_bottom.back();
+        m_bottom.pop_back();
+        m_size--;
+        return ev;
+    }
+
+    void LadderScheduler::Remove (const Event &ev) {
+        if (RemoveFrom(m_bottom, ev)) {
+            m_size--;
+            return;
+        }
+        for (Rung& rung : m_rungs) {
+            if (ev.key.m_ts >= rung.start) {
+                size_t idx = (size_t) ((ev.key.m_ts - rung.start) / rung.width);
+                if (idx < rung.buckets.size() && RemoveFrom(rung.buckets[idx], ev)) {
+                    m_size--;
+                    return;
+                }
+            }
+        }
+        if (RemoveFrom(m_top, ev)) {
+            m_size--;
+            return;
+        }
+        throw std::runtime_error("Event to remove is not in the ladder scheduler");
+    }
+
+    size_t LadderScheduler::GetNumRungs() const {
+        return m_rungs.size();
+    }
+
+    size_t LadderScheduler::GetNumBottom() const {
+        return m_bottom.size();
+    }
+
+    /**
+     * Spread the top over a first rung, with about one event per bucket.
+     * From then on, the top starts after the last bucket.
+     */
+    void LadderScheduler::TransferTop() {
+        uint64_t width = (m_top_max_ts - m_top_min_ts) / m_top.size() + 1;
+        SpawnRung(m_top, m_top_min_ts, width * m_top.size());
+        m_top_start = m_rungs.back().start + m_rungs.back().buckets.size() * m_rungs.back().width;
+        m_top.clear();
+    }
+
+    /**
+     * Spread the events over a new (finest) rung with about one event per bucket.
+     *
+     * @param events    Events, all in [start, start + span)
+     * @param start     Start of the first bucket
+     * @param span      Time span covered by the rung
+     */
+    void LadderScheduler::SpawnRung(std::vector<Event>& events, uint64_t start, uint64_t span) {
+        Rung rung;
+        rung.start = start;
+        rung.width = std::max((uint64_t) 1, (span + events.size() - 1) / events.size());
+        rung.current = 0;
+        rung.buckets.resize((size_t) ((span + rung.width - 1) / rung.width));
+        for (const Event& ev : events) {
+            rung.buckets[(size_t) ((ev.key.m_ts - start) / rung.width)].push_back(ev);
+        }
+        m_rungs.push_back(std::move(rung));
+    }
+
+    /**
+     * If the bottom is empty, fill it with the next bucket which is not empty.
+     */
+    void LadderScheduler::FillBottom() {
+        while (m_bottom.empty()) {
+
+            // Nothing left in the rungs
+            if (m_rungs.empty()) {
+                TransferTop();
+            }
+
+            // Next bucket of the finest rung which is not empty
+            Rung& rung = m_rungs.back();
+            while (rung.current < rung.buckets.size() && rung.buckets[rung.current].empty()) {
+                rung.current++;
+            }
+            if (rung.current == rung.buckets.size()) {
+                m_rungs.pop_back();
+                continue;
+            }
+            std::vector<Event> bucket;
+            bucket.swap(rung.buckets[rung.current]);
+            uint64_t bucket_start = rung.start + rung.current * rung.width;
+            uint64_t bucket_width = rung.width;
+            rung.current++;
+
+            // Either it becomes a finer rung, or it is sorted into the bottom
+            if (bucket.size() > BUCKET_THRESHOLD && m_rungs.size() < MAX_RUNGS && bucket_width > 1) {
+                SpawnRung(bucket, bucket_start, bucket_width);
+            } else {
+                m_bottom.swap(bucket);
+                std::sort(m_bottom.begin(), m_bottom.end(), [](const Event& a, const Event& b) {
+                    return b.key < a.key;
+                });
+            }
+
+        }
+    }
+
+    /**
+     * Insert an event into the sorted bottom.
+     *
+     * @param ev    Event
+     */
+    void LadderScheduler::InsertBottom(const Event& ev) {
+        std::vector<Event>::iterator it = std::upper_bound(m_bottom.begin(), m_bottom.end(), ev, [](const Event& a, const Event& b) {
+            return b.key < a.key;
+        });
+        m_bottom.insert(it, ev);
+    }
+
+    /**
+     * Remove an event from a list of events.
+     *
+     * @param events    Events
+     * @param ev        Event to remove
+     *
+     * @return True iff it was found (and removed)
+     */
+    bool LadderScheduler::RemoveFrom(std::vector<Event>& events, const Event& ev) {
+        for (size_t i = 0; i < events.size(); i++) {
+            if (events[i].key.m_uid == ev.key.m_uid) {
+                events.erase(events.begin() + i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+}
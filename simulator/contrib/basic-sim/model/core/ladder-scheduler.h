@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+#include "ns3/core-module.h"
+#include "ns3/scheduler.h"
+
+namespace ns3 {
+
+    /**
+     * Ladder queue (Tang, Goh and Thng, 2005): O(1) amortized insertion and removal,
+     * independent of the number of pending events.
+     *
+     * Events far in the future are appended unsorted to the top. Once everything before them
+     * has been executed, the top is spread over the buckets of a rung. The buckets are
+     * consumed in order. A small bucket is sorted into the bottom, from which the events are
+     * removed, while a bucket with more than a threshold of events is spread over the finer
+     * buckets of a new rung below. New events go to the first rung whose unconsumed buckets
+     * cover them, or else (if they are very near in the future) are sorted into the bottom.
+     *
+     * Events at the same time are removed in the order in which they were scheduled,
+     * just as for the other schedulers.
+     */
+    class LadderScheduler : public Scheduler {
+
+    public:
+        static TypeId GetTypeId (void);
+        LadderScheduler();
+        virtual ~LadderScheduler();
+
+        // Scheduler
+        virtual void Insert (const Event &ev);
+        virtual bool IsEmpty (void) const;
+        virtual Event PeekNext (void) const;
+        virtual Event RemoveNext (void);
+        virtual void Remove (const Event &ev);
+
+        // Shape of the ladder
+        size_t GetNumRungs() const;
+        size_t GetNumBottom() const;
+
+    private:
+        struct Rung {
+            uint64_t start;                             //!< Time at which the first bucket starts
+            uint64_t width;                             //!< Width of each bucket
+            size_t current;                             //!< Index of the first bucket not yet consumed
+            std::vector<std::vector<Event>> buckets;    //!< Unsorted
+        };
+
+        void TransferTop();
+        void SpawnRung(std::vector<Event>& events, uint64_t start, uint64_t width);
+        void FillBottom();
+        void InsertBottom(const Event& ev);
+        static bool RemoveFrom(std::vector<Event>& events, const Event& ev);
+
+        static const size_t BUCKET_THRESHOLD = 50;  //!< A bucket with more events becomes a new rung
+        static const size_t MAX_RUNGS = 8;
+
+        size_t m_size;
+
+        // Top
+        std::vector<Event> m_top;
+        uint64_t m_top_start;
+        uint64_t m_top_min_ts;
+        uint64_t m_top_max_ts;
+
+        // Rungs (the last one is the finest)
+        std::vector<Rung> m_rungs;
+
+        // Bottom, sorted from the last event to the next one (such that it is removed from the back)
+        std::vector<Event> m_bottom;
+
+    };
+
+}
+
+#endif // LADDER_SCHEDULER_H
@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "latency-histogram.h"
+
+namespace ns3 {
+
+    LatencyHistogram::LatencyHistogram(uint32_t sub_bucket_bits) {
+        if (sub_bucket_bits > 16) {
+            throw std::invalid_argument("Latency histogram cannot have more than 16 sub-bucket bits");
+        }
+        m_sub_bucket_bits = sub_bucket_bits;
+        m_count = 0;
+        m_min = 0;
+        m_max = 0;
+        m_sum = 0;
+        m_prev_latency_ns = -1;
+        m_jitter = 0;
+    }
+
+    size_t LatencyHistogram::BucketOf(int64_t value) const {
+        uint64_t v = (uint64_t) value;
+        uint64_t sub_buckets = 1ULL << m_sub_bucket_bits;
+        if (v < sub_buckets) {
+            return v;
+        }
+        uint32_t exponent = 63 - __builtin_clzll(v); // >= m_sub_bucket_bits
+        uint32_t shift = exponent - m_sub_bucket_bits;
+        return (shift + 1) * sub_buckets + ((v >> shift) - sub_buckets);
+    }
+
+    int64_t LatencyHistogram::LowestOfBucket(size_t bucket) const {
+        uint64_t sub_buckets = 1ULL << m_sub_bucket_bits;
+        if (bucket < sub_buckets) {
+            return bucket;
+        }
+        uint32_t shift = bucket / sub_buckets - 1;
+        return (int64_t) ((sub_buckets + bucket % sub_buckets) << shift);
+    }
+
+    int64_t LatencyHistogram::HighestOfBucket(size_t bucket) const {
+        uint64_t sub_buckets = 1ULL << m_sub_bucket_bits;
+        if (bucket < sub_buckets) {
+            return bucket;
+        }
+        uint32_t shift = bucket / sub_buckets - 1;
+        return LowestOfBucket(bucket) + (int64_t) ((1ULL << shift) - 1);
+    }
+
+    void LatencyHistogram::Record(int64_t latency_ns) {
+        if (latency_ns < 0) {
+            throw std::invalid_argument("Latency cannot be negative");
+        }
+        size_t bucket = BucketOf(latency_ns);
+        if (bucket >= m_counts.size()) {
+            m_counts.resize(bucket + 1, 0);
+        }
+        m_counts[bucket]++;
+        m_min = m_count == 0 ? latency_ns : std::min(m_min, latency_ns);
+        m_max = m_count == 0 ? latency_ns : std::max(m_max, latency_ns);
+        m_count++;
+        m_sum += latency_ns;
+
+        // Jitter (RFC 3550, section 6.4.1)
+        if (m_prev_latency_ns != -1) {
+            int64_t d = latency_ns - m_prev_latency_ns;
+            m_jitter += ((double) (d < 0 ? -d : d) - m_jitter) / 16.0;
+        }
+        m_prev_latency_ns = latency_ns;
+    }
+
+    uint64_t LatencyHistogram::GetCount() const {
+        return m_count;
+    }
+
+    int64_t LatencyHistogram::GetMin() const {
+        return m_min;
+    }
+
+    int64_t LatencyHistogram::GetMax() const {
+        return m_max;
+    }
+
+    double LatencyHistogram::GetMean() const {
+        return m_count == 0 ? 0 : m_sum / m_count;
+    }
+
+    /**
+     * Value below or at which the percentile of the recorded values are. It is the middle
+     * of the bucket in which that rank falls, within the minimum and maximum recorded
+     * (the highest rank is the maximum itself).
+     *
+     * @param percentile    Percentile in [0, 100]
+     *
+     * @return Latency (ns), or 0 if nothing has been recorded
+     */
+    int64_t LatencyHistogram::GetPercentile(double percentile) const {
+        if (percentile < 0 || percentile > 100) {
+            throw std::invalid_argument("Percentile must be in [0, 100]");
+        }
+        if (m_count == 0) {
+            return 0;
+        }
+        uint64_t rank = (uint64_t) std::ceil(percentile / 100.0 * m_count);
+        rank = std::max((uint64_t) 1, rank);
+        if (rank == m_count) {
+            return m_max;
+        }
+        uint64_t cumulative = 0;
+        for (size_t bucket = 0; bucket < m_counts.size(); bucket++) {
+            cumulative += m_counts[bucket];
+            if (cumulative >= rank) {
+                int64_t middle = LowestOfBucket(bucket) + (HighestOfBucket(bucket) - LowestOfBucket(bucket)) / 2;
+                return std::max(m_min, std::min(m_max, middle));
+            }
+        }
+        return m_max;
+    }
+
+    double LatencyHistogram::GetJitter() const {
+        return m_jitter;
+    }
+
+    size_t LatencyHistogram::GetNumBuckets() const {
+        return m_counts.size();
+    }
+
+}
@@ -0,0 +1,70 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+    /**
+     * Histogram of latencies (ns) with logarithmic buckets in the style of HDR histograms:
+     * each power of two is split into 2^sub_bucket_bits equally wide buckets, so the
+     * relative error of a percentile is at most 2^-sub_bucket_bits, and values below
+     * 2^sub_bucket_bits are exact. The memory is bounded by the largest value recorded
+     * (at most 64 powers of two), independent of the number of values.
+     *
+     * It also keeps the interarrival jitter as in RFC 3550: the running average (gain 1/16)
+     * of the absolute difference between the latencies of consecutively recorded values.
+     */
+    class LatencyHistogram {
+
+    public:
+        LatencyHistogram(uint32_t sub_bucket_bits = 7);
+        void Record(int64_t latency_ns);
+        uint64_t GetCount() const;
+        int64_t GetMin() const;
+        int64_t GetMax() const;
+        double GetMean() const;
+        int64_t GetPercentile(double percentile) const;
+        double GetJitter() const;
+        size_t GetNumBuckets() const;
+
+    private:
+        size_t BucketOf(int64_t value) const;
+        int64_t LowestOfBucket(size_t bucket) const;
+        int64_t HighestOfBucket(size_t bucket) const;
+
+        uint32_t m_sub_bucket_bits;
+        std::vector<uint64_t> m_counts;     //!< Only up to the bucket of the largest value recorded
+        uint64_t m_count;
+        int64_t m_min;
+        int64_t m_max;
+        double m_sum;
+        int64_t m_prev_latency_ns;
+        double m_jitter;
+
+    };
+
+}
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multicast-replication-counter.h"
+
+namespace ns3 {
+
+    NS_OBJECT_ENSURE_REGISTERED (MulticastReplicationCounter);
+    TypeId MulticastReplicationCounter::GetTypeId (void)
+    {
+        static TypeId tid = TypeId ("ns3::MulticastReplicationCounter")
+                .SetParent<Object> ()
+                .SetGroupName("BasicSim")
+        ;
+        return tid;
+    }
+
+    MulticastReplicationCounter::MulticastReplicationCounter(int64_t num_nodes) {
+        if (num_nodes < 0) {
+            throw std::invalid_argument("Number of nodes cannot be negative");
+        }
+        m_node_counts = std::vector<std::unordered_map<uint64_t, MulticastReplicationCount>>(num_nodes);
+    }
+
+    void MulticastReplicationCounter::Count(uint32_t node_id, uint32_t out_if_idx, uint32_t group, uint32_t num_bytes) {
+        if (out_if_idx == 0) {
+            return; // Loop-back does not cross a link
+        }
+        MulticastReplicationCount& count = m_node_counts.at(node_id)[(((uint64_t) out_if_idx) << 32) | group];
+        count.num_packets++;
+        count.num_bytes += num_bytes;
+    }
+
+    MulticastReplicationCount MulticastReplicationCounter::GetCount(uint32_t node_id, uint32_t out_if_idx, uint32_t group) {
+        const std::unordered_map<uint64_t, MulticastReplicationCount>& counts = m_node_counts.at(node_id);
+        auto it = counts.find((((uint64_t) out_if_idx) << 32) | group);
+        if (it == counts.end()) {
+            return {0, 0};
+        }
+        return it->second;
+    }
+
+    const std::unordered_map<uint64_t, MulticastReplicationCount>& MulticastReplicationCounter::GetCountsOfNode(uint32_t node_id) {
+        return m_node_counts.at(node_id);
+    }
+
+    uint32_t MulticastReplicationCounter::GetOutIfIdxOfKey(uint64_t key) {
+        return (uint32_t) (key >> 32);
+    }
+
+    uint32_t MulticastReplicationCounter::GetGroupOfKey(uint64_t key) {
+        return (uint32_t) (key & 0xFFFFFFFFULL);
+    }
+
+}
@@ -0,0 +1,57 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTICAST_REPLICATION_COUNTER_H
+#define MULTICAST_REPLICATION_COUNTER_H
+
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+
+#include "ns3/core-module.h"
+
+namespace ns3 {
+
+    struct MulticastReplicationCount {
+        uint64_t num_packets;
+        uint64_t num_bytes;     //!< IP packet size (including the IP and UDP headers)
+    };
+
+    /**
+     * Counts the multicast packets (and their bytes) actually transmitted onto
+     * each output interface of each node, separately for every group. A packet
+     * replicated onto three interfaces is counted three times, once per link.
+     * Packets looped back by a source (interface 0) are not counted, as they do
+     * not cross a link; their copies are counted when they are replicated.
+     */
+    class MulticastReplicationCounter : public Object {
+
+    public:
+        static TypeId GetTypeId (void);
+        MulticastReplicationCounter(int64_t num_nodes);
+        void Count(uint32_t node_id, uint32_t out_if_idx, uint32_t group, uint32_t num_bytes);
+        MulticastReplicationCount GetCount(uint32_t node_id, uint32_t out_if_idx, uint32_t group);
+        const std::unordered_map<uint64_t, MulticastReplicationCount>& GetCountsOfNode(uint32_t node_id);
+        static uint32_t GetOutIfIdxOfKey(uint64_t key);
+        static uint32_t GetGroupOfKey(uint64_t key);
+
+    private:
+        std::vector<std::unordered_map<uint64_t, MulticastReplicationCount>> m_node_counts; //!< Key: (out_if_idx << 32) | group
+    };
+
+}
+
+#endif // MULTICAST_REPLICATION_COUNTER_H
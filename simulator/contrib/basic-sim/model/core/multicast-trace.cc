@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multicast-trace.h"
+
+namespace ns3 {
+
+    NS_OBJECT_ENSURE_REGISTERED (MulticastTrace);
+    TypeId MulticastTrace::GetTypeId (void)
+    {
+        static TypeId tid = TypeId ("ns3::MulticastTrace")
+                .SetParent<Object> ()
+                .SetGroupName("BasicSim")
+        ;
+        return tid;
+    }
+
+    MulticastTrace::MulticastTrace(std::string filename, uint32_t ring_capacity) {
+        static_assert(sizeof(MulticastTraceRecord) == 32, "Multicast trace record must be 32 bytes");
+
+        // Round the capacity up to a power of two such that a position maps to a slot with a mask
+        if (ring_capacity == 0) {
+            throw std::invalid_argument("Multicast trace ring capacity must be at least 1");
+        }
+        uint64_t capacity = 1;
+        while (capacity < ring_capacity) {
+            capacity *= 2;
+        }
+        m_ring = std::vector<MulticastTraceRecord>(capacity);
+        m_ring_mask = capacity - 1;
+        m_notify_every = std::max((uint64_t) 1, capacity / 4);
+        m_head = 0;
+        m_tail = 0;
+        m_num_dropped = 0;
+        m_stop = false;
+        m_closed = false;
+
+        // Open the binary output file
+        m_filename = filename;
+        m_file = fopen(m_filename.c_str(), "wb");
+        if (m_file == nullptr) {
+            throw std::runtime_error("Could not open multicast trace file: " + m_filename);
+        }
+
+        // Writer which drains the ring in the background
+        m_writer = std::thread(&MulticastTrace::WriterLoop, this);
+
+    }
+
+    MulticastTrace::~MulticastTrace() {
+        try {
+            Close();
+        } catch (const std::exception& e) {
+            std::cerr << "Multicast trace was not closed properly: " << e.what() << std::endl;
+        }
+    }
+
+    void MulticastTrace::Record(uint32_t node_id, uint32_t group, uint32_t iif, uint64_t oif_bitmap, uint16_t num_oifs, uint8_t decision) {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) > m_ring_mask) {
+            m_num_dropped++;
+            return;
+        }
+        MulticastTraceRecord& record = m_ring[head & m_ring_mask];
+        record.time_ns = Simulator::Now().GetNanoSeconds();
+        record.node_id = node_id;
+        record.group = group;
+        record.iif = iif;
+        record.num_oifs = num_oifs;
+        record.decision = decision;
+        record.reserved = 0;
+        record.oif_bitmap = oif_bitmap;
+        m_head.store(head + 1, std::memory_order_release);
+
+        // Wake up the writer once a chunk has accumulated (it also wakes up periodically itself)
+        if ((head + 1) % m_notify_every == 0) {
+            m_cv.notify_one();
+        }
+    }
+
+    void MulticastTrace::WriterLoop() {
+        try {
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_cv.wait_for(lock, std::chrono::milliseconds(50), [this] {
+                        return m_stop.load() || m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed) >= m_notify_every;
+                    });
+                }
+                DrainToFile();
+                if (m_stop.load()) {
+                    DrainToFile();
+                    return;
+                }
+            }
+        } catch (...) {
+            // An exception cannot leave the thread, it is thrown by Close() instead
+            // (the ring is no longer drained, so further records are dropped)
+            m_writer_error = std::current_exception();
+        }
+    }
+
+    void MulticastTrace::DrainToFile() {
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        while (tail < head) {
+
+            // Contiguous range until either the head or the physical end of the ring
+            uint64_t idx = tail & m_ring_mask;
+            uint64_t n = std::min(head - tail, (uint64_t) m_ring.size() - idx);
+            if (fwrite(&m_ring[idx], sizeof(MulticastTraceRecord), n, m_file) != n) {
+                throw std::runtime_error("Failed to write to multicast trace file: " + m_filename);
+            }
+            tail += n;
+            m_tail.store(tail, std::memory_order_release);
+
+        }
+    }
+
+    void MulticastTrace::Close() {
+        if (m_closed) {
+            return;
+        }
+        m_stop = true;
+        m_cv.notify_one();
+        m_writer.join();
+        bool close_failed = fclose(m_file) != 0;
+        m_closed = true;
+        if (m_writer_error) {
+            std::rethrow_exception(m_writer_error);
+        }
+        if (close_failed) {
+            throw std::runtime_error("Failed to write to multicast trace file: " + m_filename);
+        }
+    }
+
+    uint64_t MulticastTrace::GetNumRecorded() {
+        return m_head.load() + m_num_dropped;
+    }
+
+    uint64_t MulticastTrace::GetNumWritten() {
+        return m_tail.load();
+    }
+
+    uint64_t MulticastTrace::GetNumDropped() {
+        return m_num_dropped;
+    }
+
+}
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTICAST_TRACE_H
+#define MULTICAST_TRACE_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include <stdexcept>
+#include <exception>
+#include <iostream>
+
+#include "ns3/core-module.h"
+
+namespace ns3 {
+
+    // What the multicast routing decided for a packet at a node
+    enum MulticastTraceDecision : uint8_t {
+        MULTICAST_TRACE_OUTBOUND = 0,       //!< Sent out by the source node itself
+        MULTICAST_TRACE_FORWARD = 1,        //!< Replicated onto the output interfaces
+        MULTICAST_TRACE_LOCAL_DELIVERY = 2, //!< Delivered to the local sockets (group member)
+        MULTICAST_TRACE_NO_ROUTE = 3,       //!< No multicast forwarding entry, so not forwarded
+        MULTICAST_TRACE_RPF_FAIL = 4        //!< Not arrived on the input interface of its entry, so dropped
+    };
+
+    /**
+     * Fixed-size binary record (32 bytes, little-endian as on the host).
+     * The output interface bitmap has bit i set iff interface i is an output
+     * interface; interfaces >= 64 are not in the bitmap but do count in num_oifs.
+     */
+    struct MulticastTraceRecord {
+        int64_t time_ns;
+        uint32_t node_id;
+        uint32_t group;
+        uint32_t iif;
+        uint16_t num_oifs;
+        uint8_t decision;
+        uint8_t reserved;
+        uint64_t oif_bitmap;
+    };
+
+    /**
+     * Bounded single-producer single-consumer ring of multicast trace records.
+     * The simulation thread only copies a record into the ring, a background
+     * thread drains it to a binary file in large writes. If the writer cannot
+     * keep up and the ring is full, the record is dropped (and counted) rather
+     * than stalling the simulation. If the writer fails, it stops and the error is
+     * thrown by Close() on the simulation thread.
+     */
+    class MulticastTrace : public Object {
+
+    public:
+        static TypeId GetTypeId (void);
+        MulticastTrace(std::string filename, uint32_t ring_capacity);
+        ~MulticastTrace();
+        void Record(uint32_t node_id, uint32_t group, uint32_t iif, uint64_t oif_bitmap, uint16_t num_oifs, uint8_t decision);
+        void Close();
+        uint64_t GetNumRecorded();
+        uint64_t GetNumWritten();
+        uint64_t GetNumDropped();
+
+    private:
+        void WriterLoop();
+        void DrainToFile();
+
+        std::string m_filename;
+        FILE* m_file;
+        std::vector<MulticastTraceRecord> m_ring;
+        uint64_t m_ring_mask;
+        uint64_t m_notify_every;
+        std::atomic<uint64_t> m_head;   //!< Next write position (producer)
+        std::atomic<uint64_t> m_tail;   //!< Next read position (consumer)
+        uint64_t m_num_dropped;
+        std::atomic<bool> m_stop;
+        bool m_closed;
+        std::exception_ptr m_writer_error;  //!< Set by the writer if it failed, read after it is joined
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::thread m_writer;
+
+    };
+
+}
+
+#endif // MULTICAST_TRACE_H
@@ -0,0 +1,317 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "phase-profiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cinttypes>
+#include <new>
+#include <time.h>
+#include <sys/resource.h>
+
+#ifdef BASIC_SIM_COUNT_ALLOCATIONS
+
+// Number of calls to the global operator new by the whole process. The replacements below
+// are the standard (malloc-based) ones apart from the counting, which is a single relaxed
+// atomic increment per allocation. As they replace the allocation functions of every program
+// linking this module, they are only compiled in if the build is configured with
+// --enable-basic-sim-allocation-counting.
+static std::atomic<int64_t> g_phase_profiler_num_allocations(0);
+
+static void* phase_profiler_counting_new(std::size_t size) {
+    g_phase_profiler_num_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) {
+        size = 1;
+    }
+    void* ptr;
+    while ((ptr = std::malloc(size)) == nullptr) {
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+    return ptr;
+}
+
+void* operator new(std::size_t size) {
+    return phase_profiler_counting_new(size);
+}
+
+void* operator new[](std::size_t size) {
+    return phase_profiler_counting_new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return phase_profiler_counting_new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return phase_profiler_counting_new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+#endif // BASIC_SIM_COUNT_ALLOCATIONS
+
+namespace ns3 {
+
+    static int64_t phase_profiler_now_ns_since_epoch() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    static std::string phase_profiler_json_escape(const std::string& str) {
+        std::string escaped;
+        for (char c : str) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+                escaped += c;
+            } else if ((unsigned char) c < 0x20) {
+                char buffer[8];
+                snprintf(buffer, sizeof(buffer), "\\u%04x", (unsigned int) c);
+                escaped += buffer;
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    bool PhaseProfiler::IsAllocationCountingEnabled() {
+#ifdef BASIC_SIM_COUNT_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    int64_t PhaseProfiler::GetNumAllocations() {
+#ifdef BASIC_SIM_COUNT_ALLOCATIONS
+        return g_phase_profiler_num_allocations.load(std::memory_order_relaxed);
+#else
+        return 0;
+#endif
+    }
+
+    int64_t PhaseProfiler::GetCpuTimeNs() {
+        struct timespec ts;
+        if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) {
+            return 0;
+        }
+        return (int64_t) ts.tv_sec * 1000000000 + (int64_t) ts.tv_nsec;
+    }
+
+    int64_t PhaseProfiler::GetPeakRssKib() {
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+#ifdef __APPLE__
+        return (int64_t) usage.ru_maxrss / 1024; // Bytes on macOS
+#else
+        return (int64_t) usage.ru_maxrss; // Kibibytes on Linux
+#endif
+    }
+
+    PhaseProfiler::PhaseProfiler() {
+        // Left empty intentionally
+    }
+
+    /**
+     * Begin a phase, nested in the innermost phase which is still open.
+     *
+     * @param name  Phase name
+     */
+    void PhaseProfiler::Begin(const std::string& name) {
+        PhaseProfile phase;
+        phase.name = name;
+        phase.depth = m_open.size();
+        phase.start_ns_since_epoch = phase_profiler_now_ns_since_epoch();
+        phase.wall_ns = -1;
+        phase.cpu_ns = 0;
+        phase.peak_rss_delta_kib = 0;
+        phase.num_allocations = 0;
+        m_phases.push_back(phase);
+        OpenPhase open;
+        open.index = m_phases.size() - 1;
+        open.cpu_ns = GetCpuTimeNs();
+        open.peak_rss_kib = GetPeakRssKib();
+        open.num_allocations = GetNumAllocations();
+        m_open.push_back(open);
+    }
+
+    /**
+     * End the innermost phase which is still open.
+     */
+    void PhaseProfiler::End() {
+        if (m_open.empty()) {
+            throw std::runtime_error("Cannot end a phase as there is no phase open");
+        }
+        OpenPhase open = m_open.back();
+        m_open.pop_back();
+        PhaseProfile& phase = m_phases[open.index];
+        phase.wall_ns = phase_profiler_now_ns_since_epoch() - phase.start_ns_since_epoch;
+        phase.cpu_ns = GetCpuTimeNs() - open.cpu_ns;
+        phase.peak_rss_delta_kib = GetPeakRssKib() - open.peak_rss_kib;
+        phase.num_allocations = GetNumAllocations() - open.num_allocations;
+    }
+
+    const std::vector<PhaseProfile>& PhaseProfiler::GetPhases() const {
+        return m_phases;
+    }
+
+    size_t PhaseProfiler::GetNumOpenPhases() const {
+        return m_open.size();
+    }
+
+    /**
+     * Format each phase as a line in the same style as the timestamps in timing_results.txt,
+     * with the name indented according to its depth.
+     *
+     * @param origin_ns_since_epoch     Time which is shown as 0
+     *
+     * @return One line per phase (in the order they began)
+     */
+    std::vector<std::string> PhaseProfiler::FormatPhases(int64_t origin_ns_since_epoch) const {
+        std::vector<std::string> lines;
+        for (const PhaseProfile& phase : m_phases) {
+            std::string indented_name = std::string(2 * phase.depth, ' ') + phase.name;
+            char buffer[1024];
+            if (phase.wall_ns < 0) {
+                snprintf(
+                        buffer, sizeof(buffer),
+                        "[%7.1f -   (...)] :: %s (not finished)",
+                        (phase.start_ns_since_epoch - origin_ns_since_epoch) / 1e9,
+                        indented_name.c_str()
+                );
+            } else {
+                std::string allocations = IsAllocationCountingEnabled() ? std::to_string(phase.num_allocations) : "n/a";
+                snprintf(
+                        buffer, sizeof(buffer),
+                        "[%7.1f - %7.1f] (%.3f s) :: %s (CPU: %.3f s, peak RSS: +%" PRId64 " KiB, allocations: %s)",
+                        (phase.start_ns_since_epoch - origin_ns_since_epoch) / 1e9,
+                        (phase.start_ns_since_epoch + phase.wall_ns - origin_ns_since_epoch) / 1e9,
+                        phase.wall_ns / 1e9,
+                        indented_name.c_str(),
+                        phase.cpu_ns / 1e9,
+                        phase.peak_rss_delta_kib,
+                        allocations.c_str()
+                );
+            }
+            lines.push_back(buffer);
+        }
+        return lines;
+    }
+
+    /**
+     * Write the phases in the Chrome trace event format (JSON), which can be opened in
+     * chrome://tracing or Perfetto. The flat timestamps are on a separate track.
+     *
+     * @param out                       Output stream
+     * @param origin_ns_since_epoch     Time which is shown as 0
+     * @param timestamps                Flat timestamps (label, ns since epoch), each ending the segment since the previous one
+     * @param process_id                Process identifier in the trace (e.g., the system id if distributed)
+     */
+    void PhaseProfiler::WriteChromeTrace(
+            std::ostream& out,
+            int64_t origin_ns_since_epoch,
+            const std::vector<std::pair<std::string, int64_t>>& timestamps,
+            uint32_t process_id
+    ) const {
+        char buffer[1024];
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+        snprintf(buffer, sizeof(buffer), "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"System %u\"}},", process_id, process_id);
+        out << buffer << std::endl;
+        snprintf(buffer, sizeof(buffer), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":0,\"args\":{\"name\":\"Timestamps\"}},", process_id);
+        out << buffer << std::endl;
+        snprintf(buffer, sizeof(buffer), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":1,\"args\":{\"name\":\"Phases\"}}", process_id);
+        out << buffer;
+
+        // Flat timestamps
+        for (size_t i = 1; i < timestamps.size(); i++) {
+            snprintf(
+                    buffer, sizeof(buffer),
+                    ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%u,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}",
+                    phase_profiler_json_escape(timestamps[i].first).c_str(),
+                    process_id,
+                    (timestamps[i - 1].second - origin_ns_since_epoch) / 1e3,
+                    (timestamps[i].second - timestamps[i - 1].second) / 1e3
+            );
+            out << buffer;
+        }
+
+        // Finished phases (nesting follows from the time containment)
+        for (const PhaseProfile& phase : m_phases) {
+            if (phase.wall_ns < 0) {
+                continue;
+            }
+            snprintf(
+                    buffer, sizeof(buffer),
+                    ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%u,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,"
+                    "\"args\":{\"cpu_ms\":%.3f,\"peak_rss_delta_kib\":%" PRId64,
+                    phase_profiler_json_escape(phase.name).c_str(),
+                    process_id,
+                    (phase.start_ns_since_epoch - origin_ns_since_epoch) / 1e3,
+                    phase.wall_ns / 1e3,
+                    phase.cpu_ns / 1e6,
+                    phase.peak_rss_delta_kib
+            );
+            out << buffer;
+            if (IsAllocationCountingEnabled()) {
+                snprintf(buffer, sizeof(buffer), ",\"allocations\":%" PRId64, phase.num_allocations);
+                out << buffer;
+            }
+            out << "}}";
+        }
+
+        out << std::endl << "]}" << std::endl;
+    }
+
+    ScopedPhase::ScopedPhase(PhaseProfiler& profiler, const std::string& name) : m_profiler(profiler) {
+        m_profiler.Begin(name);
+    }
+
+    ScopedPhase::~ScopedPhase() {
+        m_profiler.End();
+    }
+
+}
@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef PHASE_PROFILER_H
+#define PHASE_PROFILER_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include <ostream>
+
+namespace ns3 {
+
+    /**
+     * Measurements of a single (finished or still open) phase.
+     */
+    struct PhaseProfile {
+        std::string name;
+        size_t depth;                   //!< 0 for a top-level phase
+        int64_t start_ns_since_epoch;
+        int64_t wall_ns;                //!< -1 while the phase is still open
+        int64_t cpu_ns;                 //!< CPU time of the whole process (all threads)
+        int64_t peak_rss_delta_kib;     //!< Increase of the peak resident set size
+        int64_t num_allocations;        //!< Calls to the global operator new (0 if not counted)
+    };
+
+    /**
+     * Profiler of nested phases. Each phase records its wall time, process CPU time,
+     * increase of the peak resident set size and number of heap allocations. Heap allocations
+     * are only counted if the build is configured with --enable-basic-sim-allocation-counting,
+     * as this replaces the global operator new and delete.
+     * Phases are kept in the order in which they began (pre-order of the phase tree).
+     */
+    class PhaseProfiler {
+
+    public:
+        PhaseProfiler();
+        void Begin(const std::string& name);
+        void End();
+        const std::vector<PhaseProfile>& GetPhases() const;
+        size_t GetNumOpenPhases() const;
+        std::vector<std::string> FormatPhases(int64_t origin_ns_since_epoch) const;
+        void WriteChromeTrace(
+                std::ostream& out,
+                int64_t origin_ns_since_epoch,
+                const std::vector<std::pair<std::string, int64_t>>& timestamps,
+                uint32_t process_id
+        ) const;
+
+        static bool IsAllocationCountingEnabled();
+        static int64_t GetNumAllocations();
+        static int64_t GetCpuTimeNs();
+        static int64_t GetPeakRssKib();
+
+    private:
+        struct OpenPhase {
+            size_t index;
+            int64_t cpu_ns;
+            int64_t peak_rss_kib;
+            int64_t num_allocations;
+        };
+        std::vector<PhaseProfile> m_phases;
+        std::vector<OpenPhase> m_open;
+
+    };
+
+    /**
+     * Phase which begins on construction and ends on destruction (also when unwinding due to an exception).
+     *
+     * Usage: ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Read ISLs");
+     */
+    class ScopedPhase {
+
+    public:
+        ScopedPhase(PhaseProfiler& profiler, const std::string& name);
+        ~ScopedPhase();
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+    private:
+        PhaseProfiler& m_profiler;
+
+    };
+
+}
+
+#endif // PHASE_PROFILER_H
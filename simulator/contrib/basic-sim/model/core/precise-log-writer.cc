@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "precise-log-writer.h"
+
+namespace ns3 {
+
+    NS_OBJECT_ENSURE_REGISTERED (PreciseLogWriter);
+    TypeId PreciseLogWriter::GetTypeId (void)
+    {
+        static TypeId tid = TypeId ("ns3::PreciseLogWriter")
+                .SetParent<Object> ()
+                .SetGroupName("BasicSim")
+        ;
+        return tid;
+    }
+
+    PreciseLogWriter::PreciseLogWriter(uint32_t buffer_num_records) {
+        static_assert(sizeof(PreciseLogRecord) == 24, "Precise log record must be 24 bytes");
+        if (buffer_num_records == 0) {
+            throw std::invalid_argument("Precise log buffer must hold at least one record");
+        }
+        m_buffer_num_records = buffer_num_records;
+        m_num_records_written = 0;
+        m_num_writes = 0;
+        m_stop = false;
+        m_closed = false;
+        m_writer_error_thrown = false;
+
+        // Writer which drains the full buffers in the background
+        m_writer = std::thread(&PreciseLogWriter::WriterLoop, this);
+
+    }
+
+    PreciseLogWriter::~PreciseLogWriter() {
+        try {
+            Close();
+        } catch (const std::exception& e) {
+            std::cerr << "Precise log writer was not closed properly: " << e.what() << std::endl;
+        }
+    }
+
+    uint32_t PreciseLogWriter::OpenFile(std::string csv_filename) {
+        if (m_closed) {
+            throw std::runtime_error("Cannot open a file for a closed precise log writer");
+        }
+        std::string bin_filename = csv_filename + ".bin";
+        FILE* file = fopen(bin_filename.c_str(), "wb");
+        if (file == nullptr) {
+            throw std::runtime_error("Could not open precise log file: " + bin_filename);
+        }
+        std::vector<PreciseLogRecord> buffer;
+        buffer.reserve(m_buffer_num_records);
+
+        // The writer thread reads the file pointers
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_csv_filenames.push_back(csv_filename);
+        m_bin_filenames.push_back(bin_filename);
+        m_files.push_back(file);
+        m_buffers.push_back(std::move(buffer));
+        return m_files.size() - 1;
+    }
+
+    void PreciseLogWriter::HandOver(uint32_t file_idx) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_writer_error && !m_writer_error_thrown) {
+            m_writer_error_thrown = true;
+            std::rethrow_exception(m_writer_error);
+        }
+        m_full.emplace_back(file_idx, std::move(m_buffers[file_idx]));
+        if (!m_spare.empty()) {
+            m_buffers[file_idx] = std::move(m_spare.back());
+            m_spare.pop_back();
+        } else {
+            m_buffers[file_idx] = std::vector<PreciseLogRecord>();
+            m_buffers[file_idx].reserve(m_buffer_num_records);
+        }
+        m_cv.notify_one();
+    }
+
+    void PreciseLogWriter::WriterLoop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_cv.wait(lock, [this] { return m_stop || !m_full.empty(); });
+            while (!m_full.empty()) {
+                std::pair<uint32_t, std::vector<PreciseLogRecord>> full = std::move(m_full.front());
+                m_full.pop_front();
+                FILE* file = m_files[full.first];
+
+                // Write without holding the lock, such that the simulation can hand over more
+                // (after a failure nothing is written anymore, an exception cannot leave the thread)
+                if (!m_writer_error) {
+                    lock.unlock();
+                    bool failed = fwrite(full.second.data(), sizeof(PreciseLogRecord), full.second.size(), file) != full.second.size();
+                    lock.lock();
+                    if (failed) {
+                        m_writer_error = std::make_exception_ptr(std::runtime_error("Failed to write to precise log file: " + m_bin_filenames[full.first]));
+                    } else {
+                        m_num_records_written += full.second.size();
+                        m_num_writes++;
+                    }
+                }
+                full.second.clear();
+                m_spare.push_back(std::move(full.second));
+            }
+            if (m_stop) {
+                return;
+            }
+        }
+    }
+
+    void PreciseLogWriter::Close() {
+        if (m_closed) {
+            return;
+        }
+
+        // Hand over what is left in the partially filled buffers
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (uint32_t i = 0; i < m_buffers.size(); i++) {
+                if (!m_buffers[i].empty()) {
+                    m_full.emplace_back(i, std::move(m_buffers[i]));
+                    m_buffers[i] = std::vector<PreciseLogRecord>();
+                }
+            }
+            m_stop = true;
+        }
+        m_cv.notify_one();
+        m_writer.join();
+        bool close_failed = false;
+        for (FILE* file : m_files) {
+            close_failed = fclose(file) != 0 || close_failed;
+        }
+        m_closed = true;
+
+        // Write failures of the writer thread are thrown here on the simulation thread
+        if (m_writer_error && !m_writer_error_thrown) {
+            m_writer_error_thrown = true;
+            std::rethrow_exception(m_writer_error);
+        }
+        if (close_failed && !m_writer_error_thrown) {
+            m_writer_error_thrown = true;
+            throw std::runtime_error("Failed to write to precise log file");
+        }
+    }
+
+    void PreciseLogWriter::ConvertToCsv() {
+        if (!m_closed) {
+            throw std::runtime_error("Precise log writer must be closed before converting to CSV");
+        }
+        for (uint32_t i = 0; i < m_csv_filenames.size(); i++) {
+            precise_log_bin_to_csv(m_bin_filenames[i], m_csv_filenames[i]);
+            remove_file_if_exists(m_bin_filenames[i]);
+        }
+    }
+
+    uint64_t PreciseLogWriter::GetNumRecordsWritten() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_num_records_written;
+    }
+
+    uint64_t PreciseLogWriter::GetNumWrites() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_num_writes;
+    }
+
+    void precise_log_bin_to_csv(const std::string& bin_filename, const std::string& csv_filename) {
+        FILE* file_bin = fopen(bin_filename.c_str(), "rb");
+        if (file_bin == nullptr) {
+            throw std::runtime_error("Could not open precise log file: " + bin_filename);
+        }
+        FILE* file_csv = fopen(csv_filename.c_str(), "w");
+        if (file_csv == nullptr) {
+            fclose(file_bin);
+            throw std::runtime_error("Could not open precise log file: " + csv_filename);
+        }
+        std::vector<PreciseLogRecord> chunk(65536);
+        size_t n;
+        while ((n = fread(chunk.data(), sizeof(PreciseLogRecord), chunk.size(), file_bin)) > 0) {
+            for (size_t i = 0; i < n; i++) {
+                fprintf(file_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 "\n", chunk[i].id, chunk[i].seq, chunk[i].time_ns);
+            }
+        }
+        fclose(file_bin);
+        fclose(file_csv);
+    }
+
+}
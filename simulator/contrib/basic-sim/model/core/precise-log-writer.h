@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PRECISE_LOG_WRITER_H
+#define PRECISE_LOG_WRITER_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#include <stdexcept>
+#include <exception>
+#include <iostream>
+
+#include "ns3/core-module.h"
+#include "ns3/exp-util.h"
+
+namespace ns3 {
+
+    /**
+     * Fixed-size binary record (24 bytes, little-endian as on the host) of a precise log:
+     * e.g., (UDP burst id, sequence number, time) of a packet sent or received.
+     */
+    struct PreciseLogRecord {
+        int64_t id;
+        int64_t seq;
+        int64_t time_ns;
+    };
+
+    /**
+     * Writer of precise logs shared by applications. Each log file has its own buffer
+     * to which records are appended without any I/O; a full buffer is handed over to a
+     * background thread, which appends it to the binary file in a single write. After
+     * the run, the binary files are converted to the CSV files with one "id,seq,time"
+     * line per record. If a write fails, the writer stops writing and the error is thrown
+     * on the simulation thread, by the next hand-over or by Close().
+     */
+    class PreciseLogWriter : public Object {
+
+    public:
+        static TypeId GetTypeId (void);
+        PreciseLogWriter(uint32_t buffer_num_records);
+        ~PreciseLogWriter();
+        uint32_t OpenFile(std::string csv_filename);
+        inline void Append(uint32_t file_idx, int64_t id, int64_t seq, int64_t time_ns) {
+            std::vector<PreciseLogRecord>& buffer = m_buffers[file_idx];
+            buffer.push_back({id, seq, time_ns});
+            if (buffer.size() == m_buffer_num_records) {
+                HandOver(file_idx);
+            }
+        }
+        void Close();
+        void ConvertToCsv();
+        uint64_t GetNumRecordsWritten();
+        uint64_t GetNumWrites();
+
+    private:
+        void HandOver(uint32_t file_idx);
+        void WriterLoop();
+
+        uint32_t m_buffer_num_records;
+        std::vector<std::string> m_csv_filenames;
+        std::vector<std::string> m_bin_filenames;
+        std::vector<FILE*> m_files;
+        std::vector<std::vector<PreciseLogRecord>> m_buffers;                       //!< Being filled (simulation thread)
+        std::deque<std::pair<uint32_t, std::vector<PreciseLogRecord>>> m_full;      //!< Full buffers to be written
+        std::vector<std::vector<PreciseLogRecord>> m_spare;                         //!< Written buffers to be re-used
+        uint64_t m_num_records_written;
+        uint64_t m_num_writes;
+        bool m_stop;
+        bool m_closed;
+        std::exception_ptr m_writer_error;                                          //!< Set by the writer if it failed
+        bool m_writer_error_thrown;
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::thread m_writer;
+
+    };
+
+    /**
+     * Convert a binary precise log file to CSV, one "id,seq,time" line per record.
+     *
+     * @param bin_filename      Binary file with precise log records
+     * @param csv_filename      CSV file to (over)write
+     */
+    void precise_log_bin_to_csv(const std::string& bin_filename, const std::string& csv_filename);
+
+}
+
+#endif // PRECISE_LOG_WRITER_H
@@ -0,0 +1,283 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "profiling-scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cinttypes>
+#include <cxxabi.h>
+#include "ns3/map-scheduler.h"
+#include "ns3/exp-util.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace ns3 {
+
+    static int64_t profiling_scheduler_steady_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static inline uint64_t profiling_scheduler_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return (uint64_t) profiling_scheduler_steady_ns();
+#endif
+    }
+
+    /**
+     * Readable name of an event implementation type. For the types generated by MakeEvent()
+     * this is the type of its first parameter, the function (pointer) which the event invokes.
+     */
+    static std::string profiling_scheduler_kind_name(const char* mangled_name) {
+        std::string name = mangled_name;
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(mangled_name, nullptr, nullptr, &status);
+        if (status == 0 && demangled != nullptr) {
+            name = demangled;
+        }
+        std::free(demangled);
+        const std::string prefix = "ns3::MakeEvent";
+        size_t start = name.find(prefix);
+        if (start != std::string::npos) {
+            size_t i = start + prefix.size();
+            int depth = 0;
+            if (i < name.size() && name[i] == '<') {
+                for (; i < name.size(); i++) {
+                    if (name[i] == '<') {
+                        depth++;
+                    } else if (name[i] == '>' && --depth == 0) {
+                        i++;
+                        break;
+                    }
+                }
+            }
+            if (i < name.size() && name[i] == '(') {
+                size_t first = ++i;
+                for (; i < name.size(); i++) {
+                    char c = name[i];
+                    if (c == '<' || c == '(') {
+                        depth++;
+                    } else if ((c == '>' || c == ')') && depth > 0) {
+                        depth--;
+                    } else if ((c == ')' || c == ',') && depth == 0) {
+                        return name.substr(first, i - first);
+                    }
+                }
+            }
+        }
+        return name;
+    }
+
+    ProfilingScheduler* ProfilingScheduler::s_current = nullptr;
+
+    NS_OBJECT_ENSURE_REGISTERED (ProfilingScheduler);
+    TypeId ProfilingScheduler::GetTypeId (void)
+    {
+        static TypeId tid = TypeId ("ns3::ProfilingScheduler")
+                .SetParent<Scheduler> ()
+                .SetGroupName("BasicSim")
+                .AddConstructor<ProfilingScheduler> ()
+                .AddAttribute ("WrappedSchedulerType",
+                               "Type of the scheduler which actually holds the events",
+                               TypeIdValue (MapScheduler::GetTypeId ()),
+                               MakeTypeIdAccessor (&ProfilingScheduler::SetWrappedSchedulerType,
+                                                   &ProfilingScheduler::GetWrappedSchedulerType),
+                               MakeTypeIdChecker ())
+        ;
+        return tid;
+    }
+
+    ProfilingScheduler::ProfilingScheduler() {
+        m_profiling = true;
+        m_start_ticks = profiling_scheduler_ticks();
+        m_start_steady_ns = profiling_scheduler_steady_ns();
+        m_stop_ticks = 0;
+        m_stop_steady_ns = 0;
+        m_previous_type = nullptr;
+        m_previous_cancelled = false;
+        m_previous_start_ticks = 0;
+        m_cancelled_statistics.count = 0;
+        m_cancelled_statistics.ticks = 0;
+        s_current = this;
+    }
+
+    ProfilingScheduler::~ProfilingScheduler() {
+        if (s_current == this) {
+            s_current = nullptr;
+        }
+    }
+
+    /**
+     * Latest profiling scheduler which has been created and is not yet destroyed.
+     *
+     * @return Profiling scheduler (nullptr if there is none)
+     */
+    ProfilingScheduler* ProfilingScheduler::GetCurrent() {
+        return s_current;
+    }
+
+    void ProfilingScheduler::SetWrappedSchedulerType(TypeId type) {
+        ObjectFactory factory;
+        factory.SetTypeId(type);
+        Ptr<Scheduler> wrapped = factory.Create<Scheduler>();
+        if (m_wrapped != nullptr) {
+            while (!m_wrapped->IsEmpty()) {
+                wrapped->Insert(m_wrapped->RemoveNext());
+            }
+        }
+        m_wrapped_type = type;
+        m_wrapped = wrapped;
+    }
+
+    TypeId ProfilingScheduler::GetWrappedSchedulerType() const {
+        return m_wrapped_type;
+    }
+
+    void ProfilingScheduler::Insert (const Event &ev) {
+        m_wrapped->Insert(ev);
+    }
+
+    bool ProfilingScheduler::IsEmpty (void) const {
+        return m_wrapped->IsEmpty();
+    }
+
+    Scheduler::Event ProfilingScheduler::PeekNext (void) const {
+        return m_wrapped->PeekNext();
+    }
+
+    Scheduler::Event ProfilingScheduler::RemoveNext (void) {
+        if (!m_profiling) {
+            return m_wrapped->RemoveNext();
+        }
+        RecordPrevious(profiling_scheduler_ticks());
+        Event ev = m_wrapped->RemoveNext();
+        m_previous_type = &typeid(*ev.impl);
+        m_previous_cancelled = ev.impl->IsCancelled();
+        m_previous_start_ticks = profiling_scheduler_ticks();
+        return ev;
+    }
+
+    void ProfilingScheduler::Remove (const Event &ev) {
+        m_wrapped->Remove(ev);
+    }
+
+    /**
+     * Attribute the ticks since the previous event was removed to it.
+     *
+     * @param now_ticks     Ticks now
+     */
+    void ProfilingScheduler::RecordPrevious(uint64_t now_ticks) {
+        if (m_previous_type == nullptr) {
+            return;
+        }
+        KindStatistics& statistics = m_previous_cancelled ? m_cancelled_statistics : m_statistics[std::type_index(*m_previous_type)];
+        statistics.count++;
+        statistics.ticks += now_ticks - m_previous_start_ticks;
+        m_previous_type = nullptr;
+    }
+
+    /**
+     * Stop profiling, such that the events removed afterwards (e.g., when the simulator
+     * is destroyed) are not counted. The event executing right now is recorded until now.
+     */
+    void ProfilingScheduler::StopProfiling() {
+        if (!m_profiling) {
+            return;
+        }
+        uint64_t now_ticks = profiling_scheduler_ticks();
+        RecordPrevious(now_ticks);
+        m_profiling = false;
+        m_stop_ticks = now_ticks;
+        m_stop_steady_ns = profiling_scheduler_steady_ns();
+    }
+
+    /**
+     * Statistics of each kind of event, ranked by their total execution time (highest first).
+     *
+     * @return Ranked event profile
+     */
+    std::vector<EventProfileEntry> ProfilingScheduler::GetEventProfile() const {
+
+        // Calibrate the ticks over the whole profiled period
+        uint64_t end_ticks = m_profiling ? profiling_scheduler_ticks() : m_stop_ticks;
+        int64_t end_steady_ns = m_profiling ? profiling_scheduler_steady_ns() : m_stop_steady_ns;
+        double ns_per_tick = 1.0;
+        if (end_ticks > m_start_ticks) {
+            ns_per_tick = (double) (end_steady_ns - m_start_steady_ns) / (double) (end_ticks - m_start_ticks);
+        }
+
+        // One entry per kind
+        std::vector<EventProfileEntry> profile;
+        for (const std::pair<const std::type_index, KindStatistics>& kind : m_statistics) {
+            EventProfileEntry entry;
+            entry.kind = profiling_scheduler_kind_name(kind.first.name());
+            entry.count = kind.second.count;
+            entry.total_ns = kind.second.ticks * ns_per_tick;
+            entry.mean_ns = entry.total_ns / entry.count;
+            profile.push_back(entry);
+        }
+        if (m_cancelled_statistics.count > 0) {
+            EventProfileEntry entry;
+            entry.kind = "(cancelled)";
+            entry.count = m_cancelled_statistics.count;
+            entry.total_ns = m_cancelled_statistics.ticks * ns_per_tick;
+            entry.mean_ns = entry.total_ns / entry.count;
+            profile.push_back(entry);
+        }
+
+        // Ranked by total time
+        std::sort(profile.begin(), profile.end(), [](const EventProfileEntry& a, const EventProfileEntry& b) {
+            return a.total_ns > b.total_ns || (a.total_ns == b.total_ns && a.kind < b.kind);
+        });
+        return profile;
+
+    }
+
+    /**
+     * Write the ranked event profile to a CSV file, with line format:
+     * [rank],[count],[total (ns)],[mean (ns)],"[kind]"
+     *
+     * @param filename  Output filename
+     */
+    void ProfilingScheduler::WriteEventProfile(const std::string& filename) const {
+        FILE* file_csv = fopen(filename.c_str(), "w+");
+        if (file_csv == nullptr) {
+            throw std::runtime_error(format_string("File %s could not be opened for writing.", filename.c_str()));
+        }
+        std::vector<EventProfileEntry> profile = GetEventProfile();
+        for (size_t i = 0; i < profile.size(); i++) {
+            std::string quoted_kind;
+            for (char c : profile[i].kind) {
+                quoted_kind += c;
+                if (c == '"') {
+                    quoted_kind += '"';
+                }
+            }
+            fprintf(
+                    file_csv, "%" PRIu64 ",%" PRIu64 ",%.0f,%.1f,\"%s\"\n",
+                    (uint64_t) (i + 1), profile[i].count, profile[i].total_ns, profile[i].mean_ns, quoted_kind.c_str()
+            );
+        }
+        fclose(file_csv);
+    }
+
+}
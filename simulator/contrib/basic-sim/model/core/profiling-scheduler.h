@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PROFILING_SCHEDULER_H
+#define PROFILING_SCHEDULER_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <typeinfo>
+#include <typeindex>
+#include <unordered_map>
+#include <stdexcept>
+
+#include "ns3/core-module.h"
+#include "ns3/scheduler.h"
+
+namespace ns3 {
+
+    /**
+     * Execution statistics of one kind of event.
+     */
+    struct EventProfileEntry {
+        std::string kind;
+        uint64_t count;
+        double total_ns;
+        double mean_ns;
+    };
+
+    /**
+     * Scheduler which wraps another scheduler (by default the map scheduler) and measures
+     * the execution of every event, per kind of event.
+     *
+     * The kind of an event is the type of its implementation, which MakeEvent() generates per
+     * function (pointer) type, e.g., "void (ns3::GSLNetDevice::*)(ns3::Ptr<ns3::Packet>)".
+     * Different member functions of the same class with the same signature are thus the same kind.
+     * Cancelled events are counted separately.
+     *
+     * The simulator takes the next event out of the scheduler right before it invokes it,
+     * and the next one right after, so the time between two RemoveNext() calls is attributed
+     * to the event removed by the first. It is measured with the time stamp counter (x86),
+     * converted to nanoseconds by calibrating it against the steady clock over the whole run.
+     */
+    class ProfilingScheduler : public Scheduler {
+
+    public:
+        static TypeId GetTypeId (void);
+        ProfilingScheduler();
+        virtual ~ProfilingScheduler();
+
+        // Scheduler
+        virtual void Insert (const Event &ev);
+        virtual bool IsEmpty (void) const;
+        virtual Event PeekNext (void) const;
+        virtual Event RemoveNext (void);
+        virtual void Remove (const Event &ev);
+
+        // Profile
+        void StopProfiling();
+        std::vector<EventProfileEntry> GetEventProfile() const;
+        void WriteEventProfile(const std::string& filename) const;
+        static ProfilingScheduler* GetCurrent();
+
+    private:
+        struct KindStatistics {
+            uint64_t count;
+            uint64_t ticks;
+        };
+
+        void SetWrappedSchedulerType(TypeId type);
+        TypeId GetWrappedSchedulerType() const;
+        void RecordPrevious(uint64_t now_ticks);
+
+        static ProfilingScheduler* s_current;
+
+        TypeId m_wrapped_type;
+        Ptr<Scheduler> m_wrapped;
+        bool m_profiling;
+
+        // Calibration of the ticks
+        uint64_t m_start_ticks;
+        int64_t m_start_steady_ns;
+        uint64_t m_stop_ticks;
+        int64_t m_stop_steady_ns;
+
+        // Event which is executing right now
+        const std::type_info* m_previous_type;
+        bool m_previous_cancelled;
+        uint64_t m_previous_start_ticks;
+
+        // Statistics per kind
+        std::unordered_map<std::type_index, KindStatistics> m_statistics;
+        KindStatistics m_cancelled_statistics;
+
+    };
+
+}
+
+#endif // PROFILING_SCHEDULER_H
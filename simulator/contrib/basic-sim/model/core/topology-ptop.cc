@@ -69,6 +69,7 @@ TopologyPtop::TopologyPtop(
     m_basicSimulation = basicSimulation;
     m_queueSelector = queueSelector;
     m_tcQdiscSelector = tcQdiscSelector;
+    ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Build point-to-point topology");
     ReadTopologyConfig();
     ParseTopologyGraph();
     ParseTopologyLinkProperties();
@@ -122,6 +123,7 @@ void TopologyPtop::ReadTopologyConfig() {
  * Parse the topology graph.
  */
 void TopologyPtop::ParseTopologyGraph() {
+    ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Parse topology graph");
     std::cout << "TOPOLOGY GRAPH PARSING" << std::endl;
 
     // Basic
@@ -493,6 +495,7 @@ void TopologyPtop::ParseLinkInterfaceTrafficControlQdiscProperty() {
  * Parse all topology link property mappings.
  */
 void TopologyPtop::ParseTopologyLinkProperties() {
+    ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Parse topology link properties");
     std::cout << "TOPOLOGY LINK PROPERTIES PARSING" << std::endl;
 
     // Channel delay
@@ -529,6 +532,7 @@ void TopologyPtop::ParseTopologyLinkProperties() {
  * @param ipv4RoutingHelper     IPv4 routing helper (decides which routing is installed on the node)
  */
 void TopologyPtop::SetupNodes(const Ipv4RoutingHelper& ipv4RoutingHelper) {
+    ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Setup nodes");
     std::cout << "SETUP NODES" << std::endl;
 
     // Creating the nodes in their respective system ID
@@ -556,6 +560,7 @@ void TopologyPtop::SetupNodes(const Ipv4RoutingHelper& ipv4RoutingHelper) {
  * Setup all the links based on the topological layout and the link mappings.
  */
 void TopologyPtop::SetupLinks() {
+    ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Setup links");
     std::cout << "SETUP LINKS" << std::endl;
 
     // Each link is a network on its own
@@ -701,4 +706,8 @@ Ptr<PointToPointNetDevice> TopologyPtop::GetNetDeviceForLink(std::pair<int64_t,
     return m_link_to_net_device.at(link);
 }
 
+double TopologyPtop::GetLinkDataRateMegabitPerSec(std::pair<int64_t, int64_t> link) {
+    return m_link_device_data_rate_megabit_per_s_mapping.at(link);
+}
+
 }
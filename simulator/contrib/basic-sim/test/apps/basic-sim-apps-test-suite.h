@@ -4,10 +4,15 @@
 #include "ns3/test.h"
 #include "tcp-flow-schedule-reader-test.h"
 #include "udp-burst-schedule-reader-test.h"
+#include "workload-generator-test.h"
+#include "trace-replay-test.h"
 #include "tcp-flow-end-to-end-test.h"
 #include "pingmesh-end-to-end-test.h"
 #include "manual-end-to-end-test.h"
 #include "udp-burst-end-to-end-test.h"
+#include "multicast-feedback-test.h"
+#include "multicast-fec-test.h"
+#include "multicast-udp-application-test.h"
 
 using namespace ns3;
 
@@ -23,6 +28,13 @@ public:
         AddTestCase(new UdpBurstScheduleReaderNormalTestCase, TestCase::QUICK);
         AddTestCase(new UdpBurstScheduleReaderInvalidTestCase, TestCase::QUICK);
 
+        // Stochastic workload generator
+        AddTestCase(new WorkloadGeneratorTestCase, TestCase::QUICK);
+
+        // Packet trace replay
+        AddTestCase(new PacketTraceReaderTestCase, TestCase::QUICK);
+        AddTestCase(new TraceReplayEndToEndTestCase, TestCase::QUICK);
+
         // Manual end-to-end, which means the application helpers are used
         // directly instead of the schedulers reading from files
         AddTestCase(new ManualEndToEndTestCase, TestCase::QUICK);
@@ -39,10 +51,13 @@ public:
         AddTestCase(new TcpFlowEndToEndPrematureCloseTestCase, TestCase::QUICK);
         AddTestCase(new TcpFlowEndToEndNotEnabledTestCase, TestCase::QUICK);
         AddTestCase(new TcpFlowEndToEndInvalidLoggingIdTestCase, TestCase::QUICK);
+        AddTestCase(new TcpFlowEndToEndWorkloadGeneratorTestCase, TestCase::QUICK);
+        AddTestCase(new TcpFlowEndToEndStreamingTestCase, TestCase::QUICK);
 
         // Pingmesh end-to-end
         AddTestCase(new PingmeshEndToEndNineAllTestCase, TestCase::QUICK);
         AddTestCase(new PingmeshEndToEndFivePairsTestCase, TestCase::QUICK);
+        AddTestCase(new PingmeshEndToEndSampledSummaryTestCase, TestCase::QUICK);
         AddTestCase(new PingmeshEndToEndCompetitionTcpTestCase, TestCase::QUICK);
         AddTestCase(new PingmeshEndToEndNotEnabledTestCase, TestCase::QUICK);
 
@@ -51,8 +66,23 @@ public:
         AddTestCase(new UdpBurstEndToEndSingleOverflowTestCase, TestCase::QUICK);
         AddTestCase(new UdpBurstEndToEndDoubleEnoughTestCase, TestCase::QUICK);
         AddTestCase(new UdpBurstEndToEndDoubleOverflowTestCase, TestCase::QUICK);
+        AddTestCase(new UdpBurstEndToEndPacedInBatchesTestCase, TestCase::QUICK);
         AddTestCase(new UdpBurstEndToEndNotEnabledTestCase, TestCase::QUICK);
         AddTestCase(new UdpBurstEndToEndInvalidLoggingIdTestCase, TestCase::QUICK);
+        AddTestCase(new UdpBurstEndToEndStreamingTestCase, TestCase::QUICK);
+        AddTestCase(new UdpBurstEndToEndLateRegistrationTestCase, TestCase::QUICK);
+
+        // Multicast rate adaptation feedback
+        AddTestCase(new MulticastFeedbackTestCase, TestCase::QUICK);
+
+        // Multicast forward error correction
+        AddTestCase(new MulticastFecTestCase, TestCase::QUICK);
+
+        // Multicast UDP application
+        AddTestCase(new MulticastUdpApplicationFecCountingTestCase, TestCase::QUICK);
+        AddTestCase(new MulticastUdpApplicationRateAdaptationBottleneckTestCase, TestCase::QUICK);
+        AddTestCase(new MulticastUdpApplicationRateAdaptationLateJoinerTestCase, TestCase::QUICK);
+        AddTestCase(new MulticastUdpApplicationFeedbackExpiryTestCase, TestCase::QUICK);
 
     }
 };
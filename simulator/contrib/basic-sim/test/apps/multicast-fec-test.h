@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/multicast-fec-header.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+#include "../test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class MulticastFecTestCase : public TestCase
+{
+public:
+    MulticastFecTestCase () : TestCase ("multicast-fec") {};
+    void DoRun () {
+
+        // Header survives a packet round trip
+        MulticastFecHeader header;
+        header.SetBlock(12345);
+        header.SetIndex(9);
+        header.SetBlockSize(8);
+        header.SetNumRepair(2);
+        ASSERT_TRUE(header.IsRepair());
+        ASSERT_EQUAL(header.GetSerializedSize(), 14);
+        Ptr<Packet> p = Create<Packet>(100);
+        p->AddHeader(header);
+        ASSERT_EQUAL(p->GetSize(), 114);
+        MulticastFecHeader received;
+        p->RemoveHeader(received);
+        ASSERT_EQUAL(received.GetBlock(), 12345);
+        ASSERT_EQUAL(received.GetIndex(), 9);
+        ASSERT_EQUAL(received.GetBlockSize(), 8);
+        ASSERT_EQUAL(received.GetNumRepair(), 2);
+        ASSERT_TRUE(received.IsRepair());
+        received.SetIndex(7);
+        ASSERT_FALSE(received.IsRepair());
+
+        // n = 8, k = 2: parity groups {0, 2, 4, 6} and {1, 3, 5, 7}
+        uint64_t all = 0xFF;
+
+        // Nothing lost, nothing to recover
+        ASSERT_EQUAL(multicast_fec_xor_recover(all, 0x3, 8, 2, all), 0);
+
+        // One loss in each group is recovered
+        ASSERT_EQUAL(multicast_fec_xor_recover(all & ~0x1ULL & ~0x8ULL, 0x3, 8, 2, all), 0x9);
+
+        // Not without the repair packet of its group
+        ASSERT_EQUAL(multicast_fec_xor_recover(all & ~0x1ULL & ~0x8ULL, 0x2, 8, 2, all), 0x8);
+
+        // Two losses in one group cannot be recovered, the other group still can
+        ASSERT_EQUAL(multicast_fec_xor_recover(all & ~0x1ULL & ~0x4ULL & ~0x2ULL, 0x3, 8, 2, all), 0x2);
+
+        // Packets which were not sent are not missing
+        ASSERT_EQUAL(multicast_fec_xor_recover(0x7 & ~0x4ULL, 0x1, 8, 2, 0x7), 0x4);
+
+        // A full block of 64
+        ASSERT_EQUAL(multicast_fec_xor_recover(~0ULL & ~(1ULL << 63), 0x1, 64, 1, ~0ULL), 1ULL << 63);
+
+        // Invalid block size or number of repair packets
+        ASSERT_EXCEPTION(multicast_fec_xor_recover(0, 0, 0, 1, 0));
+        ASSERT_EXCEPTION(multicast_fec_xor_recover(0, 0, 65, 1, 0));
+        ASSERT_EXCEPTION(multicast_fec_xor_recover(0, 0, 4, 0, 0));
+        ASSERT_EXCEPTION(multicast_fec_xor_recover(0, 0, 4, 5, 0));
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,58 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/multicast-feedback-header.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+#include "../test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class MulticastFeedbackTestCase : public TestCase
+{
+public:
+    MulticastFeedbackTestCase () : TestCase ("multicast-feedback") {};
+    void DoRun () {
+
+        // Header survives a packet round trip
+        MulticastFeedbackHeader header;
+        header.SetId(7);
+        header.SetReceiverNodeId(3);
+        header.SetNumReceived(90);
+        header.SetNumExpected(100);
+        ASSERT_EQUAL(header.GetSerializedSize(), 32);
+        Ptr<Packet> p = Create<Packet>(0);
+        p->AddHeader(header);
+        ASSERT_EQUAL(p->GetSize(), 32);
+        MulticastFeedbackHeader received;
+        p->RemoveHeader(received);
+        ASSERT_EQUAL(received.GetId(), 7);
+        ASSERT_EQUAL(received.GetReceiverNodeId(), 3);
+        ASSERT_EQUAL(received.GetNumReceived(), 90);
+        ASSERT_EQUAL(received.GetNumExpected(), 100);
+
+        // Without losses the rate increases by the step
+        ASSERT_EQUAL_APPROX(multicast_feedback_receiver_rate(50.0, 100, 100, 10000000, 5.0), 55.0, 0.000001);
+        ASSERT_EQUAL_APPROX(multicast_feedback_receiver_rate(50.0, 0, 0, 10000000, 5.0), 55.0, 0.000001);
+
+        // With losses it is 95% of the rate received: 500 packets of 1500 byte in 100 ms is 60 Mbit/s
+        ASSERT_EQUAL_APPROX(multicast_feedback_receiver_rate(100.0, 500, 800, 100000000, 5.0), 57.0, 0.000001);
+        ASSERT_EQUAL_APPROX(multicast_feedback_receiver_rate(100.0, 0, 800, 100000000, 5.0), 0.0, 0.000001);
+        ASSERT_EXCEPTION(multicast_feedback_receiver_rate(100.0, 500, 800, 0, 5.0));
+
+        // Percentile of the receiver rates
+        std::vector<double> rates = {40.0, 10.0, 30.0, 20.0, 50.0};
+        ASSERT_EQUAL_APPROX(multicast_feedback_select_rate(rates, 0), 10.0, 0.000001);
+        ASSERT_EQUAL_APPROX(multicast_feedback_select_rate(rates, 50), 30.0, 0.000001);
+        ASSERT_EQUAL_APPROX(multicast_feedback_select_rate(rates, 60), 30.0, 0.000001);
+        ASSERT_EQUAL_APPROX(multicast_feedback_select_rate(rates, 100), 50.0, 0.000001);
+        ASSERT_EQUAL_APPROX(multicast_feedback_select_rate({25.0}, 90), 25.0, 0.000001);
+        ASSERT_EXCEPTION(multicast_feedback_select_rate({}, 0));
+        ASSERT_EXCEPTION(multicast_feedback_select_rate(rates, -1));
+        ASSERT_EXCEPTION(multicast_feedback_select_rate(rates, 101));
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
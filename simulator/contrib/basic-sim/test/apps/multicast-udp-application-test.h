@@ -0,0 +1,326 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-simulation.h"
+#include "ns3/tcp-optimizer.h"
+#include "ns3/arbiter-ecmp-helper.h"
+#include "ns3/multicast-udp-helper.h"
+#include "ns3/test.h"
+#include "../test-helpers.h"
+#include <iostream>
+#include <fstream>
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+// The multicast UDP application used directly over a single link 0 -- 1, with a single
+// member which is addressed by its unicast address (no multicast routing needed)
+class MulticastUdpApplicationTestCase : public TestCase {
+public:
+    MulticastUdpApplicationTestCase(std::string s) : TestCase(s) {};
+    const std::string temp_dir = ".tmp-multicast-udp-application-test";
+
+    void prepare_test_dir(int64_t simulation_end_time_ns, double link_device_data_rate_megabit_per_s) {
+        mkdir_if_not_exists(temp_dir);
+        remove_file_if_exists(temp_dir + "/config_ns3.properties");
+        remove_file_if_exists(temp_dir + "/topology.properties");
+
+        // Basic configuration
+        std::ofstream config_file;
+        config_file.open (temp_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=" << simulation_end_time_ns << std::endl;
+        config_file << "simulation_seed=123456789" << std::endl;
+        config_file << "topology_ptop_filename=\"topology.properties\"" << std::endl;
+        config_file.close();
+
+        // Topology
+        std::ofstream topology_file;
+        topology_file.open (temp_dir + "/topology.properties");
+        topology_file << "num_nodes=2" << std::endl;
+        topology_file << "num_undirected_edges=1" << std::endl;
+        topology_file << "switches=set(0,1)" << std::endl;
+        topology_file << "switches_which_are_tors=set(0,1)" << std::endl;
+        topology_file << "servers=set()" << std::endl;
+        topology_file << "undirected_edges=set(0-1)" << std::endl;
+        topology_file << "link_channel_delay_ns=10000" << std::endl;
+        topology_file << "link_device_data_rate_megabit_per_s=" << link_device_data_rate_megabit_per_s << std::endl;
+        topology_file << "link_device_queue=drop_tail(100p)" << std::endl;
+        topology_file << "link_interface_traffic_control_qdisc=disabled" << std::endl;
+        topology_file.close();
+    }
+
+    // Rate of the source after each adaptation, from its rate log: (time, rate)
+    void read_rate_log(std::vector<std::pair<int64_t, double>>& rates) {
+        for (std::string line : read_file_direct(temp_dir + "/logs_ns3/multicast_udp_0_rate.csv")) {
+            std::vector<std::string> line_spl = split_string(line, ",", 3);
+            ASSERT_EQUAL(parse_int64(line_spl[0]), 0);
+            rates.push_back(std::make_pair(parse_int64(line_spl[1]), parse_double(line_spl[2])));
+        }
+    }
+
+    void cleanup_test_dir() {
+        remove_file_if_exists(temp_dir + "/config_ns3.properties");
+        remove_file_if_exists(temp_dir + "/topology.properties");
+        remove_file_if_exists(temp_dir + "/logs_ns3/finished.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/multicast_udp_0_outgoing.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/multicast_udp_0_incoming.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/multicast_udp_0_rate.csv");
+        remove_dir_if_exists(temp_dir + "/logs_ns3");
+        remove_dir_if_exists(temp_dir);
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class MulticastUdpApplicationFecCountingTestCase : public MulticastUdpApplicationTestCase
+{
+public:
+    MulticastUdpApplicationFecCountingTestCase () : MulticastUdpApplicationTestCase ("multicast-udp-application fec-counting") {};
+
+    void DoRun () {
+        prepare_test_dir(2000000000, 100.0);
+
+        // Perform basic simulation
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
+        TcpOptimizer::OptimizeBasic(basicSimulation);
+
+        // Blocks of 4 data packets followed by 1 repair packet
+        MulticastUdpHelper multicastUdpHelper(3026, basicSimulation->GetLogsDir());
+        multicastUdpHelper.SetAttribute("FecBlockSize", UintegerValue(4));
+        multicastUdpHelper.SetAttribute("FecNumRepair", UintegerValue(1));
+        ApplicationContainer apps = multicastUdpHelper.Install(topology->GetNodes());
+        apps.Start(Seconds(0.0));
+        Ptr<MulticastUdpApplication> source = apps.Get(0)->GetObject<MulticastUdpApplication>();
+        Ptr<MulticastUdpApplication> member = apps.Get(1)->GetObject<MulticastUdpApplication>();
+
+        // 10 Mbit/s for 1 second, which the link carries without loss
+        MulticastUdpInfo info(0, 0, {1}, 10, 100000000, 1000000000, "", "");
+        source->RegisterOutgoingBurst(info, InetSocketAddress(topology->GetNodes().Get(1)->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 3026), false);
+        member->RegisterIncomingBurst(info, false);
+
+        // Run simulation
+        basicSimulation->Run();
+        basicSimulation->Finalize();
+
+        // Of the packets sent, each fifth is a repair packet
+        uint64_t sent = source->GetSentCounterOf(0);
+        ASSERT_TRUE(sent > 800);
+        uint64_t num_data = (sent / 5) * 4 + std::min(sent % 5, (uint64_t) 4);
+        uint64_t num_repair = sent - num_data;
+
+        // Only the data packets are counted as received and in the latency,
+        // the repair packets only in the FEC statistics
+        ASSERT_EQUAL(member->GetReceivedCounterOf(0), num_data);
+        ASSERT_EQUAL(member->GetLatencyHistogramOf(0).GetCount(), num_data);
+        MulticastFecStats stats = member->GetFecStatsOf(0);
+        ASSERT_EQUAL(stats.data_received, num_data);
+        ASSERT_EQUAL(stats.repair_received, num_repair);
+        ASSERT_EQUAL(stats.data_recovered, 0);
+        ASSERT_EQUAL(stats.blocks_with_loss, 0);
+
+        // Make sure these are removed
+        cleanup_test_dir();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class MulticastUdpApplicationRateAdaptationBottleneckTestCase : public MulticastUdpApplicationTestCase
+{
+public:
+    MulticastUdpApplicationRateAdaptationBottleneckTestCase () : MulticastUdpApplicationTestCase ("multicast-udp-application rate-adaptation-bottleneck") {};
+
+    void DoRun () {
+        prepare_test_dir(6000000000, 10.0);
+
+        // Perform basic simulation
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
+        TcpOptimizer::OptimizeBasic(basicSimulation);
+
+        // Rate adaptation every 100 ms
+        MulticastUdpHelper multicastUdpHelper(3026, basicSimulation->GetLogsDir());
+        multicastUdpHelper.SetAttribute("EnableRateAdaptation", BooleanValue(true));
+        multicastUdpHelper.SetAttribute("FeedbackIntervalNs", IntegerValue(100000000));
+        ApplicationContainer apps = multicastUdpHelper.Install(topology->GetNodes());
+        apps.Start(Seconds(0.0));
+        Ptr<MulticastUdpApplication> source = apps.Get(0)->GetObject<MulticastUdpApplication>();
+        Ptr<MulticastUdpApplication> member = apps.Get(1)->GetObject<MulticastUdpApplication>();
+
+        // A target of 50 Mbit/s over a link of 10 Mbit/s
+        MulticastUdpInfo info(0, 0, {1}, 50, 100000000, 5000000000, "", "");
+        source->RegisterOutgoingBurst(info, InetSocketAddress(topology->GetNodes().Get(1)->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 3026), true);
+        member->RegisterIncomingBurst(info, false);
+        member->EnableIncomingBurstFeedback(0, InetSocketAddress(topology->GetNodes().Get(0)->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 3027));
+
+        // Run simulation
+        basicSimulation->Run();
+        basicSimulation->Finalize();
+
+        // The rate converges to around the bottleneck rate in the second half of the burst
+        std::vector<std::pair<int64_t, double>> rates;
+        read_rate_log(rates);
+        ASSERT_TRUE(rates.size() >= 45);
+        double sum_rate = 0.0;
+        int64_t num_rates = 0;
+        for (std::pair<int64_t, double> entry : rates) {
+            if (entry.first >= 3100000000) {
+                ASSERT_TRUE(entry.second < 25.0);
+                sum_rate += entry.second;
+                num_rates++;
+            }
+        }
+        ASSERT_TRUE(num_rates >= 15);
+        ASSERT_TRUE(sum_rate / num_rates >= 7.0);
+        ASSERT_TRUE(sum_rate / num_rates <= 16.0);
+
+        // And the link is kept busy (it carries at most 10 Mbit/s * 5 s / 12000 bit = 4167 packets)
+        ASSERT_TRUE(member->GetReceivedCounterOf(0) >= 3000);
+
+        // Make sure these are removed
+        cleanup_test_dir();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class MulticastUdpApplicationRateAdaptationLateJoinerTestCase : public MulticastUdpApplicationTestCase
+{
+public:
+    MulticastUdpApplicationRateAdaptationLateJoinerTestCase () : MulticastUdpApplicationTestCase ("multicast-udp-application rate-adaptation-late-joiner") {};
+
+    void DoRun () {
+        prepare_test_dir(3000000000, 100.0);
+
+        // Perform basic simulation
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
+        TcpOptimizer::OptimizeBasic(basicSimulation);
+
+        // Rate adaptation every 100 ms
+        MulticastUdpHelper multicastUdpHelper(3026, basicSimulation->GetLogsDir());
+        multicastUdpHelper.SetAttribute("EnableRateAdaptation", BooleanValue(true));
+        multicastUdpHelper.SetAttribute("FeedbackIntervalNs", IntegerValue(100000000));
+        ApplicationContainer apps = multicastUdpHelper.Install(topology->GetNodes());
+        apps.Start(Seconds(0.0));
+        Ptr<MulticastUdpApplication> source = apps.Get(0)->GetObject<MulticastUdpApplication>();
+        Ptr<MulticastUdpApplication> member = apps.Get(1)->GetObject<MulticastUdpApplication>();
+
+        // 10 Mbit/s from 0.1 s to 2.1 s, which the link carries without loss, to a member
+        // which joins at 0.5 s, leaves at 1.0 s and rejoins at 1.4 s
+        MulticastUdpInfo info(0, 0, {}, 10, 100000000, 2000000000, "", "");
+        info.AddMembershipEvent({500000000, 1, true});
+        info.AddMembershipEvent({1000000000, 1, false});
+        info.AddMembershipEvent({1400000000, 1, true});
+        source->RegisterOutgoingBurst(info, InetSocketAddress(topology->GetNodes().Get(1)->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 3026), true);
+        member->RegisterIncomingBurst(info, false);
+        member->EnableIncomingBurstFeedback(0, InetSocketAddress(topology->GetNodes().Get(0)->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 3027));
+        for (const MulticastMembershipEvent& event : info.GetMembershipEvents()) {
+            Simulator::Schedule(NanoSeconds(event.time_ns), &MulticastUdpApplication::SetIncomingBurstMember, member, 0, event.is_join);
+        }
+
+        // Run simulation
+        basicSimulation->Run();
+        basicSimulation->Finalize();
+
+        // Neither the join nor the rejoin are mistaken for losses, so the rate stays at the target
+        std::vector<std::pair<int64_t, double>> rates;
+        read_rate_log(rates);
+        ASSERT_TRUE(rates.size() >= 15);
+        for (std::pair<int64_t, double> entry : rates) {
+            ASSERT_EQUAL_APPROX(entry.second, 10.0, 0.000001);
+        }
+        ASSERT_EQUAL_APPROX(source->GetRateOf(0), 10.0, 0.000001);
+
+        // Received while a member: 0.5 s + 0.7 s at 10 Mbit/s of 1500 byte packets
+        ASSERT_EQUAL_APPROX((double) member->GetReceivedCounterOf(0), 1000.0, 5.0);
+
+        // Make sure these are removed
+        cleanup_test_dir();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+// Report of a receiver which cannot receive anything
+static void send_lossy_feedback(Ptr<Socket> socket, InetSocketAddress sourceAddress) {
+    MulticastFeedbackHeader feedback;
+    feedback.SetId(0);
+    feedback.SetReceiverNodeId(7);
+    feedback.SetNumReceived(0);
+    feedback.SetNumExpected(100);
+    Ptr<Packet> p = Create<Packet>(0);
+    p->AddHeader(feedback);
+    socket->SendTo(p, 0, sourceAddress);
+}
+
+class MulticastUdpApplicationFeedbackExpiryTestCase : public MulticastUdpApplicationTestCase
+{
+public:
+    MulticastUdpApplicationFeedbackExpiryTestCase () : MulticastUdpApplicationTestCase ("multicast-udp-application feedback-expiry") {};
+
+    void DoRun () {
+        prepare_test_dir(5000000000, 100.0);
+
+        // Perform basic simulation
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
+        TcpOptimizer::OptimizeBasic(basicSimulation);
+
+        // Rate adaptation every 100 ms
+        MulticastUdpHelper multicastUdpHelper(3026, basicSimulation->GetLogsDir());
+        multicastUdpHelper.SetAttribute("EnableRateAdaptation", BooleanValue(true));
+        multicastUdpHelper.SetAttribute("FeedbackIntervalNs", IntegerValue(100000000));
+        ApplicationContainer apps = multicastUdpHelper.Install(topology->GetNodes());
+        apps.Start(Seconds(0.0));
+        Ptr<MulticastUdpApplication> source = apps.Get(0)->GetObject<MulticastUdpApplication>();
+        Ptr<MulticastUdpApplication> member = apps.Get(1)->GetObject<MulticastUdpApplication>();
+
+        // 10 Mbit/s from 0.1 s to 4.1 s, which the link carries without loss
+        MulticastUdpInfo info(0, 0, {1}, 10, 100000000, 4000000000, "", "");
+        InetSocketAddress sourceFeedbackAddress(topology->GetNodes().Get(0)->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 3027);
+        source->RegisterOutgoingBurst(info, InetSocketAddress(topology->GetNodes().Get(1)->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 3026), true);
+        member->RegisterIncomingBurst(info, false);
+        member->EnableIncomingBurstFeedback(0, sourceFeedbackAddress);
+
+        // Another receiver reports that it lost everything twice, and then leaves
+        Ptr<Socket> lossySocket = Socket::CreateSocket(topology->GetNodes().Get(1), UdpSocketFactory::GetTypeId());
+        lossySocket->Bind();
+        Simulator::Schedule(NanoSeconds(250000000), &send_lossy_feedback, lossySocket, sourceFeedbackAddress);
+        Simulator::Schedule(NanoSeconds(350000000), &send_lossy_feedback, lossySocket, sourceFeedbackAddress);
+
+        // Run simulation
+        basicSimulation->Run();
+        basicSimulation->Finalize();
+
+        // The source drops to its minimum rate (1% of the target) for the lossy receiver
+        std::vector<std::pair<int64_t, double>> rates;
+        read_rate_log(rates);
+        double min_rate = 10.0;
+        for (std::pair<int64_t, double> entry : rates) {
+            min_rate = std::min(min_rate, entry.second);
+        }
+        ASSERT_EQUAL_APPROX(min_rate, 0.1, 0.000001);
+
+        // Once that receiver's report has expired, it recovers to the target rate (by 0.5 Mbit/s per interval)
+        ASSERT_EQUAL_APPROX(source->GetRateOf(0), 10.0, 0.000001);
+
+        // Make sure these are removed
+        lossySocket->Close();
+        cleanup_test_dir();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
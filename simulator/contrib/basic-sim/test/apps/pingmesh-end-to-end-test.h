@@ -419,6 +419,81 @@ public:
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
+class PingmeshEndToEndSampledSummaryTestCase : public PingmeshEndToEndTestCase
+{
+public:
+    PingmeshEndToEndSampledSummaryTestCase () : PingmeshEndToEndTestCase ("pingmesh-end-to-end sampled-summary") {};
+
+    void DoRun () {
+        prepare_test_dir();
+
+        // 5 seconds, every 100ms a ping to two random destinations, only statistics kept
+        write_basic_config(5000000000, 100000000, "random(2)");
+        std::ofstream config_file(temp_dir + "/config_ns3.properties", std::ofstream::out | std::ofstream::app);
+        config_file << "pingmesh_keep_all_pings=false" << std::endl;
+        config_file.close();
+        write_six_topology();
+
+        // Perform basic simulation
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
+        PingmeshScheduler pingmeshScheduler(basicSimulation, topology);
+        basicSimulation->Run();
+        pingmeshScheduler.WriteResults();
+        basicSimulation->Finalize();
+
+        // Every endpoint (0, 1, 2, 3, 5) pings two different other endpoints
+        std::map<int64_t, std::pair<int64_t, int64_t>> node_to_xy = {
+                {0, {0, 0}}, {1, {1, 0}}, {2, {2, 0}}, {3, {0, 1}}, {4, {1, 1}}, {5, {2, 1}}
+        };
+        std::vector<std::string> lines_csv = read_file_direct(temp_dir + "/logs_ns3/pingmesh_summary.csv");
+        ASSERT_EQUAL(lines_csv.size(), 10);
+        std::set<std::pair<int64_t, int64_t>> pairs;
+        std::map<int64_t, int64_t> num_destinations;
+        for (std::string line : lines_csv) {
+            std::vector<std::string> line_spl = split_string(line, ",", 10);
+            int64_t from_node_id = parse_positive_int64(line_spl[0]);
+            int64_t to_node_id = parse_positive_int64(line_spl[1]);
+            ASSERT_NOT_EQUAL(from_node_id, to_node_id);
+            ASSERT_TRUE(pairs.insert(std::make_pair(from_node_id, to_node_id)).second);
+            num_destinations[from_node_id]++;
+
+            // Latency is 50ms per hop
+            int64_t hops = std::abs(node_to_xy[from_node_id].first - node_to_xy[to_node_id].first) + std::abs(node_to_xy[from_node_id].second - node_to_xy[to_node_id].second);
+            int64_t sent = parse_positive_int64(line_spl[2]);
+            int64_t received = parse_positive_int64(line_spl[3]);
+            ASSERT_EQUAL(sent, 50);
+            ASSERT_TRUE(received >= 47 && received <= sent);
+            ASSERT_EQUAL_APPROX(parse_double(line_spl[4]), hops * 50000000, 500);
+            ASSERT_EQUAL_APPROX(parse_double(line_spl[5]), hops * 50000000, 500);
+            ASSERT_EQUAL_APPROX(parse_positive_int64(line_spl[6]), hops * 100000000, 1000);
+            ASSERT_EQUAL_APPROX(parse_double(line_spl[7]), hops * 100000000, 1000);
+            ASSERT_EQUAL_APPROX(parse_positive_int64(line_spl[8]), hops * 100000000, 1000);
+            ASSERT_TRUE(parse_double(line_spl[9]) < 1000);
+        }
+        ASSERT_EQUAL(num_destinations.size(), 5);
+        for (std::pair<int64_t, int64_t> p : num_destinations) {
+            ASSERT_EQUAL(p.second, 2);
+        }
+        ASSERT_FALSE(file_exists(temp_dir + "/logs_ns3/pingmesh.csv"));
+
+        // Make sure these are removed
+        remove_file_if_exists(temp_dir + "/config_ns3.properties");
+        remove_file_if_exists(temp_dir + "/topology.properties");
+        remove_file_if_exists(temp_dir + "/logs_ns3/finished.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/pingmesh_summary.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/pingmesh.txt");
+        remove_dir_if_exists(temp_dir + "/logs_ns3");
+        remove_dir_if_exists(temp_dir);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
 class PingmeshEndToEndCompetitionTcpTestCase : public PingmeshEndToEndTestCase
 {
 public:
@@ -4,6 +4,7 @@
 #include "ns3/tcp-flow-scheduler.h"
 #include "ns3/tcp-optimizer.h"
 #include "ns3/arbiter-ecmp-helper.h"
+#include "ns3/workload-generator.h"
 #include "ns3/test.h"
 #include "../test-helpers.h"
 #include <iostream>
@@ -834,3 +835,166 @@ public:
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////
+
+class TcpFlowEndToEndWorkloadGeneratorTestCase : public TcpFlowEndToEndTestCase
+{
+public:
+    TcpFlowEndToEndWorkloadGeneratorTestCase () : TcpFlowEndToEndTestCase ("tcp-flow-end-to-end workload-generator") {};
+
+    void DoRun () {
+
+        // Run directory
+        prepare_test_dir();
+        int64_t simulation_end_time_ns = 2000000000;
+
+        // Config file: flows from the workload generator instead of a schedule file, streamed in small chunks
+        std::ofstream config_file;
+        config_file.open (temp_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=" << simulation_end_time_ns << std::endl;
+        config_file << "simulation_seed=" << 123456 << std::endl;
+        config_file << "topology_ptop_filename=\"topology.properties\"" << std::endl;
+        config_file << "enable_tcp_flow_scheduler=true" << std::endl;
+        config_file << "tcp_flow_enable_workload_generator=true" << std::endl;
+        config_file << "tcp_flow_workload_arrival_rate_per_s=20" << std::endl;
+        config_file << "tcp_flow_workload_size_cdf_filename=\"size_cdf.csv\"" << std::endl;
+        config_file << "tcp_flow_workload_pair_model=permutation" << std::endl;
+        config_file << "tcp_flow_schedule_streaming_lookahead=4" << std::endl;
+        config_file.close();
+
+        // Size CDF: half exactly 10 KB, half uniform in [10 KB, 100 KB]
+        std::ofstream cdf_file(temp_dir + "/size_cdf.csv");
+        cdf_file << "10000,0.5" << std::endl;
+        cdf_file << "100000,1.0" << std::endl;
+        cdf_file.close();
+
+        // Topology: servers 0, 1 and 3 around switch 2
+        std::ofstream topology_file;
+        topology_file.open (temp_dir + "/topology.properties");
+        topology_file << "num_nodes=4" << std::endl;
+        topology_file << "num_undirected_edges=3" << std::endl;
+        topology_file << "switches=set(2)" << std::endl;
+        topology_file << "switches_which_are_tors=set(2)" << std::endl;
+        topology_file << "servers=set(0, 1, 3)" << std::endl;
+        topology_file << "undirected_edges=set(0-2,1-2,2-3)" << std::endl;
+        topology_file << "link_channel_delay_ns=200000" << std::endl;
+        topology_file << "link_device_data_rate_megabit_per_s=30" << std::endl;
+        topology_file << "link_device_queue=drop_tail(100p)" << std::endl;
+        topology_file << "link_interface_traffic_control_qdisc=disabled" << std::endl;
+        topology_file.close();
+
+        // Perform basic simulation
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
+        TcpOptimizer::OptimizeUsingWorstCaseRtt(basicSimulation, topology->GetWorstCaseRttEstimateNs());
+        TcpFlowScheduler tcpFlowScheduler(basicSimulation, topology);
+        basicSimulation->Run();
+        tcpFlowScheduler.WriteResults();
+        basicSimulation->Finalize();
+
+        // The same flows as the generator yields on its own (it is seeded by simulation_seed)
+        TcpFlowWorkloadGenerator expected_generator(WorkloadGenerator(
+                {0, 1, 3}, 20.0, read_workload_size_cdf(temp_dir + "/size_cdf.csv"), "permutation", 123456, simulation_end_time_ns, -1
+        ));
+        std::vector<TcpFlowScheduleEntry> expected;
+        while (expected_generator.ReadChunk(expected, 100) > 0) {
+            // Read everything
+        }
+        ASSERT_TRUE(expected.size() >= 20); // About 40 arrivals in 2 seconds
+        std::vector<std::string> lines_csv = read_file_direct(temp_dir + "/logs_ns3/tcp_flows.csv");
+        ASSERT_EQUAL(lines_csv.size(), expected.size());
+        std::map<int64_t, int64_t> partner;
+        int64_t num_completed = 0;
+        for (size_t i = 0; i < lines_csv.size(); i++) {
+            std::vector<std::string> line_spl = split_string(lines_csv[i], ",");
+            ASSERT_EQUAL(line_spl.size(), 10);
+            ASSERT_EQUAL(parse_positive_int64(line_spl[0]), (int64_t) i);
+            ASSERT_EQUAL(parse_positive_int64(line_spl[1]), expected[i].GetFromNodeId());
+            ASSERT_EQUAL(parse_positive_int64(line_spl[2]), expected[i].GetToNodeId());
+            ASSERT_EQUAL(parse_positive_int64(line_spl[3]), expected[i].GetSizeByte());
+            ASSERT_EQUAL(parse_positive_int64(line_spl[4]), expected[i].GetStartTimeNs());
+            ASSERT_TRUE(expected[i].GetSizeByte() >= 10000 && expected[i].GetSizeByte() <= 100000);
+
+            // Permutation: every endpoint always sends to the same other endpoint
+            int64_t from_node_id = expected[i].GetFromNodeId();
+            ASSERT_TRUE(from_node_id != expected[i].GetToNodeId());
+            if (partner.find(from_node_id) == partner.end()) {
+                partner[from_node_id] = expected[i].GetToNodeId();
+            }
+            ASSERT_EQUAL(partner[from_node_id], expected[i].GetToNodeId());
+            if (line_spl[8] == "YES") {
+                num_completed++;
+            }
+        }
+        ASSERT_TRUE(num_completed >= (int64_t) lines_csv.size() / 2); // Little load, only those started near the end are unfinished
+
+        // Make sure these are removed
+        remove_file_if_exists(temp_dir + "/config_ns3.properties");
+        remove_file_if_exists(temp_dir + "/topology.properties");
+        remove_file_if_exists(temp_dir + "/size_cdf.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/finished.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/tcp_flows.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/tcp_flows.txt");
+        remove_dir_if_exists(temp_dir + "/logs_ns3");
+        remove_dir_if_exists(temp_dir);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class TcpFlowEndToEndStreamingTestCase : public TcpFlowEndToEndTestCase
+{
+public:
+    TcpFlowEndToEndStreamingTestCase () : TcpFlowEndToEndTestCase ("tcp-flow-end-to-end streaming") {};
+
+    void DoRun () {
+        int64_t simulation_end_time_ns = 5000000000;
+
+        // Flows both ways, some of them competing
+        std::vector<TcpFlowScheduleEntry> schedule;
+        schedule.push_back(TcpFlowScheduleEntry(0, 0, 1, 1000000, 0, "", "abc"));
+        schedule.push_back(TcpFlowScheduleEntry(1, 1, 0, 500000, 10000000, "", ""));
+        schedule.push_back(TcpFlowScheduleEntry(2, 0, 1, 200000, 500000000, "", "def"));
+        schedule.push_back(TcpFlowScheduleEntry(3, 0, 1, 300000, 600000000, "", ""));
+        schedule.push_back(TcpFlowScheduleEntry(4, 1, 0, 1000000, 1000000000, "", "ghi"));
+
+        // Schedule read upfront
+        prepare_test_dir();
+        write_basic_config(simulation_end_time_ns, 123456, 5);
+        write_single_topology(10.0, 100000);
+        std::vector<int64_t> upfront_end_time_ns_list;
+        std::vector<int64_t> upfront_sent_byte_list;
+        std::vector<std::string> upfront_finished_list;
+        BeforeRunOperationNothing op;
+        test_run_and_validate_tcp_flow_logs(simulation_end_time_ns, temp_dir, schedule, upfront_end_time_ns_list, upfront_sent_byte_list, upfront_finished_list, &op);
+
+        // Schedule streamed two flows at a time
+        prepare_test_dir();
+        write_basic_config(simulation_end_time_ns, 123456, 5);
+        std::ofstream config_file(temp_dir + "/config_ns3.properties", std::ofstream::out | std::ofstream::app);
+        config_file << "tcp_flow_schedule_streaming_lookahead=2" << std::endl;
+        config_file.close();
+        write_single_topology(10.0, 100000);
+        std::vector<int64_t> streamed_end_time_ns_list;
+        std::vector<int64_t> streamed_sent_byte_list;
+        std::vector<std::string> streamed_finished_list;
+        test_run_and_validate_tcp_flow_logs(simulation_end_time_ns, temp_dir, schedule, streamed_end_time_ns_list, streamed_sent_byte_list, streamed_finished_list, &op);
+
+        // Streaming must not change anything about the flows
+        ASSERT_EQUAL(streamed_end_time_ns_list.size(), 5);
+        ASSERT_EQUAL(streamed_sent_byte_list.size(), 5);
+        ASSERT_EQUAL(streamed_finished_list.size(), 5);
+        for (size_t i = 0; i < 5; i++) {
+            ASSERT_EQUAL(upfront_finished_list.at(i), "YES");
+            ASSERT_EQUAL(streamed_end_time_ns_list.at(i), upfront_end_time_ns_list.at(i));
+            ASSERT_EQUAL(streamed_sent_byte_list.at(i), upfront_sent_byte_list.at(i));
+            ASSERT_EQUAL(streamed_finished_list.at(i), upfront_finished_list.at(i));
+        }
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -87,6 +87,27 @@ public:
         ASSERT_EQUAL(schedule[1].GetAdditionalParameters(), "a=b2");
         ASSERT_EQUAL(schedule[1].GetMetadata(), "");
 
+        // Streamed in chunks of one
+
+        TcpFlowScheduleReader reader(tcp_flow_schedule_reader_test_dir + "/tcp_flow_schedule.csv", topology, 10000000000);
+        std::vector<TcpFlowScheduleEntry> chunk;
+        ASSERT_EQUAL(reader.ReadChunk(chunk, 1), 1);
+        ASSERT_EQUAL(chunk.size(), 1);
+        ASSERT_EQUAL(chunk[0].GetTcpFlowId(), 0);
+        ASSERT_EQUAL(reader.GetNumRead(), 1);
+        chunk.clear();
+        ASSERT_EQUAL(reader.ReadChunk(chunk, 1), 1);
+        ASSERT_EQUAL(chunk[0].GetTcpFlowId(), 1);
+        ASSERT_EQUAL(chunk[0].GetFromNodeId(), 7);
+        ASSERT_EQUAL(chunk[0].GetToNodeId(), 3);
+        ASSERT_EQUAL(chunk[0].GetSizeByte(), 7488338);
+        ASSERT_EQUAL(chunk[0].GetStartTimeNs(), 1356567);
+        ASSERT_EQUAL(chunk[0].GetAdditionalParameters(), "a=b2");
+        ASSERT_EQUAL(chunk[0].GetMetadata(), "");
+        ASSERT_EQUAL(reader.ReadChunk(chunk, 1), 0);
+        ASSERT_EQUAL(chunk.size(), 1);
+        ASSERT_EQUAL(reader.GetNumRead(), 2);
+
         // Empty
 
         std::ofstream schedule_file_empty(tcp_flow_schedule_reader_test_dir + "/tcp_flow_schedule.csv");
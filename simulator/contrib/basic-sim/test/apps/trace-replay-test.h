@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-simulation.h"
+#include "ns3/test.h"
+#include "ns3/exp-util.h"
+#include "ns3/packet-trace-reader.h"
+#include "ns3/trace-replay-scheduler.h"
+#include "ns3/topology-ptop.h"
+#include "ns3/ipv4-arbiter-routing-helper.h"
+#include "ns3/arbiter-ecmp-helper.h"
+#include "../test-helpers.h"
+
+using namespace ns3;
+
+const std::string trace_replay_test_dir = ".tmp-trace-replay-test";
+
+void prepare_trace_replay_test_config(bool enable) {
+    mkdir_if_not_exists(trace_replay_test_dir);
+
+    std::ofstream config_file(trace_replay_test_dir + "/config_ns3.properties");
+    config_file << "simulation_end_time_ns=2000000000" << std::endl;
+    config_file << "simulation_seed=123456789" << std::endl;
+    config_file << "topology_ptop_filename=\"topology.properties\"" << std::endl;
+    config_file << "enable_trace_replay_scheduler=" << (enable ? "true" : "false") << std::endl;
+    config_file << "trace_replay_filename=\"trace.bin\"" << std::endl;
+    config_file << "trace_replay_window_num_records=16" << std::endl;
+    config_file.close();
+
+    // Two nodes at 10 Mbit/s, 100 microseconds delay
+    std::ofstream topology_file(trace_replay_test_dir + "/topology.properties");
+    topology_file << "num_nodes=2" << std::endl;
+    topology_file << "num_undirected_edges=1" << std::endl;
+    topology_file << "switches=set(0,1)" << std::endl;
+    topology_file << "switches_which_are_tors=set(0,1)" << std::endl;
+    topology_file << "servers=set()" << std::endl;
+    topology_file << "undirected_edges=set(0-1)" << std::endl;
+    topology_file << "link_channel_delay_ns=100000" << std::endl;
+    topology_file << "link_device_data_rate_megabit_per_s=10" << std::endl;
+    topology_file << "link_device_queue=drop_tail(100p)" << std::endl;
+    topology_file << "link_interface_traffic_control_qdisc=disabled" << std::endl;
+    topology_file.close();
+}
+
+void cleanup_trace_replay_test() {
+    remove_file_if_exists(trace_replay_test_dir + "/config_ns3.properties");
+    remove_file_if_exists(trace_replay_test_dir + "/topology.properties");
+    remove_file_if_exists(trace_replay_test_dir + "/trace.bin");
+    remove_file_if_exists(trace_replay_test_dir + "/logs_ns3/finished.txt");
+    remove_file_if_exists(trace_replay_test_dir + "/logs_ns3/timing_results.txt");
+    remove_file_if_exists(trace_replay_test_dir + "/logs_ns3/timing_results.csv");
+    remove_file_if_exists(trace_replay_test_dir + "/logs_ns3/trace_replay_outgoing.csv");
+    remove_file_if_exists(trace_replay_test_dir + "/logs_ns3/trace_replay_incoming.csv");
+    remove_dir_if_exists(trace_replay_test_dir + "/logs_ns3");
+    remove_dir_if_exists(trace_replay_test_dir);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class PacketTraceReaderTestCase : public TestCase
+{
+public:
+    PacketTraceReaderTestCase () : TestCase ("packet-trace-reader") {};
+
+    void DoRun () {
+        prepare_trace_replay_test_config(false);
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(trace_replay_test_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        std::string filename = trace_replay_test_dir + "/trace.bin";
+
+        // Written and read back in windows of three records
+        std::vector<PacketTraceRecord> records;
+        for (int64_t i = 0; i < 10; i++) {
+            records.push_back(PacketTraceRecord{i / 2 * 1000, i % 3, i % 2, 1 - i % 2, 24 + i * 100});
+        }
+        write_packet_trace(filename, records);
+        PacketTraceReader reader(filename, topology, 2000000000, 3);
+        ASSERT_EQUAL(reader.GetNumRecords(), 10);
+        PacketTraceRecord record;
+        for (size_t i = 0; i < records.size(); i++) {
+            ASSERT_TRUE(reader.Next(record));
+            ASSERT_EQUAL(record.time_ns, records[i].time_ns);
+            ASSERT_EQUAL(record.flow_id, records[i].flow_id);
+            ASSERT_EQUAL(record.from_node_id, records[i].from_node_id);
+            ASSERT_EQUAL(record.to_node_id, records[i].to_node_id);
+            ASSERT_EQUAL(record.size_byte, records[i].size_byte);
+        }
+        ASSERT_FALSE(reader.Next(record));
+        ASSERT_EQUAL(reader.GetNumRead(), 10);
+
+        // Stops at the end of the simulation
+        PacketTraceReader reader_end(filename, topology, 3000, 100);
+        int64_t num_before_end = 0;
+        while (reader_end.Next(record)) {
+            num_before_end++;
+        }
+        ASSERT_EQUAL(num_before_end, 6);
+
+        // Empty
+        write_packet_trace(filename, std::vector<PacketTraceRecord>());
+        PacketTraceReader reader_empty(filename, topology, 2000000000, 1);
+        ASSERT_EQUAL(reader_empty.GetNumRecords(), 0);
+        ASSERT_FALSE(reader_empty.Next(record));
+
+        // Invalid records are only found once they are read
+        std::vector<std::vector<PacketTraceRecord>> invalid_traces = {
+                {{1000, 0, 0, 1, 100}, {999, 0, 0, 1, 100}}, // Time goes back
+                {{1000, 0, 0, 0, 100}},                      // To itself
+                {{1000, 0, 0, 2, 100}},                      // Not an endpoint
+                {{1000, 0, 0, 1, 23}},                       // Smaller than the header
+                {{1000, 0, 0, 1, 65508}},                    // Larger than a UDP datagram
+                {{1000, -1, 0, 1, 100}}                      // Negative flow id
+        };
+        for (const std::vector<PacketTraceRecord>& invalid : invalid_traces) {
+            write_packet_trace(filename, invalid);
+            PacketTraceReader reader_invalid(filename, topology, 2000000000, 1);
+            ASSERT_EXCEPTION(while (reader_invalid.Next(record)) {});
+        }
+
+        // Not a packet trace, or truncated
+        std::ofstream not_a_trace(filename);
+        not_a_trace << "0,0,1,100,1000" << std::endl;
+        not_a_trace.close();
+        ASSERT_EXCEPTION(PacketTraceReader(filename, topology, 2000000000, 1));
+        write_packet_trace(filename, records);
+        ASSERT_EQUAL(truncate(filename.c_str(), PACKET_TRACE_HEADER_SIZE_BYTE + 5 * PACKET_TRACE_RECORD_SIZE_BYTE), 0);
+        ASSERT_EXCEPTION(PacketTraceReader(filename, topology, 2000000000, 1));
+        ASSERT_EXCEPTION(PacketTraceReader(trace_replay_test_dir + "/does-not-exist.bin", topology, 2000000000, 1));
+
+        basicSimulation->Finalize();
+        cleanup_trace_replay_test();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class TraceReplayEndToEndTestCase : public TestCase
+{
+public:
+    TraceReplayEndToEndTestCase () : TestCase ("trace-replay-end-to-end") {};
+
+    void DoRun () {
+        prepare_trace_replay_test_config(true);
+
+        // Flow 0 from 0 to 1, and flow 1 from 1 to 0, a packet of 1000 byte each every ms (8 Mbit/s),
+        // and one more packet for each at the end of the simulation which is not sent
+        std::vector<PacketTraceRecord> records;
+        for (int64_t i = 0; i < 1000; i++) {
+            records.push_back(PacketTraceRecord{i * 1000000, i % 2, i % 2, 1 - i % 2, 1000});
+            records.push_back(PacketTraceRecord{i * 1000000, 1 - i % 2, 1 - i % 2, i % 2, 1000});
+        }
+        records.push_back(PacketTraceRecord{2000000000, 0, 0, 1, 1000});
+        records.push_back(PacketTraceRecord{2000000000, 1, 1, 0, 1000});
+        write_packet_trace(trace_replay_test_dir + "/trace.bin", records);
+
+        // Perform basic simulation
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(trace_replay_test_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
+        TraceReplayScheduler traceReplayScheduler(basicSimulation, topology);
+        basicSimulation->Run();
+        traceReplayScheduler.WriteResults();
+        basicSimulation->Finalize();
+
+        // Everything is sent
+        std::vector<std::string> lines_outgoing = read_file_direct(trace_replay_test_dir + "/logs_ns3/trace_replay_outgoing.csv");
+        ASSERT_EQUAL(lines_outgoing.size(), 2);
+        for (int64_t flow_id = 0; flow_id < 2; flow_id++) {
+            std::vector<std::string> line_spl = split_string(lines_outgoing[flow_id], ",", 5);
+            ASSERT_EQUAL(parse_positive_int64(line_spl[0]), flow_id);
+            ASSERT_EQUAL(parse_positive_int64(line_spl[1]), flow_id);
+            ASSERT_EQUAL(parse_positive_int64(line_spl[2]), 1 - flow_id);
+            ASSERT_EQUAL(parse_positive_int64(line_spl[3]), 1000);
+            ASSERT_EQUAL(parse_positive_int64(line_spl[4]), 1000000);
+        }
+
+        // And arrives after the propagation delay and the transmission of 1000 + 8 (UDP) + 20 (IP) + 2 (PPP) byte
+        std::vector<std::string> lines_incoming = read_file_direct(trace_replay_test_dir + "/logs_ns3/trace_replay_incoming.csv");
+        ASSERT_EQUAL(lines_incoming.size(), 2);
+        for (int64_t flow_id = 0; flow_id < 2; flow_id++) {
+            std::vector<std::string> line_spl = split_string(lines_incoming[flow_id], ",", 6);
+            ASSERT_EQUAL(parse_positive_int64(line_spl[0]), flow_id);
+            ASSERT_EQUAL(parse_positive_int64(line_spl[1]), flow_id);
+            ASSERT_EQUAL(parse_positive_int64(line_spl[2]), 1 - flow_id);
+            ASSERT_EQUAL(parse_positive_int64(line_spl[3]), 1000);
+            ASSERT_EQUAL(parse_positive_int64(line_spl[4]), 1000000);
+            ASSERT_EQUAL_APPROX(parse_positive_double(line_spl[5]), 100000 + 1030 * 800, 1);
+        }
+
+        cleanup_trace_replay_test();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
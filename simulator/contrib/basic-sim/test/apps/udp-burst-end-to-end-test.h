@@ -60,6 +60,22 @@ public:
             std::vector<double>& list_outgoing_rate_megabit_per_s,
             std::vector<double>& list_incoming_rate_megabit_per_s
     ) {
+        std::vector<std::map<int64_t, int64_t>> list_incoming_seq_to_timestamp_ns;
+        test_run_and_validate_udp_burst_logs(
+                simulation_end_time_ns, temp_dir, write_schedule, 0,
+                list_outgoing_rate_megabit_per_s, list_incoming_rate_megabit_per_s, list_incoming_seq_to_timestamp_ns
+        );
+    }
+
+    void test_run_and_validate_udp_burst_logs(
+            int64_t simulation_end_time_ns,
+            std::string temp_dir,
+            std::vector<UdpBurstInfo> write_schedule,
+            int64_t pacing_batch_window_ns,
+            std::vector<double>& list_outgoing_rate_megabit_per_s,
+            std::vector<double>& list_incoming_rate_megabit_per_s,
+            std::vector<std::map<int64_t, int64_t>>& list_incoming_seq_to_timestamp_ns
+    ) {
 
         // Make sure these are removed
         remove_file_if_exists(temp_dir + "/logs_ns3/finished.txt");
@@ -253,24 +269,26 @@ public:
         // Check the precise outgoing / incoming logs for each burst
         for (UdpBurstInfo entry : write_schedule) {
 
-            // Outgoing
+            // Outgoing (paced in batches, a packet is sent at the start of its batch window)
             std::vector<std::string> lines_precise_outgoing_csv = read_file_direct(temp_dir + "/logs_ns3/udp_burst_" + std::to_string(entry.GetUdpBurstId()) + "_outgoing.csv");
             ASSERT_EQUAL(lines_precise_outgoing_csv.size(), (size_t) udp_burst_sent_amount.at(entry.GetUdpBurstId()));
+            int64_t packet_gap_ns = std::ceil(1500.0 / (entry.GetTargetRateMegabitPerSec() / 8000.0));
+            int64_t packets_per_batch = std::max((int64_t) 1, (pacing_batch_window_ns + packet_gap_ns - 1) / packet_gap_ns);
             int j = 0;
             for (std::string line : lines_precise_outgoing_csv) {
                 std::vector <std::string> line_spl = split_string(line, ",");
                 ASSERT_EQUAL(line_spl.size(), 3);
                 ASSERT_EQUAL(parse_positive_int64(line_spl[0]), entry.GetUdpBurstId());
                 ASSERT_EQUAL(parse_positive_int64(line_spl[1]), j);
-                ASSERT_EQUAL(parse_positive_int64(line_spl[2]), entry.GetStartTimeNs() + j * std::ceil(1500.0 / (entry.GetTargetRateMegabitPerSec() / 8000.0)));
+                ASSERT_EQUAL(parse_positive_int64(line_spl[2]), entry.GetStartTimeNs() + (j - j % packets_per_batch) * packet_gap_ns);
                 j += 1;
             }
 
             // Incoming
             std::vector<std::string> lines_precise_incoming_csv = read_file_direct(temp_dir + "/logs_ns3/udp_burst_" + std::to_string(entry.GetUdpBurstId()) + "_incoming.csv");
             ASSERT_EQUAL(lines_precise_incoming_csv.size(), (size_t) udp_burst_received_amount.at(entry.GetUdpBurstId()));
-            std::set<int64_t> already_seen_seqs;
-            int prev_timestamp_ns = 0;
+            std::map<int64_t, int64_t> seq_to_timestamp_ns;
+            int64_t prev_timestamp_ns = 0;
             for (std::string line : lines_precise_incoming_csv) {
                 std::vector <std::string> line_spl = split_string(line, ",");
                 ASSERT_EQUAL(line_spl.size(), 3);
@@ -280,14 +298,15 @@ public:
 
                 // We can only check that the sequence number has not arrived before
                 int64_t seq = parse_positive_int64(line_spl[1]);
-                ASSERT_TRUE(already_seen_seqs.find(seq) == already_seen_seqs.end());
-                already_seen_seqs.insert(seq);
+                ASSERT_TRUE(seq_to_timestamp_ns.find(seq) == seq_to_timestamp_ns.end());
 
                 // And that the timestamps are at least weakly ascending
                 int64_t timestamp = parse_positive_int64(line_spl[2]);
                 ASSERT_TRUE(timestamp >= prev_timestamp_ns);
                 prev_timestamp_ns = timestamp;
+                seq_to_timestamp_ns[seq] = timestamp;
             }
+            list_incoming_seq_to_timestamp_ns.push_back(seq_to_timestamp_ns);
 
         }
 
@@ -462,6 +481,78 @@ public:
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
+class UdpBurstEndToEndPacedInBatchesTestCase : public UdpBurstEndToEndTestCase
+{
+public:
+    UdpBurstEndToEndPacedInBatchesTestCase () : UdpBurstEndToEndTestCase ("udp-burst-end-to-end paced-in-batches") {};
+
+    void DoRun () {
+        int64_t simulation_end_time_ns = 5000000000;
+
+        // A UDP burst each way
+        std::vector<UdpBurstInfo> schedule;
+        schedule.push_back(UdpBurstInfo(0, 0, 1, 9, 1000000000, 3000000000, "", "abc"));
+        schedule.push_back(UdpBurstInfo(1, 1, 0, 9, 1000000000, 3000000000, "", ""));
+
+        // One event per packet
+        prepare_test_dir();
+        write_basic_config(simulation_end_time_ns, 123456, "0,1");
+        write_single_topology(10.0, 100000);
+        std::vector<double> per_packet_outgoing_rate_megabit_per_s;
+        std::vector<double> per_packet_incoming_rate_megabit_per_s;
+        std::vector<std::map<int64_t, int64_t>> per_packet_incoming_seq_to_timestamp_ns;
+        test_run_and_validate_udp_burst_logs(
+                simulation_end_time_ns, temp_dir, schedule, 0,
+                per_packet_outgoing_rate_megabit_per_s, per_packet_incoming_rate_megabit_per_s, per_packet_incoming_seq_to_timestamp_ns
+        );
+
+        // One event per 10 ms (8 packets at 9 Mbit/s, which fit in the queue)
+        int64_t pacing_batch_window_ns = 10000000;
+        prepare_test_dir();
+        write_basic_config(simulation_end_time_ns, 123456, "0,1");
+        std::ofstream config_file(temp_dir + "/config_ns3.properties", std::ofstream::out | std::ofstream::app);
+        config_file << "udp_burst_pacing_batch_window_ns=" << pacing_batch_window_ns << std::endl;
+        config_file.close();
+        write_single_topology(10.0, 100000);
+        std::vector<double> batched_outgoing_rate_megabit_per_s;
+        std::vector<double> batched_incoming_rate_megabit_per_s;
+        std::vector<std::map<int64_t, int64_t>> batched_incoming_seq_to_timestamp_ns;
+        test_run_and_validate_udp_burst_logs(
+                simulation_end_time_ns, temp_dir, schedule, pacing_batch_window_ns,
+                batched_outgoing_rate_megabit_per_s, batched_incoming_rate_megabit_per_s, batched_incoming_seq_to_timestamp_ns
+        );
+
+        // As no packet is lost, the amounts sent and received are the same
+        ASSERT_EQUAL(batched_outgoing_rate_megabit_per_s.size(), 2);
+        ASSERT_EQUAL(batched_outgoing_rate_megabit_per_s.at(0), per_packet_outgoing_rate_megabit_per_s.at(0));
+        ASSERT_EQUAL(batched_outgoing_rate_megabit_per_s.at(1), per_packet_outgoing_rate_megabit_per_s.at(1));
+        ASSERT_EQUAL(batched_incoming_rate_megabit_per_s.size(), 2);
+        ASSERT_EQUAL(batched_incoming_rate_megabit_per_s.at(0), per_packet_incoming_rate_megabit_per_s.at(0));
+        ASSERT_EQUAL(batched_incoming_rate_megabit_per_s.at(1), per_packet_incoming_rate_megabit_per_s.at(1));
+
+        // At the receiver, the packets of a batch arrive back-to-back at the line rate: each arrives
+        // at most a window earlier than with per-packet pacing (and never later), and most do arrive earlier
+        ASSERT_EQUAL(batched_incoming_seq_to_timestamp_ns.size(), 2);
+        for (size_t b = 0; b < 2; b++) {
+            ASSERT_EQUAL(batched_incoming_seq_to_timestamp_ns.at(b).size(), per_packet_incoming_seq_to_timestamp_ns.at(b).size());
+            int64_t num_earlier = 0;
+            for (std::pair<const int64_t, int64_t>& entry : per_packet_incoming_seq_to_timestamp_ns.at(b)) {
+                ASSERT_TRUE(batched_incoming_seq_to_timestamp_ns.at(b).find(entry.first) != batched_incoming_seq_to_timestamp_ns.at(b).end());
+                int64_t batched_timestamp_ns = batched_incoming_seq_to_timestamp_ns.at(b).at(entry.first);
+                ASSERT_TRUE(batched_timestamp_ns <= entry.second);
+                ASSERT_TRUE(batched_timestamp_ns > entry.second - pacing_batch_window_ns);
+                if (batched_timestamp_ns < entry.second) {
+                    num_earlier++;
+                }
+            }
+            ASSERT_TRUE(num_earlier >= (int64_t) per_packet_incoming_seq_to_timestamp_ns.at(b).size() / 2);
+        }
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
 class UdpBurstEndToEndNotEnabledTestCase : public UdpBurstEndToEndTestCase
 {
 public:
@@ -582,3 +673,167 @@ public:
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////
+
+class UdpBurstEndToEndStreamingTestCase : public UdpBurstEndToEndTestCase
+{
+public:
+    UdpBurstEndToEndStreamingTestCase () : UdpBurstEndToEndTestCase ("udp-burst-end-to-end streaming") {};
+
+    void DoRun () {
+        int64_t simulation_end_time_ns = 4000000000;
+
+        // Alternating directions, such that each chunk of two is registered while a burst of the previous is still sending
+        std::vector<UdpBurstInfo> schedule;
+        schedule.push_back(UdpBurstInfo(0, 0, 1, 5, 1000000000, 500000000, "", "abc"));
+        schedule.push_back(UdpBurstInfo(1, 1, 0, 4, 1200000000, 1000000000, "", ""));
+        schedule.push_back(UdpBurstInfo(2, 0, 1, 6, 1600000000, 500000000, "", "def"));
+        schedule.push_back(UdpBurstInfo(3, 1, 0, 3, 2300000000, 500000000, "", ""));
+        schedule.push_back(UdpBurstInfo(4, 0, 1, 8, 2500000000, 500000000, "", "ghi"));
+
+        // Schedule read upfront
+        prepare_test_dir();
+        write_basic_config(simulation_end_time_ns, 123456, "0,1,2,3,4");
+        write_single_topology(10.0, 100000);
+        std::vector<double> upfront_outgoing_rate_megabit_per_s;
+        std::vector<double> upfront_incoming_rate_megabit_per_s;
+        std::vector<std::map<int64_t, int64_t>> upfront_incoming_seq_to_timestamp_ns;
+        test_run_and_validate_udp_burst_logs(
+                simulation_end_time_ns, temp_dir, schedule, 0,
+                upfront_outgoing_rate_megabit_per_s, upfront_incoming_rate_megabit_per_s, upfront_incoming_seq_to_timestamp_ns
+        );
+
+        // Schedule streamed two bursts at a time
+        prepare_test_dir();
+        write_basic_config(simulation_end_time_ns, 123456, "0,1,2,3,4");
+        std::ofstream config_file(temp_dir + "/config_ns3.properties", std::ofstream::out | std::ofstream::app);
+        config_file << "udp_burst_schedule_streaming_lookahead=2" << std::endl;
+        config_file.close();
+        write_single_topology(10.0, 100000);
+        std::vector<double> streamed_outgoing_rate_megabit_per_s;
+        std::vector<double> streamed_incoming_rate_megabit_per_s;
+        std::vector<std::map<int64_t, int64_t>> streamed_incoming_seq_to_timestamp_ns;
+        test_run_and_validate_udp_burst_logs(
+                simulation_end_time_ns, temp_dir, schedule, 0,
+                streamed_outgoing_rate_megabit_per_s, streamed_incoming_rate_megabit_per_s, streamed_incoming_seq_to_timestamp_ns
+        );
+
+        // Streaming must not change anything about the bursts
+        ASSERT_EQUAL(streamed_outgoing_rate_megabit_per_s.size(), 5);
+        ASSERT_EQUAL(streamed_incoming_rate_megabit_per_s.size(), 5);
+        ASSERT_EQUAL(streamed_incoming_seq_to_timestamp_ns.size(), 5);
+        for (size_t i = 0; i < 5; i++) {
+            ASSERT_TRUE(upfront_outgoing_rate_megabit_per_s.at(i) > 0);
+            ASSERT_TRUE(upfront_incoming_rate_megabit_per_s.at(i) > 0);
+            ASSERT_EQUAL(streamed_outgoing_rate_megabit_per_s.at(i), upfront_outgoing_rate_megabit_per_s.at(i));
+            ASSERT_EQUAL(streamed_incoming_rate_megabit_per_s.at(i), upfront_incoming_rate_megabit_per_s.at(i));
+            ASSERT_TRUE(streamed_incoming_seq_to_timestamp_ns.at(i) == upfront_incoming_seq_to_timestamp_ns.at(i));
+        }
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+static void register_late_udp_burst(Ptr<UdpBurstApplication> fromApp, Ptr<UdpBurstApplication> toApp, UdpBurstInfo info, InetSocketAddress targetAddress) {
+    fromApp->RegisterOutgoingBurst(info, targetAddress, false);
+    toApp->RegisterIncomingBurst(info, false);
+}
+
+static void register_too_late_udp_burst(Ptr<UdpBurstApplication> fromApp, UdpBurstInfo info, InetSocketAddress targetAddress, bool* rejected) {
+    try {
+        fromApp->RegisterOutgoingBurst(info, targetAddress, false);
+    } catch (std::runtime_error& e) {
+        *rejected = true;
+    }
+}
+
+class UdpBurstEndToEndLateRegistrationTestCase : public UdpBurstEndToEndTestCase
+{
+public:
+    UdpBurstEndToEndLateRegistrationTestCase () : UdpBurstEndToEndTestCase ("udp-burst-end-to-end late-registration") {};
+
+    void DoRun () {
+
+        // Run directory
+        prepare_test_dir();
+
+        // Config file: no scheduler, the bursts are registered manually
+        std::ofstream config_file;
+        config_file.open (temp_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=" << 1500000000 << std::endl;
+        config_file << "simulation_seed=" << 123456789 << std::endl;
+        config_file << "topology_ptop_filename=\"topology.properties\"" << std::endl;
+        config_file.close();
+        write_single_topology(30.0, 10000);
+
+        // Perform basic simulation
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterEcmpHelper::InstallArbiters(basicSimulation, topology);
+        TcpOptimizer::OptimizeBasic(basicSimulation);
+
+        // Install a UDP burst application on both
+        UdpBurstHelper udpBurstHelper(1026, basicSimulation->GetLogsDir());
+        ApplicationContainer udpApp = udpBurstHelper.Install(topology->GetNodes());
+        udpApp.Start(Seconds(0.0));
+        Ptr<UdpBurstApplication> fromApp = udpApp.Get(0)->GetObject<UdpBurstApplication>();
+        Ptr<UdpBurstApplication> toApp = udpApp.Get(1)->GetObject<UdpBurstApplication>();
+        InetSocketAddress targetAddress(topology->GetNodes().Get(1)->GetObject<Ipv4>()->GetAddress(1,0).GetLocal(), 1026);
+
+        // 6 Mbit/s is a packet every 2 ms: 100 packets in 200 ms, 50 in 100 ms
+        UdpBurstInfo info0(0, 0, 1, 6, 100000000, 200000000, "", "");
+        UdpBurstInfo info1(1, 0, 1, 6, 500000000, 200000000, "", "");
+        UdpBurstInfo info2(2, 0, 1, 6, 600000000, 100000000, "", "");
+        UdpBurstInfo info3(3, 0, 1, 6, 800000000, 100000000, "", "");
+        UdpBurstInfo info4(4, 0, 1, 6, 900000000, 100000000, "", "");
+
+        // Before the start
+        register_late_udp_burst(fromApp, toApp, info0, targetAddress);
+
+        // While burst 0 is sending and no next burst is scheduled
+        Simulator::Schedule(NanoSeconds(200000000), &register_late_udp_burst, fromApp, toApp, info1, targetAddress);
+
+        // While the start of burst 1 is scheduled, which then schedules this one
+        Simulator::Schedule(NanoSeconds(250000000), &register_late_udp_burst, fromApp, toApp, info2, targetAddress);
+
+        // When all are done, starting right away
+        Simulator::Schedule(NanoSeconds(800000000), &register_late_udp_burst, fromApp, toApp, info3, targetAddress);
+
+        // After its start time
+        bool rejected = false;
+        Simulator::Schedule(NanoSeconds(1000000000), &register_too_late_udp_burst, fromApp, info4, targetAddress, &rejected);
+
+        // Run simulation
+        basicSimulation->Run();
+        basicSimulation->Finalize();
+
+        // The one registered too late is not kept
+        ASSERT_TRUE(rejected);
+
+        // All others are sent and arrive completely
+        std::vector<std::tuple<UdpBurstInfo, uint64_t>> outgoing_info = fromApp->GetOutgoingBurstsInformation();
+        std::vector<std::tuple<UdpBurstInfo, uint64_t>> incoming_info = toApp->GetIncomingBurstsInformation();
+        std::vector<uint64_t> expected_packets = {100, 100, 50, 50};
+        ASSERT_EQUAL(outgoing_info.size(), 4);
+        ASSERT_EQUAL(incoming_info.size(), 4);
+        for (size_t i = 0; i < 4; i++) {
+            ASSERT_EQUAL(std::get<0>(outgoing_info.at(i)).GetUdpBurstId(), (int64_t) i);
+            ASSERT_EQUAL(std::get<1>(outgoing_info.at(i)), expected_packets.at(i));
+            ASSERT_EQUAL(std::get<0>(incoming_info.at(i)).GetUdpBurstId(), (int64_t) i);
+            ASSERT_EQUAL(std::get<1>(incoming_info.at(i)), expected_packets.at(i));
+        }
+
+        // Make sure these are removed
+        remove_file_if_exists(temp_dir + "/config_ns3.properties");
+        remove_file_if_exists(temp_dir + "/topology.properties");
+        remove_file_if_exists(temp_dir + "/logs_ns3/finished.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.csv");
+        remove_dir_if_exists(temp_dir + "/logs_ns3");
+        remove_dir_if_exists(temp_dir);
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
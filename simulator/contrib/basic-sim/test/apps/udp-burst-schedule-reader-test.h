@@ -89,6 +89,20 @@ public:
         ASSERT_EQUAL(schedule[1].GetAdditionalParameters(), "a=b2");
         ASSERT_EQUAL(schedule[1].GetMetadata(), "");
 
+        // Streamed in chunks of one
+
+        UdpBurstScheduleReader reader(udp_burst_schedule_reader_test_dir + "/udp_burst_schedule.csv", topology, 10000000000);
+        std::vector<UdpBurstInfo> chunk;
+        ASSERT_EQUAL(reader.ReadChunk(chunk, 1), 1);
+        ASSERT_EQUAL(chunk[0].GetUdpBurstId(), 0);
+        ASSERT_EQUAL(reader.ReadChunk(chunk, 1), 1);
+        ASSERT_EQUAL(chunk.size(), 2);
+        ASSERT_EQUAL(chunk[1].GetUdpBurstId(), 1);
+        ASSERT_EQUAL(chunk[1].GetStartTimeNs(), schedule[1].GetStartTimeNs());
+        ASSERT_EQUAL(chunk[1].GetDurationNs(), schedule[1].GetDurationNs());
+        ASSERT_EQUAL(reader.ReadChunk(chunk, 1), 0);
+        ASSERT_EQUAL(reader.GetNumRead(), 2);
+
         // Empty
 
         std::ofstream schedule_file_empty(udp_burst_schedule_reader_test_dir + "/udp_burst_schedule.csv");
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-simulation.h"
+#include "ns3/test.h"
+#include "ns3/exp-util.h"
+#include "ns3/workload-generator.h"
+#include "../test-helpers.h"
+
+using namespace ns3;
+
+const std::string workload_generator_test_dir = ".tmp-workload-generator-test";
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class WorkloadGeneratorTestCase : public TestCase
+{
+public:
+    WorkloadGeneratorTestCase () : TestCase ("workload-generator") {};
+
+    void DoRun () {
+        mkdir_if_not_exists(workload_generator_test_dir);
+
+        // Size CDF: half exactly 1000 byte, half uniform in [1000, 3000] (mean: 1500 byte)
+        std::ofstream cdf_file(workload_generator_test_dir + "/size_cdf.csv");
+        cdf_file << "1000,0.5" << std::endl;
+        cdf_file << "3000,1.0" << std::endl;
+        cdf_file.close();
+        WorkloadSizeCdf cdf = read_workload_size_cdf(workload_generator_test_dir + "/size_cdf.csv");
+        ASSERT_EQUAL(cdf.size(), 2);
+        ASSERT_EQUAL(cdf[0].first, 1000);
+        ASSERT_EQUAL(cdf[1].second, 1.0);
+
+        // Poisson arrivals at 1000 per second for 100 seconds between uniform pairs
+        std::set<int64_t> endpoints = {1, 2, 3, 4, 5};
+        WorkloadGenerator uniform(endpoints, 1000.0, cdf, "uniform", 42, 100000000000, -1);
+        WorkloadArrival arrival;
+        int64_t prev_start_time_ns = 0;
+        double total_size_byte = 0;
+        std::set<std::pair<int64_t, int64_t>> pairs;
+        while (uniform.Next(arrival)) {
+            ASSERT_EQUAL(arrival.id, uniform.GetNumGenerated() - 1);
+            ASSERT_TRUE(arrival.from_node_id != arrival.to_node_id);
+            ASSERT_TRUE(endpoints.find(arrival.from_node_id) != endpoints.end());
+            ASSERT_TRUE(endpoints.find(arrival.to_node_id) != endpoints.end());
+            ASSERT_TRUE(arrival.start_time_ns >= prev_start_time_ns);
+            ASSERT_TRUE(arrival.start_time_ns < 100000000000);
+            ASSERT_TRUE(arrival.size_byte >= 1000 && arrival.size_byte <= 3000);
+            prev_start_time_ns = arrival.start_time_ns;
+            total_size_byte += arrival.size_byte;
+            pairs.insert(std::make_pair(arrival.from_node_id, arrival.to_node_id));
+        }
+        ASSERT_EQUAL_APPROX(uniform.GetNumGenerated(), 100000, 1500);
+        ASSERT_EQUAL_APPROX(total_size_byte / uniform.GetNumGenerated(), 1500, 10);
+        ASSERT_EQUAL(pairs.size(), 20);
+
+        // Permutation: every endpoint always sends to the same other endpoint
+        WorkloadGenerator permutation(endpoints, 1000.0, cdf, "permutation", 7, 100000000000, 1000);
+        std::map<int64_t, int64_t> partner;
+        while (permutation.Next(arrival)) {
+            ASSERT_TRUE(arrival.from_node_id != arrival.to_node_id);
+            if (partner.find(arrival.from_node_id) == partner.end()) {
+                partner[arrival.from_node_id] = arrival.to_node_id;
+            }
+            ASSERT_EQUAL(partner[arrival.from_node_id], arrival.to_node_id);
+        }
+        ASSERT_EQUAL(permutation.GetNumGenerated(), 1000);
+
+        // The permutation is a uniform random derangement: each of the 9 derangements of 4 endpoints
+        // is about equally likely, including the 3 which are two swaps (so not a single cycle)
+        std::map<std::map<int64_t, int64_t>, int64_t> derangement_count;
+        for (int64_t seed = 1; seed <= 900; seed++) {
+            WorkloadGenerator generator({1, 2, 3, 4}, 1000.0, cdf, "permutation", seed, 100000000000, 200);
+            std::map<int64_t, int64_t> seed_partner;
+            while (generator.Next(arrival)) {
+                seed_partner[arrival.from_node_id] = arrival.to_node_id;
+            }
+            ASSERT_EQUAL(seed_partner.size(), 4);
+            derangement_count[seed_partner]++;
+        }
+        ASSERT_EQUAL(derangement_count.size(), 9);
+        int64_t num_two_swaps = 0;
+        for (const std::pair<const std::map<int64_t, int64_t>, int64_t>& p : derangement_count) {
+            ASSERT_TRUE(p.second >= 60 && p.second <= 140);
+            if (p.first.at(p.first.at(1)) == 1) {
+                num_two_swaps++;
+            }
+        }
+        ASSERT_EQUAL(num_two_swaps, 3);
+
+        // Generated as TCP flows in chunks, and again the exact same from a copy
+        WorkloadGenerator generator(endpoints, 1000.0, cdf, "uniform", 123, 1000000000, 50);
+        TcpFlowWorkloadGenerator flows_a(generator);
+        TcpFlowWorkloadGenerator flows_b(generator);
+        std::vector<TcpFlowScheduleEntry> chunks_a;
+        while (flows_a.ReadChunk(chunks_a, 7) > 0) {
+            // Read everything
+        }
+        std::vector<TcpFlowScheduleEntry> all_b;
+        ASSERT_EQUAL(flows_b.ReadChunk(all_b, 1000), 50);
+        ASSERT_EQUAL(flows_a.GetNumRead(), 50);
+        ASSERT_EQUAL(chunks_a.size(), 50);
+        for (size_t i = 0; i < chunks_a.size(); i++) {
+            ASSERT_EQUAL(chunks_a[i].GetTcpFlowId(), (int64_t) i);
+            ASSERT_EQUAL(chunks_a[i].GetFromNodeId(), all_b[i].GetFromNodeId());
+            ASSERT_EQUAL(chunks_a[i].GetToNodeId(), all_b[i].GetToNodeId());
+            ASSERT_EQUAL(chunks_a[i].GetSizeByte(), all_b[i].GetSizeByte());
+            ASSERT_EQUAL(chunks_a[i].GetStartTimeNs(), all_b[i].GetStartTimeNs());
+        }
+
+        // As UDP bursts the size determines the duration: 1000 byte at 100 Mbit/s takes 80 us
+        UdpBurstWorkloadGenerator bursts(generator, 100.0);
+        std::vector<UdpBurstInfo> bursts_chunk;
+        ASSERT_EQUAL(bursts.ReadChunk(bursts_chunk, 50), 50);
+        for (size_t i = 0; i < bursts_chunk.size(); i++) {
+            ASSERT_EQUAL(bursts_chunk[i].GetStartTimeNs(), all_b[i].GetStartTimeNs());
+            ASSERT_EQUAL(bursts_chunk[i].GetTargetRateMegabitPerSec(), 100.0);
+            ASSERT_TRUE(bursts_chunk[i].GetDurationNs() >= 80000 && bursts_chunk[i].GetDurationNs() <= 240000);
+        }
+
+        // Invalid
+        ASSERT_EXCEPTION(WorkloadGenerator({1}, 1000.0, cdf, "uniform", 1, 1000000000, -1));
+        ASSERT_EXCEPTION(WorkloadGenerator(endpoints, 0.0, cdf, "uniform", 1, 1000000000, -1));
+        ASSERT_EXCEPTION(WorkloadGenerator(endpoints, 1000.0, cdf, "does-not-exist", 1, 1000000000, -1));
+        ASSERT_EXCEPTION(UdpBurstWorkloadGenerator(generator, 0.0));
+        cdf_file.open(workload_generator_test_dir + "/size_cdf.csv");
+        cdf_file << "1000,0.5" << std::endl;
+        cdf_file << "3000,0.9" << std::endl;
+        cdf_file.close();
+        ASSERT_EXCEPTION(read_workload_size_cdf(workload_generator_test_dir + "/size_cdf.csv"));
+        cdf_file.open(workload_generator_test_dir + "/size_cdf.csv");
+        cdf_file << "3000,0.5" << std::endl;
+        cdf_file << "1000,1.0" << std::endl;
+        cdf_file.close();
+        ASSERT_EXCEPTION(read_workload_size_cdf(workload_generator_test_dir + "/size_cdf.csv"));
+        ASSERT_EXCEPTION(read_workload_size_cdf(workload_generator_test_dir + "/does-not-exist.csv"));
+
+        remove_file_if_exists(workload_generator_test_dir + "/size_cdf.csv");
+        remove_dir_if_exists(workload_generator_test_dir);
+    }
+};
@@ -3,6 +3,8 @@
 #include "ns3/basic-simulation.h"
 #include "ns3/arbiter-ecmp.h"
 #include "ns3/arbiter-ecmp-helper.h"
+#include "ns3/arbiter-multicast.h"
+#include "ns3/arbiter-multicast-helper.h"
 #include "ns3/test.h"
 #include "../test-helpers.h"
 
@@ -440,3 +442,491 @@ public:
 
     }
 };
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+class ArbiterMulticastTableTestCase : public TestCase
+{
+public:
+    ArbiterMulticastTableTestCase () : TestCase ("routing-arbiter-multicast table") {};
+    void DoRun () {
+        prepare_arbiter_test();
+
+        // Create topology
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(arbiter_test_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        NodeContainer nodes = topology->GetNodes();
+
+        // Multicast arbiter at node 1 (neighbors are 0 and 2), unicast state is not used
+        std::vector<std::vector<uint32_t>> candidate_list(topology->GetNumNodes(), std::vector<uint32_t>());
+        Ptr<ArbiterMulticast> arbiter = CreateObject<ArbiterMulticast>(nodes.Get(1), nodes, topology, candidate_list);
+        uint32_t if_to_0 = arbiter->GetNbrIdToIfIdx()[0];
+        uint32_t if_to_2 = arbiter->GetNbrIdToIfIdx()[2];
+        Ipv4Address origin("10.0.0.1");
+        Ipv4Address group_base("225.1.2.4");
+
+        // Many groups such that the table has to grow several times
+        for (uint32_t i = 0; i < 1000; i++) {
+            if (i % 2 == 0) {
+                arbiter->AddMulticastRoute(origin, Ipv4Address(group_base.Get() + i), if_to_0, {if_to_2});
+            } else {
+                arbiter->AddMulticastRoute(origin, Ipv4Address(group_base.Get() + i), if_to_2, {if_to_0, 0});
+            }
+        }
+        ASSERT_EQUAL(arbiter->GetNumMulticastRoutes(), 1000);
+
+        // Forwarding lookups for all groups
+        Ipv4Header header;
+        header.SetSource(origin);
+        for (uint32_t i = 0; i < 1000; i++) {
+            header.SetDestination(Ipv4Address(group_base.Get() + i));
+            ArbiterResult result = arbiter->DecideMulticast(0, Create<Packet>(10), header);
+            ASSERT_FALSE(result.Failed());
+            ASSERT_TRUE(result.IsMulticast());
+            ASSERT_FALSE(result.IsMulticastOutbound());
+            ASSERT_EQUAL(result.GetNumOutIfIdxMulticast(), 1); // Loop-back interface 0 is never an output interface
+            ASSERT_EQUAL(result.GetOutIfIdxMulticast(0), i % 2 == 0 ? if_to_2 : if_to_0);
+            ASSERT_EXCEPTION(result.GetOutIfIdxMulticast(1));
+        }
+
+        // Unknown group is a drop
+        header.SetDestination(Ipv4Address(group_base.Get() + 1000));
+        ASSERT_TRUE(arbiter->DecideMulticast(0, Create<Packet>(10), header).Failed());
+
+        // Different origin falls back to the any-source entry of the group
+        header.SetSource(Ipv4Address("102.102.102.102"));
+        header.SetDestination(Ipv4Address(group_base.Get() + 6));
+        ASSERT_EQUAL(arbiter->DecideMulticast(0, Create<Packet>(10), header).GetOutIfIdxMulticast(0), if_to_2);
+
+        // Replacing an entry with more output interfaces
+        arbiter->AddMulticastRoute(origin, Ipv4Address(group_base.Get() + 6), if_to_0, {if_to_0, if_to_2});
+        ASSERT_EQUAL(arbiter->GetNumMulticastRoutes(), 1000);
+        header.SetSource(origin);
+        ArbiterResult result = arbiter->DecideMulticast(0, Create<Packet>(10), header);
+        ASSERT_EQUAL(result.GetNumOutIfIdxMulticast(), 2);
+        ASSERT_EQUAL(result.GetOutIfIdxMulticast(0), if_to_0);
+        ASSERT_EQUAL(result.GetOutIfIdxMulticast(1), if_to_2);
+
+        // Outbound at the source itself is a single interface
+        header.SetDestination(Ipv4Address(group_base.Get() + 8));
+        result = arbiter->DecideMulticast(1, Create<Packet>(10), header);
+        ASSERT_TRUE(result.IsMulticastOutbound());
+        ASSERT_EQUAL(result.GetOutIfIdx(), if_to_2);
+        ASSERT_EQUAL(result.GetNumOutIfIdxMulticast(), 1);
+
+        // Outbound at the source onto multiple interfaces (looped back to be replicated)
+        header.SetDestination(Ipv4Address(group_base.Get() + 6));
+        result = arbiter->DecideMulticast(1, Create<Packet>(10), header);
+        ASSERT_TRUE(result.IsMulticastOutbound());
+        ASSERT_EQUAL(result.GetNumOutIfIdxMulticast(), 2);
+        ASSERT_EQUAL(result.GetOutIfIdxMulticast(0), if_to_0);
+        ASSERT_EQUAL(result.GetOutIfIdxMulticast(1), if_to_2);
+
+        // Grafting onto an entry in use keeps its input interface
+        arbiter->AddMulticastOutputInterface(origin, group_base, if_to_2, if_to_0);
+        header.SetDestination(group_base);
+        result = arbiter->DecideMulticast(0, Create<Packet>(10), header);
+        ASSERT_EQUAL(result.GetInputIfIdxMulticast(), if_to_0);
+        ASSERT_EQUAL(result.GetNumOutIfIdxMulticast(), 2);
+
+        // Grafting onto an entry which was pruned empty takes the new input interface
+        arbiter->RemoveMulticastOutputInterface(origin, Ipv4Address(group_base.Get() + 2), if_to_2);
+        arbiter->AddMulticastOutputInterface(origin, Ipv4Address(group_base.Get() + 2), if_to_2, if_to_0);
+        header.SetDestination(Ipv4Address(group_base.Get() + 2));
+        result = arbiter->DecideMulticast(0, Create<Packet>(10), header);
+        ASSERT_EQUAL(result.GetInputIfIdxMulticast(), if_to_2);
+        ASSERT_EQUAL(result.GetNumOutIfIdxMulticast(), 1);
+        ASSERT_EQUAL(result.GetOutIfIdxMulticast(0), if_to_0);
+
+        // Clean-up
+        basicSimulation->Finalize();
+        cleanup_arbiter_test();
+
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+class ArbiterBierTestCase : public TestCase
+{
+public:
+    ArbiterBierTestCase () : TestCase ("routing-arbiter bier") {};
+    void DoRun () {
+        prepare_arbiter_test();
+
+        // Create topology
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(arbiter_test_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        NodeContainer nodes = topology->GetNodes();
+
+        // Multicast arbiter at node 1 (neighbors are 0 and 2), unicast state is not used
+        std::vector<std::vector<uint32_t>> candidate_list(topology->GetNumNodes(), std::vector<uint32_t>());
+        Ptr<ArbiterMulticast> arbiter = CreateObject<ArbiterMulticast>(nodes.Get(1), nodes, topology, candidate_list);
+        uint32_t if_to_0 = arbiter->GetNbrIdToIfIdx()[0];
+        uint32_t if_to_2 = arbiter->GetNbrIdToIfIdx()[2];
+        ASSERT_FALSE(arbiter->IsBierEnabled());
+
+        // Endpoints 0 and 3 are reached via node 0, endpoint 2 via node 2
+        BierForwardingState state;
+        state.own_bit_position = 1;
+        state.neighbors.push_back({if_to_0, Ipv4Address("10.0.0.1").Get(), {(1ULL << 0) | (1ULL << 3)}});
+        state.neighbors.push_back({if_to_2, Ipv4Address("10.0.2.2").Get(), {1ULL << 2}});
+        arbiter->SetBierForwardingState(state);
+        ASSERT_TRUE(arbiter->IsBierEnabled());
+        ASSERT_EQUAL(arbiter->GetNumBierNeighbors(), 2);
+        ASSERT_EQUAL(arbiter->GetBierNeighbor(1).out_if_idx, if_to_2);
+        ASSERT_EXCEPTION(arbiter->GetBierNeighbor(2));
+
+        // All endpoints: delivered locally, and each neighbor only gets its own bits
+        std::vector<uint32_t> copy_neighbor_idxs;
+        std::vector<uint64_t> copy_bit_strings;
+        ASSERT_TRUE(arbiter->DecideBier({0xF}, copy_neighbor_idxs, copy_bit_strings));
+        ASSERT_EQUAL(copy_neighbor_idxs.size(), 2);
+        ASSERT_EQUAL(copy_neighbor_idxs[0], 0);
+        ASSERT_EQUAL(copy_neighbor_idxs[1], 1);
+        ASSERT_EQUAL(copy_bit_strings.size(), 2);
+        ASSERT_EQUAL(copy_bit_strings[0], 0x9);
+        ASSERT_EQUAL(copy_bit_strings[1], 0x4);
+
+        // Only endpoint 3: a single copy, not local
+        ASSERT_FALSE(arbiter->DecideBier({0x8}, copy_neighbor_idxs, copy_bit_strings));
+        ASSERT_EQUAL(copy_neighbor_idxs.size(), 1);
+        ASSERT_EQUAL(copy_neighbor_idxs[0], 0);
+        ASSERT_EQUAL(copy_bit_strings[0], 0x8);
+
+        // Only itself: no copies
+        ASSERT_TRUE(arbiter->DecideBier({0x2}, copy_neighbor_idxs, copy_bit_strings));
+        ASSERT_EQUAL(copy_neighbor_idxs.size(), 0);
+        ASSERT_EQUAL(copy_bit_strings.size(), 0);
+
+        // Bit string length must match that of the masks
+        ASSERT_EXCEPTION(arbiter->DecideBier({0x1, 0x0}, copy_neighbor_idxs, copy_bit_strings));
+
+        // Clean-up
+        basicSimulation->Finalize();
+        cleanup_arbiter_test();
+
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+class ArbiterMulticastGraftPruneTestCase : public TestCase
+{
+public:
+    ArbiterMulticastGraftPruneTestCase () : TestCase ("routing-arbiter-multicast graft-prune") {};
+    void DoRun () {
+        prepare_arbiter_test();
+        std::ofstream config_file(arbiter_test_dir + "/config_ns3.properties", std::ofstream::app);
+        config_file << "multicast_route_filename=multicast_route.txt" << std::endl;
+        config_file.close();
+
+        // Create topology (ring 0-1-2-3-0)
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(arbiter_test_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        NodeContainer nodes = topology->GetNodes();
+
+        // Group 0 from node 0 to node 1
+        MulticastUdpInfo req(0, 0, {1}, 10.0, 0, 1000000000, "", "");
+        req.SetMulticastGroup(topology->GetMulticastGroupBase());
+        ArbiterMulticastHelper helper(basicSimulation, topology, {req});
+        std::vector<Ptr<ArbiterMulticast>> arbiters;
+        for (int i = 0; i < 4; i++) {
+            arbiters.push_back(DynamicCast<ArbiterMulticast>(nodes.Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->GetArbiter()));
+        }
+        Ipv4Address origin = helper.GetGroupTreeState(0).origin;
+        Ipv4Address group = helper.GetGroupTreeState(0).group;
+        ASSERT_EQUAL(arbiters[0]->GetNumMulticastOutputInterfaces(origin, group), 1);
+        ASSERT_EQUAL(arbiters[1]->GetNumMulticastOutputInterfaces(origin, group), 0);
+
+        // Node 2 joins: grafted onto node 1 (0 -> 1 -> 2 is the first ECMP candidate path), source unchanged
+        helper.Graft(0, 2);
+        ASSERT_EQUAL(helper.GetNumMembershipLinksChanged(), 1);
+        ASSERT_EQUAL(arbiters[0]->GetNumMulticastOutputInterfaces(origin, group), 1);
+        ASSERT_EQUAL(arbiters[1]->GetNumMulticastOutputInterfaces(origin, group), 1);
+        ASSERT_TRUE(helper.GetGroupTreeState(0).node_to_children.at(1) == std::set<int64_t>({2}));
+        ASSERT_EQUAL(helper.GetGroupTreeState(0).node_to_parent.at(1), 0);
+        ASSERT_EQUAL(helper.GetGroupTreeState(0).node_to_parent.at(2), 1);
+        ASSERT_EXCEPTION(helper.Graft(0, 2));
+
+        // Node 1 leaves, but still forwards to node 2
+        helper.Prune(0, 1);
+        ASSERT_EQUAL(helper.GetNumMembershipLinksChanged(), 1);
+        ASSERT_EQUAL(arbiters[1]->GetNumMulticastOutputInterfaces(origin, group), 1);
+
+        // Node 2 leaves: the entire branch is removed, the source drops
+        helper.Prune(0, 2);
+        ASSERT_EQUAL(helper.GetNumMembershipLinksChanged(), 3);
+        ASSERT_EQUAL(arbiters[0]->GetNumMulticastOutputInterfaces(origin, group), 0);
+        ASSERT_EQUAL(arbiters[1]->GetNumMulticastOutputInterfaces(origin, group), 0);
+        ASSERT_EQUAL(helper.GetGroupTreeState(0).node_to_parents.size(), 0);
+        ASSERT_EQUAL(helper.GetGroupTreeState(0).node_to_parent.size(), 0);
+        Ipv4Header header;
+        header.SetSource(origin);
+        header.SetDestination(group);
+        ASSERT_TRUE(arbiters[0]->DecideMulticast(0, Create<Packet>(10), header).Failed());
+        ASSERT_EXCEPTION(helper.Prune(0, 2));
+
+        // Node 3 joins: directly from the source, re-using its pruned entry
+        helper.Graft(0, 3);
+        ASSERT_EQUAL(arbiters[0]->GetNumMulticastOutputInterfaces(origin, group), 1);
+        ArbiterResult result = arbiters[0]->DecideMulticast(0, Create<Packet>(10), header);
+        ASSERT_FALSE(result.Failed());
+        ASSERT_EQUAL(result.GetOutIfIdxMulticast(0), arbiters[0]->GetNbrIdToIfIdx()[3]);
+        ASSERT_EQUAL(arbiters[0]->GetNumMulticastRoutes(), 1);
+
+        // Clean-up
+        basicSimulation->Finalize();
+        remove_file_if_exists(arbiter_test_dir + "/logs_ns3/multicast_trees.csv");
+        remove_file_if_exists(arbiter_test_dir + "/logs_ns3/multicast_link_load.csv");
+        remove_file_if_exists(arbiter_test_dir + "/logs_ns3/multicast_state_compression.csv");
+        cleanup_arbiter_test();
+
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+class ArbiterMulticastAggregationTestCase : public TestCase
+{
+public:
+    ArbiterMulticastAggregationTestCase () : TestCase ("routing-arbiter-multicast aggregation") {};
+    void DoRun () {
+        prepare_arbiter_test();
+
+        // Create topology
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(arbiter_test_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        NodeContainer nodes = topology->GetNodes();
+
+        // Multicast arbiter at node 1 (neighbors are 0 and 2), unicast state is not used
+        std::vector<std::vector<uint32_t>> candidate_list(topology->GetNumNodes(), std::vector<uint32_t>());
+        Ptr<ArbiterMulticast> arbiter = CreateObject<ArbiterMulticast>(nodes.Get(1), nodes, topology, candidate_list);
+        uint32_t if_to_0 = arbiter->GetNbrIdToIfIdx()[0];
+        uint32_t if_to_2 = arbiter->GetNbrIdToIfIdx()[2];
+        Ipv4Address origin("10.0.0.1");
+        Ipv4Address group_base("225.1.2.4");
+
+        // Groups 0-99 to 2, groups 100-199 to both (in a different order each time)
+        for (uint32_t i = 0; i < 200; i++) {
+            if (i < 100) {
+                arbiter->AddMulticastRoute(origin, Ipv4Address(group_base.Get() + i), if_to_0, {if_to_2});
+            } else {
+                arbiter->AddMulticastRoute(origin, Ipv4Address(group_base.Get() + i), if_to_0, i % 2 == 0 ? std::vector<uint32_t>({if_to_0, if_to_2}) : std::vector<uint32_t>({if_to_2, if_to_0}));
+            }
+        }
+
+        // The output interface sets are shared
+        ASSERT_EQUAL(arbiter->GetNumMulticastRoutes(), 200);
+        ASSERT_EQUAL(arbiter->GetNumMulticastForwardingEntries(), 200);
+        ASSERT_EQUAL(arbiter->GetNumMulticastOifSets(), 2);
+
+        // Two ranges remain after aggregation
+        uint64_t size_before_byte = arbiter->GetMulticastStateSizeByte();
+        arbiter->AggregateMulticastRoutes();
+        ASSERT_EQUAL(arbiter->GetNumMulticastRoutes(), 200);
+        ASSERT_EQUAL(arbiter->GetNumMulticastForwardingEntries(), 2);
+        ASSERT_EQUAL(arbiter->GetNumMulticastGroupRanges(), 2);
+        ASSERT_EQUAL(arbiter->GetNumMulticastOifSets(), 2);
+        ASSERT_TRUE(arbiter->GetMulticastStateSizeByte() < size_before_byte);
+        ASSERT_TRUE(arbiter->GetMulticastStateSizeByte() * 10 < arbiter->GetMulticastStateUncompressedSizeByte());
+
+        // Lookups are unchanged, also for another source
+        Ipv4Header header;
+        header.SetSource(origin);
+        for (uint32_t i = 0; i < 200; i++) {
+            header.SetDestination(Ipv4Address(group_base.Get() + i));
+            ArbiterResult result = arbiter->DecideMulticast(0, Create<Packet>(10), header);
+            ASSERT_FALSE(result.Failed());
+            ASSERT_EQUAL(result.GetNumOutIfIdxMulticast(), i < 100 ? 1 : 2);
+        }
+        header.SetSource(Ipv4Address("102.102.102.102"));
+        header.SetDestination(Ipv4Address(group_base.Get() + 150));
+        ASSERT_EQUAL(arbiter->DecideMulticast(0, Create<Packet>(10), header).GetNumOutIfIdxMulticast(), 2);
+        header.SetDestination(Ipv4Address(group_base.Get() + 200));
+        ASSERT_TRUE(arbiter->DecideMulticast(0, Create<Packet>(10), header).Failed());
+
+        // Grafting group 50 takes it out of its range
+        arbiter->AddMulticastOutputInterface(origin, Ipv4Address(group_base.Get() + 50), if_to_0, if_to_0);
+        ASSERT_EQUAL(arbiter->GetNumMulticastRoutes(), 200);
+        ASSERT_EQUAL(arbiter->GetNumMulticastGroupRanges(), 3);
+        ASSERT_EQUAL(arbiter->GetNumMulticastForwardingEntries(), 4);
+        ASSERT_EQUAL(arbiter->GetNumMulticastOifSets(), 2);
+        ASSERT_EQUAL(arbiter->GetNumMulticastOutputInterfaces(origin, Ipv4Address(group_base.Get() + 49)), 1);
+        ASSERT_EQUAL(arbiter->GetNumMulticastOutputInterfaces(origin, Ipv4Address(group_base.Get() + 50)), 2);
+        ASSERT_EQUAL(arbiter->GetNumMulticastOutputInterfaces(origin, Ipv4Address(group_base.Get() + 51)), 1);
+
+        // Pruning everything of group 50 creates a new (empty) set, which is freed again
+        arbiter->RemoveMulticastOutputInterface(origin, Ipv4Address(group_base.Get() + 50), if_to_0);
+        arbiter->RemoveMulticastOutputInterface(origin, Ipv4Address(group_base.Get() + 50), if_to_2);
+        ASSERT_EQUAL(arbiter->GetNumMulticastOifSets(), 3);
+        header.SetSource(origin);
+        header.SetDestination(Ipv4Address(group_base.Get() + 50));
+        ASSERT_TRUE(arbiter->DecideMulticast(0, Create<Packet>(10), header).Failed());
+        arbiter->AddMulticastOutputInterface(origin, Ipv4Address(group_base.Get() + 50), if_to_0, if_to_2);
+        ASSERT_EQUAL(arbiter->GetNumMulticastOifSets(), 2);
+
+        // Clean-up
+        basicSimulation->Finalize();
+        cleanup_arbiter_test();
+
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+int64_t arbiter_multicast_rpf_test_num_forwarded = 0;
+
+void arbiter_multicast_rpf_test_mcb(Ptr<Ipv4MulticastRoute> route, Ptr<const Packet> p, const Ipv4Header &header) {
+    arbiter_multicast_rpf_test_num_forwarded++;
+}
+
+void arbiter_multicast_rpf_test_ucb(Ptr<Ipv4Route> route, Ptr<const Packet> p, const Ipv4Header &header) {
+    arbiter_multicast_rpf_test_num_forwarded++;
+}
+
+void arbiter_multicast_rpf_test_lcb(Ptr<const Packet> p, const Ipv4Header &header, uint32_t iif) {
+    // Left empty intentionally
+}
+
+void arbiter_multicast_rpf_test_ecb(Ptr<const Packet> p, const Ipv4Header &header, Socket::SocketErrno sockerr) {
+    // Left empty intentionally
+}
+
+class ArbiterMulticastRpfTestCase : public TestCase
+{
+public:
+    ArbiterMulticastRpfTestCase () : TestCase ("routing-arbiter-multicast rpf") {};
+    void DoRun () {
+        prepare_arbiter_test();
+        std::ofstream config_file(arbiter_test_dir + "/config_ns3.properties", std::ofstream::app);
+        config_file << "multicast_route_filename=multicast_route.txt" << std::endl;
+        config_file.close();
+
+        // Create topology (ring 0-1-2-3-0)
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(arbiter_test_dir);
+        Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        NodeContainer nodes = topology->GetNodes();
+
+        // Group 0 from node 0 to node 1 and 2, such that node 1 forwards from node 0 to node 2
+        MulticastUdpInfo req(0, 0, {1}, 10.0, 0, 1000000000, "", "");
+        req.SetMulticastGroup(topology->GetMulticastGroupBase());
+        ArbiterMulticastHelper helper(basicSimulation, topology, {req});
+        helper.Graft(0, 2);
+        Ptr<Ipv4ArbiterRouting> routing = nodes.Get(1)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>();
+        Ptr<ArbiterMulticast> arbiter = DynamicCast<ArbiterMulticast>(routing->GetArbiter());
+        uint32_t if_to_0 = arbiter->GetNbrIdToIfIdx()[0];
+        uint32_t if_to_2 = arbiter->GetNbrIdToIfIdx()[2];
+        Ipv4Header header;
+        header.SetSource(helper.GetGroupTreeState(0).origin);
+        header.SetDestination(helper.GetGroupTreeState(0).group);
+        header.SetProtocol(17);
+
+        // The entry expects the packets from the parent (node 0)
+        ArbiterResult result = arbiter->DecideMulticast(0, Create<Packet>(10), header);
+        ASSERT_EQUAL(result.GetInputIfIdxMulticast(), if_to_0);
+        ASSERT_EQUAL(result.GetOutIfIdxMulticast(0), if_to_2);
+
+        // In from node 0: forwarded
+        arbiter_multicast_rpf_test_num_forwarded = 0;
+        ASSERT_TRUE(routing->RouteInput(
+                Create<Packet>(10), header, nodes.Get(1)->GetObject<Ipv4>()->GetNetDevice(if_to_0),
+                MakeCallback(&arbiter_multicast_rpf_test_ucb), MakeCallback(&arbiter_multicast_rpf_test_mcb),
+                MakeCallback(&arbiter_multicast_rpf_test_lcb), MakeCallback(&arbiter_multicast_rpf_test_ecb)
+        ));
+        ASSERT_EQUAL(arbiter_multicast_rpf_test_num_forwarded, 1);
+
+        // In from node 2 (the wrong interface): dropped, as sending it back to node 2 would loop
+        arbiter_multicast_rpf_test_num_forwarded = 0;
+        ASSERT_FALSE(routing->RouteInput(
+                Create<Packet>(10), header, nodes.Get(1)->GetObject<Ipv4>()->GetNetDevice(if_to_2),
+                MakeCallback(&arbiter_multicast_rpf_test_ucb), MakeCallback(&arbiter_multicast_rpf_test_mcb),
+                MakeCallback(&arbiter_multicast_rpf_test_lcb), MakeCallback(&arbiter_multicast_rpf_test_ecb)
+        ));
+        ASSERT_EQUAL(arbiter_multicast_rpf_test_num_forwarded, 0);
+
+        // At the source only from its own loop-back
+        Ptr<Ipv4ArbiterRouting> source_routing = nodes.Get(0)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>();
+        uint32_t source_if_to_1 = DynamicCast<ArbiterMulticast>(source_routing->GetArbiter())->GetNbrIdToIfIdx()[1];
+        ASSERT_FALSE(source_routing->RouteInput(
+                Create<Packet>(10), header, nodes.Get(0)->GetObject<Ipv4>()->GetNetDevice(source_if_to_1),
+                MakeCallback(&arbiter_multicast_rpf_test_ucb), MakeCallback(&arbiter_multicast_rpf_test_mcb),
+                MakeCallback(&arbiter_multicast_rpf_test_lcb), MakeCallback(&arbiter_multicast_rpf_test_ecb)
+        ));
+        ASSERT_EQUAL(arbiter_multicast_rpf_test_num_forwarded, 0);
+
+        // Clean-up
+        basicSimulation->Finalize();
+        remove_file_if_exists(arbiter_test_dir + "/logs_ns3/multicast_trees.csv");
+        remove_file_if_exists(arbiter_test_dir + "/logs_ns3/multicast_link_load.csv");
+        remove_file_if_exists(arbiter_test_dir + "/logs_ns3/multicast_state_compression.csv");
+        cleanup_arbiter_test();
+
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+class ArbiterMulticastLoadAwarePlacementTestCase : public TestCase
+{
+public:
+    ArbiterMulticastLoadAwarePlacementTestCase () : TestCase ("routing-arbiter-multicast load-aware-placement") {};
+    void DoRun () {
+
+        // Group 0 (60 Mbit/s) and group 1 (20 Mbit/s) both from node 0 to node 1 over the ring 0-1-2-3-0 (100 Mbit/s links)
+        for (std::string placement : {"independent", "load_aware"}) {
+            prepare_arbiter_test();
+            std::ofstream config_file(arbiter_test_dir + "/config_ns3.properties", std::ofstream::app);
+            config_file << "multicast_route_filename=multicast_route.txt" << std::endl;
+            config_file << "multicast_tree_builder=spt" << std::endl;
+            config_file << "multicast_tree_placement=" << placement << std::endl;
+            config_file.close();
+
+            Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(arbiter_test_dir);
+            Ptr<TopologyPtop> topology = CreateObject<TopologyPtop>(basicSimulation, Ipv4ArbiterRoutingHelper());
+            MulticastUdpInfo req_large(0, 0, {1}, 60.0, 0, 1000000000, "", "");
+            req_large.SetMulticastGroup(topology->GetMulticastGroupBase());
+            MulticastUdpInfo req_small(1, 0, {1}, 20.0, 0, 1000000000, "", "");
+            req_small.SetMulticastGroup(topology->GetMulticastGroupBase());
+            ArbiterMulticastHelper helper(basicSimulation, topology, {req_large, req_small});
+
+            // The large group always takes the direct link
+            ASSERT_TRUE(helper.GetGroupTreeState(0).node_to_children == (std::map<int64_t, std::set<int64_t>>({{0, {1}}})));
+
+            if (placement == "independent") {
+
+                // Every tree on its own: the small group shares the direct link
+                ASSERT_TRUE(helper.GetGroupTreeState(1).node_to_children == (std::map<int64_t, std::set<int64_t>>({{0, {1}}})));
+
+            } else {
+
+                // With the small group on it, the direct link would be at 80% utilization (weight 1 / (1 - 0.8) = 5),
+                // whereas the three links of the detour would each be at 20% (weight 1 / (1 - 0.2) = 1.25, total 3.75)
+                ASSERT_TRUE(helper.GetGroupTreeState(1).node_to_children == (std::map<int64_t, std::set<int64_t>>({{0, {3}}, {3, {2}}, {2, {1}}})));
+
+            }
+
+            // Committed load of the direct link
+            std::vector<std::string> lines_link_load = read_file_direct(arbiter_test_dir + "/logs_ns3/multicast_link_load.csv");
+            ASSERT_EQUAL(lines_link_load.size(), 8);
+            bool found_direct_link = false;
+            for (std::string& line : lines_link_load) {
+                std::vector<std::string> spl = split_string(line, ",", 6);
+                if (parse_int64(spl[0]) == 0 && parse_int64(spl[1]) == 1) {
+                    ASSERT_EQUAL(parse_int64(spl[2]), placement == "independent" ? 2 : 1);
+                    ASSERT_EQUAL_APPROX(parse_double(spl[3]), placement == "independent" ? 80.0 : 60.0, 1e-6);
+                    found_direct_link = true;
+                }
+            }
+            ASSERT_TRUE(found_direct_link);
+
+            // Clean-up
+            basicSimulation->Finalize();
+            remove_file_if_exists(arbiter_test_dir + "/logs_ns3/multicast_trees.csv");
+            remove_file_if_exists(arbiter_test_dir + "/logs_ns3/multicast_link_load.csv");
+            remove_file_if_exists(arbiter_test_dir + "/logs_ns3/multicast_state_compression.csv");
+            cleanup_arbiter_test();
+        }
+
+    }
+};
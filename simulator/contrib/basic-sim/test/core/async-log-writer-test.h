@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-simulation.h"
+#include "ns3/test.h"
+#include "../test-helpers.h"
+#include "ns3/async-log-writer.h"
+
+using namespace ns3;
+
+const std::string async_log_writer_test_dir = ".tmp-async-log-writer-test";
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class AsyncLogWriterTestCase : public TestCase
+{
+public:
+    AsyncLogWriterTestCase () : TestCase ("async-log-writer basic") {};
+    void DoRun () {
+        mkdir_if_not_exists(async_log_writer_test_dir);
+        std::string filename_cwnd = async_log_writer_test_dir + "/tcp_flow_3_cwnd.csv";
+        std::string filename_rtt = async_log_writer_test_dir + "/tcp_flow_3_rtt.csv";
+        std::string filename_late = async_log_writer_test_dir + "/tcp_flow_4_cwnd.csv";
+
+        // Capacity must be at least one
+        ASSERT_EXCEPTION(CreateObject<AsyncLogWriter>(0));
+
+        // Many more records than the ring capacity, the writer drains in between
+        Ptr<AsyncLogWriter> writer = CreateObject<AsyncLogWriter>(100);
+        uint32_t file_cwnd = writer->OpenFile(filename_cwnd);
+        uint32_t file_rtt = writer->OpenFile(filename_rtt);
+        int64_t num_records = 10000;
+        for (int64_t i = 0; i < num_records; i++) {
+            writer->Record(i % 2 == 0 ? file_cwnd : file_rtt, 3, i, i * 10);
+            if (i == num_records / 2) {
+                writer->OpenFile(filename_late); // Opened while the writer is running
+            }
+        }
+        writer->Close();
+        writer->Close(); // Closing twice is fine
+        ASSERT_EXCEPTION(writer->OpenFile(async_log_writer_test_dir + "/other.csv"));
+        ASSERT_EQUAL(writer->GetNumRecorded(), num_records);
+        ASSERT_EQUAL(writer->GetNumWritten() + writer->GetNumDropped(), num_records);
+
+        // Each file has its records in order (without the dropped ones)
+        std::vector<std::string> lines_cwnd = read_file_direct(filename_cwnd);
+        std::vector<std::string> lines_rtt = read_file_direct(filename_rtt);
+        ASSERT_EQUAL(lines_cwnd.size() + lines_rtt.size(), writer->GetNumWritten());
+        int64_t prev_time = -1;
+        for (std::string& line : lines_cwnd) {
+            std::vector<std::string> spl = split_string(line, ",", 3);
+            int64_t time = parse_int64(spl[1]);
+            ASSERT_EQUAL(parse_int64(spl[0]), 3);
+            ASSERT_EQUAL(time % 2, 0);
+            ASSERT_TRUE(time > prev_time);
+            ASSERT_EQUAL(parse_int64(spl[2]), time * 10);
+            prev_time = time;
+        }
+        ASSERT_EQUAL(read_file_direct(filename_late).size(), 0);
+
+        remove_file_if_exists(filename_cwnd);
+        remove_file_if_exists(filename_rtt);
+        remove_file_if_exists(filename_late);
+        remove_dir_if_exists(async_log_writer_test_dir);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class AsyncLogWriterWriteFailureTestCase : public TestCase
+{
+public:
+    AsyncLogWriterWriteFailureTestCase () : TestCase ("async-log-writer write-failure") {};
+    void DoRun () {
+
+        // Every write to /dev/full fails (no space left): the writer thread stops,
+        // and the error is thrown when it is closed instead of terminating the program
+        Ptr<AsyncLogWriter> writer = CreateObject<AsyncLogWriter>(1024);
+        uint32_t file = writer->OpenFile("/dev/full");
+        for (int64_t i = 0; i < 100000; i++) {
+            writer->Record(file, 0, i, i);
+        }
+        ASSERT_EXCEPTION(writer->Close());
+        writer->Close(); // Thrown only once
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
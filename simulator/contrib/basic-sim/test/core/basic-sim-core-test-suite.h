@@ -9,6 +9,16 @@
 #include "ptop-link-queue-test.h"
 #include "tcp-optimizer-test.h"
 #include "log-update-helper-test.h"
+#include "multicast-trace-test.h"
+#include "multicast-tree-builder-test.h"
+#include "bier-header-test.h"
+#include "multicast-replication-counter-test.h"
+#include "precise-log-writer-test.h"
+#include "async-log-writer-test.h"
+#include "latency-histogram-test.h"
+#include "phase-profiler-test.h"
+#include "profiling-scheduler-test.h"
+#include "ladder-scheduler-test.h"
 
 using namespace ns3;
 
@@ -41,6 +51,12 @@ public:
         AddTestCase(new ArbiterEcmpHashTestCase, TestCase::QUICK);
         AddTestCase(new ArbiterEcmpStringReprTestCase, TestCase::QUICK);
         AddTestCase(new ArbiterBadImplTestCase, TestCase::QUICK);
+        AddTestCase(new ArbiterMulticastTableTestCase, TestCase::QUICK);
+        AddTestCase(new ArbiterMulticastGraftPruneTestCase, TestCase::QUICK);
+        AddTestCase(new ArbiterMulticastRpfTestCase, TestCase::QUICK);
+        AddTestCase(new ArbiterMulticastLoadAwarePlacementTestCase, TestCase::QUICK);
+        AddTestCase(new ArbiterMulticastAggregationTestCase, TestCase::QUICK);
+        AddTestCase(new ArbiterBierTestCase, TestCase::QUICK);
 
         // Point-to-point link utilization tracking
         AddTestCase(new PtopLinkUtilizationSimpleTestCase, TestCase::QUICK);
@@ -54,6 +70,36 @@ public:
         AddTestCase(new TcpOptimizerBasicTestCase, TestCase::QUICK);
         AddTestCase(new TcpOptimizerWorstCaseRttTestCase, TestCase::QUICK);
 
+        // Multicast forwarding trace
+        AddTestCase(new MulticastTraceRingTestCase, TestCase::QUICK);
+        AddTestCase(new MulticastTraceWriteFailureTestCase, TestCase::QUICK);
+
+        // Multicast tree construction
+        AddTestCase(new MulticastTreeBuilderTestCase, TestCase::QUICK);
+
+        // Stateless (BIER) multicast
+        AddTestCase(new BierHeaderTestCase, TestCase::QUICK);
+
+        // Multicast replication accounting
+        AddTestCase(new MulticastReplicationCounterTestCase, TestCase::QUICK);
+
+        // Buffered precise logging
+        AddTestCase(new PreciseLogWriterTestCase, TestCase::QUICK);
+        AddTestCase(new PreciseLogWriterWriteFailureTestCase, TestCase::QUICK);
+        AddTestCase(new AsyncLogWriterTestCase, TestCase::QUICK);
+        AddTestCase(new AsyncLogWriterWriteFailureTestCase, TestCase::QUICK);
+
+        // Latency histograms
+        AddTestCase(new LatencyHistogramTestCase, TestCase::QUICK);
+
+        // Profiling
+        AddTestCase(new PhaseProfilerTestCase, TestCase::QUICK);
+        AddTestCase(new PhaseProfilerChromeTraceTestCase, TestCase::QUICK);
+        AddTestCase(new ProfilingSchedulerTestCase, TestCase::QUICK);
+
+        // Event queue
+        AddTestCase(new LadderSchedulerTestCase, TestCase::QUICK);
+
     }
 };
 static BasicSimTestSuite basicSimTestSuite;
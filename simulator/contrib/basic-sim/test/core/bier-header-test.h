@@ -0,0 +1,57 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/bier-header.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+#include "../test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class BierHeaderTestCase : public TestCase
+{
+public:
+    BierHeaderTestCase () : TestCase ("bier-header") {};
+    void DoRun () {
+
+        // Bit positions follow the ascending order of the endpoints
+        std::vector<int64_t> bit_positions = bier_bit_positions({1, 4, 5, 70}, 72);
+        ASSERT_EQUAL(bit_positions.size(), 72);
+        ASSERT_EQUAL(bit_positions[0], -1);
+        ASSERT_EQUAL(bit_positions[1], 0);
+        ASSERT_EQUAL(bit_positions[4], 1);
+        ASSERT_EQUAL(bit_positions[5], 2);
+        ASSERT_EQUAL(bit_positions[70], 3);
+        ASSERT_EQUAL(bier_num_words(0), 0);
+        ASSERT_EQUAL(bier_num_words(1), 1);
+        ASSERT_EQUAL(bier_num_words(64), 1);
+        ASSERT_EQUAL(bier_num_words(65), 2);
+
+        // Setting bits
+        BierHeader header;
+        header.SetBitString(std::vector<uint64_t>(2, 0));
+        header.SetBit(0);
+        header.SetBit(63);
+        header.SetBit(100);
+        ASSERT_TRUE(header.IsBitSet(0));
+        ASSERT_FALSE(header.IsBitSet(1));
+        ASSERT_TRUE(header.IsBitSet(63));
+        ASSERT_TRUE(header.IsBitSet(100));
+        ASSERT_EXCEPTION(header.SetBit(128));
+        ASSERT_FALSE(header.IsBitSet(128));
+        ASSERT_EQUAL(header.GetSerializedSize(), 2 + 2 * 8);
+
+        // Round-trip through a packet
+        Ptr<Packet> p = Create<Packet>(100);
+        p->AddHeader(header);
+        ASSERT_EQUAL(p->GetSize(), 100 + 18);
+        BierHeader received;
+        p->RemoveHeader(received);
+        ASSERT_EQUAL(p->GetSize(), 100);
+        ASSERT_EQUAL(received.GetBitString().size(), 2);
+        ASSERT_EQUAL(received.GetBitString()[0], (1ULL << 0) | (1ULL << 63));
+        ASSERT_EQUAL(received.GetBitString()[1], 1ULL << 36);
+
+    }
+};
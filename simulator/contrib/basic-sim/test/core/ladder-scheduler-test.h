@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-simulation.h"
+#include "ns3/test.h"
+#include "../test-helpers.h"
+#include "ns3/ladder-scheduler.h"
+#include <random>
+
+using namespace ns3;
+
+std::vector<int64_t> ladder_scheduler_test_executed;
+
+void ladder_scheduler_test_record(int64_t value) {
+    ladder_scheduler_test_executed.push_back(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class LadderSchedulerTestCase : public TestCase
+{
+public:
+    LadderSchedulerTestCase () : TestCase ("ladder-scheduler basic") {};
+    void DoRun () {
+        ASSERT_TRUE(CreateObject<LadderScheduler>()->IsEmpty());
+        ASSERT_EXCEPTION(CreateObject<LadderScheduler>()->RemoveNext());
+
+        // Same order as the map scheduler for a mix of near-future events, bursts at the same time,
+        // events at the current time, periodic events far ahead and removals
+        Ptr<LadderScheduler> ladder = CreateObject<LadderScheduler>();
+        Ptr<MapScheduler> map = CreateObject<MapScheduler>();
+        std::mt19937_64 rng(123456789);
+        uint32_t uid = 0;
+        uint64_t now = 0;
+        size_t max_num_rungs = 0;
+        for (int i = 0; i < 10000; i++) {
+            Scheduler::Event ev;
+            ev.impl = nullptr;
+            ev.key.m_ts = rng() % 1000000;
+            ev.key.m_uid = uid++;
+            ev.key.m_context = 0;
+            ladder->Insert(ev);
+            map->Insert(ev);
+        }
+        for (int i = 0; i < 100000; i++) {
+            Scheduler::Event expected = map->RemoveNext();
+            ASSERT_EQUAL(ladder->PeekNext().key.m_uid, expected.key.m_uid);
+            Scheduler::Event next = ladder->RemoveNext();
+            ASSERT_EQUAL(next.key.m_uid, expected.key.m_uid);
+            ASSERT_EQUAL(next.key.m_ts, expected.key.m_ts);
+            now = next.key.m_ts;
+            max_num_rungs = std::max(max_num_rungs, ladder->GetNumRungs());
+            uint64_t r = rng() % 100;
+            std::vector<Scheduler::Event> new_events;
+            Scheduler::Event ev;
+            ev.impl = nullptr;
+            ev.key.m_context = 0;
+            if (r < 2) {
+                ev.key.m_ts = now + 100000000;
+                ev.key.m_uid = uid++;
+                new_events.push_back(ev);
+            } else if (r < 10) {
+                for (int k = 0; k < 3; k++) {
+                    ev.key.m_ts = now + 5000;
+                    ev.key.m_uid = uid++;
+                    new_events.push_back(ev);
+                }
+            } else if (r < 12) {
+                ev.key.m_ts = now;
+                ev.key.m_uid = uid++;
+                new_events.push_back(ev);
+            } else {
+                ev.key.m_ts = now + rng() % 20000;
+                ev.key.m_uid = uid++;
+                new_events.push_back(ev);
+            }
+            for (const Scheduler::Event& new_ev : new_events) {
+                ladder->Insert(new_ev);
+                map->Insert(new_ev);
+            }
+            if (r == 50) {
+                ladder->Remove(new_events[0]);
+                map->Remove(new_events[0]);
+            }
+        }
+        while (!map->IsEmpty()) {
+            ASSERT_FALSE(ladder->IsEmpty());
+            ASSERT_EQUAL(ladder->RemoveNext().key.m_uid, map->RemoveNext().key.m_uid);
+        }
+        ASSERT_TRUE(ladder->IsEmpty());
+        ASSERT_TRUE(max_num_rungs >= 2);
+
+        // As the scheduler of the simulator
+        ladder_scheduler_test_executed.clear();
+        ObjectFactory schedulerFactory;
+        schedulerFactory.SetTypeId("ns3::LadderScheduler");
+        Simulator::SetScheduler(schedulerFactory);
+        for (int64_t i = 0; i < 100; i++) {
+            Simulator::Schedule(NanoSeconds((i * 37) % 100), &ladder_scheduler_test_record, (i * 37) % 100);
+        }
+        Simulator::Run();
+        ASSERT_EQUAL(ladder_scheduler_test_executed.size(), 100);
+        for (int64_t i = 0; i < 100; i++) {
+            ASSERT_EQUAL(ladder_scheduler_test_executed[i], i);
+        }
+        Simulator::Destroy();
+
+    }
+};
@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-simulation.h"
+#include "ns3/test.h"
+#include "../test-helpers.h"
+#include "ns3/latency-histogram.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class LatencyHistogramTestCase : public TestCase
+{
+public:
+    LatencyHistogramTestCase () : TestCase ("latency-histogram basic") {};
+    void DoRun () {
+        ASSERT_EXCEPTION(LatencyHistogram(17));
+
+        // Nothing recorded
+        LatencyHistogram empty;
+        ASSERT_EQUAL(empty.GetCount(), 0);
+        ASSERT_EQUAL(empty.GetPercentile(50), 0);
+        ASSERT_EQUAL(empty.GetJitter(), 0);
+        ASSERT_EXCEPTION(empty.Record(-1));
+        ASSERT_EXCEPTION(empty.GetPercentile(-0.1));
+        ASSERT_EXCEPTION(empty.GetPercentile(100.1));
+
+        // Small values are exact
+        LatencyHistogram exact(4);
+        for (int64_t i = 0; i < 16; i++) {
+            exact.Record(i);
+        }
+        ASSERT_EQUAL(exact.GetNumBuckets(), 16);
+        ASSERT_EQUAL(exact.GetPercentile(50), 7);
+        ASSERT_EQUAL(exact.GetPercentile(0), 0);
+        ASSERT_EQUAL(exact.GetPercentile(100), 15);
+
+        // 1 us to 100 ms uniformly: percentiles within the relative error of a bucket
+        LatencyHistogram histogram(7);
+        for (int64_t i = 1; i <= 100000; i++) {
+            histogram.Record(i * 1000);
+        }
+        ASSERT_EQUAL(histogram.GetCount(), 100000);
+        ASSERT_EQUAL(histogram.GetMin(), 1000);
+        ASSERT_EQUAL(histogram.GetMax(), 100000000);
+        ASSERT_EQUAL_APPROX(histogram.GetMean(), 50000500.0, 0.001);
+        ASSERT_EQUAL_APPROX(histogram.GetPercentile(50), 50000000, 50000000 / 128);
+        ASSERT_EQUAL_APPROX(histogram.GetPercentile(99), 99000000, 99000000 / 128);
+        ASSERT_EQUAL_APPROX(histogram.GetPercentile(99.9), 99900000, 99900000 / 128);
+        ASSERT_EQUAL(histogram.GetPercentile(100), 100000000);
+        ASSERT_TRUE(histogram.GetNumBuckets() < 3000);
+
+        // Jitter converges to the constant difference between consecutive latencies
+        ASSERT_EQUAL_APPROX(histogram.GetJitter(), 1000.0, 0.001);
+        LatencyHistogram constant;
+        for (int i = 0; i < 100; i++) {
+            constant.Record(500000);
+        }
+        ASSERT_EQUAL(constant.GetJitter(), 0);
+        ASSERT_EQUAL(constant.GetPercentile(99.9), 500000);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,55 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-simulation.h"
+#include "ns3/test.h"
+#include "../test-helpers.h"
+#include "ns3/multicast-replication-counter.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class MulticastReplicationCounterTestCase : public TestCase
+{
+public:
+    MulticastReplicationCounterTestCase () : TestCase ("multicast-replication-counter basic") {};
+    void DoRun () {
+        ASSERT_EXCEPTION(CreateObject<MulticastReplicationCounter>(-1));
+
+        Ptr<MulticastReplicationCounter> counter = CreateObject<MulticastReplicationCounter>(3);
+        uint32_t group_a = 0xE1010204;
+        uint32_t group_b = 0xE1010205;
+
+        // Replicated onto two interfaces at node 1, once onto one at node 2
+        for (int i = 0; i < 10; i++) {
+            counter->Count(1, 1, group_a, 1500);
+            counter->Count(1, 2, group_a, 1500);
+        }
+        counter->Count(2, 1, group_b, 100);
+        counter->Count(2, 1, group_b, 200);
+
+        // Loop-back is not a link
+        counter->Count(0, 0, group_a, 1500);
+
+        ASSERT_EQUAL(counter->GetCount(1, 1, group_a).num_packets, 10);
+        ASSERT_EQUAL(counter->GetCount(1, 1, group_a).num_bytes, 15000);
+        ASSERT_EQUAL(counter->GetCount(1, 2, group_a).num_packets, 10);
+        ASSERT_EQUAL(counter->GetCount(1, 1, group_b).num_packets, 0);
+        ASSERT_EQUAL(counter->GetCount(2, 1, group_b).num_packets, 2);
+        ASSERT_EQUAL(counter->GetCount(2, 1, group_b).num_bytes, 300);
+        ASSERT_EQUAL(counter->GetCountsOfNode(0).size(), 0);
+        ASSERT_EQUAL(counter->GetCountsOfNode(1).size(), 2);
+
+        // Keys split back into interface and group
+        for (const std::pair<const uint64_t, MulticastReplicationCount>& entry : counter->GetCountsOfNode(2)) {
+            ASSERT_EQUAL(MulticastReplicationCounter::GetOutIfIdxOfKey(entry.first), 1);
+            ASSERT_EQUAL(MulticastReplicationCounter::GetGroupOfKey(entry.first), group_b);
+        }
+
+        // Out of range node
+        ASSERT_EXCEPTION(counter->Count(3, 1, group_a, 1500));
+        ASSERT_EXCEPTION(counter->GetCountsOfNode(3));
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
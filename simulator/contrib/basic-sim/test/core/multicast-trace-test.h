@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-simulation.h"
+#include "ns3/test.h"
+#include "../test-helpers.h"
+#include "ns3/multicast-trace.h"
+
+using namespace ns3;
+
+const std::string multicast_trace_test_dir = ".tmp-multicast-trace-test";
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class MulticastTraceRingTestCase : public TestCase
+{
+public:
+    MulticastTraceRingTestCase () : TestCase ("multicast-trace ring") {};
+    void DoRun () {
+        mkdir_if_not_exists(multicast_trace_test_dir);
+        std::string filename = multicast_trace_test_dir + "/multicast_trace.bin";
+
+        // Capacity must be at least one
+        ASSERT_EXCEPTION(CreateObject<MulticastTrace>(filename, 0));
+
+        // Many more records than the ring capacity, the writer drains in between
+        Ptr<MulticastTrace> trace = CreateObject<MulticastTrace>(filename, 100);
+        uint32_t num_records = 10000;
+        for (uint32_t i = 0; i < num_records; i++) {
+            trace->Record(i % 7, 0xE1010204 + i, i % 5, 1ULL << (i % 64), 1, (uint8_t) (i % 4));
+        }
+        trace->Close();
+        trace->Close(); // Closing twice is fine
+        ASSERT_EQUAL(trace->GetNumRecorded(), num_records);
+        ASSERT_EQUAL(trace->GetNumWritten() + trace->GetNumDropped(), num_records);
+
+        // Read the records back: they must be in order, without gaps caused by wrap-around
+        std::ifstream file(filename, std::ios::binary);
+        std::vector<MulticastTraceRecord> records;
+        MulticastTraceRecord record;
+        while (file.read((char*) &record, sizeof(MulticastTraceRecord))) {
+            records.push_back(record);
+        }
+        file.close();
+        ASSERT_EQUAL(records.size(), trace->GetNumWritten());
+        for (size_t j = 0; j < records.size(); j++) {
+            ASSERT_EQUAL(records[j].time_ns, 0);
+            uint32_t i = records[j].group - 0xE1010204;
+            ASSERT_TRUE(j == 0 || records[j - 1].group < records[j].group);
+            ASSERT_EQUAL(records[j].node_id, i % 7);
+            ASSERT_EQUAL(records[j].iif, i % 5);
+            ASSERT_EQUAL(records[j].oif_bitmap, 1ULL << (i % 64));
+            ASSERT_EQUAL(records[j].num_oifs, 1);
+            ASSERT_EQUAL(records[j].decision, i % 4);
+        }
+
+        remove_file_if_exists(filename);
+        remove_dir_if_exists(multicast_trace_test_dir);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class MulticastTraceWriteFailureTestCase : public TestCase
+{
+public:
+    MulticastTraceWriteFailureTestCase () : TestCase ("multicast-trace write-failure") {};
+    void DoRun () {
+
+        // Every write to /dev/full fails (no space left): the writer thread stops,
+        // and the error is thrown when it is closed instead of terminating the program
+        Ptr<MulticastTrace> trace = CreateObject<MulticastTrace>("/dev/full", 1024);
+        for (uint32_t i = 0; i < 100000; i++) {
+            trace->Record(0, 0xE1010204, 0, 0, 0, MULTICAST_TRACE_FORWARD);
+        }
+        ASSERT_EXCEPTION(trace->Close());
+        trace->Close(); // Thrown only once
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,70 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-simulation.h"
+#include "ns3/test.h"
+#include "../test-helpers.h"
+#include "ns3/multicast-tree-builder.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+WeightedAdjacencyList multicast_tree_builder_test_graph(int64_t num_nodes, std::vector<std::tuple<int64_t, int64_t, double>> edges) {
+    WeightedAdjacencyList adjacency(num_nodes);
+    for (std::tuple<int64_t, int64_t, double> edge : edges) {
+        adjacency[std::get<0>(edge)].push_back(std::make_pair(std::get<1>(edge), std::get<2>(edge)));
+        adjacency[std::get<1>(edge)].push_back(std::make_pair(std::get<0>(edge), std::get<2>(edge)));
+    }
+    for (std::vector<std::pair<int64_t, double>>& nbrs : adjacency) {
+        std::sort(nbrs.begin(), nbrs.end());
+    }
+    return adjacency;
+}
+
+class MulticastTreeBuilderTestCase : public TestCase
+{
+public:
+    MulticastTreeBuilderTestCase () : TestCase ("multicast-tree-builder spt-steiner") {};
+    void DoRun () {
+
+        // Hub 1 is slightly further away from 0 than the destinations 3, 4, 5,
+        // but from there all of them can be reached cheaply
+        WeightedAdjacencyList adjacency = multicast_tree_builder_test_graph(6, {
+            std::make_tuple(0, 1, 1.5),
+            std::make_tuple(0, 3, 2.0), std::make_tuple(0, 4, 2.0), std::make_tuple(0, 5, 2.0),
+            std::make_tuple(1, 3, 0.9), std::make_tuple(1, 4, 0.9), std::make_tuple(1, 5, 0.9)
+        });
+
+        // Shortest-path tree uses the direct links
+        MulticastTree spt = CreateObject<MulticastTreeBuilderSpt>()->BuildTree(adjacency, 0, {3, 4, 5});
+        ASSERT_EQUAL(spt.GetNumLinks(), 3);
+        ASSERT_EQUAL_APPROX(spt.cost, 6.0, 1e-9);
+        ASSERT_EQUAL(spt.node_to_children.at(0).size(), 3);
+
+        // Steiner heuristic: 0 -> 3 first, then everything else via the hub
+        MulticastTree steiner = CreateObject<MulticastTreeBuilderSteiner>()->BuildTree(adjacency, 0, {3, 4, 5});
+        ASSERT_EQUAL(steiner.GetNumLinks(), 4);
+        ASSERT_EQUAL_APPROX(steiner.cost, 4.7, 1e-9);
+        ASSERT_TRUE(steiner.node_to_children.at(0) == std::set<int64_t>({3}));
+        ASSERT_TRUE(steiner.node_to_children.at(3) == std::set<int64_t>({1}));
+        ASSERT_TRUE(steiner.node_to_children.at(1) == std::set<int64_t>({4, 5}));
+
+        // Source among the destinations, and a destination on the path of another
+        WeightedAdjacencyList line = multicast_tree_builder_test_graph(4, {
+            std::make_tuple(0, 1, 1.0), std::make_tuple(1, 2, 1.0), std::make_tuple(2, 3, 1.0)
+        });
+        MulticastTree spt_line = CreateObject<MulticastTreeBuilderSpt>()->BuildTree(line, 0, {0, 2, 3});
+        MulticastTree steiner_line = CreateObject<MulticastTreeBuilderSteiner>()->BuildTree(line, 0, {0, 2, 3});
+        ASSERT_EQUAL(spt_line.GetNumLinks(), 3);
+        ASSERT_EQUAL(steiner_line.GetNumLinks(), 3);
+        ASSERT_EQUAL_APPROX(steiner_line.cost, 3.0, 1e-9);
+
+        // Unreachable destination
+        WeightedAdjacencyList disconnected = multicast_tree_builder_test_graph(3, {std::make_tuple(0, 1, 1.0)});
+        ASSERT_EXCEPTION(CreateObject<MulticastTreeBuilderSpt>()->BuildTree(disconnected, 0, {2}));
+        ASSERT_EXCEPTION(CreateObject<MulticastTreeBuilderSteiner>()->BuildTree(disconnected, 0, {2}));
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
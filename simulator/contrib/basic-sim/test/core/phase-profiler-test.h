@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-simulation.h"
+#include "ns3/test.h"
+#include "../test-helpers.h"
+#include "ns3/phase-profiler.h"
+
+using namespace ns3;
+
+const std::string phase_profiler_test_dir = ".tmp-phase-profiler-test";
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class PhaseProfilerTestCase : public TestCase
+{
+public:
+    PhaseProfilerTestCase () : TestCase ("phase-profiler basic") {};
+    void DoRun () {
+
+        // Nested phases, the inner one allocating
+        PhaseProfiler profiler;
+        ASSERT_EXCEPTION(profiler.End());
+        {
+            ScopedPhase outer(profiler, "Outer \"phase\"");
+            {
+                ScopedPhase inner(profiler, "Inner");
+                std::vector<int*> allocated;
+                for (int i = 0; i < 1000; i++) {
+                    allocated.push_back(new int(i));
+                }
+                for (int* ptr : allocated) {
+                    delete ptr;
+                }
+            }
+            ScopedPhase sibling(profiler, "Sibling");
+            ASSERT_EQUAL(profiler.GetNumOpenPhases(), 2);
+        }
+        ASSERT_EQUAL(profiler.GetNumOpenPhases(), 0);
+        const std::vector<PhaseProfile>& phases = profiler.GetPhases();
+        ASSERT_EQUAL(phases.size(), 3);
+        ASSERT_EQUAL(phases[0].name, "Outer \"phase\"");
+        ASSERT_EQUAL(phases[0].depth, 0);
+        ASSERT_EQUAL(phases[1].name, "Inner");
+        ASSERT_EQUAL(phases[1].depth, 1);
+        ASSERT_EQUAL(phases[2].name, "Sibling");
+        ASSERT_EQUAL(phases[2].depth, 1);
+        if (PhaseProfiler::IsAllocationCountingEnabled()) {
+            ASSERT_TRUE(phases[1].num_allocations >= 1000);
+            ASSERT_TRUE(phases[0].num_allocations >= phases[1].num_allocations + phases[2].num_allocations);
+        } else {
+            for (const PhaseProfile& phase : phases) {
+                ASSERT_EQUAL(phase.num_allocations, 0);
+            }
+        }
+        for (const PhaseProfile& phase : phases) {
+            ASSERT_TRUE(phase.wall_ns >= 0);
+            ASSERT_TRUE(phase.cpu_ns >= 0);
+            ASSERT_TRUE(phase.peak_rss_delta_kib >= 0);
+        }
+        ASSERT_TRUE(phases[1].start_ns_since_epoch >= phases[0].start_ns_since_epoch);
+        ASSERT_TRUE(phases[2].start_ns_since_epoch >= phases[1].start_ns_since_epoch + phases[1].wall_ns);
+
+        // Text lines are indented by depth
+        std::vector<std::string> lines = profiler.FormatPhases(phases[0].start_ns_since_epoch);
+        ASSERT_EQUAL(lines.size(), 3);
+        ASSERT_TRUE(lines[0].find(":: Outer \"phase\" (CPU: ") != std::string::npos);
+        ASSERT_TRUE(lines[1].find("::   Inner (CPU: ") != std::string::npos);
+        ASSERT_EQUAL(lines[1].find("allocations: n/a") != std::string::npos, !PhaseProfiler::IsAllocationCountingEnabled());
+
+        // Chrome trace with one flat timestamp segment and the three phases
+        std::vector<std::pair<std::string, int64_t>> timestamps;
+        timestamps.push_back(std::make_pair("Start", phases[0].start_ns_since_epoch));
+        timestamps.push_back(std::make_pair("Everything", phases[0].start_ns_since_epoch + phases[0].wall_ns));
+        std::ostringstream trace;
+        profiler.WriteChromeTrace(trace, phases[0].start_ns_since_epoch, timestamps, 3);
+        std::string json = trace.str();
+        ASSERT_TRUE(json.find("\"name\":\"Outer \\\"phase\\\"\",\"ph\":\"X\",\"pid\":3,\"tid\":1,\"ts\":0.000,") != std::string::npos);
+        ASSERT_TRUE(json.find("\"name\":\"Everything\",\"ph\":\"X\",\"pid\":3,\"tid\":0,\"ts\":0.000,") != std::string::npos);
+        ASSERT_TRUE(json.find("\"name\":\"Start\"") == std::string::npos);
+        ASSERT_EQUAL(json.find("\"allocations\":") != std::string::npos, PhaseProfiler::IsAllocationCountingEnabled());
+
+        // Open phases are shown as not finished, and left out of the trace
+        PhaseProfiler unfinished;
+        unfinished.Begin("Never ends");
+        ASSERT_TRUE(unfinished.FormatPhases(0)[0].find("(not finished)") != std::string::npos);
+        std::ostringstream unfinished_trace;
+        unfinished.WriteChromeTrace(unfinished_trace, 0, timestamps, 0);
+        ASSERT_TRUE(unfinished_trace.str().find("Never ends") == std::string::npos);
+
+    }
+};
+
+class PhaseProfilerChromeTraceTestCase : public TestCase
+{
+public:
+    PhaseProfilerChromeTraceTestCase () : TestCase ("phase-profiler chrome-trace") {};
+    void DoRun () {
+        mkdir_if_not_exists(phase_profiler_test_dir);
+        std::ofstream config_file(phase_profiler_test_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=1000000" << std::endl;
+        config_file << "simulation_seed=123456789" << std::endl;
+        config_file << "enable_timing_results_chrome_trace=true" << std::endl;
+        config_file.close();
+
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(phase_profiler_test_dir);
+        {
+            ScopedPhase phase(basicSimulation->GetPhaseProfiler(), "Custom phase");
+        }
+        basicSimulation->Run();
+        basicSimulation->Finalize();
+
+        // Phases in both the text and the trace
+        std::vector<std::string> lines_txt = read_file_direct(phase_profiler_test_dir + "/logs_ns3/timing_results.txt");
+        std::vector<std::string> lines_json = read_file_direct(phase_profiler_test_dir + "/logs_ns3/timing_results.json");
+        bool txt_has_phases = false;
+        bool txt_has_run = false;
+        for (const std::string& line : lines_txt) {
+            txt_has_phases = txt_has_phases || line == "PHASES";
+            txt_has_run = txt_has_run || line.find(":: Run simulation (CPU: ") != std::string::npos;
+        }
+        ASSERT_TRUE(txt_has_phases);
+        ASSERT_TRUE(txt_has_run);
+        ASSERT_EQUAL(lines_json.front(), "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+        ASSERT_EQUAL(lines_json.back(), "]}");
+        bool json_has_custom = false;
+        bool json_has_destroy = false;
+        for (const std::string& line : lines_json) {
+            json_has_custom = json_has_custom || line.find("{\"name\":\"Custom phase\",\"ph\":\"X\",\"pid\":0,\"tid\":1,") != std::string::npos;
+            json_has_destroy = json_has_destroy || line.find("{\"name\":\"Destroy simulator\",\"ph\":\"X\",\"pid\":0,\"tid\":1,") != std::string::npos;
+        }
+        ASSERT_TRUE(json_has_custom);
+        ASSERT_TRUE(json_has_destroy);
+
+        remove_file_if_exists(phase_profiler_test_dir + "/config_ns3.properties");
+        remove_file_if_exists(phase_profiler_test_dir + "/logs_ns3/finished.txt");
+        remove_file_if_exists(phase_profiler_test_dir + "/logs_ns3/timing_results.txt");
+        remove_file_if_exists(phase_profiler_test_dir + "/logs_ns3/timing_results.csv");
+        remove_file_if_exists(phase_profiler_test_dir + "/logs_ns3/timing_results.json");
+        remove_dir_if_exists(phase_profiler_test_dir + "/logs_ns3");
+        remove_dir_if_exists(phase_profiler_test_dir);
+    }
+};
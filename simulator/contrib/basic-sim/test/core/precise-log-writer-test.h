@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-simulation.h"
+#include "ns3/test.h"
+#include "../test-helpers.h"
+#include "ns3/precise-log-writer.h"
+#include <unistd.h>
+
+using namespace ns3;
+
+const std::string precise_log_writer_test_dir = ".tmp-precise-log-writer-test";
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class PreciseLogWriterTestCase : public TestCase
+{
+public:
+    PreciseLogWriterTestCase () : TestCase ("precise-log-writer basic") {};
+    void DoRun () {
+        mkdir_if_not_exists(precise_log_writer_test_dir);
+        std::string filename_a = precise_log_writer_test_dir + "/udp_burst_0_outgoing.csv";
+        std::string filename_b = precise_log_writer_test_dir + "/udp_burst_1_incoming.csv";
+        std::string filename_c = precise_log_writer_test_dir + "/udp_burst_2_incoming.csv";
+
+        // Buffer must hold at least one record
+        ASSERT_EXCEPTION(CreateObject<PreciseLogWriter>(0));
+
+        // Interleaved appends to two files, many more records than fit in a buffer
+        Ptr<PreciseLogWriter> writer = CreateObject<PreciseLogWriter>(7);
+        uint32_t file_a = writer->OpenFile(filename_a);
+        uint32_t file_b = writer->OpenFile(filename_b);
+        uint32_t file_c = writer->OpenFile(filename_c);
+        for (int64_t i = 0; i < 1000; i++) {
+            writer->Append(file_a, 0, i, 1000 + i);
+            if (i % 3 == 0) {
+                writer->Append(file_b, 1, i / 3, 5000000000 + i);
+            }
+        }
+
+        // Cannot convert before it is closed
+        ASSERT_EXCEPTION(writer->ConvertToCsv());
+        writer->Close();
+        writer->Close(); // Closing twice is fine
+        ASSERT_EXCEPTION(writer->OpenFile(precise_log_writer_test_dir + "/other.csv"));
+        ASSERT_EQUAL(writer->GetNumRecordsWritten(), 1334);
+        ASSERT_EQUAL(writer->GetNumWrites(), 142 + 1 + 47 + 1); // Full buffers + the remainder of each file
+
+        // The CSVs have the same layout as if written directly
+        writer->ConvertToCsv();
+        ASSERT_FALSE(file_exists(filename_a + ".bin"));
+        std::vector<std::string> lines_a = read_file_direct(filename_a);
+        ASSERT_EQUAL(lines_a.size(), 1000);
+        for (int64_t i = 0; i < 1000; i++) {
+            ASSERT_EQUAL(lines_a[i], format_string("0,%" PRId64 ",%" PRId64, i, 1000 + i));
+        }
+        std::vector<std::string> lines_b = read_file_direct(filename_b);
+        ASSERT_EQUAL(lines_b.size(), 334);
+        ASSERT_EQUAL(lines_b[0], "1,0,5000000000");
+        ASSERT_EQUAL(lines_b[333], "1,333,5000000999");
+
+        // A file without any record is still created (empty)
+        ASSERT_TRUE(file_exists(filename_c));
+        ASSERT_EQUAL(read_file_direct(filename_c).size(), 0);
+
+        remove_file_if_exists(filename_a);
+        remove_file_if_exists(filename_b);
+        remove_file_if_exists(filename_c);
+        remove_dir_if_exists(precise_log_writer_test_dir);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class PreciseLogWriterWriteFailureTestCase : public TestCase
+{
+public:
+    PreciseLogWriterWriteFailureTestCase () : TestCase ("precise-log-writer write-failure") {};
+    void DoRun () {
+        mkdir_if_not_exists(precise_log_writer_test_dir);
+        std::string filename = precise_log_writer_test_dir + "/udp_burst_0_outgoing.csv";
+
+        // The binary file is /dev/full, to which every write fails (no space left)
+        ASSERT_EQUAL(symlink("/dev/full", (filename + ".bin").c_str()), 0);
+
+        // The error of the writer thread is thrown on this thread, either by a later hand-over or by closing
+        Ptr<PreciseLogWriter> writer = CreateObject<PreciseLogWriter>(7);
+        uint32_t file = writer->OpenFile(filename);
+        bool thrown = false;
+        try {
+            for (int64_t i = 0; i < 100000; i++) {
+                writer->Append(file, 0, i, i);
+            }
+            writer->Close();
+        } catch (const std::runtime_error& e) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+        writer->Close(); // Thrown only once
+
+        remove_file_if_exists(filename + ".bin");
+        remove_dir_if_exists(precise_log_writer_test_dir);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-simulation.h"
+#include "ns3/test.h"
+#include "../test-helpers.h"
+#include "ns3/profiling-scheduler.h"
+
+using namespace ns3;
+
+const std::string profiling_scheduler_test_dir = ".tmp-profiling-scheduler-test";
+
+std::vector<int64_t> profiling_scheduler_test_executed;
+
+void profiling_scheduler_test_record(int64_t value) {
+    profiling_scheduler_test_executed.push_back(value);
+}
+
+void profiling_scheduler_test_busy() {
+    volatile int64_t sum = 0;
+    for (int64_t i = 0; i < 1000000; i++) {
+        sum += i;
+    }
+    profiling_scheduler_test_executed.push_back(-1);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class ProfilingSchedulerTestCase : public TestCase
+{
+public:
+    ProfilingSchedulerTestCase () : TestCase ("profiling-scheduler basic") {};
+    void DoRun () {
+        mkdir_if_not_exists(profiling_scheduler_test_dir);
+        profiling_scheduler_test_executed.clear();
+
+        // Wrapping a heap scheduler
+        ObjectFactory schedulerFactory;
+        schedulerFactory.SetTypeId("ns3::ProfilingScheduler");
+        schedulerFactory.Set("WrappedSchedulerType", TypeIdValue(TypeId::LookupByName("ns3::HeapScheduler")));
+        Simulator::SetScheduler(schedulerFactory);
+        ProfilingScheduler* profilingScheduler = ProfilingScheduler::GetCurrent();
+        ASSERT_TRUE(profilingScheduler != nullptr);
+
+        // 5 recording events, 2 busy events and 1 cancelled event
+        for (int64_t i = 0; i < 5; i++) {
+            Simulator::Schedule(NanoSeconds(100 - i * 10), &profiling_scheduler_test_record, 100 - i * 10);
+        }
+        Simulator::Schedule(NanoSeconds(5), &profiling_scheduler_test_busy);
+        Simulator::Schedule(NanoSeconds(200), &profiling_scheduler_test_busy);
+        EventId cancelled = Simulator::Schedule(NanoSeconds(150), &profiling_scheduler_test_record, 150);
+        Simulator::Cancel(cancelled);
+        Simulator::Run();
+        profilingScheduler->StopProfiling();
+
+        // Executed in order
+        std::vector<int64_t> expected = {-1, 60, 70, 80, 90, 100, -1};
+        ASSERT_EQUAL(profiling_scheduler_test_executed.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            ASSERT_EQUAL(profiling_scheduler_test_executed[i], expected[i]);
+        }
+
+        // Profile ranked by total time: the busy ones take longest
+        std::vector<EventProfileEntry> profile = profilingScheduler->GetEventProfile();
+        ASSERT_EQUAL(profile.size(), 3);
+        ASSERT_EQUAL(profile[0].kind, "void (*)()");
+        ASSERT_EQUAL(profile[0].count, 2);
+        ASSERT_TRUE(profile[0].total_ns > 0);
+        ASSERT_EQUAL_APPROX(profile[0].mean_ns, profile[0].total_ns / 2, 0.001);
+        ASSERT_TRUE(profile[0].total_ns >= profile[1].total_ns);
+        ASSERT_TRUE(profile[1].total_ns >= profile[2].total_ns);
+        uint64_t num_record = 0;
+        uint64_t num_cancelled = 0;
+        for (const EventProfileEntry& entry : profile) {
+            if (entry.kind == "(cancelled)") {
+                num_cancelled = entry.count;
+            } else if (entry.kind != "void (*)()") {
+                num_record = entry.count;
+            }
+        }
+        ASSERT_EQUAL(num_record, 5);
+        ASSERT_EQUAL(num_cancelled, 1);
+
+        // Written to file, one line per kind
+        profilingScheduler->WriteEventProfile(profiling_scheduler_test_dir + "/event_profile.csv");
+        std::vector<std::string> lines = read_file_direct(profiling_scheduler_test_dir + "/event_profile.csv");
+        ASSERT_EQUAL(lines.size(), 3);
+        ASSERT_EQUAL(lines[0].substr(0, 4), "1,2,");
+        ASSERT_TRUE(lines[0].find(",\"void (*)()\"") != std::string::npos);
+
+        // Events removed after profiling has stopped are not counted
+        Simulator::Schedule(NanoSeconds(10), &profiling_scheduler_test_busy);
+        Simulator::Run();
+        ASSERT_EQUAL(profilingScheduler->GetEventProfile()[0].count, 2);
+
+        Simulator::Destroy();
+        ASSERT_TRUE(ProfilingScheduler::GetCurrent() == nullptr);
+
+        remove_file_if_exists(profiling_scheduler_test_dir + "/event_profile.csv");
+        remove_dir_if_exists(profiling_scheduler_test_dir);
+    }
+};
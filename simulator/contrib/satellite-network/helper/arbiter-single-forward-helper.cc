@@ -21,10 +21,31 @@
 
 namespace ns3 {
 
-ArbiterSingleForwardHelper::ArbiterSingleForwardHelper (Ptr<BasicSimulation> basicSimulation, NodeContainer nodes) {
+ArbiterSingleForwardHelper::ArbiterSingleForwardHelper (Ptr<BasicSimulation> basicSimulation, NodeContainer nodes)
+        : ArbiterSingleForwardHelper(basicSimulation, nodes, std::vector<MulticastUdpInfo>(), std::set<int64_t>()) {
+    // Left empty intentionally
+}
+
+ArbiterSingleForwardHelper::ArbiterSingleForwardHelper (Ptr<BasicSimulation> basicSimulation, NodeContainer nodes, const std::vector<MulticastUdpInfo>& multicast_reqs, const std::set<int64_t>& endpoints) {
     std::cout << "SETUP SINGLE FORWARDING ROUTING" << std::endl;
+    ScopedPhase phase(basicSimulation->GetPhaseProfiler(), "Setup single forwarding routing");
     m_basicSimulation = basicSimulation;
     m_nodes = nodes;
+    m_multicast_reqs = multicast_reqs;
+    m_num_multicast_tree_links = 0;
+    m_num_multicast_unreachable_dsts = 0;
+    m_endpoints = endpoints;
+    m_num_bier_neighbors = 0;
+
+    // Multicast mode: trees (state per group) or BIER (state per endpoint, carried bit string in each packet)
+    std::string multicast_mode = m_basicSimulation->GetConfigParamOrDefault("multicast_mode", "tree");
+    if (multicast_mode != "tree" && multicast_mode != "bier") {
+        throw std::invalid_argument("Unknown multicast mode: " + multicast_mode);
+    }
+    m_enable_bier = multicast_mode == "bier";
+    if (m_enable_bier) {
+        m_bier_bit_positions = bier_bit_positions(m_endpoints, m_nodes.GetN());
+    }
 
     // Read in initial forwarding state
     std::cout << "  > Create initial single forwarding state" << std::endl;
@@ -34,7 +55,7 @@ ArbiterSingleForwardHelper::ArbiterSingleForwardHelper (Ptr<BasicSimulation> bas
     // Set the routing arbiters
     std::cout << "  > Setting the routing arbiter on each node" << std::endl;
     for (size_t i = 0; i < m_nodes.GetN(); i++) {
-        Ptr<ArbiterSingleForward> arbiter = CreateObject<ArbiterSingleForward>(m_nodes.Get(i), m_nodes, initial_forwarding_state[i]);
+        Ptr<ArbiterSatMulticast> arbiter = CreateObject<ArbiterSatMulticast>(m_nodes.Get(i), m_nodes, initial_forwarding_state[i]);
         m_arbiters.push_back(arbiter);
         m_nodes.Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->SetArbiter(arbiter);
     }
@@ -44,9 +65,31 @@ ArbiterSingleForwardHelper::ArbiterSingleForwardHelper (Ptr<BasicSimulation> bas
     m_dynamicStateUpdateIntervalNs = parse_positive_int64(m_basicSimulation->GetConfigParamOrFail("dynamic_state_update_interval_ns"));
     std::cout << "  > Forward state update interval: " << m_dynamicStateUpdateIntervalNs << "ns" << std::endl;
     std::cout << "  > Perform first forwarding state load for t=0" << std::endl;
-    UpdateForwardingState(0);
+    {
+        ScopedPhase load_phase(basicSimulation->GetPhaseProfiler(), "Load forwarding state for t=0");
+        UpdateForwardingState(0);
+    }
     basicSimulation->RegisterTimestamp("Create initial single forwarding state");
 
+    // Joins and leaves only change the trees, the BIER source changes its own bit string
+    if (!m_enable_bier) {
+        for (size_t i = 0; i < m_multicast_reqs.size(); i++) {
+            for (const MulticastMembershipEvent& event : m_multicast_reqs[i].GetMembershipEvents()) {
+                Simulator::Schedule(NanoSeconds(event.time_ns), &ArbiterSingleForwardHelper::ApplyMembershipEvent, this, i, event.node_id, event.is_join);
+            }
+        }
+    }
+
+    // Multicast trees are derived from the forwarding state of each epoch
+    if (!m_multicast_reqs.empty() && m_enable_bier) {
+        std::cout << "  > BIER forwarding state for " << m_endpoints.size() << " endpoint(s) at t=0: "
+                  << m_num_bier_neighbors << " neighbor entries" << std::endl;
+    } else if (!m_multicast_reqs.empty()) {
+        std::cout << "  > Multicast trees for " << m_multicast_reqs.size() << " group(s) at t=0: "
+                  << m_num_multicast_tree_links << " links, "
+                  << m_num_multicast_unreachable_dsts << " unreachable destination(s)" << std::endl;
+    }
+
     std::cout << std::endl;
 }
 
@@ -163,6 +206,14 @@ void ArbiterSingleForwardHelper::UpdateForwardingState(int64_t t) {
         throw std::runtime_error(format_string("File %s could not be read.", filename.c_str()));
     }
 
+    // The multicast trees of this epoch replace those of the previous one in this same event,
+    // such that no packet is ever forwarded on a mix of trees of different epochs
+    if (m_enable_bier) {
+        UpdateBierForwardingState();
+    } else {
+        UpdateMulticastForwardingState();
+    }
+
     // Given that this code will only be used with satellite networks, this is okay-ish,
     // but it does create a very tight coupling between the two -- technically this class
     // can be used for other purposes as well
@@ -178,4 +229,141 @@ void ArbiterSingleForwardHelper::UpdateForwardingState(int64_t t) {
 
 }
 
+/**
+ * Calculate the multicast tree of every group from the current single forwarding state,
+ * and replace the multicast forwarding state of all arbiters at once.
+ *
+ * The tree of a group is the union of the forwarding paths from the source towards each
+ * destination. A path is grafted onto the tree at the last node it has in common with it,
+ * such that every node has a single parent. Destinations which cannot be reached
+ * in this epoch are left out of the tree until a later epoch.
+ */
+void ArbiterSingleForwardHelper::UpdateMulticastForwardingState() {
+    if (m_multicast_reqs.empty()) {
+        return;
+    }
+    size_t num_nodes = m_nodes.GetN();
+    std::vector<SatMulticastForwardingState> multicast_forwarding_state(num_nodes);
+    m_num_multicast_tree_links = 0;
+    m_num_multicast_unreachable_dsts = 0;
+    for (MulticastUdpInfo& req : m_multicast_reqs) {
+        uint32_t group = req.GetMulticastGroup().Get();
+        int32_t src_node_id = req.GetFromNodeId();
+
+        std::vector<bool> in_tree(num_nodes, false);
+        in_tree[src_node_id] = true;
+        std::vector<int32_t> path;
+        std::vector<std::tuple<int32_t, int32_t, int32_t>> path_hops;
+        for (int64_t dst_node_id : req.GetToNodeIds()) {
+            if (in_tree[dst_node_id]) {
+                continue;
+            }
+
+            // Path from the source towards the destination
+            path = {src_node_id};
+            path_hops.clear();
+            bool reachable = true;
+            while (path.back() != dst_node_id) {
+                std::tuple<int32_t, int32_t, int32_t> hop = m_arbiters.at(path.back())->GetSingleForwardState(dst_node_id);
+                if (std::get<0>(hop) < 0 || std::get<0>(hop) == src_node_id || path.size() > num_nodes) {
+                    reachable = false; // Drop, back through the source, or a loop
+                    break;
+                }
+                path.push_back(std::get<0>(hop));
+                path_hops.push_back(hop);
+            }
+            if (!reachable) {
+                m_num_multicast_unreachable_dsts++;
+                continue;
+            }
+
+            // Graft from the last node which is already in the tree
+            size_t graft_idx = 0;
+            for (size_t i = 0; i < path.size(); i++) {
+                if (in_tree[path[i]]) {
+                    graft_idx = i;
+                }
+            }
+            for (size_t i = graft_idx; i + 1 < path.size(); i++) {
+                AddMulticastNextHop(
+                        multicast_forwarding_state[path[i]],
+                        group,
+                        std::get<1>(path_hops[i]),
+                        std::get<0>(path_hops[i]),
+                        std::get<2>(path_hops[i])
+                );
+                in_tree[path[i + 1]] = true;
+                m_num_multicast_tree_links++;
+            }
+
+        }
+    }
+
+    // Swap in the new multicast forwarding state everywhere
+    for (size_t i = 0; i < num_nodes; i++) {
+        m_arbiters[i]->SetMulticastForwardingState(std::move(multicast_forwarding_state[i]));
+    }
+
+}
+
+/**
+ * Calculate the BIER bit masks of every node from the current single forwarding state:
+ * the bit of an endpoint is in the mask of the neighbor which is the next hop towards it.
+ * Unlike the trees, this state does not depend on the number of groups.
+ */
+void ArbiterSingleForwardHelper::UpdateBierForwardingState() {
+    if (m_multicast_reqs.empty()) {
+        return;
+    }
+    uint32_t num_words = bier_num_words(m_endpoints.size());
+    m_num_bier_neighbors = 0;
+    for (size_t i = 0; i < m_nodes.GetN(); i++) {
+        BierForwardingState state;
+        state.own_bit_position = m_bier_bit_positions[i];
+        for (int64_t endpoint : m_endpoints) {
+            if (endpoint == (int64_t) i) {
+                continue;
+            }
+            std::tuple<int32_t, int32_t, int32_t> hop = m_arbiters[i]->GetSingleForwardState(endpoint);
+            if (std::get<0>(hop) < 0) {
+                continue; // Unreachable in this epoch
+            }
+
+            // Neighbors are distinguished by interface and gateway, as a GSL is shared
+            uint32_t out_if_idx = std::get<1>(hop);
+            uint32_t gateway_ip_address = m_nodes.Get(std::get<0>(hop))->GetObject<Ipv4>()->GetAddress(std::get<2>(hop), 0).GetLocal().Get();
+            size_t n = 0;
+            while (n < state.neighbors.size() && !(state.neighbors[n].out_if_idx == out_if_idx && state.neighbors[n].gateway_ip_address == gateway_ip_address)) {
+                n++;
+            }
+            if (n == state.neighbors.size()) {
+                state.neighbors.push_back({out_if_idx, gateway_ip_address, std::vector<uint64_t>(num_words, 0)});
+            }
+            int64_t bit = m_bier_bit_positions[endpoint];
+            state.neighbors[n].forwarding_bit_mask[bit / 64] |= (1ULL << (bit % 64));
+        }
+        m_num_bier_neighbors += state.neighbors.size();
+        m_arbiters[i]->SetBierForwardingState(std::move(state));
+    }
+}
+
+/**
+ * A member joins or leaves: the trees are recalculated from the forwarding state of the current
+ * epoch right away (they are recalculated entirely every epoch anyway).
+ */
+void ArbiterSingleForwardHelper::ApplyMembershipEvent(size_t req_idx, int64_t node_id, bool is_join) {
+    if (is_join) {
+        m_multicast_reqs[req_idx].GetToNodeIds().insert(node_id);
+    } else {
+        m_multicast_reqs[req_idx].GetToNodeIds().erase(node_id);
+    }
+    UpdateMulticastForwardingState();
+}
+
+void ArbiterSingleForwardHelper::AddMulticastNextHop(SatMulticastForwardingState& state, uint32_t group, int32_t own_if_id, int32_t next_node_id, int32_t next_if_id) {
+    SatMulticastNextHops& next_hops = state[group];
+    next_hops.out_if_idxs.push_back(own_if_id);
+    next_hops.gateway_ip_addresses.push_back(m_nodes.Get(next_node_id)->GetObject<Ipv4>()->GetAddress(next_if_id, 0).GetLocal().Get());
+}
+
 } // namespace ns3
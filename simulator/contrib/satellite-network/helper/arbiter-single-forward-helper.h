@@ -25,6 +25,9 @@
 #include "ns3/topology-satellite-network.h"
 #include "ns3/ipv4-arbiter-routing.h"
 #include "ns3/arbiter-single-forward.h"
+#include "ns3/arbiter-sat-multicast.h"
+#include "ns3/multicast-udp-schedule-reader.h"
+#include "ns3/bier-header.h"
 #include "ns3/abort.h"
 
 namespace ns3 {
@@ -33,15 +36,31 @@ namespace ns3 {
     {
     public:
         ArbiterSingleForwardHelper(Ptr<BasicSimulation> basicSimulation, NodeContainer nodes);
+        ArbiterSingleForwardHelper(Ptr<BasicSimulation> basicSimulation, NodeContainer nodes, const std::vector<MulticastUdpInfo>& multicast_reqs, const std::set<int64_t>& endpoints);
     private:
         std::vector<std::vector<std::tuple<int32_t, int32_t, int32_t>>> InitialEmptyForwardingState();
         void UpdateForwardingState(int64_t t);
+        void UpdateMulticastForwardingState();
+        void UpdateBierForwardingState();
+        void ApplyMembershipEvent(size_t req_idx, int64_t node_id, bool is_join);
+        void AddMulticastNextHop(SatMulticastForwardingState& state, uint32_t group, int32_t own_if_id, int32_t next_node_id, int32_t next_if_id);
 
         // Parameters
         Ptr<BasicSimulation> m_basicSimulation;
         NodeContainer m_nodes;
         int64_t m_dynamicStateUpdateIntervalNs;
-        std::vector<Ptr<ArbiterSingleForward>> m_arbiters;
+        std::vector<Ptr<ArbiterSatMulticast>> m_arbiters;
+
+        // Multicast
+        std::vector<MulticastUdpInfo> m_multicast_reqs;
+        int64_t m_num_multicast_tree_links;
+        int64_t m_num_multicast_unreachable_dsts;
+
+        // BIER (stateless) multicast
+        bool m_enable_bier;
+        std::set<int64_t> m_endpoints;
+        std::vector<int64_t> m_bier_bit_positions;
+        int64_t m_num_bier_neighbors;
 
     };
 
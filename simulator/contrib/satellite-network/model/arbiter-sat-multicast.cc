@@ -12,9 +12,40 @@ TypeId ArbiterSatMulticast::GetTypeId (void)
     return tid;
 }
 
+ArbiterSatMulticast::ArbiterSatMulticast(
+        Ptr<Node> this_node,
+        NodeContainer nodes,
+        std::vector<std::tuple<int32_t, int32_t, int32_t>> next_hop_list
+) : ArbiterSingleForward(this_node, nodes, next_hop_list)
+{
+    // Left empty intentionally
+}
+
 ArbiterResult ArbiterSatMulticast::DecideMulticast(int32_t source_node_id, Ptr<const Packet> pkt, Ipv4Header const &ipHeader) {
-    throw std::runtime_error("not implement");
+    auto it = m_multicast_forwarding_state.find(ipHeader.GetDestination().Get());
+    if (it == m_multicast_forwarding_state.end() || it->second.out_if_idxs.empty()) {
+        return ArbiterResult(true, 0, 0); // No tree in the current epoch reaches this node
+    }
+    const SatMulticastNextHops& next_hops = it->second;
+
+    // Each next hop is addressed via its own gateway. The single out interface and gateway are
+    // only used by a source with one next hop, a source with more loops it back to replicate it.
+    ArbiterResult result = ArbiterResult(false, next_hops.out_if_idxs[0], next_hops.gateway_ip_addresses[0]);
+    result.SetIsMulticast(true);
+    result.SetIsMulticastOutbound(source_node_id == m_node_id);
+    result.SetOutIfIdxs(next_hops.out_if_idxs.data(), next_hops.out_if_idxs.size(), next_hops.gateway_ip_addresses.data());
+    return result;
 }
 
+void ArbiterSatMulticast::SetMulticastForwardingState(SatMulticastForwardingState multicast_forwarding_state) {
+    for (const std::pair<const uint32_t, SatMulticastNextHops>& entry : multicast_forwarding_state) {
+        NS_ABORT_MSG_IF(entry.second.out_if_idxs.size() != entry.second.gateway_ip_addresses.size(), "Each multicast out interface must have a gateway.");
+    }
+    m_multicast_forwarding_state = std::move(multicast_forwarding_state);
 }
 
+size_t ArbiterSatMulticast::GetNumMulticastGroups() {
+    return m_multicast_forwarding_state.size();
+}
+
+}
@@ -21,6 +21,8 @@
 #define ARBITER_SAT_MULTICAST_H
 
 #include <tuple>
+#include <map>
+#include <vector>
 #include "ns3/arbiter-satnet.h"
 #include "ns3/arbiter-single-forward.h"
 #include "ns3/topology-satellite-network.h"
@@ -32,6 +34,15 @@
 
 namespace ns3 {
 
+// Next hops of a multicast group at a node: out_if_idxs[i] is reached via gateway_ip_addresses[i]
+struct SatMulticastNextHops {
+    std::vector<uint32_t> out_if_idxs;
+    std::vector<uint32_t> gateway_ip_addresses;
+};
+
+// Multicast forwarding state of a node: group IP address -> next hops
+typedef std::map<uint32_t, SatMulticastNextHops> SatMulticastForwardingState;
+
 class ArbiterSatMulticast : public ArbiterSingleForward
 {
 public:
@@ -44,16 +55,16 @@ public:
             std::vector<std::tuple<int32_t, int32_t, int32_t>> next_hop_list
     );
 
-    // void AddMulticastRoute(Ipv4Address origin, Ipv4Address group, uint32_t inputInterface, std::vector<uint32_t> outputInterfaces);
-    // void SetMulticastRoutes(std::list<Ipv4MulticastRoutingTableEntry *> multicast_routes);
+    // Multicast next-hop implementation
     ArbiterResult DecideMulticast(int32_t source_node_id, Ptr<const Packet> pkt, Ipv4Header const &ipHeader);
 
-    // Static routing table
-    // std::string StringReprOfForwardingState();
-
+    // Updating of multicast forwarding state (replaces all groups at once)
+    void SetMulticastForwardingState(SatMulticastForwardingState multicast_forwarding_state);
+    size_t GetNumMulticastGroups();
 
 private:
-    std::list<Ipv4MulticastRoutingTableEntry *> m_multicast_routes;
+    SatMulticastForwardingState m_multicast_forwarding_state;
+
 };
 
 }
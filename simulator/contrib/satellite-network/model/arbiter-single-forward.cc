@@ -55,6 +55,10 @@ void ArbiterSingleForward::SetSingleForwardState(int32_t target_node_id, int32_t
     m_next_hop_list[target_node_id] = std::make_tuple(next_node_id, own_if_id, next_if_id);
 }
 
+std::tuple<int32_t, int32_t, int32_t> ArbiterSingleForward::GetSingleForwardState(int32_t target_node_id) {
+    return m_next_hop_list.at(target_node_id);
+}
+
 std::string ArbiterSingleForward::StringReprOfForwardingState() {
     std::ostringstream res;
     res << "Single-forward state of node " << m_node_id << std::endl;
@@ -54,6 +54,7 @@ public:
 
     // Updating of forward state
     void SetSingleForwardState(int32_t target_node_id, int32_t next_node_id, int32_t own_if_id, int32_t next_if_id);
+    std::tuple<int32_t, int32_t, int32_t> GetSingleForwardState(int32_t target_node_id);
 
     // Static routing table
     std::string StringReprOfForwardingState();
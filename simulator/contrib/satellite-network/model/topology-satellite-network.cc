@@ -21,6 +21,9 @@
 
 #include "topology-satellite-network.h"
 
+#include <algorithm>
+#include <sstream>
+
 namespace ns3 {
 
     NS_OBJECT_ENSURE_REGISTERED (TopologySatelliteNetwork);
@@ -47,6 +50,7 @@ namespace ns3 {
 
     void
     TopologySatelliteNetwork::Build(const Ipv4RoutingHelper& ipv4RoutingHelper) {
+        ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Build satellite network");
         std::cout << "SATELLITE NETWORK" << std::endl;
 
         // Initialize satellites
@@ -71,9 +75,6 @@ namespace ns3 {
         InstallInternetStacks(ipv4RoutingHelper);
         std::cout << "  > Installed Internet stacks" << std::endl;
 
-        // IP helper
-        m_ipv4_helper.SetBase ("10.0.0.0", "255.255.255.0");
-
         // Link settings
         m_isl_data_rate_megabit_per_s = parse_positive_double(m_basicSimulation->GetConfigParamOrFail("isl_data_rate_megabit_per_s"));
         m_gsl_data_rate_megabit_per_s = parse_positive_double(m_basicSimulation->GetConfigParamOrFail("gsl_data_rate_megabit_per_s"));
@@ -94,6 +95,13 @@ namespace ns3 {
         std::cout << "  > Creating GSLs" << std::endl;
         CreateGSLs();
 
+        // Check that no IP address was assigned twice
+        std::cout << "  > Validating IP addresses" << std::endl;
+        {
+            ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Validate IP addresses");
+            ValidateIpv4Addresses(m_allNodes);
+        }
+
         // ARP caches
         std::cout << "  > Populating ARP caches" << std::endl;
         PopulateArpCaches();
@@ -105,6 +113,7 @@ namespace ns3 {
     void
     TopologySatelliteNetwork::ReadSatellites()
     {
+        ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Read satellites");
 
         // Open file
         std::ifstream fs;
@@ -178,6 +187,7 @@ namespace ns3 {
     void
     TopologySatelliteNetwork::ReadGroundStations()
     {
+        ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Read ground stations");
 
         // Create a new file stream to open the file
         std::ifstream fs;
@@ -227,6 +237,7 @@ namespace ns3 {
 
     void
     TopologySatelliteNetwork::InstallInternetStacks(const Ipv4RoutingHelper& ipv4RoutingHelper) {
+        ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Install Internet stacks");
         InternetStackHelper internet;
         internet.SetRoutingHelper(ipv4RoutingHelper);
         internet.Install(m_allNodes);
@@ -235,6 +246,7 @@ namespace ns3 {
     void
     TopologySatelliteNetwork::ReadISLs()
     {
+        ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Read and create ISLs");
 
         // Link helper
         PointToPointLaserHelper p2p_laser_helper;
@@ -244,10 +256,6 @@ namespace ns3 {
         std::cout << "    >> ISL data rate........ " << m_isl_data_rate_megabit_per_s << " Mbit/s" << std::endl;
         std::cout << "    >> ISL max queue size... " << m_isl_max_queue_size_pkts << " packets" << std::endl;
 
-        // Traffic control helper
-        TrafficControlHelper tch_isl;
-        tch_isl.SetRootQueueDisc("ns3::FifoQueueDisc", "MaxSize", QueueSizeValue(QueueSize("1p"))); // Will be removed later any case
-
         // Open file
         std::ifstream fs;
         fs.open(m_satellite_network_dir + "/isls.txt");
@@ -271,18 +279,8 @@ namespace ns3 {
             c.Add(m_satelliteNodes.Get(sat1_id));
             NetDeviceContainer netDevices = p2p_laser_helper.Install(c);
 
-            // Install traffic control helper
-            tch_isl.Install(netDevices.Get(0));
-            tch_isl.Install(netDevices.Get(1));
-
             // Assign some IP address (nothing smart, no aggregation, just some IP address)
-            m_ipv4_helper.Assign(netDevices);
-            m_ipv4_helper.NewNetwork();
-
-            // Remove the traffic control layer (must be done here, else the Ipv4 helper will assign a default one)
-            TrafficControlHelper tch_uninstaller;
-            tch_uninstaller.Uninstall(netDevices.Get(0));
-            tch_uninstaller.Uninstall(netDevices.Get(1));
+            AssignIpv4Network(counter, netDevices);
 
             // Utilization tracking
             if (m_enable_isl_utilization_tracking) {
@@ -298,6 +296,7 @@ namespace ns3 {
             counter += 1;
         }
         fs.close();
+        m_num_isl_networks = counter;
 
         // Completed
         std::cout << "    >> Created " << std::to_string(counter) << " ISL(s)" << std::endl;
@@ -306,6 +305,7 @@ namespace ns3 {
 
     void
     TopologySatelliteNetwork::CreateGSLs() {
+        ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Create GSLs");
 
         // Link helper
         GSLHelper gsl_helper;
@@ -315,10 +315,6 @@ namespace ns3 {
         std::cout << "    >> GSL data rate........ " << m_gsl_data_rate_megabit_per_s << " Mbit/s" << std::endl;
         std::cout << "    >> GSL max queue size... " << m_gsl_max_queue_size_pkts << " packets" << std::endl;
 
-        // Traffic control helper
-        TrafficControlHelper tch_gsl;
-        tch_gsl.SetRootQueueDisc("ns3::FifoQueueDisc", "MaxSize", QueueSizeValue(QueueSize("1p")));  // Will be removed later any case
-
         // Check that the file exists
         std::string filename = m_satellite_network_dir + "/gsl_interfaces_info.txt";
         if (!file_exists(filename)) {
@@ -355,54 +351,12 @@ namespace ns3 {
         NetDeviceContainer devices = gsl_helper.Install(m_satelliteNodes, m_groundStationNodes, node_gsl_if_info);
         std::cout << "    >> Finished install GSL interfaces (interfaces, network devices, one shared channel)" << std::endl;
 
-        // Install queueing disciplines
-        tch_gsl.Install(devices);
-        std::cout << "    >> Finished installing traffic control layer qdisc which will be removed later" << std::endl;
-
-        // Assign IP addresses
-        //
-        // This is slow because of an inefficient implementation, if you want to speed it up, you can need to edit:
-        // src/internet/helper/ipv4-address-helper.cc
-        //
-        // And then within function Ipv4AddressHelper::NewAddress (void), comment out:
-        // Ipv4AddressGenerator::AddAllocated (addr);
-        //
-        // Beware that if you do this, and there are IP assignment conflicts, they are not detected.
-        //
-        std::cout << "    >> Assigning IP addresses..." << std::endl;
-        std::cout << "       (with many interfaces, this can take long due to an inefficient IP assignment conflict checker)" << std::endl;
-        std::cout << "       Progress (as there are more entries, it becomes slower):" << std::endl;
-        int64_t start_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-        int64_t last_time_ns = start_time_ns;
+        // Assign IP addresses, each GSL interface its own network after the ones of the ISLs
         for (uint32_t i = 0; i < devices.GetN(); i++) {
-
-            // Assign IPv4 address
-            m_ipv4_helper.Assign(devices.Get(i));
-            m_ipv4_helper.NewNetwork();
-
-            // Give a progress update if at an even 10%
-            int update_interval = (int) std::ceil(devices.GetN() / 10.0);
-            if (((i + 1) % update_interval) == 0 || (i + 1) == devices.GetN()) {
-                int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-                printf("       - %.2f%% (t = %.2f s, update took %.2f s)\n",
-                    (float) (i + 1) / (float) devices.GetN() * 100.0,
-                    (now_ns - start_time_ns) / 1e9,
-                    (now_ns - last_time_ns) / 1e9
-                );
-                last_time_ns = now_ns;
-            }
-
+            AssignIpv4Network(m_num_isl_networks + i, NetDeviceContainer(devices.Get(i)));
         }
         std::cout << "    >> Finished assigning IPs" << std::endl;
 
-        // Remove the traffic control layer (must be done here, else the Ipv4 helper will assign a default one)
-        TrafficControlHelper tch_uninstaller;
-        std::cout << "    >> Removing traffic control layers (qdiscs)..." << std::endl;
-        for (uint32_t i = 0; i < devices.GetN(); i++) {
-            tch_uninstaller.Uninstall(devices.Get(i));
-        }
-        std::cout << "    >> Finished removing GSL queueing disciplines" << std::endl;
-
         // Check that all interfaces were created
         NS_ABORT_MSG_IF(total_num_gsl_ifs != devices.GetN(), "Not the expected amount of interfaces has been created.");
 
@@ -410,8 +364,67 @@ namespace ns3 {
 
     }
 
+    /**
+     * Assign the addresses of a /24 network directly to the Ipv4 interfaces of the devices,
+     * the i-th device getting host i + 1. The network follows from its index: 10.0.0.0/24 + index,
+     * which is the same as the Ipv4AddressHelper with base 10.0.0.0/24 and a new network each time.
+     *
+     * Unlike the Ipv4AddressHelper, it neither checks every address against all the ones allocated
+     * before (which becomes slow with many interfaces), nor installs a traffic control layer (qdisc).
+     * Conflicts are instead checked once afterwards by ValidateIpv4Addresses(nodes).
+     *
+     * @param network_index     Index of the network
+     * @param devices           Network devices (at most 254)
+     */
+    void
+    TopologySatelliteNetwork::AssignIpv4Network(uint32_t network_index, const NetDeviceContainer& devices) {
+        if (network_index >= (uint32_t) ((127 - 10) << 16)) {
+            throw std::runtime_error(format_string("Too many networks: network index %u is beyond 126.255.255.0/24", network_index));
+        }
+        uint32_t network = Ipv4Address("10.0.0.0").Get() + (network_index << 8);
+        for (uint32_t i = 0; i < devices.GetN(); i++) {
+            Ptr<NetDevice> device = devices.Get(i);
+            Ptr<Ipv4> ipv4 = device->GetNode()->GetObject<Ipv4>();
+            int32_t interface = ipv4->GetInterfaceForDevice(device);
+            if (interface == -1) {
+                interface = ipv4->AddInterface(device);
+            }
+            ipv4->AddAddress(interface, Ipv4InterfaceAddress(Ipv4Address(network + i + 1), Ipv4Mask("255.255.255.0")));
+            ipv4->SetMetric(interface, 1);
+            ipv4->SetUp(interface);
+        }
+    }
+
+    /**
+     * Check in a single sorted pass that no IP address is assigned to more than one interface
+     * (the loop-back interfaces excepted).
+     *
+     * @param nodes     Nodes with an Ipv4 stack
+     */
+    void
+    TopologySatelliteNetwork::ValidateIpv4Addresses(const NodeContainer& nodes) {
+        std::vector<uint32_t> addresses;
+        for (uint32_t i = 0; i < nodes.GetN(); i++) {
+            Ptr<Ipv4> ipv4 = nodes.Get(i)->GetObject<Ipv4>();
+            for (uint32_t j = 1; j < ipv4->GetNInterfaces(); j++) {
+                for (uint32_t k = 0; k < ipv4->GetNAddresses(j); k++) {
+                    addresses.push_back(ipv4->GetAddress(j, k).GetLocal().Get());
+                }
+            }
+        }
+        std::sort(addresses.begin(), addresses.end());
+        for (size_t i = 1; i < addresses.size(); i++) {
+            if (addresses[i] == addresses[i - 1]) {
+                std::ostringstream address;
+                Ipv4Address(addresses[i]).Print(address);
+                throw std::runtime_error("IP address " + address.str() + " is assigned more than once");
+            }
+        }
+    }
+
     void
     TopologySatelliteNetwork::PopulateArpCaches() {
+        ScopedPhase phase(m_basicSimulation->GetPhaseProfiler(), "Populate ARP caches");
 
         // ARP lookups hinder performance, and actually won't succeed, so to prevent that from happening,
         // all GSL interfaces' IPs are added into an ARP cache
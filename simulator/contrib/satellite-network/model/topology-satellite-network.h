@@ -87,6 +87,9 @@ namespace ns3 {
         // Post-processing
         void CollectUtilizationStatistics();
 
+        // IP address checks
+        static void ValidateIpv4Addresses(const NodeContainer& nodes);
+
     private:
 
         // Build functions
@@ -102,7 +105,7 @@ namespace ns3 {
         void EnsureValidNodeId(uint32_t node_id);
 
         // Routing
-        Ipv4AddressHelper m_ipv4_helper;
+        void AssignIpv4Network(uint32_t network_index, const NetDeviceContainer& devices);
         void PopulateArpCaches();
 
         // Input
@@ -124,6 +127,9 @@ namespace ns3 {
         NetDeviceContainer m_islNetDevices;
         std::vector<std::pair<int32_t, int32_t>> m_islFromTo;
 
+        // IP addresses
+        uint32_t m_num_isl_networks;                        //!< Number of /24 networks assigned to ISLs
+
         // Values
         double m_isl_data_rate_megabit_per_s;
         double m_gsl_data_rate_megabit_per_s;
@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <map>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <ctime>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <chrono>
+#include <stdexcept>
+
+#include "ns3/basic-simulation.h"
+#include "ns3/multicast-udp-scheduler.h"
+#include "ns3/topology-satellite-network.h"
+#include "ns3/tcp-optimizer.h"
+#include "ns3/arbiter-single-forward-helper.h"
+#include "ns3/ipv4-arbiter-routing-helper.h"
+#include "ns3/gsl-if-bandwidth-helper.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class EndToEndMulticastTestCase : public TestCase {
+public:
+    EndToEndMulticastTestCase (std::string multicast_mode)
+            : TestCase (multicast_mode == "tree" ? "end-to-end-multicast" : "end-to-end-multicast-" + multicast_mode),
+              m_multicast_mode(multicast_mode) {};
+
+    void DoRun () {
+
+        const std::string temp_dir = ".tmp-end-to-end-multicast-" + m_multicast_mode + "-test";
+        const std::string dyn_state_dir = temp_dir + "/dynamic_state";
+
+        // Create temporary run directory
+        mkdir_if_not_exists(temp_dir);
+        mkdir_if_not_exists(dyn_state_dir);
+
+        // A configuration file
+        std::ofstream config_file;
+        config_file.open (temp_dir + "/config_ns3.properties");
+        int64_t simulation_end_time_ns = 4000000000; // 4s
+        config_file << "simulation_end_time_ns=" << simulation_end_time_ns << std::endl;
+        config_file << "simulation_seed=987654321" << std::endl;
+        config_file << "satellite_network_dir=." << std::endl;
+        config_file << "satellite_network_routes_dir=dynamic_state" << std::endl;
+        config_file << "isl_data_rate_megabit_per_s=4.00" << std::endl;
+        config_file << "gsl_data_rate_megabit_per_s=10.00" << std::endl;
+        config_file << "isl_max_queue_size_pkts=80" << std::endl;
+        config_file << "gsl_max_queue_size_pkts=75" << std::endl;
+        config_file << "enable_isl_utilization_tracking=false" << std::endl;
+        config_file << "dynamic_state_update_interval_ns=100000000" << std::endl;
+        config_file << "enable_multicast_udp_scheduler=true" << std::endl;
+        config_file << "multicast_udp_schedule_filename=multicast_udp_schedule.csv" << std::endl;
+        config_file << "multicast_mode=" << m_multicast_mode << std::endl;
+        config_file.close();
+
+        // Topology
+        //
+        // Satellites:               0 ----- 1        2
+        //                          ||       ||       |
+        //                   ( ......... GSL channel ......... )
+        //                    ||    |               |    |
+        // Ground stations:   3     4               5    6
+
+        // Multicast UDP schedule: 3 -> {5, 6} at 3 Mbit/s (less than the ISL rate)
+        std::ofstream multicast_udp_schedule_file;
+        multicast_udp_schedule_file.open (temp_dir + "/multicast_udp_schedule.csv");
+        multicast_udp_schedule_file << "0,3,2,5 6,3,0,4000000000,," << std::endl;
+        multicast_udp_schedule_file.close();
+
+        // TLES
+        std::ofstream tles_file;
+        tles_file.open (temp_dir + "/tles.txt");
+        tles_file << "1 3" << std::endl;
+        tles_file << "Starlink-550 0" << std::endl; // 1477
+        tles_file << "1 01478U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    03" << std::endl;
+        tles_file << "2 01478  53.0000 335.0000 0000001   0.0000  57.2727 15.19000000    08" << std::endl;
+        tles_file << "Starlink-550 1" << std::endl; // 1499
+        tles_file << "1 01500U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    09" << std::endl;
+        tles_file << "2 01500  53.0000 340.0000 0000001   0.0000  49.0909 15.19000000    01" << std::endl;
+        tles_file << "Starlink-550 2" << std::endl; // 1543
+        tles_file << "1 01544U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    07" << std::endl;
+        tles_file << "2 01544  53.0000 350.0000 0000001   0.0000  49.0909 15.19000000    00" << std::endl;
+        tles_file.close();
+
+        // ISLs
+        std::ofstream isls_file;
+        isls_file.open (temp_dir + "/isls.txt");
+        isls_file << "0 1" << std::endl;
+        isls_file.close();
+
+        // Ground stations
+        std::ofstream ground_stations_file;
+        ground_stations_file.open (temp_dir + "/ground_stations.txt");
+        ground_stations_file << "0,New-York-Newark,40.717042,-74.003663,0.000000,1334103.172127,-4653693.528901,4138656.197504" << std::endl;
+        ground_stations_file << "1,New-York-Newark,40.717042,-74.003663,0.000000,1334103.172127,-4653693.528901,4138656.197504" << std::endl;
+        ground_stations_file << "2,Atlanta,33.760000,-84.400000,0.000000,517979.453140,-5282763.124122,3524344.845288" << std::endl;
+        ground_stations_file << "3,Atlanta,33.760000,-84.400000,0.000000,517979.453140,-5282763.124122,3524344.845288" << std::endl;
+        ground_stations_file.close();
+
+        // GSL interfaces info
+        std::ofstream gsl_interfaces_info_file;
+        gsl_interfaces_info_file.open (temp_dir + "/gsl_interfaces_info.txt");
+
+        // Satellites GSL interfaces info
+        gsl_interfaces_info_file << "0,2,2.0" << std::endl;
+        gsl_interfaces_info_file << "1,2,2.0" << std::endl;
+        gsl_interfaces_info_file << "2,1,1.0" << std::endl;
+
+        // Ground station GSL interfaces info
+        gsl_interfaces_info_file << "3,2,1.0" << std::endl;
+        gsl_interfaces_info_file << "4,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "5,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "6,1,1.0" << std::endl;
+
+        gsl_interfaces_info_file.close();
+
+        // Dynamic state
+        //
+        // Until t=2s:  3 -> 0 -> 1 -> {5, 6}       (satellite 1 sends a copy to each over its GSL)
+        // From t=2s:   3 -> {0 -> 5, 1 -> 6}       (the source itself sends a copy over each of its GSL interfaces)
+        for (int64_t i = 0; i < simulation_end_time_ns; i += 100000000) {
+            std::ofstream fstate_file;
+            fstate_file.open (dyn_state_dir + "/fstate_" + std::to_string(i) + ".txt");
+            if (i == 0) {
+                fstate_file << "3,5,0,0,1" << std::endl;
+                fstate_file << "3,6,0,0,1" << std::endl;
+                fstate_file << "0,5,1,0,0" << std::endl;
+                fstate_file << "0,6,1,0,0" << std::endl;
+                fstate_file << "1,5,5,1,0" << std::endl;
+                fstate_file << "1,6,6,1,0" << std::endl;
+            } else if (i == 2000000000) {
+                fstate_file << "3,6,1,1,1" << std::endl;
+                fstate_file << "0,5,5,1,0" << std::endl;
+                fstate_file << "0,6,-1,-1,-1" << std::endl;
+            }
+            fstate_file.close();
+
+            std::ofstream gsl_if_bandwidth_file;
+            gsl_if_bandwidth_file.open (dyn_state_dir + "/gsl_if_bandwidth_" + std::to_string(i) + ".txt");
+            gsl_if_bandwidth_file.close();
+        }
+
+        // Load basic simulation environment
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+
+        // Optimize TCP
+        TcpOptimizer::OptimizeBasic(basicSimulation);
+
+        // Read topology, schedule multicast and install routing arbiters
+        Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        MulticastUdpScheduler multicastUdpScheduler(basicSimulation, topology); // Requires enable_multicast_udp_scheduler=true
+        ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes(), multicastUdpScheduler.GetMulticastReqs(), topology->GetEndpoints());
+        GslIfBandwidthHelper gslIfBandwidthHelper(basicSimulation, topology->GetNodes());
+
+        // Run simulation
+        basicSimulation->Run();
+
+        // Write multicast UDP results
+        multicastUdpScheduler.WriteResults();
+
+        // Both members receive the full stream across the tree change
+        std::vector<std::string> lines_incoming_csv = read_file_direct(temp_dir + "/logs_ns3/multicast_udp_incoming.csv");
+        ASSERT_EQUAL(lines_incoming_csv.size(), 2);
+        std::set<int64_t> dst_node_ids;
+        for (std::string line : lines_incoming_csv) {
+            std::vector<std::string> line_spl = split_string(line, ",");
+            ASSERT_EQUAL(parse_int64(line_spl[0]), 0);
+            ASSERT_EQUAL(parse_int64(line_spl[1]), 3);
+            dst_node_ids.insert(parse_int64(line_spl[2]));
+            ASSERT_EQUAL_APPROX(parse_positive_double(line_spl[6]), 3.0, 0.1);
+        }
+        ASSERT_EQUAL(dst_node_ids.size(), 2);
+        ASSERT_TRUE(dst_node_ids.find(5) != dst_node_ids.end());
+        ASSERT_TRUE(dst_node_ids.find(6) != dst_node_ids.end());
+
+        // Finalize the simulation
+        basicSimulation->Finalize();
+
+        // Clean up the run directory
+        remove_file_if_exists(temp_dir + "/config_ns3.properties");
+        remove_file_if_exists(temp_dir + "/multicast_udp_schedule.csv");
+        remove_file_if_exists(temp_dir + "/tles.txt");
+        remove_file_if_exists(temp_dir + "/isls.txt");
+        remove_file_if_exists(temp_dir + "/ground_stations.txt");
+        remove_file_if_exists(temp_dir + "/gsl_interfaces_info.txt");
+        for (int64_t i = 0; i < simulation_end_time_ns; i += 100000000) {
+            remove_file_if_exists(dyn_state_dir + "/fstate_" + std::to_string(i) + ".txt");
+            remove_file_if_exists(dyn_state_dir + "/gsl_if_bandwidth_" + std::to_string(i) + ".txt");
+        }
+        remove_dir_if_exists(dyn_state_dir);
+        remove_file_if_exists(temp_dir + "/logs_ns3/finished.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/timing_results.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/multicast_udp_outgoing.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/multicast_udp_outgoing.txt");
+        remove_file_if_exists(temp_dir + "/logs_ns3/multicast_udp_incoming.csv");
+        remove_file_if_exists(temp_dir + "/logs_ns3/multicast_udp_incoming.txt");
+        remove_dir_if_exists(temp_dir + "/logs_ns3");
+        remove_dir_if_exists(temp_dir);
+
+    }
+
+private:
+    std::string m_multicast_mode; // Trees or BIER, which must deliver the same
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
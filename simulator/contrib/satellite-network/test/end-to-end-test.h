@@ -47,6 +47,18 @@ public:
         ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes());
         GslIfBandwidthHelper gslIfBandwidthHelper(basicSimulation, topology->GetNodes());
 
+        // IP addresses: each ISL its own /24 network (first ISL is 0-1, second 0-4)
+        ASSERT_EQUAL(topology->GetNodes().Get(0)->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal(), Ipv4Address("10.0.0.1"));
+        ASSERT_EQUAL(topology->GetNodes().Get(1)->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal(), Ipv4Address("10.0.0.2"));
+        ASSERT_EQUAL(topology->GetNodes().Get(0)->GetObject<Ipv4>()->GetAddress(2, 0).GetLocal(), Ipv4Address("10.0.1.1"));
+        ASSERT_EQUAL(topology->GetNodes().Get(4)->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal(), Ipv4Address("10.0.1.2"));
+
+        // GSL interfaces: each its own /24 network after those of the 20 ISLs, first of the 17 satellites
+        // (satellite 0 has two ISLs, so its GSL interface is the third), then of the ground stations
+        ASSERT_EQUAL(topology->GetNodes().Get(0)->GetObject<Ipv4>()->GetAddress(3, 0).GetLocal(), Ipv4Address("10.0.20.1"));
+        ASSERT_EQUAL(topology->GetNodes().Get(17)->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal(), Ipv4Address("10.0.37.1"));
+        ASSERT_EQUAL(topology->GetNodes().Get(18)->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal(), Ipv4Address("10.0.38.1"));
+
         // Schedule UDP bursts
         UdpBurstScheduler udpBurstScheduler(basicSimulation, topology); // Requires enable_udp_burst_scheduler=true
 
@@ -0,0 +1,60 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/basic-simulation.h"
+#include "ns3/topology-satellite-network.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/point-to-point-helper.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class Ipv4AddressValidationTestCase : public TestCase {
+public:
+    Ipv4AddressValidationTestCase () : TestCase ("ipv4-address-validation") {};
+
+    void DoRun () {
+
+        // Three nodes in a line: 0 -- 1 -- 2
+        NodeContainer nodes;
+        nodes.Create(3);
+        InternetStackHelper internet;
+        internet.Install(nodes);
+        PointToPointHelper p2p;
+        NetDeviceContainer devices_01 = p2p.Install(nodes.Get(0), nodes.Get(1));
+        NetDeviceContainer devices_12 = p2p.Install(nodes.Get(1), nodes.Get(2));
+        std::vector<std::pair<Ptr<NetDevice>, Ipv4Address>> device_addresses = {
+                {devices_01.Get(0), Ipv4Address("10.0.0.1")},
+                {devices_01.Get(1), Ipv4Address("10.0.0.2")},
+                {devices_12.Get(0), Ipv4Address("10.0.1.1")},
+                {devices_12.Get(1), Ipv4Address("10.0.1.2")},
+        };
+        for (std::pair<Ptr<NetDevice>, Ipv4Address> p : device_addresses) {
+            Ptr<Ipv4> ipv4 = p.first->GetNode()->GetObject<Ipv4>();
+            uint32_t interface = ipv4->AddInterface(p.first);
+            ipv4->AddAddress(interface, Ipv4InterfaceAddress(p.second, Ipv4Mask("255.255.255.0")));
+        }
+
+        // All distinct (the loop-back address of every node is not taken into account)
+        TopologySatelliteNetwork::ValidateIpv4Addresses(nodes);
+
+        // Node 2 gets the address of node 0 as a second address
+        Ptr<Ipv4> ipv4_2 = nodes.Get(2)->GetObject<Ipv4>();
+        ipv4_2->AddAddress(ipv4_2->GetInterfaceForDevice(devices_12.Get(1)), Ipv4InterfaceAddress(Ipv4Address("10.0.0.1"), Ipv4Mask("255.255.255.0")));
+        ASSERT_EXCEPTION(TopologySatelliteNetwork::ValidateIpv4Addresses(nodes));
+
+        // Not a conflict without node 0
+        NodeContainer nodes_12;
+        nodes_12.Add(nodes.Get(1));
+        nodes_12.Add(nodes.Get(2));
+        TopologySatelliteNetwork::ValidateIpv4Addresses(nodes_12);
+
+        Simulator::Destroy();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
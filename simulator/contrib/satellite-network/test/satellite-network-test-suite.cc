@@ -7,6 +7,8 @@
 #include "satellite-info-test.h"
 #include "ground-station-info-test.h"
 #include "end-to-end-special-test.h"
+#include "end-to-end-multicast-test.h"
+#include "ipv4-address-validation-test.h"
 
 using namespace ns3;
 
@@ -17,6 +19,8 @@ public:
         // Running it complete with reading in files etc.
         AddTestCase(new EndToEndTestCase, TestCase::QUICK);
         AddTestCase(new EndToEndSpecialTestCase, TestCase::QUICK);
+        AddTestCase(new EndToEndMulticastTestCase("tree"), TestCase::QUICK);
+        AddTestCase(new EndToEndMulticastTestCase("bier"), TestCase::QUICK);
 
         // Running it by creating every component manually (not using satellite-network.cc/h)
         AddTestCase(new ManualTwoSatTwoGsFirstTest, TestCase::QUICK);
@@ -31,6 +35,9 @@ public:
         AddTestCase(new SatelliteInfoTestCase, TestCase::QUICK);
         AddTestCase(new GroundStationInfoTestCase, TestCase::QUICK);
 
+        // IP addresses
+        AddTestCase(new Ipv4AddressValidationTestCase, TestCase::QUICK);
+
     }
 };
 static SatelliteNetworkTestSuite SatelliteNetworkTestSuite;
@@ -16,6 +16,7 @@
 #include "ns3/udp-burst-scheduler.h"
 #include "ns3/multicast-udp-scheduler.h"
 #include "ns3/pingmesh-scheduler.h"
+#include "ns3/trace-replay-scheduler.h"
 #include "ns3/tcp-optimizer.h"
 #include "ns3/ipv4-arbiter-routing-helper.h"
 
@@ -24,6 +25,8 @@
 #include "ns3/ptop-link-utilization-tracker-helper.h"
 #include "ns3/ptop-link-queue-tracker-helper.h"
 #include "ns3/arbiter-multicast-helper.h"
+#include "ns3/multicast-trace-helper.h"
+#include "ns3/multicast-efficiency-helper.h"
 // #include "ns3/ptop-queue-utilization-tracker-helper.h"
 
 using namespace ns3;
@@ -55,6 +58,12 @@ int main(int argc, char *argv[]) {
     std::vector<MulticastUdpInfo> multicast_reqs = multicastUdpScheduler.GetMulticastReqs();
     ArbiterMulticastHelper arbiterHelper(basicSimulation, topology, multicast_reqs);
 
+    // Install multicast forwarding trace
+    MulticastTraceHelper multicastTraceHelper(basicSimulation, topology); // Requires enable_multicast_trace=true
+
+    // Install multicast replication accounting
+    MulticastEfficiencyHelper multicastEfficiencyHelper(basicSimulation, topology, arbiterHelper); // Requires enable_multicast_efficiency_accounting=true
+
     // Install link utilization trackers
     PtopLinkUtilizationTrackerHelper linkUtilizationTrackerHelper = PtopLinkUtilizationTrackerHelper(basicSimulation, topology); // Requires enable_link_utilization_tracking=true
 
@@ -73,6 +82,9 @@ int main(int argc, char *argv[]) {
     // Schedule pings
     PingmeshScheduler pingmeshScheduler(basicSimulation, topology); // Requires enable_pingmesh_scheduler=true
 
+    // Replay packet trace
+    TraceReplayScheduler traceReplayScheduler(basicSimulation, topology); // Requires enable_trace_replay_scheduler=true
+
     // Run simulation
     basicSimulation->Run();
 
@@ -83,16 +95,23 @@ int main(int argc, char *argv[]) {
     udpBurstScheduler.WriteResults();
 
     multicastUdpScheduler.WriteResults();
+    multicastEfficiencyHelper.WriteResults(multicastUdpScheduler);
 
     // Write pingmesh results
     pingmeshScheduler.WriteResults();
 
+    // Write trace replay results
+    traceReplayScheduler.WriteResults();
+
     // Write link utilization results
     linkUtilizationTrackerHelper.WriteResults();
 
     // Write link queue results
     linkQueueTrackerHelper.WriteResults();
 
+    // Write multicast forwarding trace
+    multicastTraceHelper.WriteResults();
+
     // Finalize the simulation
     basicSimulation->Finalize();
 
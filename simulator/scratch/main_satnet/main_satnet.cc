@@ -34,6 +34,9 @@
 #include "ns3/tcp-flow-scheduler.h"
 #include "ns3/udp-burst-scheduler.h"
 #include "ns3/pingmesh-scheduler.h"
+#include "ns3/trace-replay-scheduler.h"
+#include "ns3/multicast-udp-scheduler.h"
+#include "ns3/multicast-trace-helper.h"
 #include "ns3/tcp-optimizer.h"
 #include "ns3/ipv4-arbiter-routing-helper.h"
 
@@ -71,9 +74,13 @@ int main(int argc, char *argv[]) {
 
     // Read topology, and install routing arbiters
     Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
-    ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes());
+    MulticastUdpScheduler multicastUdpScheduler(basicSimulation, topology); // must be before of ArbiterSingleForwardHelper init to pass multicast_reqs
+    ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes(), multicastUdpScheduler.GetMulticastReqs(), topology->GetEndpoints());
     GslIfBandwidthHelper gslIfBandwidthHelper(basicSimulation, topology->GetNodes()); 
 
+    // Install multicast forwarding trace
+    MulticastTraceHelper multicastTraceHelper(basicSimulation, topology); // Requires enable_multicast_trace=true
+
     // Schedule flows
     TcpFlowScheduler tcpFlowScheduler(basicSimulation, topology); // Requires enable_tcp_flow_scheduler=true
 
@@ -83,6 +90,9 @@ int main(int argc, char *argv[]) {
     // Schedule pings
     PingmeshScheduler pingmeshScheduler(basicSimulation, topology); // Requires enable_pingmesh_scheduler=true
 
+    // Replay packet trace
+    TraceReplayScheduler traceReplayScheduler(basicSimulation, topology); // Requires enable_trace_replay_scheduler=true
+
     // Run simulation
     basicSimulation->Run();
 
@@ -95,6 +105,15 @@ int main(int argc, char *argv[]) {
     // Write pingmesh results
     pingmeshScheduler.WriteResults();
 
+    // Write trace replay results
+    traceReplayScheduler.WriteResults();
+
+    // Write multicast UDP results
+    multicastUdpScheduler.WriteResults();
+
+    // Write multicast forwarding trace
+    multicastTraceHelper.WriteResults();
+
     // Collect utilization statistics
     topology->CollectUtilizationStatistics();
 